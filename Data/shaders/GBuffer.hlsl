@@ -30,12 +30,28 @@ cbuffer MaterialBuffer : register(b1)
 	float3 padding2;
 };
 
+#if INSTANCED
+struct InstanceData
+{
+	matrix model;
+	matrix mvp_current;
+	matrix mvp_previous;
+};
+StructuredBuffer<InstanceData> instances : register(t0); // vertex shader only
+
+cbuffer InstanceBuffer : register(b2)
+{
+	uint instanceOffset;
+	uint3 padding3;
+};
+#else
 cbuffer ObjectBuffer : register(b2)
 {		
 	matrix mModel;
 	matrix mMVP_current;
 	matrix mMVP_previous;
 };
+#endif
 
 struct PixelInputType
 {
@@ -58,9 +74,20 @@ struct PixelOutputType
 	float2 depth	: SV_Target4;
 };
 
+#if INSTANCED
+PixelInputType mainVS(Vertex_PosUvNorTan input, uint instanceID : SV_InstanceID)
+{
+    PixelInputType output;
+	
+	InstanceData instance	= instances[instanceOffset + instanceID];
+	matrix mModel			= instance.model;
+	matrix mMVP_current		= instance.mvp_current;
+	matrix mMVP_previous	= instance.mvp_previous;
+#else
 PixelInputType mainVS(Vertex_PosUvNorTan input)
 {
     PixelInputType output;
+#endif
     
     input.position.w 			= 1.0f;	
 	output.positionWS 			= mul(input.position, mModel);
@@ -10,13 +10,29 @@ Texture2D texEnvironment 	: register(t7);
 Texture2D texLutIBL			: register(t8);
 //=========================================
 
+//= CLUSTERED LIGHTS =====================================
+struct ClusterLight
+{
+	float3 position;
+	float range;
+	float3 color;
+	float intensity;
+	float3 direction;
+	float angle;
+	uint type; // 0 = point, 1 = spot
+	float3 padding;
+};
+StructuredBuffer<ClusterLight> lights	: register(t9);
+StructuredBuffer<uint2> clusters		: register(t10); // offset, count
+StructuredBuffer<uint> lightIndices		: register(t11);
+//========================================================
+
 //= SAMPLERS ======================================
 SamplerState sampler_linear_clamp	: register(s0);
 SamplerState sampler_point_clamp	: register(s1);
 //=================================================
 
 //= CONSTANT BUFFERS ==========================
-#define MaxLights 64
 cbuffer MiscBuffer : register(b1)
 {
     matrix mWorldViewProjection;
@@ -26,17 +42,8 @@ cbuffer MiscBuffer : register(b1)
     float4 dirLightIntensity;
     float4 dirLightDirection;
 
-    float4 pointLightPosition[MaxLights];
-    float4 pointLightColor[MaxLights];
-    float4 pointLightIntenRange[MaxLights];
-	
-    float4 spotLightColor[MaxLights];
-    float4 spotLightPosition[MaxLights];
-    float4 spotLightDirection[MaxLights];
-    float4 spotLightIntenRangeAngle[MaxLights];
-	
-    float pointlightCount;
-    float spotlightCount;
+    float4 clusterGrid;		// tiles x, tiles y, slices, light count
+    float2 clusterSlicing;	// slice scale, slice bias
     float2 padding2;
 };
 //=============================================
@@ -129,57 +136,48 @@ float4 mainPS(Pixel_PosUv input) : SV_TARGET
 	color += BRDF(material, directionalLight, normal, camera_to_pixel);
 	//====================================================================================================================
 	
-	//= Point lights ====================================================
-    Light pointLight;
-    for (int i = 0; i < pointlightCount; i++)
-    {
-		// Get light data
-        pointLight.color        = pointLightColor[i].rgb;
-        float3 position         = pointLightPosition[i].xyz;
-        pointLight.intensity    = pointLightIntenRange[i].x;
-        float range             = pointLightIntenRange[i].y;
-        
-		// Compute light
-        pointLight.direction    = normalize(position - worldPos);
-        float dist              = length(worldPos - position);
-        float attunation        = clamp(1.0f - dist / range, 0.0f, 1.0f);
-        attunation              *= attunation;
-        pointLight.intensity    *= attunation;
-
-		// Compute illumination
-        if (dist < range)
-        {
-            color += BRDF(material, pointLight, normal, camera_to_pixel);
-        }
-    }
-	//===================================================================
-
-	//= Spot Lights =========================================================================================================
-    Light spotLight;
-    for (int j = 0; j < spotlightCount; j++)
+	//= Point and spot lights ==============================================================================================
+	// Find the cluster of the pixel, the same way LightClusters does on the CPU
+	float4 position_clip	= mul(float4(worldPos, 1.0f), g_viewProjection);
+	float2 position_ndc		= position_clip.xy / position_clip.w;
+	float depth_view		= mul(float4(worldPos, 1.0f), g_view).z;
+	uint2 tile				= (uint2)clamp((position_ndc * 0.5f + 0.5f) * clusterGrid.xy, 0.0f, clusterGrid.xy - 1.0f);
+	uint slice				= (uint)clamp(floor(log(max(depth_view, g_camera_near)) * clusterSlicing.x + clusterSlicing.y), 0.0f, clusterGrid.z - 1.0f);
+	uint2 cluster			= clusters[(slice * (uint)clusterGrid.y + tile.y) * (uint)clusterGrid.x + tile.x];
+
+    for (uint i = 0; i < cluster.y; i++)
     {
 		// Get light data
-        spotLight.color     = spotLightColor[j].rgb;
-        float3 position     = spotLightPosition[j].xyz;
-        spotLight.intensity = spotLightIntenRangeAngle[j].x;
-        spotLight.direction = normalize(-spotLightDirection[j].xyz);
-        float range         = spotLightIntenRangeAngle[j].y;
-        float cutoffAngle   = 1.0f - spotLightIntenRangeAngle[j].z;
-        
-		// Compute light
-        float3 direction    = normalize(position - worldPos);
-        float dist          = length(worldPos - position);
-        float theta         = dot(direction, spotLight.direction);
-        float epsilon       = cutoffAngle - cutoffAngle * 0.9f;
-        float attunation    = clamp((theta - cutoffAngle) / epsilon, 0.0f, 1.0f); // attunate when approaching the outer cone
-        attunation          *= clamp(1.0f - dist / range, 0.0f, 1.0f);
-        attunation          *= attunation; // attunate with distance as well
-        spotLight.intensity *= attunation;
+		ClusterLight data	= lights[lightIndices[cluster.x + i]];
+		Light light;
+        light.color			= data.color;
+        light.intensity		= data.intensity;
+        float3 direction	= normalize(data.position - worldPos);
+        float dist			= length(worldPos - data.position);
+        float attunation	= clamp(1.0f - dist / data.range, 0.0f, 1.0f);
+		bool lit			= dist < data.range;
+
+		if (data.type == 0) // Point
+		{
+			light.direction	= direction;
+			attunation		*= attunation;
+		}
+		else // Spot
+		{
+			light.direction		= normalize(-data.direction);
+			float cutoffAngle	= 1.0f - data.angle;
+			float theta			= dot(direction, light.direction);
+			float epsilon		= cutoffAngle - cutoffAngle * 0.9f;
+			attunation			*= clamp((theta - cutoffAngle) / epsilon, 0.0f, 1.0f); // attunate when approaching the outer cone
+			attunation			*= attunation; // attunate with distance as well
+			lit					= theta > cutoffAngle;
+		}
+        light.intensity *= attunation;
 
 		// Compute illumination
-        if (theta > cutoffAngle)
+        if (lit)
         {
-            color += BRDF(material, spotLight, normal, camera_to_pixel);
+            color += BRDF(material, light, normal, camera_to_pixel);
         }
     }
 	//=======================================================================================================================
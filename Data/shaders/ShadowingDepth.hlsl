@@ -2,6 +2,26 @@
 #include "Common.hlsl"
 //====================
 
+#if INSTANCED
+StructuredBuffer<matrix> instances : register(t0); // world matrices
+
+cbuffer InstanceBuffer : register(b1)
+{
+	matrix viewProjection;
+	uint instanceOffset;
+	uint3 padding;
+};
+
+Pixel_Pos mainVS(Vertex_Pos input, uint instanceID : SV_InstanceID)
+{
+	Pixel_Pos output;
+
+	input.position.w 	= 1.0f;	
+    output.position 	= mul(mul(input.position, instances[instanceOffset + instanceID]), viewProjection);
+	
+	return output;
+}
+#else
 cbuffer ObjectBuffer : register(b1)
 {		
 	matrix mvp;
@@ -16,6 +36,7 @@ Pixel_Pos mainVS(Vertex_Pos input)
 	
 	return output;
 }
+#endif
 
 float mainPS(Pixel_Pos input) : SV_TARGET
 {
@@ -160,7 +160,7 @@ public:
 			g_threading->AddTask([texture, file_path]()
 			{
 				texture->LoadFromFile(file_path);
-			});
+			}, Spartan::Job_Io);
 		}
 
 		return texture;
@@ -174,7 +174,7 @@ public:
 		g_threading->AddTask([resource_cache, file_path]()
 		{
 			resource_cache->Load<Spartan::Model>(file_path);
-		});
+		}, Spartan::Job_Io);
 	}
 
 	void LoadScene(const std::string& file_path) const
@@ -185,7 +185,7 @@ public:
 		g_threading->AddTask([world, file_path]()
 		{
 			world->LoadFromFile(file_path);
-		});
+		}, Spartan::Job_Io);
 	}
 
 	void SaveScene(const std::string& file_path) const
@@ -196,7 +196,7 @@ public:
 		g_threading->AddTask([world, file_path]()
 		{
 			world->SaveToFile(file_path);
-		});
+		}, Spartan::Job_Io);
 	}
 
 	void PickEntity()
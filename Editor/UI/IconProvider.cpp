@@ -179,7 +179,7 @@ const Thumbnail& IconProvider::Thumbnail_Load(const string& filePath, Icon_Type
 		m_context->GetSubsystem<Threading>()->AddTask([texture, filePath]()
 		{
 			texture->LoadFromFile(filePath);
-		});
+		}, Job_Io);
 
 		m_thumbnails.emplace_back(type, texture, filePath);
 		return m_thumbnails.back();
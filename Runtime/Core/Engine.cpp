@@ -23,6 +23,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "Engine.h"
 #include "EventSystem.h"
 #include "Timer.h"
+#include "FrameAllocator.h"
 #include "../Audio/Audio.h"
 #include "../Input/Input.h"
 #include "../Physics/Physics.h"
@@ -61,9 +62,11 @@ namespace Spartan
 		m_context->RegisterSubsystem<Renderer>();	
 		m_context->RegisterSubsystem<Threading>();	
 		m_context->RegisterSubsystem<Input>();
+#ifndef SPARTAN_HEADLESS // Audio, scripting and physics need libraries the headless build doesn't link
 		m_context->RegisterSubsystem<Audio>();		
 		m_context->RegisterSubsystem<Scripting>();
 		m_context->RegisterSubsystem<Physics>();	
+#endif
 		m_context->RegisterSubsystem<World>();		
 
 		// Initialize above subsystems
@@ -77,6 +80,7 @@ namespace Spartan
 
 	void Engine::Tick() const
 	{
+		FrameAllocator::OnFrameStart();
 		FIRE_EVENT(Event_Frame_Start);
 
 		if (EngineMode_IsSet(Engine_Tick))
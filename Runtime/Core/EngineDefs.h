@@ -24,10 +24,16 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 // Version
 #define ENGINE_VERSION "v0.31 WIP"
 
-// APIs
+// APIs, SPARTAN_HEADLESS selects the null graphics and input backends on every platform
+#if defined(_WIN32) && !defined(SPARTAN_HEADLESS)
 #define API_GRAPHICS_D3D11
 //#define API_GRAPHICS_VULKAN
+//#define API_GRAPHICS_NULL
 #define API_INPUT_WINDOWS
+#else
+#define API_GRAPHICS_NULL // Headless, everything runs but nothing is rendered
+#define API_INPUT_NULL
+#endif
 
 // Class
 #define SPARTAN_CLASS
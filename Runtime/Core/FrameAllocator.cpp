@@ -0,0 +1,160 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ==============
+#include "FrameAllocator.h"
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <cstring>
+#include <cstdint>
+//=========================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+	namespace _FrameAllocator
+	{
+		static const size_t block_size			= 256 * 1024;
+		static const unsigned int buffer_count	= 2;
+		static const unsigned int thread_max	= 64;
+
+		struct Block
+		{
+			unique_ptr<uint8_t[]> data;
+			size_t size = 0;
+		};
+
+		// The memory a single thread allocates from during a frame
+		struct Arena
+		{
+			void* Allocate(const size_t size, const size_t alignment)
+			{
+				while (true)
+				{
+					// Try the current block
+					if (block_index < blocks.size())
+					{
+						Block& block			= blocks[block_index];
+						const uintptr_t base	= reinterpret_cast<uintptr_t>(block.data.get());
+						const uintptr_t aligned	= (base + offset + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+						if (aligned + size <= base + block.size)
+						{
+							offset		= (aligned + size) - base;
+							allocated	+= size;
+							return reinterpret_cast<void*>(aligned);
+						}
+
+						// Move on to the next block
+						block_index++;
+						offset = 0;
+						continue;
+					}
+
+					// Out of blocks, grow (only happens until the arena has warmed up)
+					Block block;
+					block.size = max(block_size, size + alignment);
+					block.data = make_unique<uint8_t[]>(block.size);
+					blocks.emplace_back(move(block));
+				}
+			}
+
+			void Reset()
+			{
+				block_index	= 0;
+				offset		= 0;
+				allocated	= 0;
+			}
+
+			vector<Block> blocks;
+			size_t block_index	= 0;
+			size_t offset		= 0;
+			size_t allocated	= 0;
+		};
+
+		static Arena arenas[buffer_count][thread_max];
+		static atomic<unsigned int> buffer_index	= 0;
+		static atomic<unsigned int> thread_count	= 0;
+		static thread_local int thread_index		= -1;
+
+		// Threads past thread_max share a mutex protected arena
+		static const unsigned int thread_index_shared = thread_max - 1;
+		static mutex mutex_shared;
+	}
+
+	void* FrameAllocator::Allocate(const size_t size, const size_t alignment)
+	{
+		using namespace _FrameAllocator;
+
+		// Assign an arena to this thread on first use
+		if (thread_index == -1)
+		{
+			const unsigned int index = thread_count++;
+			thread_index = index < thread_index_shared ? static_cast<int>(index) : static_cast<int>(thread_index_shared);
+		}
+
+		Arena& arena = arenas[buffer_index.load(memory_order_relaxed)][thread_index];
+		if (thread_index == thread_index_shared)
+		{
+			lock_guard<mutex> lock(mutex_shared);
+			return arena.Allocate(size, alignment);
+		}
+
+		return arena.Allocate(size, alignment);
+	}
+
+	const char* FrameAllocator::AllocateString(const char* text)
+	{
+		const size_t size	= strlen(text) + 1;
+		char* copy			= static_cast<char*>(Allocate(size, alignof(char)));
+		memcpy(copy, text, size);
+		return copy;
+	}
+
+	void FrameAllocator::OnFrameStart()
+	{
+		using namespace _FrameAllocator;
+
+		// The buffer which is about to be used was last used two frames ago, so it's safe to reset
+		const unsigned int index = (buffer_index.load() + 1) % buffer_count;
+		for (auto& arena : arenas[index])
+		{
+			arena.Reset();
+		}
+		buffer_index = index;
+	}
+
+	size_t FrameAllocator::GetAllocatedBytes()
+	{
+		using namespace _FrameAllocator;
+
+		size_t allocated = 0;
+		for (const auto& arena : arenas[buffer_index.load()])
+		{
+			allocated += arena.allocated;
+		}
+
+		return allocated;
+	}
+}
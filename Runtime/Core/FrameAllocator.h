@@ -0,0 +1,72 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ==========
+#include <vector>
+#include <cstddef>
+#include "EngineDefs.h"
+//=====================
+
+namespace Spartan
+{
+	// A linear allocator for data which only lives for the duration of a frame.
+	// It's double buffered, so memory allocated during a frame remains valid until the end of the next one,
+	// and every thread allocates from its own sub-arena, so allocation is lock-free. Memory is never freed
+	// individually, the blocks are reused once the buffer comes around again, so steady-state frames don't
+	// touch the general heap. Jobs which allocate from it must complete within the frame they were issued in.
+	class SPARTAN_CLASS FrameAllocator
+	{
+	public:
+		static void* Allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t));
+		static const char* AllocateString(const char* text);
+
+		template <typename T>
+		static T* Allocate(const std::size_t count) { return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T))); }
+
+		// Swaps buffers, invoked by the engine at the start of every frame
+		static void OnFrameStart();
+
+		// Bytes allocated during the current frame
+		static std::size_t GetAllocatedBytes();
+	};
+
+	// STL allocator adapter, deallocation is a no-op
+	template <typename T>
+	class FrameAllocatorStl
+	{
+	public:
+		using value_type = T;
+
+		FrameAllocatorStl() = default;
+		template <typename U> FrameAllocatorStl(const FrameAllocatorStl<U>&) {}
+
+		T* allocate(const std::size_t count)	{ return FrameAllocator::Allocate<T>(count); }
+		void deallocate(T*, std::size_t)		{}
+
+		template <typename U> bool operator ==(const FrameAllocatorStl<U>&) const { return true; }
+		template <typename U> bool operator !=(const FrameAllocatorStl<U>&) const { return false; }
+	};
+
+	template <typename T>
+	using FrameVector = std::vector<T, FrameAllocatorStl<T>>;
+}
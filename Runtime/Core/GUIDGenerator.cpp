@@ -23,7 +23,12 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "GUIDGenerator.h"
 #include <iomanip>
 #include <sstream> 
+#ifdef _WIN32
 #include "objbase.h"
+#else
+#include <random>
+#include <cstdint>
+#endif
 //========================
 
 //= NAMESPACES =====
@@ -40,28 +45,40 @@ namespace Spartan
 
 	string GUIDGenerator::GenerateAsStr()
 	{
-		string guidString = "N/A";
+#ifdef _WIN32
 		GUID guid;
 		HRESULT hr = CoCreateGuid(&guid);
-		if (SUCCEEDED(hr))
+		if (FAILED(hr))
+			return "N/A";
+#else
+		// Random (version 4), laid out like a Windows GUID
+		struct { uint32_t Data1; uint16_t Data2; uint16_t Data3; uint8_t Data4[8]; } guid;
+		static thread_local mt19937 generator(random_device{}());
+		guid.Data1 = generator();
+		guid.Data2 = static_cast<uint16_t>(generator());
+		guid.Data3 = static_cast<uint16_t>((generator() & 0x0FFF) | 0x4000);
+		for (auto& byte : guid.Data4)
 		{
-			stringstream stream;
-			stream << hex << uppercase
-				<< setw(8) << setfill('0') << guid.Data1
-				<< "-" << setw(4) << setfill('0') << guid.Data2
-				<< "-" << setw(4) << setfill('0') << guid.Data3
-				<< "-";
+			byte = static_cast<uint8_t>(generator());
+		}
+		guid.Data4[0] = (guid.Data4[0] & 0x3F) | 0x80;
+#endif
+
+		stringstream stream;
+		stream << hex << uppercase
+			<< setw(8) << setfill('0') << guid.Data1
+			<< "-" << setw(4) << setfill('0') << guid.Data2
+			<< "-" << setw(4) << setfill('0') << guid.Data3
+			<< "-";
 
-			for (unsigned int i = 0; i < sizeof(guid.Data4); ++i)
-			{
-				if (i == 2)
-					stream << "-";
-				stream << hex << setw(2) << setfill('0') << int(guid.Data4[i]);
-			}
-			guidString = stream.str();
+		for (unsigned int i = 0; i < sizeof(guid.Data4); ++i)
+		{
+			if (i == 2)
+				stream << "-";
+			stream << hex << setw(2) << setfill('0') << int(guid.Data4[i]);
 		}
 
-		return guidString;
+		return stream.str();
 	}
 
 	string GUIDGenerator::ToStr(unsigned int guid)
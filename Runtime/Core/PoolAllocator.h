@@ -0,0 +1,125 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ======
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <cstddef>
+//=================
+
+namespace Spartan
+{
+	// A pool of objects of type T. Objects live in contiguous slabs with stable addresses,
+	// freed slots are kept in a free list and reused, slabs are never returned to the heap.
+	template <typename T>
+	class Pool
+	{
+	public:
+		// The pool is intentionally never destroyed, pooled objects can outlive static destruction
+		static Pool& Get() { static Pool* pool = new Pool(); return *pool; }
+
+		T* Allocate()
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+
+			// Out of free slots, allocate a new slab and thread its slots into the free list
+			if (!m_free)
+			{
+				auto slab = std::make_unique<Slot[]>(m_slab_size);
+				for (unsigned int i = 0; i < m_slab_size; i++)
+				{
+					slab[i].next = i + 1 < m_slab_size ? &slab[i + 1] : nullptr;
+				}
+				m_free = &slab[0];
+				m_slabs.emplace_back(std::move(slab));
+			}
+
+			Slot* slot = m_free;
+			m_free = slot->next;
+			m_count++;
+
+			return reinterpret_cast<T*>(slot->storage);
+		}
+
+		void Free(T* object)
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+
+			Slot* slot	= reinterpret_cast<Slot*>(object);
+			slot->next	= m_free;
+			m_free		= slot;
+			m_count--;
+		}
+
+		unsigned int GetCount() const		{ return m_count; }
+		unsigned int GetCapacity() const	{ return static_cast<unsigned int>(m_slabs.size()) * m_slab_size; }
+
+	private:
+		Pool() = default;
+
+		union Slot
+		{
+			Slot* next;
+			alignas(T) unsigned char storage[sizeof(T)];
+		};
+
+		std::vector<std::unique_ptr<Slot[]>> m_slabs;
+		Slot* m_free				= nullptr;
+		unsigned int m_slab_size	= 256;
+		unsigned int m_count		= 0;
+		std::mutex m_mutex;
+	};
+
+	// STL allocator adapter which allocates single objects from Pool<T>.
+	// Used with std::allocate_shared, the object and its control block share one pooled slot.
+	template <typename T>
+	class PoolAllocator
+	{
+	public:
+		using value_type = T;
+
+		PoolAllocator() = default;
+		template <typename U> PoolAllocator(const PoolAllocator<U>&) {}
+
+		T* allocate(const std::size_t count)
+		{
+			return count == 1 ? Pool<T>::Get().Allocate() : std::allocator<T>().allocate(count);
+		}
+
+		void deallocate(T* object, const std::size_t count)
+		{
+			if (count == 1)
+			{
+				Pool<T>::Get().Free(object);
+			}
+			else
+			{
+				std::allocator<T>().deallocate(object, count);
+			}
+		}
+
+		template <typename U> bool operator ==(const PoolAllocator<U>&) const { return true; }
+		template <typename U> bool operator !=(const PoolAllocator<U>&) const { return false; }
+	};
+}
@@ -22,6 +22,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES ========================
 #include "Settings.h"
 #include <fstream>
+#include <thread>
+#include <cfloat>
 #include "../Logging/Log.h"
 #include "../FileSystem/FileSystem.h"
 //===================================
@@ -69,14 +69,15 @@ namespace Spartan
 		auto GetFpsPolicy()			{ return m_fps_policy; }
 		//==================================================
 
-		//= MISC ==============================================================
+		//= MISC =======================================================================
 		auto GetIsFullScreen() const		{ return m_is_fullscreen; }
 		auto GetIsMouseVisible() const		{ return m_is_mouse_visible; }
 		auto GetShadowResolution() const	{ return m_shadow_map_resolution; }
 		auto GetAnisotropy() const			{ return m_anisotropy; }
 		auto GetMaxThreadCount() const		{ return m_max_thread_count; }	
 		auto GetReverseZ() const			{ return m_reverse_z; }
-		//=====================================================================
+		void SetMaxThreadCount(const unsigned int count)	{ m_max_thread_count = count; }
+		//==============================================================================
 
 		// Third party lib versions
 		std::string m_versionAngelScript;
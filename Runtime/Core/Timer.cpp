@@ -32,6 +32,8 @@ using namespace chrono;
 
 namespace Spartan
 {
+	float ISubsystem::m_delta_time_sec;
+
 	Timer::Timer(Context* context) : ISubsystem(context)
 	{
 		time_a			= high_resolution_clock::now();
@@ -24,8 +24,10 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <filesystem>
 #include <regex>
 #include "../Logging/Log.h"
+#ifdef _WIN32
 #include <Windows.h>
 #include <shellapi.h>
+#endif
 //=========================
 
 //= NAMESPACES =================
@@ -227,7 +229,11 @@ namespace Spartan
 
 	void FileSystem::OpenDirectoryWindow(const std::string& directory)
 	{
+#ifdef _WIN32
 		ShellExecute(nullptr, nullptr, StringToWstring(directory).c_str(), nullptr, nullptr, SW_SHOW);
+#else
+		LOGF_WARNING("Opening %s is only supported on Windows", directory.c_str());
+#endif
 	}
 
 	bool FileSystem::FileExists(const string& file_path)
@@ -711,6 +717,7 @@ namespace Spartan
 
 	wstring FileSystem::StringToWstring(const string& str)
 	{
+#ifdef _WIN32
 		const auto slength =	 static_cast<int>(str.length()) + 1;
 		const auto len		= MultiByteToWideChar(CP_ACP, 0, str.c_str(), slength, nullptr, 0);
 		const auto buf		= new wchar_t[len];
@@ -718,5 +725,8 @@ namespace Spartan
 		std::wstring result(buf);
 		delete[] buf;
 		return result;
+#else
+		return wstring(str.begin(), str.end());
+#endif
 	}
 }
\ No newline at end of file
@@ -0,0 +1,60 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= IMPLEMENTATION =================
+#include "../Input_Implementation.h"
+#ifdef API_INPUT_NULL
+//==================================
+
+//= INCLUDES ========
+#include "../Input.h"
+//===================
+
+namespace Spartan
+{
+	// There are no devices, every key stays released and the mouse stays put
+	Input::Input(Context* context) : ISubsystem(context)
+	{
+		m_keys.fill(false);
+		m_keys_previous.fill(false);
+		m_gamepad_connected		= false;
+		m_gamepad_trigger_left	= 0.0f;
+		m_gamepad_trigger_right	= 0.0f;
+	}
+
+	Input::~Input() = default;
+
+	void Input::Tick()
+	{
+		m_keys_previous	= m_keys;
+		m_mouse_delta	= Math::Vector2::Zero;
+	}
+
+	bool Input::ReadMouse() const		{ return false; }
+	bool Input::ReadKeyboard() const	{ return false; }
+	bool Input::ReadGamepad() const		{ return false; }
+
+	bool Input::GamepadVibrate(const float left_motor_speed, const float right_motor_speed) const
+	{
+		return false;
+	}
+}
+#endif
@@ -45,6 +45,7 @@ namespace Spartan
 
 	// Forward declarations
 	class Entity;
+	class ILogger;
 	namespace Math
 	{
 		class Quaternion;
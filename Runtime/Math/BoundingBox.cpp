@@ -44,13 +44,19 @@ namespace Spartan::Math
 		this->m_max = max;
 	}
 
-	BoundingBox::BoundingBox(const std::vector<RHI_Vertex_PosUvNorTan>& vertices)
+	BoundingBox::BoundingBox(const std::vector<RHI_Vertex_PosUvNorTan>& vertices) : BoundingBox(vertices.data(), static_cast<unsigned int>(vertices.size()))
+	{
+	}
+
+	BoundingBox::BoundingBox(const RHI_Vertex_PosUvNorTan* vertices, const unsigned int vertex_count)
 	{
 		m_min = Vector3::Infinity;
 		m_max = Vector3::InfinityNeg;
 
-		for (const auto& vertex : vertices)
+		for (unsigned int i = 0; i < vertex_count; i++)
 		{
+			const auto& vertex = vertices[i];
+
 			m_max.x = Max(m_max.x, vertex.pos[0]);
 			m_max.y = Max(m_max.y, vertex.pos[1]);
 			m_max.z = Max(m_max.z, vertex.pos[2]);
@@ -116,7 +122,33 @@ namespace Spartan::Math
 		m_min.y = Min(m_min.y, box.m_min.y);
 		m_min.z = Min(m_min.z, box.m_min.z);
 		m_max.x = Max(m_max.x, box.m_max.x);
-		m_max.y = Max(m_max.x, box.m_max.x);
-		m_max.z = Max(m_max.x, box.m_max.x);
+		m_max.y = Max(m_max.y, box.m_max.y);
+		m_max.z = Max(m_max.z, box.m_max.z);
+	}
+
+	void BoundingBoxes::Resize(const unsigned int count)
+	{
+		m_count = count;
+
+		// Padding boxes have no size and sit at the origin
+		const unsigned int count_padded = (count + 3) & ~3u;
+		center_x.resize(count_padded, 0.0f);
+		center_y.resize(count_padded, 0.0f);
+		center_z.resize(count_padded, 0.0f);
+		extent_x.resize(count_padded, 0.0f);
+		extent_y.resize(count_padded, 0.0f);
+		extent_z.resize(count_padded, 0.0f);
+	}
+
+	void BoundingBoxes::Set(const unsigned int index, const BoundingBox& box)
+	{
+		const Vector3 center	= box.GetCenter();
+		const Vector3 extent	= box.GetExtents();
+		center_x[index]			= center.x;
+		center_y[index]			= center.y;
+		center_z[index]			= center.z;
+		extent_x[index]			= extent.x;
+		extent_y[index]			= extent.y;
+		extent_z[index]			= extent.z;
 	}
-}
\ No newline at end of file
+}
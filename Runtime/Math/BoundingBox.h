@@ -47,6 +47,9 @@ namespace Spartan
 			// Construct from vertices
 			BoundingBox(const std::vector<RHI_Vertex_PosUvNorTan>& vertices);
 
+			// Construct from a range of vertices
+			BoundingBox(const RHI_Vertex_PosUvNorTan* vertices, unsigned int vertex_count);
+
 			~BoundingBox() {}
 
 			// Assign from bounding box
@@ -90,5 +93,25 @@ namespace Spartan
 			Vector3 m_min;
 			Vector3 m_max;	
 		};
+
+		// Boxes stored as separate arrays of centers and extents (SoA), the layout batched culling works on.
+		// The arrays are padded to a multiple of 4 so they can always be processed 4 boxes at a time.
+		class SPARTAN_CLASS BoundingBoxes
+		{
+		public:
+			void Resize(unsigned int count);
+			void Set(unsigned int index, const BoundingBox& box);
+			unsigned int GetCount() const { return m_count; }
+
+			std::vector<float> center_x;
+			std::vector<float> center_y;
+			std::vector<float> center_z;
+			std::vector<float> extent_x;
+			std::vector<float> extent_y;
+			std::vector<float> extent_z;
+
+		private:
+			unsigned int m_count = 0;
+		};
 	}
 }
@@ -19,10 +19,12 @@ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
 CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 */
 
-//= INCLUDES =======
+//= INCLUDES ===========
 #include "Frustum.h"
 #include "Plane.h"
-//==================
+#include "BoundingBox.h"
+#include "SIMD.h"
+//======================
 
 //= NAMESPACES ========================
 using namespace Spartan::Math::Helper;
@@ -85,7 +87,7 @@ namespace Spartan::Math
 		m_planes[5].Normalize();
 	}
 
-	Intersection Frustum::CheckCube(const Vector3& center, const Vector3& extent)
+	Intersection Frustum::CheckCube(const Vector3& center, const Vector3& extent) const
 	{
 		// Check if any one point of the cube is in the view frustum.
 		Intersection result = Inside;
@@ -114,7 +116,7 @@ namespace Spartan::Math
 		return result;
 	}
 
-	Intersection Frustum::CheckSphere(const Vector3& center, float radius)
+	Intersection Frustum::CheckSphere(const Vector3& center, float radius) const
 	{
 		// calculate our distances to each of the planes
 		for (const auto& plane : m_planes)
@@ -138,4 +140,52 @@ namespace Spartan::Math
 		// otherwise we are fully in view
 		return Inside;
 	}
-}
\ No newline at end of file
+
+	void Frustum::CheckCubes(const BoundingBoxes& boxes, const unsigned int start, const unsigned int end, uint32_t* visibility) const
+	{
+		// Splat the planes once
+		Simd::Float4 normal_x[6], normal_y[6], normal_z[6], normal_abs_x[6], normal_abs_y[6], normal_abs_z[6], distance_neg[6];
+		for (unsigned int p = 0; p < 6; p++)
+		{
+			normal_x[p]		= Simd::Splat(m_planes[p].normal.x);
+			normal_y[p]		= Simd::Splat(m_planes[p].normal.y);
+			normal_z[p]		= Simd::Splat(m_planes[p].normal.z);
+			normal_abs_x[p]	= Simd::Abs(normal_x[p]);
+			normal_abs_y[p]	= Simd::Abs(normal_y[p]);
+			normal_abs_z[p]	= Simd::Abs(normal_z[p]);
+			distance_neg[p]	= Simd::Splat(-m_planes[p].d);
+		}
+
+		for (unsigned int i = start; i < end; i += 4)
+		{
+			const Simd::Float4 center_x = Simd::Load(&boxes.center_x[i]);
+			const Simd::Float4 center_y = Simd::Load(&boxes.center_y[i]);
+			const Simd::Float4 center_z = Simd::Load(&boxes.center_z[i]);
+			const Simd::Float4 extent_x = Simd::Load(&boxes.extent_x[i]);
+			const Simd::Float4 extent_y = Simd::Load(&boxes.extent_y[i]);
+			const Simd::Float4 extent_z = Simd::Load(&boxes.extent_z[i]);
+
+			// A box is outside when it's fully behind any of the planes
+			Simd::Float4 outside = Simd::Splat(0.0f);
+			for (unsigned int p = 0; p < 6; p++)
+			{
+				Simd::Float4 d	= Simd::Mul(center_x, normal_x[p]);
+				d				= Simd::MulAdd(center_y, normal_y[p], d);
+				d				= Simd::MulAdd(center_z, normal_z[p], d);
+				d				= Simd::MulAdd(extent_x, normal_abs_x[p], d);
+				d				= Simd::MulAdd(extent_y, normal_abs_y[p], d);
+				d				= Simd::MulAdd(extent_z, normal_abs_z[p], d);
+				outside			= Simd::Or(outside, Simd::CompareLess(d, distance_neg[p]));
+			}
+
+			// Ignore the padding past the end of the range
+			uint32_t visible = ~Simd::MoveMask(outside) & 0xF;
+			if (end - i < 4)
+			{
+				visible &= (1u << (end - i)) - 1;
+			}
+
+			visibility[i / 32] |= visible << (i % 32);
+		}
+	}
+}
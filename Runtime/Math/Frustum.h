@@ -22,6 +22,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #pragma once
 
 //= INCLUDES =============
+#include <cstdint>
 #include "../Math/Plane.h"
 #include "Matrix.h"
 #include "Vector3.h"
@@ -29,6 +30,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 namespace Spartan::Math
 {
+	class BoundingBoxes;
+
 	class Frustum
 	{
 	public:
@@ -36,8 +39,12 @@ namespace Spartan::Math
 		~Frustum() {}
 
 		void Construct(const Matrix& mView, const Matrix&  mProjection, float screenDepth);
-		Intersection CheckCube(const Vector3& center, const Vector3& extent);
-		Intersection CheckSphere(const Vector3& center, float radius);
+		Intersection CheckCube(const Vector3& center, const Vector3& extent) const;
+		Intersection CheckSphere(const Vector3& center, float radius) const;
+
+		// Tests boxes [start, end) four at a time and sets bit i of visibility for every box which is not outside.
+		// Bits of the range have to be cleared by the caller, start has to be a multiple of 32 so ranges never share a word.
+		void CheckCubes(const BoundingBoxes& boxes, unsigned int start, unsigned int end, uint32_t* visibility) const;
 
 	private:
 		Plane m_planes[6];
@@ -35,14 +35,14 @@ namespace Spartan::Math::Helper
 		Intersects
 	};
 
-	static const float M_EPSILON	= 0.000001f;
-	static const float PI			= 3.14159265359f;
-	static const float PI_2			= 6.28318530718f;
-	static const float PI_DIV_2		= 1.57079632679f;
-	static const float PI_DIV_4		= 0.78539816339f;
-	static const float PI_INV		= 0.31830988618f;
-	static const float DEG_TO_RAD	= PI / 180.0f;
-	static const float RAD_TO_DEG	= 180.0f / PI;
+	static constexpr float M_EPSILON	= 0.000001f;
+	static constexpr float PI			= 3.14159265359f;
+	static constexpr float PI_2			= 6.28318530718f;
+	static constexpr float PI_DIV_2		= 1.57079632679f;
+	static constexpr float PI_DIV_4		= 0.78539816339f;
+	static constexpr float PI_INV		= 0.31830988618f;
+	static constexpr float DEG_TO_RAD	= PI / 180.0f;
+	static constexpr float RAD_TO_DEG	= 180.0f / PI;
 
 	inline double Cot(float x)								{ return cos(x) / sin(x); }
 	inline float CotF(float x)								{ return cosf(x) / sinf(x); }
@@ -25,6 +25,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "Quaternion.h"
 #include "Vector3.h"
 #include "Vector4.h"
+#include "SIMD.h"
 //=====================
 
 //= NAMESPACES ========================
@@ -63,12 +64,7 @@ namespace Spartan::Math
 
 		Matrix(const Vector3& translation, const Quaternion& rotation, const Vector3& scale)
 		{
-			Matrix mRotation = CreateRotation(rotation);
-
-			m00 = scale.x * mRotation.m00; m01 = scale.x * mRotation.m01; m02 = scale.x * mRotation.m02; m03 = 0.0f;
-			m10 = scale.y * mRotation.m10; m11 = scale.y * mRotation.m11; m12 = scale.y * mRotation.m12; m13 = 0.0f;
-			m20 = scale.z * mRotation.m20; m21 = scale.z * mRotation.m21; m22 = scale.z * mRotation.m22; m23 = 0.0f;
-			m30 = translation.x; m31 = translation.y; m32 = translation.z; m33 = 1.0f;
+			Simd::MatrixCompose(translation.Data(), &rotation.x, scale.Data(), &m00);
 		}
 
 		~Matrix() {}
@@ -120,10 +116,11 @@ namespace Spartan::Math
 			);
 		}
 
-		Quaternion GetRotation()
-		{
-			Vector3 scale = GetScale();
+		Quaternion GetRotation() { return GetRotation(GetScale()); }
 
+		// Rotation for an already known scale, saves decomposing the scale twice
+		Quaternion GetRotation(const Vector3& scale)
+		{
 			// Avoid division by zero (we'll divide to remove scaling)
 			if (scale.x == 0.0f || scale.y == 0.0f || scale.z == 0.0f) { return Quaternion(0, 0, 0, 1); }
 
@@ -278,12 +275,9 @@ namespace Spartan::Math
 		void Transpose() { *this = Transpose(*this); }
 		static Matrix Transpose(const Matrix& matrix)
 		{
-			return Matrix(
-				matrix.m00, matrix.m10, matrix.m20, matrix.m30,
-				matrix.m01, matrix.m11, matrix.m21, matrix.m31,
-				matrix.m02, matrix.m12, matrix.m22, matrix.m32,
-				matrix.m03, matrix.m13, matrix.m23, matrix.m33
-			);
+			Matrix result;
+			Simd::MatrixTranspose(matrix.Data(), &result.m00);
+			return result;
 		}
 		//================================================================================================
 
@@ -291,59 +285,9 @@ namespace Spartan::Math
 		Matrix Inverted() const { return Invert(*this); }
 		static Matrix Invert(const Matrix& matrix)
 		{
-			float v0 = matrix.m20 * matrix.m31 - matrix.m21 * matrix.m30;
-			float v1 = matrix.m20 * matrix.m32 - matrix.m22 * matrix.m30;
-			float v2 = matrix.m20 * matrix.m33 - matrix.m23 *matrix.m30;
-			float v3 = matrix.m21 * matrix.m32 - matrix.m22 * matrix.m31;
-			float v4 = matrix.m21 * matrix.m33 - matrix.m23 * matrix.m31;
-			float v5 = matrix.m22 * matrix.m33 - matrix.m23 * matrix.m32;
-
-			float i00 = (v5 * matrix.m11 - v4 * matrix.m12 + v3 * matrix.m13);
-			float i10 = -(v5 * matrix.m10 - v2 * matrix.m12 + v1 * matrix.m13);
-			float i20 = (v4 * matrix.m10 - v2 * matrix.m11 + v0 * matrix.m13);
-			float i30 = -(v3 * matrix.m10 - v1 * matrix.m11 + v0 * matrix.m12);
-
-			float invDet = 1.0f / (i00 * matrix.m00 + i10 * matrix.m01 + i20 * matrix.m02 + i30 * matrix.m03);
-
-			i00 *= invDet;
-			i10 *= invDet;
-			i20 *= invDet;
-			i30 *= invDet;
-
-			float i01 = -(v5 * matrix.m01 - v4 * matrix.m02 + v3 * matrix.m03) * invDet;
-			float i11 = (v5 * matrix.m00 - v2 * matrix.m02 + v1 * matrix.m03) * invDet;
-			float i21 = -(v4 * matrix.m00 - v2 * matrix.m01 + v0 * matrix.m03) * invDet;
-			float i31 = (v3 * matrix.m00 - v1 * matrix.m01 + v0 * matrix.m02) * invDet;
-
-			v0 = matrix.m10 * matrix.m31 - matrix.m11 * matrix.m30;
-			v1 = matrix.m10 * matrix.m32 - matrix.m12 * matrix.m30;
-			v2 = matrix.m10 * matrix.m33 - matrix.m13 * matrix.m30;
-			v3 = matrix.m11 * matrix.m32 - matrix.m12 * matrix.m31;
-			v4 = matrix.m11 * matrix.m33 - matrix.m13 * matrix.m31;
-			v5 = matrix.m12 * matrix.m33 - matrix.m13 * matrix.m32;
-
-			float i02 = (v5 * matrix.m01 - v4 * matrix.m02 + v3 * matrix.m03) * invDet;
-			float i12 = -(v5 * matrix.m00 - v2 * matrix.m02 + v1 * matrix.m03) * invDet;
-			float i22 = (v4 * matrix.m00 - v2 * matrix.m01 + v0 * matrix.m03) * invDet;
-			float i32 = -(v3 * matrix.m00 - v1 * matrix.m01 + v0 * matrix.m02) * invDet;
-
-			v0 = matrix.m21 * matrix.m10 - matrix.m20 * matrix.m11;
-			v1 = matrix.m22 * matrix.m10 - matrix.m20 * matrix.m12;
-			v2 = matrix.m23 * matrix.m10 - matrix.m20 * matrix.m13;
-			v3 = matrix.m22 * matrix.m11 - matrix.m21 * matrix.m12;
-			v4 = matrix.m23 * matrix.m11 - matrix.m21 * matrix.m13;
-			v5 = matrix.m23 * matrix.m12 - matrix.m22 * matrix.m13;
-
-			float i03 = -(v5 * matrix.m01 - v4 * matrix.m02 + v3 * matrix.m03) * invDet;
-			float i13 = (v5 * matrix.m00 - v2 * matrix.m02 + v1 * matrix.m03) * invDet;
-			float i23 = -(v4 * matrix.m00 - v2 * matrix.m01 + v0 * matrix.m03) * invDet;
-			float i33 = (v3 * matrix.m00 - v1 * matrix.m01 + v0 * matrix.m02) * invDet;
-
-			return Matrix(
-				i00, i01, i02, i03,
-				i10, i11, i12, i13,
-				i20, i21, i22, i23,
-				i30, i31, i32, i33);
+			Matrix result;
+			Simd::MatrixInverse(matrix.Data(), &result.m00);
+			return result;
 		}
 		//================================================================================================
 
@@ -351,7 +295,7 @@ namespace Spartan::Math
 		{
 			translation = GetTranslation();
 			scale		= GetScale();
-			rotation	= GetRotation();
+			rotation	= GetRotation(scale);
 		}
 
 		void SetIdentity()
@@ -365,24 +309,9 @@ namespace Spartan::Math
 		//= MULTIPLICATION ================================================================================================================
 		Matrix operator*(const Matrix& rhs) const
 		{
-			return Matrix(
-				m00 * rhs.m00 + m01 * rhs.m10 + m02 * rhs.m20 + m03 * rhs.m30,
-				m00 * rhs.m01 + m01 * rhs.m11 + m02 * rhs.m21 + m03 * rhs.m31,
-				m00 * rhs.m02 + m01 * rhs.m12 + m02 * rhs.m22 + m03 * rhs.m32,
-				m00 * rhs.m03 + m01 * rhs.m13 + m02 * rhs.m23 + m03 * rhs.m33,
-				m10 * rhs.m00 + m11 * rhs.m10 + m12 * rhs.m20 + m13 * rhs.m30,
-				m10 * rhs.m01 + m11 * rhs.m11 + m12 * rhs.m21 + m13 * rhs.m31,
-				m10 * rhs.m02 + m11 * rhs.m12 + m12 * rhs.m22 + m13 * rhs.m32,
-				m10 * rhs.m03 + m11 * rhs.m13 + m12 * rhs.m23 + m13 * rhs.m33,
-				m20 * rhs.m00 + m21 * rhs.m10 + m22 * rhs.m20 + m23 * rhs.m30,
-				m20 * rhs.m01 + m21 * rhs.m11 + m22 * rhs.m21 + m23 * rhs.m31,
-				m20 * rhs.m02 + m21 * rhs.m12 + m22 * rhs.m22 + m23 * rhs.m32,
-				m20 * rhs.m03 + m21 * rhs.m13 + m22 * rhs.m23 + m23 * rhs.m33,
-				m30 * rhs.m00 + m31 * rhs.m10 + m32 * rhs.m20 + m33 * rhs.m30,
-				m30 * rhs.m01 + m31 * rhs.m11 + m32 * rhs.m21 + m33 * rhs.m31,
-				m30 * rhs.m02 + m31 * rhs.m12 + m32 * rhs.m22 + m33 * rhs.m32,
-				m30 * rhs.m03 + m31 * rhs.m13 + m32 * rhs.m23 + m33 * rhs.m33
-			);
+			Matrix result;
+			Simd::MatrixMultiply(Data(), rhs.Data(), &result.m00);
+			return result;
 		}
 
 		void operator*=(const Matrix& rhs) { (*this) = (*this) * rhs; }
@@ -390,11 +319,8 @@ namespace Spartan::Math
 		Vector3 operator *(const Vector3& rhs) const
 		{
 			Vector4 vWorking;
-
-			vWorking.x = (rhs.x * m00) + (rhs.y * m10) + (rhs.z * m20) + m30;
-			vWorking.y = (rhs.x * m01) + (rhs.y * m11) + (rhs.z * m21) + m31;
-			vWorking.z = (rhs.x * m02) + (rhs.y * m12) + (rhs.z * m22) + m32;
-			vWorking.w = 1 / ((rhs.x * m03) + (rhs.y * m13) + (rhs.z * m23) + m33);
+			Simd::Store(&vWorking.x, Simd::MatrixTransformPoint(Data(), rhs.x, rhs.y, rhs.z));
+			vWorking.w = 1 / vWorking.w;
 
 			return Vector3(vWorking.x * vWorking.w, vWorking.y * vWorking.w, vWorking.z * vWorking.w);
 		}
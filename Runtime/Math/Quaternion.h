@@ -23,6 +23,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 //= INCLUDES =======
 #include "Vector3.h"
+#include "SIMD.h"
 //==================
 
 namespace Spartan::Math
@@ -246,37 +247,12 @@ namespace Spartan::Math
 		//= MULTIPLICATION ==============================================================================
 		Quaternion operator*(const Quaternion& rhs) const
 		{
-			float num4	= rhs.x;
-			float num3	= rhs.y;
-			float num2	= rhs.z;
-			float num	= rhs.w;
-			float num12 = (y * num2) - (z * num3);
-			float num11 = (z * num4) - (x * num2);
-			float num10 = (x * num3) - (y * num4);
-			float num9 = ((x * num4) + (y * num3)) + (z * num2);
 			Quaternion quaternion;
-			quaternion.x = ((x * num) + (num4 * w)) + num12;
-			quaternion.y = ((y * num) + (num3 * w)) + num11;
-			quaternion.z = ((z * num) + (num2 * w)) + num10;
-			quaternion.w = (w * num) - num9;
+			Simd::QuaternionMultiply(&x, &rhs.x, &quaternion.x);
 			return quaternion;
 		}
 
-		void operator*=(const Quaternion& rhs)
-		{
-			float num4 = rhs.x;
-			float num3 = rhs.y;
-			float num2 = rhs.z;
-			float num = rhs.w;
-			float num12 = (y * num2) - (z * num3);
-			float num11 = (z * num4) - (x * num2);
-			float num10 = (x * num3) - (y * num4);
-			float num9 = ((x * num4) + (y * num3)) + (z * num2);
-			x	= ((x * num) + (num4 * w)) + num12;
-			y	= ((y * num) + (num3 * w)) + num11;
-			z	= ((z * num) + (num2 * w)) + num10;
-			w	= (w * num) - num9;
-		}
+		void operator*=(const Quaternion& rhs) { *this = *this * rhs; }
 
 		Vector3 operator*(const Vector3& rhs) const
 		{
@@ -23,11 +23,14 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "Ray.h"
 #include <algorithm>
 #include "RayHit.h"
+#include "TriangleBvh.h"
 #include "../Core/Context.h"
 #include "../World/World.h"
 #include "../World/Entity.h"
 #include "../World/Components/Skybox.h"
 #include "../World/Components/Renderable.h"
+#include "../World/Components/Transform.h"
+#include "../Rendering/Model.h"
 //=========================================
 
 //= NAMESPACES =====
@@ -45,28 +48,27 @@ namespace Spartan::Math
 
 	vector<RayHit> Ray::Trace(Context* context) const
 	{
-		// Find all the entities that the ray hits
+		// Find all the entities that the ray hits, the tree only returns the ones close to the ray
 		vector<RayHit> hits;
-		const auto& entities = context->GetSubsystem<World>()->Entities_GetAll();
-		for (const auto& entity : entities)
+		context->GetSubsystem<World>()->GetSpatialTree().QueryRay(*this, [this, &hits](Entity* entity)
 		{
-			// Make sure there entity has a mesh and exclude the SkyBox
-			if (!entity->HasComponent<Renderable>() || entity->HasComponent<Skybox>())
-				continue;
-
-			// Get bounding box
-			auto aabb = entity->GetComponent<Renderable>()->GeometryAabb();
+			// Exclude the SkyBox
+			if (entity->HasComponent<Skybox>())
+				return;
 
 			// Compute hit distance
-			auto hit_distance = HitDistance(aabb);
+			const auto box_distance = HitDistance(entity->GetComponent_PtrRaw<Renderable>()->GeometryAabb());
 
 			// Don't store hit data if there was no hit
-			if (hit_distance == INFINITY)
-				continue;
+			if (box_distance == INFINITY)
+				return;
 
-			auto inside	= (hit_distance == 0.0f);
-			hits.emplace_back(entity, hit_distance, inside);
-		}
+			RayHit hit;
+			if (HitEntity(entity, box_distance, &hit))
+			{
+				hits.emplace_back(move(hit));
+			}
+		});
 
 		// Sort by distance (ascending)
 		sort(hits.begin(), hits.end(), [](const RayHit& a, const RayHit& b)
@@ -77,6 +79,81 @@ namespace Spartan::Math
 		return hits;
 	}
 
+	bool Ray::TraceClosest(Context* context, RayHit* hit) const
+	{
+		if (!hit)
+			return false;
+
+		// Find the entities whose bounding box the ray hits
+		vector<pair<float, Entity*>> candidates;
+		context->GetSubsystem<World>()->GetSpatialTree().QueryRay(*this, [this, &candidates](Entity* entity)
+		{
+			if (entity->HasComponent<Skybox>())
+				return;
+
+			const auto box_distance = HitDistance(entity->GetComponent_PtrRaw<Renderable>()->GeometryAabb());
+			if (box_distance != INFINITY)
+			{
+				candidates.emplace_back(box_distance, entity);
+			}
+		});
+
+		// Test them nearest first, an entity whose box is further away than the closest hit can't contain a closer one
+		sort(candidates.begin(), candidates.end(), [](const pair<float, Entity*>& a, const pair<float, Entity*>& b) { return a.first < b.first; });
+		RayHit closest;
+		for (const auto& [box_distance, entity] : candidates)
+		{
+			if (box_distance >= closest.m_distance)
+				break;
+
+			RayHit candidate;
+			candidate.m_distance = closest.m_distance;
+			if (HitEntity(entity, box_distance, &candidate) && !candidate.m_inside)
+			{
+				closest = move(candidate);
+			}
+		}
+
+		*hit = move(closest);
+		return hit->m_entity != nullptr;
+	}
+
+	bool Ray::HitEntity(Entity* entity, const float box_distance, RayHit* hit) const
+	{
+		auto renderable	= entity->GetComponent_PtrRaw<Renderable>();
+		auto model		= renderable->GeometryModel();
+		const auto bvh	= model ? model->GeometryBvh(renderable->GeometryIndexOffset(), renderable->GeometryIndexCount(), renderable->GeometryVertexOffset()) : nullptr;
+
+		// No geometry to test against, the bounding box is the best there is
+		if (!bvh)
+		{
+			if (box_distance >= hit->m_distance)
+				return false;
+
+			hit->m_entity	= entity->GetPtrShared();
+			hit->m_distance	= box_distance;
+			hit->m_inside	= box_distance == 0.0f;
+			return true;
+		}
+
+		// Trace in the space of the geometry, the direction isn't normalized there so distances stay in world units
+		const auto world_inverted	= entity->GetTransform_PtrRaw()->GetMatrix().Inverted();
+		const auto origin			= m_start * world_inverted;
+		const auto direction		= (m_start + m_direction) * world_inverted - origin;
+
+		TriangleHit triangle_hit;
+		triangle_hit.distance = hit->m_distance;
+		if (!bvh->Intersect(origin, direction, &triangle_hit))
+			return false;
+
+		hit->m_entity		= entity->GetPtrShared();
+		hit->m_distance		= triangle_hit.distance;
+		hit->m_inside		= false;
+		hit->m_triangle		= static_cast<int>(triangle_hit.triangle);
+		hit->m_barycentrics	= triangle_hit.barycentrics;
+		return true;
+	}
+
 	float Ray::HitDistance(const BoundingBox& box) const
 	{
 		// If undefined, no hit (infinite distance)
@@ -30,6 +30,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 namespace Spartan
 {
 	class Context;
+	class Entity;
 
 	namespace Math
 	{
@@ -43,9 +44,13 @@ namespace Spartan
 			Ray(const Vector3& start, const Vector3& end);
 			~Ray() = default;
 
-			// Traces a ray against all entities in the world, returns all hits in a vector.
+			// Traces a ray against all entities in the world, returns all hits in a vector sorted by distance.
+			// Entities with geometry are hit on their triangles, the rest on their bounding box.
 			std::vector<RayHit> Trace(Context* context) const;
 
+			// Returns the closest hit, ignoring bounding box hits which start inside the box.
+			bool TraceClosest(Context* context, RayHit* hit) const;
+
 			// Returns hit distance to a bounding box, or infinity if there is no hit.
 			float HitDistance(const BoundingBox& box) const;
 
@@ -54,6 +59,9 @@ namespace Spartan
 			const Vector3& GetDirection() const { return m_direction; }
 
 		private:
+			// Hits the triangles of the entity (or its bounding box when it has no geometry) if closer than hit->m_distance
+			bool HitEntity(Entity* entity, float box_distance, RayHit* hit) const;
+
 			Vector3 m_start;
 			Vector3 m_end;
 			Vector3 m_direction;
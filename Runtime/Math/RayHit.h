@@ -24,6 +24,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES ==================
 #include <memory>
 #include "../Core/EngineDefs.h"
+#include "Vector2.h"
 //=============================
 
 namespace Spartan
@@ -35,6 +36,7 @@ namespace Spartan
 		class SPARTAN_CLASS RayHit
 		{
 		public:
+			RayHit() = default;
 			RayHit(std::shared_ptr<Entity> entity, float distance, bool inside)
 			{
 				m_entity		= entity;
@@ -43,8 +45,13 @@ namespace Spartan
 			};
 
 			std::shared_ptr<Entity> m_entity;
-			float m_distance;
-			bool m_inside;
+			float m_distance	= INFINITY;
+			bool m_inside		= false;
+
+			// Triangle hits only, the index of the triangle within the geometry of the entity's renderable (-1 for bounding box hits)
+			int m_triangle				= -1;
+			// Weights of the second and third vertex of the triangle, the first one is 1 - x - y
+			Vector2 m_barycentrics		= Vector2::Zero;
 		};
 	}
 }
\ No newline at end of file
@@ -0,0 +1,344 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+// Selects the instruction set at compile time, define SPARTAN_SIMD_SCALAR to force the portable path
+#if !defined(SPARTAN_SIMD_SCALAR)
+	#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		#define SPARTAN_SIMD_SSE
+	#elif (defined(__ARM_NEON) && defined(__aarch64__)) || defined(_M_ARM64)
+		#define SPARTAN_SIMD_NEON
+	#endif
+#endif
+
+//= INCLUDES =============
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#if defined(SPARTAN_SIMD_SSE)
+	#include <xmmintrin.h>
+	#include <emmintrin.h>
+#elif defined(SPARTAN_SIMD_NEON)
+	#include <arm_neon.h>
+#endif
+//========================
+
+// Thin wrappers over four wide float registers, used by the math types on their hot paths
+namespace Spartan::Math::Simd
+{
+#if defined(SPARTAN_SIMD_SSE)
+	using Float4 = __m128;
+
+	inline Float4 Load(const float* data)									{ return _mm_loadu_ps(data); }
+	inline void Store(float* data, const Float4 v)							{ _mm_storeu_ps(data, v); }
+	inline Float4 Set(const float x, const float y, const float z, const float w)	{ return _mm_set_ps(w, z, y, x); }
+	inline Float4 Splat(const float value)									{ return _mm_set1_ps(value); }
+	inline Float4 Add(const Float4 a, const Float4 b)						{ return _mm_add_ps(a, b); }
+	inline Float4 Sub(const Float4 a, const Float4 b)						{ return _mm_sub_ps(a, b); }
+	inline Float4 Mul(const Float4 a, const Float4 b)						{ return _mm_mul_ps(a, b); }
+	inline Float4 MulAdd(const Float4 a, const Float4 b, const Float4 c)	{ return _mm_add_ps(_mm_mul_ps(a, b), c); }
+	inline Float4 Div(const Float4 a, const Float4 b)						{ return _mm_div_ps(a, b); }
+	template <int lane>
+	inline Float4 SplatLane(const Float4 v)									{ return _mm_shuffle_ps(v, v, _MM_SHUFFLE(lane, lane, lane, lane)); }
+	// (v[x], v[y], v[z], v[w])
+	template <int x, int y, int z, int w>
+	inline Float4 Swizzle(const Float4 v)									{ return _mm_shuffle_ps(v, v, _MM_SHUFFLE(w, z, y, x)); }
+	// (a[x], a[y], b[z], b[w])
+	template <int x, int y, int z, int w>
+	inline Float4 Shuffle(const Float4 a, const Float4 b)					{ return _mm_shuffle_ps(a, b, _MM_SHUFFLE(w, z, y, x)); }
+	inline void Transpose(Float4& r0, Float4& r1, Float4& r2, Float4& r3)	{ _MM_TRANSPOSE4_PS(r0, r1, r2, r3); }
+	inline Float4 Abs(const Float4 v)										{ return _mm_andnot_ps(_mm_set1_ps(-0.0f), v); }
+	// Lanes are all ones where a < b and zero elsewhere
+	inline Float4 CompareLess(const Float4 a, const Float4 b)				{ return _mm_cmplt_ps(a, b); }
+	inline Float4 Or(const Float4 a, const Float4 b)						{ return _mm_or_ps(a, b); }
+	inline Float4 Min(const Float4 a, const Float4 b)						{ return _mm_min_ps(a, b); }
+	inline Float4 Max(const Float4 a, const Float4 b)						{ return _mm_max_ps(a, b); }
+	// a where the mask lane is all ones, b where it is zero
+	inline Float4 Select(const Float4 mask, const Float4 a, const Float4 b)	{ return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+	// The top bit of every lane, lane 0 in bit 0
+	inline uint32_t MoveMask(const Float4 v)								{ return static_cast<uint32_t>(_mm_movemask_ps(v)); }
+#elif defined(SPARTAN_SIMD_NEON)
+	using Float4 = float32x4_t;
+
+	inline Float4 Load(const float* data)									{ return vld1q_f32(data); }
+	inline void Store(float* data, const Float4 v)							{ vst1q_f32(data, v); }
+	inline Float4 Set(const float x, const float y, const float z, const float w)	{ const float data[4] = { x, y, z, w }; return vld1q_f32(data); }
+	inline Float4 Splat(const float value)									{ return vdupq_n_f32(value); }
+	inline Float4 Add(const Float4 a, const Float4 b)						{ return vaddq_f32(a, b); }
+	inline Float4 Sub(const Float4 a, const Float4 b)						{ return vsubq_f32(a, b); }
+	inline Float4 Mul(const Float4 a, const Float4 b)						{ return vmulq_f32(a, b); }
+	inline Float4 MulAdd(const Float4 a, const Float4 b, const Float4 c)	{ return vmlaq_f32(c, a, b); }
+	inline Float4 Div(const Float4 a, const Float4 b)						{ return vdivq_f32(a, b); }
+	template <int lane>
+	inline Float4 SplatLane(const Float4 v)									{ return vdupq_laneq_f32(v, lane); }
+	template <int x, int y, int z, int w>
+	inline Float4 Swizzle(const Float4 v)									{ return Set(vgetq_lane_f32(v, x), vgetq_lane_f32(v, y), vgetq_lane_f32(v, z), vgetq_lane_f32(v, w)); }
+	template <int x, int y, int z, int w>
+	inline Float4 Shuffle(const Float4 a, const Float4 b)					{ return Set(vgetq_lane_f32(a, x), vgetq_lane_f32(a, y), vgetq_lane_f32(b, z), vgetq_lane_f32(b, w)); }
+	inline void Transpose(Float4& r0, Float4& r1, Float4& r2, Float4& r3)
+	{
+		const float32x4x2_t t0 = vzipq_f32(r0, r2);
+		const float32x4x2_t t1 = vzipq_f32(r1, r3);
+		const float32x4x2_t c0 = vzipq_f32(t0.val[0], t1.val[0]);
+		const float32x4x2_t c1 = vzipq_f32(t0.val[1], t1.val[1]);
+		r0 = c0.val[0]; r1 = c0.val[1]; r2 = c1.val[0]; r3 = c1.val[1];
+	}
+	inline Float4 Abs(const Float4 v)										{ return vabsq_f32(v); }
+	inline Float4 CompareLess(const Float4 a, const Float4 b)				{ return vreinterpretq_f32_u32(vcltq_f32(a, b)); }
+	inline Float4 Or(const Float4 a, const Float4 b)						{ return vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b))); }
+	inline Float4 Min(const Float4 a, const Float4 b)						{ return vminq_f32(a, b); }
+	inline Float4 Max(const Float4 a, const Float4 b)						{ return vmaxq_f32(a, b); }
+	inline Float4 Select(const Float4 mask, const Float4 a, const Float4 b)	{ return vbslq_f32(vreinterpretq_u32_f32(mask), a, b); }
+	inline uint32_t MoveMask(const Float4 v)
+	{
+		static const int32_t shifts[4] = { 0, 1, 2, 3 };
+		const uint32x4_t bits = vshlq_u32(vshrq_n_u32(vreinterpretq_u32_f32(v), 31), vld1q_s32(shifts));
+		return vaddvq_u32(bits);
+	}
+#else
+	struct Float4 { float v[4]; };
+
+	inline Float4 Load(const float* data)									{ return { { data[0], data[1], data[2], data[3] } }; }
+	inline void Store(float* data, const Float4 v)							{ data[0] = v.v[0]; data[1] = v.v[1]; data[2] = v.v[2]; data[3] = v.v[3]; }
+	inline Float4 Set(const float x, const float y, const float z, const float w)	{ return { { x, y, z, w } }; }
+	inline Float4 Splat(const float value)									{ return { { value, value, value, value } }; }
+	inline Float4 Add(const Float4 a, const Float4 b)						{ return { { a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3] } }; }
+	inline Float4 Sub(const Float4 a, const Float4 b)						{ return { { a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2], a.v[3] - b.v[3] } }; }
+	inline Float4 Mul(const Float4 a, const Float4 b)						{ return { { a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3] } }; }
+	inline Float4 MulAdd(const Float4 a, const Float4 b, const Float4 c)	{ return Add(Mul(a, b), c); }
+	inline Float4 Div(const Float4 a, const Float4 b)						{ return { { a.v[0] / b.v[0], a.v[1] / b.v[1], a.v[2] / b.v[2], a.v[3] / b.v[3] } }; }
+	template <int lane>
+	inline Float4 SplatLane(const Float4 v)									{ return Splat(v.v[lane]); }
+	template <int x, int y, int z, int w>
+	inline Float4 Swizzle(const Float4 v)									{ return { { v.v[x], v.v[y], v.v[z], v.v[w] } }; }
+	template <int x, int y, int z, int w>
+	inline Float4 Shuffle(const Float4 a, const Float4 b)					{ return { { a.v[x], a.v[y], b.v[z], b.v[w] } }; }
+	inline void Transpose(Float4& r0, Float4& r1, Float4& r2, Float4& r3)
+	{
+		const Float4 t0 = r0, t1 = r1, t2 = r2, t3 = r3;
+		r0 = { { t0.v[0], t1.v[0], t2.v[0], t3.v[0] } };
+		r1 = { { t0.v[1], t1.v[1], t2.v[1], t3.v[1] } };
+		r2 = { { t0.v[2], t1.v[2], t2.v[2], t3.v[2] } };
+		r3 = { { t0.v[3], t1.v[3], t2.v[3], t3.v[3] } };
+	}
+	inline Float4 Abs(const Float4 v)										{ return { { fabsf(v.v[0]), fabsf(v.v[1]), fabsf(v.v[2]), fabsf(v.v[3]) } }; }
+	inline Float4 CompareLess(const Float4 a, const Float4 b)
+	{
+		Float4 result;
+		for (int i = 0; i < 4; i++)
+		{
+			const uint32_t bits = a.v[i] < b.v[i] ? 0xFFFFFFFF : 0;
+			memcpy(&result.v[i], &bits, sizeof(float));
+		}
+		return result;
+	}
+	inline Float4 Or(const Float4 a, const Float4 b)
+	{
+		Float4 result;
+		for (int i = 0; i < 4; i++)
+		{
+			uint32_t bits_a, bits_b;
+			memcpy(&bits_a, &a.v[i], sizeof(float));
+			memcpy(&bits_b, &b.v[i], sizeof(float));
+			bits_a |= bits_b;
+			memcpy(&result.v[i], &bits_a, sizeof(float));
+		}
+		return result;
+	}
+	inline Float4 Min(const Float4 a, const Float4 b)						{ return { { a.v[0] < b.v[0] ? a.v[0] : b.v[0], a.v[1] < b.v[1] ? a.v[1] : b.v[1], a.v[2] < b.v[2] ? a.v[2] : b.v[2], a.v[3] < b.v[3] ? a.v[3] : b.v[3] } }; }
+	inline Float4 Max(const Float4 a, const Float4 b)						{ return { { a.v[0] > b.v[0] ? a.v[0] : b.v[0], a.v[1] > b.v[1] ? a.v[1] : b.v[1], a.v[2] > b.v[2] ? a.v[2] : b.v[2], a.v[3] > b.v[3] ? a.v[3] : b.v[3] } }; }
+	inline Float4 Select(const Float4 mask, const Float4 a, const Float4 b)
+	{
+		Float4 result;
+		for (int i = 0; i < 4; i++)
+		{
+			uint32_t bits;
+			memcpy(&bits, &mask.v[i], sizeof(float));
+			result.v[i] = bits ? a.v[i] : b.v[i];
+		}
+		return result;
+	}
+	inline uint32_t MoveMask(const Float4 v)
+	{
+		uint32_t mask = 0;
+		for (int i = 0; i < 4; i++)
+		{
+			uint32_t bits;
+			memcpy(&bits, &v.v[i], sizeof(float));
+			mask |= (bits >> 31) << i;
+		}
+		return mask;
+	}
+#endif
+
+	// The sum of all lanes, in every lane
+	inline Float4 HorizontalSum(const Float4 v)
+	{
+		const Float4 pairs = Add(v, Swizzle<1, 0, 3, 2>(v));
+		return Add(pairs, Swizzle<2, 3, 0, 1>(pairs));
+	}
+
+	// Multiplies two 4x4 matrices which are stored as four consecutive columns (the layout of Matrix)
+	inline void MatrixMultiply(const float* lhs, const float* rhs, float* result)
+	{
+		const Float4 c0 = Load(lhs + 0);
+		const Float4 c1 = Load(lhs + 4);
+		const Float4 c2 = Load(lhs + 8);
+		const Float4 c3 = Load(lhs + 12);
+
+		for (int i = 0; i < 4; i++)
+		{
+			const Float4 r = Load(rhs + i * 4);
+			Float4 column	= Mul(c0, SplatLane<0>(r));
+			column			= MulAdd(c1, SplatLane<1>(r), column);
+			column			= MulAdd(c2, SplatLane<2>(r), column);
+			column			= MulAdd(c3, SplatLane<3>(r), column);
+			Store(result + i * 4, column);
+		}
+	}
+
+	inline void MatrixTranspose(const float* matrix, float* result)
+	{
+		Float4 c0 = Load(matrix + 0);
+		Float4 c1 = Load(matrix + 4);
+		Float4 c2 = Load(matrix + 8);
+		Float4 c3 = Load(matrix + 12);
+		Transpose(c0, c1, c2, c3);
+		Store(result + 0, c0);
+		Store(result + 4, c1);
+		Store(result + 8, c2);
+		Store(result + 12, c3);
+	}
+
+	// Composes scale, then rotation, then translation into a matrix (the layout of Matrix). The rows are built in registers
+	// straight from the quaternion (x, y, z, w), so nothing is stored and loaded back on the way.
+	inline void MatrixCompose(const float* translation, const float* rotation, const float* scale, float* result)
+	{
+		const Float4 q		= Load(rotation);
+		const Float4 two	= Splat(2.0f);
+
+		// Row i of the rotation is the identity row plus twice the sum of two products of quaternion components
+		Float4 r0 = MulAdd(Mul(Swizzle<1, 0, 0, 0>(q), Swizzle<1, 1, 2, 0>(q)), Set(-1.0f, 1.0f, 1.0f, 0.0f), Mul(Mul(Swizzle<2, 2, 1, 0>(q), Swizzle<2, 3, 3, 0>(q)), Set(-1.0f, 1.0f, -1.0f, 0.0f)));
+		Float4 r1 = MulAdd(Mul(Swizzle<0, 0, 1, 0>(q), Swizzle<1, 0, 2, 0>(q)), Set(1.0f, -1.0f, 1.0f, 0.0f), Mul(Mul(Swizzle<2, 2, 0, 0>(q), Swizzle<3, 2, 3, 0>(q)), Set(-1.0f, -1.0f, 1.0f, 0.0f)));
+		Float4 r2 = MulAdd(Mul(Swizzle<0, 1, 0, 0>(q), Swizzle<2, 2, 0, 0>(q)), Set(1.0f, 1.0f, -1.0f, 0.0f), Mul(Mul(Swizzle<1, 0, 1, 0>(q), Swizzle<3, 3, 1, 0>(q)), Set(1.0f, -1.0f, -1.0f, 0.0f)));
+		r0 = Mul(MulAdd(r0, two, Set(1.0f, 0.0f, 0.0f, 0.0f)), Splat(scale[0]));
+		r1 = Mul(MulAdd(r1, two, Set(0.0f, 1.0f, 0.0f, 0.0f)), Splat(scale[1]));
+		r2 = Mul(MulAdd(r2, two, Set(0.0f, 0.0f, 1.0f, 0.0f)), Splat(scale[2]));
+		Float4 r3 = Set(translation[0], translation[1], translation[2], 1.0f);
+
+		// Rows to columns
+		Transpose(r0, r1, r2, r3);
+		Store(result + 0, r0);
+		Store(result + 4, r1);
+		Store(result + 8, r2);
+		Store(result + 12, r3);
+	}
+
+	// Transforms the point (x, y, z, 1) by a matrix, returns (x, y, z, w) before the perspective divide
+	inline Float4 MatrixTransformPoint(const float* matrix, const float x, const float y, const float z)
+	{
+		// The point is a row vector, so each component scales a row of the matrix
+		Float4 r0 = Load(matrix + 0);
+		Float4 r1 = Load(matrix + 4);
+		Float4 r2 = Load(matrix + 8);
+		Float4 r3 = Load(matrix + 12);
+		Transpose(r0, r1, r2, r3);
+
+		Float4 result	= MulAdd(r0, Splat(x), r3);
+		result			= MulAdd(r1, Splat(y), result);
+		return MulAdd(r2, Splat(z), result);
+	}
+
+	namespace Detail
+	{
+		// 2x2 matrices packed as (m00, m01, m10, m11)
+		inline Float4 Mat2Mul(const Float4 a, const Float4 b)		{ return Add(Mul(a, Swizzle<0, 3, 0, 3>(b)), Mul(Swizzle<1, 0, 3, 2>(a), Swizzle<2, 1, 2, 1>(b))); }
+		// adjugate(a) * b
+		inline Float4 Mat2AdjMul(const Float4 a, const Float4 b)	{ return Sub(Mul(Swizzle<3, 3, 0, 0>(a), b), Mul(Swizzle<1, 1, 2, 2>(a), Swizzle<2, 3, 0, 1>(b))); }
+		// a * adjugate(b)
+		inline Float4 Mat2MulAdj(const Float4 a, const Float4 b)	{ return Sub(Mul(a, Swizzle<3, 0, 3, 0>(b)), Mul(Swizzle<1, 0, 3, 2>(a), Swizzle<2, 1, 2, 1>(b))); }
+	}
+
+	// Inverts a 4x4 matrix through its 2x2 blocks. The inverse of the transpose is the transpose of the inverse,
+	// so this works the same whether the four registers are rows or columns.
+	inline void MatrixInverse(const float* matrix, float* result)
+	{
+		const Float4 c0 = Load(matrix + 0);
+		const Float4 c1 = Load(matrix + 4);
+		const Float4 c2 = Load(matrix + 8);
+		const Float4 c3 = Load(matrix + 12);
+
+		// Blocks
+		const Float4 a = Shuffle<0, 1, 0, 1>(c0, c1);
+		const Float4 b = Shuffle<2, 3, 2, 3>(c0, c1);
+		const Float4 c = Shuffle<0, 1, 0, 1>(c2, c3);
+		const Float4 d = Shuffle<2, 3, 2, 3>(c2, c3);
+
+		// Determinants of the blocks as (|A|, |B|, |C|, |D|)
+		const Float4 det_sub = Sub
+		(
+			Mul(Shuffle<0, 2, 0, 2>(c0, c2), Shuffle<1, 3, 1, 3>(c1, c3)),
+			Mul(Shuffle<1, 3, 1, 3>(c0, c2), Shuffle<0, 2, 0, 2>(c1, c3))
+		);
+		const Float4 det_a = SplatLane<0>(det_sub);
+		const Float4 det_b = SplatLane<1>(det_sub);
+		const Float4 det_c = SplatLane<2>(det_sub);
+		const Float4 det_d = SplatLane<3>(det_sub);
+
+		const Float4 d_c = Detail::Mat2AdjMul(d, c);
+		const Float4 a_b = Detail::Mat2AdjMul(a, b);
+		Float4 x = Sub(Mul(det_d, a), Detail::Mat2Mul(b, d_c));
+		Float4 w = Sub(Mul(det_a, d), Detail::Mat2Mul(c, a_b));
+		Float4 y = Sub(Mul(det_b, c), Detail::Mat2MulAdj(d, a_b));
+		Float4 z = Sub(Mul(det_c, b), Detail::Mat2MulAdj(a, d_c));
+
+		// |M| = |A||D| + |B||C| - trace((A#B)(D#C))
+		const Float4 trace	= HorizontalSum(Mul(a_b, Swizzle<0, 2, 1, 3>(d_c)));
+		const Float4 det	= Sub(Add(Mul(det_a, det_d), Mul(det_b, det_c)), trace);
+		const Float4 det_rcp = Div(Set(1.0f, -1.0f, -1.0f, 1.0f), det);
+
+		x = Mul(x, det_rcp);
+		y = Mul(y, det_rcp);
+		z = Mul(z, det_rcp);
+		w = Mul(w, det_rcp);
+
+		// Apply the adjugate while storing
+		Store(result + 0,	Shuffle<3, 1, 3, 1>(x, y));
+		Store(result + 4,	Shuffle<2, 0, 2, 0>(x, y));
+		Store(result + 8,	Shuffle<3, 1, 3, 1>(z, w));
+		Store(result + 12,	Shuffle<2, 0, 2, 0>(z, w));
+	}
+
+	// Hamilton product of two quaternions stored as (x, y, z, w)
+	inline void QuaternionMultiply(const float* lhs, const float* rhs, float* result)
+	{
+		const Float4 a		= Load(lhs);
+		const Float4 b		= Load(rhs);
+		const Float4 sign	= Set(1.0f, 1.0f, 1.0f, -1.0f);
+
+		Float4 product	= Mul(a, SplatLane<3>(b));
+		product			= MulAdd(Mul(Swizzle<3, 3, 3, 0>(a), Swizzle<0, 1, 2, 0>(b)), sign, product);
+		product			= MulAdd(Mul(Swizzle<1, 2, 0, 1>(a), Swizzle<2, 0, 1, 1>(b)), sign, product);
+		product			= Sub(product, Mul(Swizzle<2, 0, 1, 2>(a), Swizzle<1, 2, 0, 2>(b)));
+		Store(result, product);
+	}
+}
@@ -0,0 +1,343 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ====================
+#include "TriangleBvh.h"
+#include <algorithm>
+#include "BoundingBox.h"
+#include "../RHI/RHI_Vertex.h"
+//===============================
+
+//= NAMESPACES ========================
+using namespace std;
+using namespace Spartan::Math::Helper;
+//=====================================
+
+namespace Spartan::Math
+{
+	namespace
+	{
+		constexpr unsigned int bin_count		= 16;
+		constexpr unsigned int depth_max		= 64;
+		constexpr unsigned int leaf_size_min	= 2;
+
+		float Axis(const Vector3& v, const unsigned int axis) { return axis == 0 ? v.x : (axis == 1 ? v.y : v.z); }
+
+		float SurfaceArea(const BoundingBox& box)
+		{
+			if (!box.Defined())
+				return 0.0f;
+
+			const Vector3 size = box.GetSize();
+			return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+		}
+
+		// Returns the distance at which the ray enters the box, or infinity if it misses it
+		float HitDistance(const Vector3& min, const Vector3& max, const Vector3& origin, const Vector3& direction_inv)
+		{
+			const float x_1 = (min.x - origin.x) * direction_inv.x;
+			const float x_2 = (max.x - origin.x) * direction_inv.x;
+			const float y_1 = (min.y - origin.y) * direction_inv.y;
+			const float y_2 = (max.y - origin.y) * direction_inv.y;
+			const float z_1 = (min.z - origin.z) * direction_inv.z;
+			const float z_2 = (max.z - origin.z) * direction_inv.z;
+
+			const float t_min = Max(Max(Min(x_1, x_2), Min(y_1, y_2)), Min(z_1, z_2));
+			const float t_max = Min(Min(Max(x_1, x_2), Max(y_1, y_2)), Max(z_1, z_2));
+
+			return (t_max >= t_min && t_max > 0.0f) ? Max(t_min, 0.0f) : INFINITY;
+		}
+	}
+
+	TriangleBvh::TriangleBvh(const RHI_Vertex_PosUvNorTan* vertices, const unsigned int* indices, const unsigned int index_count)
+	{
+		const unsigned int triangle_count = index_count / 3;
+		if (!vertices || !indices || triangle_count == 0)
+			return;
+
+		// Gather the triangles in their original order
+		vector<Triangle> triangles(triangle_count);
+		vector<BoundingBox> boxes(triangle_count);
+		vector<Vector3> centroids(triangle_count);
+		m_triangle_indices.resize(triangle_count);
+		for (unsigned int i = 0; i < triangle_count; i++)
+		{
+			const float* p_0 = vertices[indices[i * 3 + 0]].pos;
+			const float* p_1 = vertices[indices[i * 3 + 1]].pos;
+			const float* p_2 = vertices[indices[i * 3 + 2]].pos;
+			const Vector3 vertex_0 = Vector3(p_0[0], p_0[1], p_0[2]);
+			const Vector3 vertex_1 = Vector3(p_1[0], p_1[1], p_1[2]);
+			const Vector3 vertex_2 = Vector3(p_2[0], p_2[1], p_2[2]);
+
+			triangles[i].vertex		= vertex_0;
+			triangles[i].edge_1		= vertex_1 - vertex_0;
+			triangles[i].edge_2		= vertex_2 - vertex_0;
+			boxes[i]				= BoundingBox(
+				Vector3(Min(Min(vertex_0.x, vertex_1.x), vertex_2.x), Min(Min(vertex_0.y, vertex_1.y), vertex_2.y), Min(Min(vertex_0.z, vertex_1.z), vertex_2.z)),
+				Vector3(Max(Max(vertex_0.x, vertex_1.x), vertex_2.x), Max(Max(vertex_0.y, vertex_1.y), vertex_2.y), Max(Max(vertex_0.z, vertex_1.z), vertex_2.z))
+			);
+			centroids[i]			= (vertex_0 + vertex_1 + vertex_2) * (1.0f / 3.0f);
+			m_triangle_indices[i]	= i;
+		}
+
+		// A binary tree with a triangle per leaf has 2n - 1 nodes, reserving them keeps node references valid while building
+		m_nodes.reserve(triangle_count * 2 - 1);
+		auto& root = m_nodes.emplace_back();
+		root.first = 0;
+		root.count = triangle_count;
+		NodeFit(root, boxes);
+		Subdivide(0, 0, centroids, boxes);
+
+		// Store the triangles in the order the leaves reference them
+		m_triangles.resize(triangle_count);
+		for (unsigned int i = 0; i < triangle_count; i++)
+		{
+			m_triangles[i] = triangles[m_triangle_indices[i]];
+		}
+	}
+
+	bool TriangleBvh::Intersect(const Vector3& origin, const Vector3& direction, TriangleHit* hit) const
+	{
+		if (m_nodes.empty() || !hit)
+			return false;
+
+		const Vector3 direction_inv = Vector3(1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z);
+		float distance				= hit->distance;
+		unsigned int triangle_hit	= 0;
+		float u_hit					= 0.0f;
+		float v_hit					= 0.0f;
+		bool found					= false;
+
+		// Nodes waiting to be visited along with the distance at which the ray enters them
+		struct Entry { unsigned int node; float distance; };
+		Entry stack[depth_max + 1];
+		unsigned int stack_size = 0;
+
+		const float distance_root = HitDistance(m_nodes[0].min, m_nodes[0].max, origin, direction_inv);
+		if (distance_root < distance)
+		{
+			stack[stack_size++] = { 0, distance_root };
+		}
+
+		while (stack_size != 0)
+		{
+			const Entry entry = stack[--stack_size];
+
+			// A closer hit was found since this node was pushed
+			if (entry.distance >= distance)
+				continue;
+
+			const Node& node = m_nodes[entry.node];
+			if (node.IsLeaf())
+			{
+				// Moller-Trumbore, both sides of the triangles are hit
+				for (unsigned int i = node.first; i < node.first + node.count; i++)
+				{
+					const Triangle& triangle	= m_triangles[i];
+					const Vector3 p				= Vector3::Cross(direction, triangle.edge_2);
+					const float determinant		= Vector3::Dot(triangle.edge_1, p);
+					if (Abs(determinant) < M_EPSILON)
+						continue;
+
+					const float determinant_inv = 1.0f / determinant;
+					const Vector3 s	= origin - triangle.vertex;
+					const float u	= Vector3::Dot(s, p) * determinant_inv;
+					if (u < 0.0f || u > 1.0f)
+						continue;
+
+					const Vector3 q	= Vector3::Cross(s, triangle.edge_1);
+					const float v	= Vector3::Dot(direction, q) * determinant_inv;
+					if (v < 0.0f || u + v > 1.0f)
+						continue;
+
+					const float t = Vector3::Dot(triangle.edge_2, q) * determinant_inv;
+					if (t <= 0.0f || t >= distance)
+						continue;
+
+					distance		= t;
+					triangle_hit	= i;
+					u_hit			= u;
+					v_hit			= v;
+					found			= true;
+				}
+				continue;
+			}
+
+			// Visit the closer child first by pushing it last
+			const Node& left		= m_nodes[node.first];
+			const Node& right		= m_nodes[node.first + 1];
+			float distance_left		= HitDistance(left.min, left.max, origin, direction_inv);
+			float distance_right	= HitDistance(right.min, right.max, origin, direction_inv);
+			unsigned int near		= node.first;
+			unsigned int far		= node.first + 1;
+			if (distance_right < distance_left)
+			{
+				swap(near, far);
+				swap(distance_left, distance_right);
+			}
+
+			if (distance_right < distance)
+			{
+				stack[stack_size++] = { far, distance_right };
+			}
+			if (distance_left < distance)
+			{
+				stack[stack_size++] = { near, distance_left };
+			}
+		}
+
+		if (!found)
+			return false;
+
+		hit->triangle		= m_triangle_indices[triangle_hit];
+		hit->distance		= distance;
+		hit->barycentrics	= Vector2(u_hit, v_hit);
+
+		return true;
+	}
+
+	void TriangleBvh::Subdivide(const unsigned int node_index, const unsigned int depth, const vector<Vector3>& centroids, const vector<BoundingBox>& boxes)
+	{
+		Node& node = m_nodes[node_index];
+		if (node.count <= leaf_size_min || depth >= depth_max)
+			return;
+
+		// Bounds of the centroids, the bins span them
+		BoundingBox bounds_centroids;
+		for (unsigned int i = node.first; i < node.first + node.count; i++)
+		{
+			bounds_centroids.Merge(BoundingBox(centroids[m_triangle_indices[i]], centroids[m_triangle_indices[i]]));
+		}
+
+		// Find the split plane with the lowest surface area cost
+		float cost_best			= INFINITY;
+		unsigned int axis_best	= 0;
+		unsigned int split_best	= 0;
+		for (unsigned int axis = 0; axis < 3; axis++)
+		{
+			const float bounds_min	= Axis(bounds_centroids.GetMin(), axis);
+			const float extent		= Axis(bounds_centroids.GetMax(), axis) - bounds_min;
+			if (extent <= 0.0f)
+				continue;
+
+			struct Bin { BoundingBox box; unsigned int count = 0; };
+			Bin bins[bin_count];
+			const float scale = bin_count / extent;
+			for (unsigned int i = node.first; i < node.first + node.count; i++)
+			{
+				const unsigned int index	= m_triangle_indices[i];
+				const unsigned int bin		= Min(bin_count - 1, static_cast<unsigned int>((Axis(centroids[index], axis) - bounds_min) * scale));
+				bins[bin].count++;
+				bins[bin].box.Merge(boxes[index]);
+			}
+
+			// Sweep from both sides to get the area and count on each side of every split
+			float area_left[bin_count - 1];
+			float area_right[bin_count - 1];
+			unsigned int count_left[bin_count - 1];
+			unsigned int count_right[bin_count - 1];
+			BoundingBox box_left;
+			BoundingBox box_right;
+			unsigned int sum_left	= 0;
+			unsigned int sum_right	= 0;
+			for (unsigned int i = 0; i < bin_count - 1; i++)
+			{
+				sum_left += bins[i].count;
+				box_left.Merge(bins[i].box);
+				count_left[i]	= sum_left;
+				area_left[i]	= SurfaceArea(box_left);
+
+				sum_right += bins[bin_count - 1 - i].count;
+				box_right.Merge(bins[bin_count - 1 - i].box);
+				count_right[bin_count - 2 - i]	= sum_right;
+				area_right[bin_count - 2 - i]	= SurfaceArea(box_right);
+			}
+
+			for (unsigned int i = 0; i < bin_count - 1; i++)
+			{
+				const float cost = count_left[i] * area_left[i] + count_right[i] * area_right[i];
+				if (cost < cost_best)
+				{
+					cost_best	= cost;
+					axis_best	= axis;
+					split_best	= i + 1;
+				}
+			}
+		}
+
+		// Splitting has to be cheaper than intersecting every triangle of the node
+		const float cost_leaf = node.count * SurfaceArea(BoundingBox(node.min, node.max));
+		if (cost_best >= cost_leaf)
+			return;
+
+		// Partition the triangles around the split plane
+		const float bounds_min	= Axis(bounds_centroids.GetMin(), axis_best);
+		const float scale		= bin_count / (Axis(bounds_centroids.GetMax(), axis_best) - bounds_min);
+		unsigned int i			= node.first;
+		unsigned int j			= node.first + node.count;
+		while (i < j)
+		{
+			const unsigned int bin = Min(bin_count - 1, static_cast<unsigned int>((Axis(centroids[m_triangle_indices[i]], axis_best) - bounds_min) * scale));
+			if (bin < split_best)
+			{
+				i++;
+			}
+			else
+			{
+				swap(m_triangle_indices[i], m_triangle_indices[--j]);
+			}
+		}
+
+		const unsigned int count_left = i - node.first;
+		if (count_left == 0 || count_left == node.count)
+			return;
+
+		// Children are allocated in pairs, the right one follows the left one
+		const unsigned int index_left = static_cast<unsigned int>(m_nodes.size());
+		Node& left	= m_nodes.emplace_back();
+		left.first	= node.first;
+		left.count	= count_left;
+		NodeFit(left, boxes);
+
+		Node& right	= m_nodes.emplace_back();
+		right.first	= i;
+		right.count	= node.count - count_left;
+		NodeFit(right, boxes);
+
+		node.first	= index_left;
+		node.count	= 0;
+
+		Subdivide(index_left, depth + 1, centroids, boxes);
+		Subdivide(index_left + 1, depth + 1, centroids, boxes);
+	}
+
+	void TriangleBvh::NodeFit(Node& node, const vector<BoundingBox>& boxes) const
+	{
+		BoundingBox box;
+		for (unsigned int i = node.first; i < node.first + node.count; i++)
+		{
+			box.Merge(boxes[m_triangle_indices[i]]);
+		}
+
+		node.min = box.GetMin();
+		node.max = box.GetMax();
+	}
+}
@@ -0,0 +1,92 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ==================
+#include <vector>
+#include "../Core/EngineDefs.h"
+#include "Vector3.h"
+#include "Vector2.h"
+//=============================
+
+namespace Spartan
+{
+	struct RHI_Vertex_PosUvNorTan;
+
+	namespace Math
+	{
+		class BoundingBox;
+
+		struct TriangleHit
+		{
+			// Index of the triangle within the indices the hierarchy was built from
+			unsigned int triangle	= 0;
+			float distance			= INFINITY;
+			// Weights of the second and third vertex, the first one is 1 - x - y
+			Vector2 barycentrics	= Vector2::Zero;
+		};
+
+		// A bounding volume hierarchy over the triangles of a mesh, built with the surface area heuristic.
+		// Nodes and triangles are stored in traversal order, which keeps ray queries cache friendly.
+		class SPARTAN_CLASS TriangleBvh
+		{
+		public:
+			// Indices are relative to vertices, every three of them form a triangle
+			TriangleBvh(const RHI_Vertex_PosUvNorTan* vertices, const unsigned int* indices, unsigned int index_count);
+			~TriangleBvh() = default;
+
+			// Finds the closest triangle hit by the ray closer than hit->distance, distances are in units of direction's length
+			bool Intersect(const Vector3& origin, const Vector3& direction, TriangleHit* hit) const;
+
+			unsigned int GetTriangleCount() const	{ return static_cast<unsigned int>(m_triangles.size()); }
+			unsigned int GetNodeCount() const		{ return static_cast<unsigned int>(m_nodes.size()); }
+
+		private:
+			struct Node
+			{
+				bool IsLeaf() const { return count != 0; }
+
+				Vector3 min;
+				// Index of the first triangle for leaves, index of the left child (the right one follows it) otherwise
+				unsigned int first = 0;
+				Vector3 max;
+				unsigned int count = 0;
+			};
+
+			// The first vertex and the two edges leaving it, what the intersection test needs
+			struct Triangle
+			{
+				Vector3 vertex;
+				Vector3 edge_1;
+				Vector3 edge_2;
+			};
+
+			void Subdivide(unsigned int node_index, unsigned int depth, const std::vector<Vector3>& centroids, const std::vector<BoundingBox>& boxes);
+			void NodeFit(Node& node, const std::vector<BoundingBox>& boxes) const;
+
+			std::vector<Node> m_nodes;
+			std::vector<Triangle> m_triangles;
+			// Original index of each triangle
+			std::vector<unsigned int> m_triangle_indices;
+		};
+	}
+}
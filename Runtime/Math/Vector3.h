@@ -112,7 +112,7 @@ namespace Spartan::Math
 			y = floorf(y);
 			z = floorf(z);
 		}
-		Vector3 Absolute() const { return Vector3(abs(x), abs(y), abs(z)); }
+		Vector3 Absolute() const { return Vector3(Helper::Abs(x), Helper::Abs(y), Helper::Abs(z)); }
 		float Volume() const { return x * y * z; }
 		//==================================================================
 
@@ -46,8 +46,6 @@ static const Vector3 GRAVITY			= Vector3(0.0f, -9.81f, 0.0f);
 
 namespace Spartan
 { 
-	float ISubsystem::m_delta_time_sec;
-
 	Physics::Physics(Context* context) : ISubsystem(context)
 	{
 		m_max_sub_steps	= 1;
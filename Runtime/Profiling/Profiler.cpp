@@ -26,6 +26,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../Core/EventSystem.h"
 #include "../Rendering/Renderer.h"
 #include "../Resource/ResourceCache.h"
+#include "../Threading/Threading.h"
 //====================================
 
 //= NAMESPACES =====
@@ -50,6 +51,7 @@ namespace Spartan
 		m_timer				= m_context->GetSubsystem<Timer>().get();
 		m_resource_manager	= m_context->GetSubsystem<ResourceCache>().get();
 		m_renderer			= m_context->GetSubsystem<Renderer>().get();
+		m_threading			= m_context->GetSubsystem<Threading>().get();
 
 		// Get available memory
 		if (const DisplayAdapter* adapter = m_renderer->GetRhiDevice()->GetPrimaryAdapter())
@@ -61,7 +63,7 @@ namespace Spartan
 		return true;
 	}
 
-	bool Profiler::TimeBlockStart(const string& func_name, bool profile_cpu /*= true*/, bool profile_gpu /*= false*/)
+	bool Profiler::TimeBlockStart(const char* func_name, bool profile_cpu /*= true*/, bool profile_gpu /*= false*/)
 	{
 		if (!m_should_update)
 			return false;
@@ -226,10 +228,18 @@ namespace Spartan
 		const auto material_count	= m_resource_manager->GetResourceCountByType(Resource_Material);
 		const auto shader_count		= m_resource_manager->GetResourceCountByType(Resource_Shader);
 
-		static char buffer[1000]; // real usage is around 700
-		sprintf_s
+		// Threading
+		JobStats jobs[job_priority_count];
+		for (unsigned int i = 0; i < job_priority_count; i++)
+		{
+			jobs[i] = m_threading->GetStats(static_cast<Job_Priority>(i));
+		}
+
+		static char buffer[1500]; // real usage is around 1000
+		snprintf
 		(
 			buffer,
+			sizeof(buffer),
 
 			// Performance
 			"FPS:\t\t\t\t\t\t\t%.2f\n"
@@ -241,6 +251,7 @@ namespace Spartan
 			// Renderer
 			"Resolution:\t\t\t\t\t%dx%d\n"
 			"Meshes rendered:\t\t\t\t%d\n"
+			"Instanced batches:\t\t\t%d\n"
 			"Textures:\t\t\t\t\t%d\n"
 			"Materials:\t\t\t\t\t%d\n"
 			"Shaders:\t\t\t\t\t\t%d\n"
@@ -253,7 +264,13 @@ namespace Spartan
 			"RHI Texture bindings:\t\t\t%d\n"
 			"RHI Vertex Shader bindings:\t\t%d\n"
 			"RHI Pixel Shader bindings:\t\t%d\n"
-			"RHI Render Target bindings:\t\t%d",
+			"RHI Render Target bindings:\t\t%d\n"
+			"RHI Redundant bindings:\t\t%d\n"
+			// Threading (queued, average wait, average execution)
+			"Jobs Critical:\t\t\t\t%d, %.2f ms, %.2f ms\n"
+			"Jobs Normal:\t\t\t\t%d, %.2f ms, %.2f ms\n"
+			"Jobs Background:\t\t\t%d, %.2f ms, %.2f ms\n"
+			"Jobs I/O:\t\t\t\t\t%d, %.2f ms, %.2f ms",
 			
 			// Performance
 			fps,
@@ -266,6 +283,7 @@ namespace Spartan
 			// Renderer
 			static_cast<int>(m_renderer->GetResolution().x), static_cast<int>(m_renderer->GetResolution().y),
 			m_renderer_meshes_rendered,
+			m_renderer_batches_instanced,
 			texture_count,
 			material_count,
 			shader_count,
@@ -278,7 +296,13 @@ namespace Spartan
 			m_rhi_bindings_texture,
 			m_rhi_bindings_vertex_shader,
 			m_rhi_bindings_pixel_shader,
-			m_rhi_bindings_render_target
+			m_rhi_bindings_render_target,
+			m_rhi_bindings_eliminated,
+			// Threading
+			jobs[Job_Critical].queued,		jobs[Job_Critical].time_wait_ms,	jobs[Job_Critical].time_execution_ms,
+			jobs[Job_Normal].queued,		jobs[Job_Normal].time_wait_ms,		jobs[Job_Normal].time_execution_ms,
+			jobs[Job_Background].queued,	jobs[Job_Background].time_wait_ms,	jobs[Job_Background].time_execution_ms,
+			jobs[Job_Io].queued,			jobs[Job_Io].time_wait_ms,			jobs[Job_Io].time_execution_ms
 		);
 
 		m_metrics = string(buffer);
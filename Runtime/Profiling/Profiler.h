@@ -40,6 +40,7 @@ namespace Spartan
 	class Timer;
 	class ResourceCache;
 	class Renderer;
+	class Threading;
 
 	class SPARTAN_CLASS Profiler : public ISubsystem
 	{
@@ -51,7 +52,7 @@ namespace Spartan
 		//=========================
 
 		// Time block
-		bool TimeBlockStart(const std::string& func_name, bool profile_cpu = true, bool profile_gpu = false);
+		bool TimeBlockStart(const char* func_name, bool profile_cpu = true, bool profile_gpu = false);
 		bool TimeBlockEnd();
 
 		// Events
@@ -77,6 +78,7 @@ namespace Spartan
 		{
 			m_rhi_draw_calls				= 0;
 			m_renderer_meshes_rendered		= 0;
+			m_renderer_batches_instanced	= 0;
 			m_rhi_bindings_buffer_index		= 0;
 			m_rhi_bindings_buffer_vertex	= 0;
 			m_rhi_bindings_buffer_constant	= 0;
@@ -85,6 +87,7 @@ namespace Spartan
 			m_rhi_bindings_vertex_shader	= 0;
 			m_rhi_bindings_pixel_shader		= 0;
 			m_rhi_bindings_render_target	= 0;
+			m_rhi_bindings_eliminated		= 0;
 		}
 
 		// Metrics - RHI
@@ -97,9 +100,11 @@ namespace Spartan
 		unsigned int m_rhi_bindings_vertex_shader	= 0;
 		unsigned int m_rhi_bindings_pixel_shader	= 0;
 		unsigned int m_rhi_bindings_render_target	= 0;
+		unsigned int m_rhi_bindings_eliminated		= 0; // redundant, dropped while recording
 
 		// Metrics - Renderer
-		unsigned int m_renderer_meshes_rendered = 0;
+		unsigned int m_renderer_meshes_rendered		= 0;
+		unsigned int m_renderer_batches_instanced	= 0;
 
 		// Metrics - Time
 		float m_time_frame_ms	= 0.0f;
@@ -143,5 +148,6 @@ namespace Spartan
 		Timer* m_timer						= nullptr;
 		ResourceCache* m_resource_manager	= nullptr;
 		Renderer* m_renderer				= nullptr;
+		Threading* m_threading				= nullptr;
 	};
 }
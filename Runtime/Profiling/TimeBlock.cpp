@@ -46,7 +46,7 @@ namespace Spartan
 		m_query_end		= nullptr;
 	}
 
-	void TimeBlock::Start(const string& name, bool profile_cpu /*= false*/, bool profile_gpu /*= false*/, const TimeBlock* parent /*= nullptr*/, const shared_ptr<RHI_Device>& rhi_device /*= nullptr*/)
+	void TimeBlock::Start(const char* name, bool profile_cpu /*= false*/, bool profile_gpu /*= false*/, const TimeBlock* parent /*= nullptr*/, const shared_ptr<RHI_Device>& rhi_device /*= nullptr*/)
 	{
 		m_name			= name;
 		m_parent		= parent;
@@ -55,7 +55,7 @@ namespace Spartan
 
 		if (profile_cpu)
 		{
-			start = chrono::high_resolution_clock::now();
+			start = chrono::steady_clock::now();
 			m_profiling_cpu = true;
 		}
 
@@ -90,7 +90,7 @@ namespace Spartan
 
 		if (m_profiling_cpu)
 		{
-			end = chrono::high_resolution_clock::now();
+			end = chrono::steady_clock::now();
 			chrono::duration<double, milli> ms = end - start;
 			m_duration_cpu = static_cast<float>(ms.count());
 		}
@@ -34,10 +34,10 @@ namespace Spartan
 	class TimeBlock
 	{
 	public:
-		TimeBlock() = default;
+		TimeBlock() { m_name.reserve(64); } // blocks are reused every frame, names shorter than this don't reallocate
 		~TimeBlock();
 
-		void Start(const std::string& name, bool profile_cpu = false, bool profile_gpu = false, const TimeBlock* parent = nullptr, const std::shared_ptr<RHI_Device>& rhi_device = nullptr);
+		void Start(const char* name, bool profile_cpu = false, bool profile_gpu = false, const TimeBlock* parent = nullptr, const std::shared_ptr<RHI_Device>& rhi_device = nullptr);
 		void End(const std::shared_ptr<RHI_Device>& rhi_device = nullptr);
 		void OnFrameEnd(const std::shared_ptr<RHI_Device>& rhi_device);
 		void Clear();
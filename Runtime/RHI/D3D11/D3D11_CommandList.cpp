@@ -35,8 +35,10 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../RHI_Shader.h"
 #include "../RHI_RenderTexture.h"
 #include "../RHI_ConstantBuffer.h"
+#include "../RHI_StructuredBuffer.h"
 #include "../../Profiling/Profiler.h"
 #include "../../Logging/Log.h"
+#include "../../Core/FrameAllocator.h"
 #include "../RHI_VertexBuffer.h"
 #include "../RHI_IndexBuffer.h"
 #include "../RHI_BlendState.h"
@@ -52,10 +54,299 @@ using namespace Spartan::Math;
 
 namespace Spartan
 {
+	namespace
+	{
+		// Executes the commands of an RHI_CommandStream on the immediate context
+		struct D3D11_Executor
+		{
+			RHI_Context* context;
+			ID3D11DeviceContext* device_context;
+			ID3D11DeviceContext1* device_context_1;
+			Profiler* profiler;
+
+			void Begin(const RHI_Cmd::Begin& cmd)
+			{
+				profiler->TimeBlockStart(cmd.name, true, true);
+				#ifdef DEBUG
+				context->annotation->BeginEvent(FileSystem::StringToWstring(cmd.name).c_str());
+				#endif
+			}
+
+			void End()
+			{
+				#ifdef DEBUG
+				context->annotation->EndEvent();
+				#endif
+				profiler->TimeBlockEnd();
+			}
+
+			void Draw(const RHI_Cmd::Draw& cmd)
+			{
+				device_context->Draw(static_cast<UINT>(cmd.vertex_count), 0);
+
+				profiler->m_rhi_draw_calls++;
+			}
+
+			void DrawIndexed(const RHI_Cmd::DrawIndexed& cmd)
+			{
+				SPARTAN_ASSERT(cmd.index_count != 0);
+
+				device_context->DrawIndexed
+				(
+					static_cast<UINT>(cmd.index_count),
+					static_cast<UINT>(cmd.index_offset),
+					static_cast<INT>(cmd.vertex_offset)
+				);
+
+				profiler->m_rhi_draw_calls++;
+			}
+
+			void DrawIndexedInstanced(const RHI_Cmd::DrawIndexedInstanced& cmd)
+			{
+				SPARTAN_ASSERT(cmd.index_count != 0 && cmd.instance_count != 0);
+
+				device_context->DrawIndexedInstanced
+				(
+					static_cast<UINT>(cmd.index_count),
+					static_cast<UINT>(cmd.instance_count),
+					static_cast<UINT>(cmd.index_offset),
+					static_cast<INT>(cmd.vertex_offset),
+					static_cast<UINT>(cmd.instance_offset)
+				);
+
+				profiler->m_rhi_draw_calls++;
+			}
+
+			void SetViewport(const RHI_Cmd::Viewport& cmd)
+			{
+				D3D11_VIEWPORT d3d11_viewport;
+				d3d11_viewport.TopLeftX	= cmd.x;
+				d3d11_viewport.TopLeftY	= cmd.y;
+				d3d11_viewport.Width	= cmd.width;
+				d3d11_viewport.Height	= cmd.height;
+				d3d11_viewport.MinDepth	= cmd.depth_min;
+				d3d11_viewport.MaxDepth	= cmd.depth_max;
+
+				device_context->RSSetViewports(1, &d3d11_viewport);
+			}
+
+			void SetScissorRectangle(const RHI_Cmd::ScissorRectangle& cmd)
+			{
+				const auto left		= cmd.x;
+				const auto top		= cmd.y;
+				const auto right	= cmd.x + cmd.width;
+				const auto bottom	= cmd.y + cmd.height;
+				const D3D11_RECT d3d11_rectangle = { static_cast<LONG>(left), static_cast<LONG>(top), static_cast<LONG>(right), static_cast<LONG>(bottom) };
+
+				device_context->RSSetScissorRects(1, &d3d11_rectangle);
+			}
+
+			void SetPrimitiveTopology(const RHI_Cmd::PrimitiveTopology& cmd)
+			{
+				device_context->IASetPrimitiveTopology(d3d11_primitive_topology[cmd.mode]);
+			}
+
+			void SetState(const RHI_Cmd_Type type, const RHI_Cmd::State& cmd)
+			{
+				switch (type)
+				{
+					case RHI_Cmd_SetInputLayout:
+					{
+						const auto input_layout = static_cast<const RHI_InputLayout*>(cmd.object);
+						device_context->IASetInputLayout(static_cast<ID3D11InputLayout*>(input_layout->GetBuffer()));
+						break;
+					}
+
+					case RHI_Cmd_SetDepthStencilState:
+					{
+						const auto depth_stencil_state = static_cast<const RHI_DepthStencilState*>(cmd.object);
+						device_context->OMSetDepthStencilState(static_cast<ID3D11DepthStencilState*>(depth_stencil_state->GetBuffer()), 1);
+						break;
+					}
+
+					case RHI_Cmd_SetRasterizerState:
+					{
+						const auto rasterizer_state = static_cast<const RHI_RasterizerState*>(cmd.object);
+						device_context->RSSetState(static_cast<ID3D11RasterizerState*>(rasterizer_state->GetBuffer()));
+						break;
+					}
+
+					case RHI_Cmd_SetBlendState:
+					{
+						const auto blend_state	= static_cast<const RHI_BlendState*>(cmd.object);
+						FLOAT blend_factor[4]	= { 0.0f, 0.0f, 0.0f, 0.0f };
+
+						device_context->OMSetBlendState(
+							static_cast<ID3D11BlendState*>(blend_state->GetBuffer()),
+							blend_factor,
+							0xffffffff
+						);
+
+						break;
+					}
+
+					case RHI_Cmd_SetVertexBuffer:
+					{
+						const auto buffer_vertex	= static_cast<const RHI_VertexBuffer*>(cmd.object);
+						auto ptr					= static_cast<ID3D11Buffer*>(buffer_vertex->GetBuffer());
+						auto stride					= buffer_vertex->GetStride();
+						unsigned int offset			= 0;
+						device_context->IASetVertexBuffers(0, 1, &ptr, &stride, &offset);
+
+						profiler->m_rhi_bindings_buffer_vertex++;
+						break;
+					}
+
+					case RHI_Cmd_SetIndexBuffer:
+					{
+						const auto buffer_index = static_cast<const RHI_IndexBuffer*>(cmd.object);
+						device_context->IASetIndexBuffer
+						(
+							static_cast<ID3D11Buffer*>(buffer_index->GetBuffer()),
+							buffer_index->Is16Bit() ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT,
+							0
+						);
+
+						profiler->m_rhi_bindings_buffer_index++;
+						break;
+					}
+
+					case RHI_Cmd_SetVertexShader:
+					{
+						const auto shader	= static_cast<const RHI_Shader*>(cmd.object);
+						const auto ptr		= static_cast<ID3D11VertexShader*>(shader->GetVertexShaderBuffer());
+						device_context->VSSetShader(ptr, nullptr, 0);
+
+						profiler->m_rhi_bindings_vertex_shader++;
+						break;
+					}
+
+					case RHI_Cmd_SetPixelShader:
+					{
+						const auto shader	= static_cast<const RHI_Shader*>(cmd.object);
+						const auto ptr		= static_cast<ID3D11PixelShader*>(shader->GetPixelShaderBuffer());
+						device_context->PSSetShader(ptr, nullptr, 0);
+
+						profiler->m_rhi_bindings_pixel_shader++;
+						break;
+					}
+
+					default:
+						break;
+				}
+			}
+
+			void SetConstantBuffers(const RHI_Cmd::Bindings& cmd)
+			{
+				const auto start_slot	= static_cast<UINT>(cmd.start_slot);
+				const auto buffer_count = static_cast<UINT>(cmd.count);
+				const auto buffer		= reinterpret_cast<ID3D11Buffer*const*>(cmd.Objects());
+				const auto scope		= cmd.scope;
+
+				// A slice of a larger buffer, offsets and sizes are in 16 byte constants
+				if (cmd.size != 0 && device_context_1)
+				{
+					const auto first_constant	= static_cast<UINT>(cmd.offset / 16);
+					const auto constant_count	= static_cast<UINT>(cmd.size / 16);
+
+					if (scope == Buffer_VertexShader || scope == Buffer_Global)
+					{
+						device_context_1->VSSetConstantBuffers1(start_slot, buffer_count, buffer, &first_constant, &constant_count);
+					}
+
+					if (scope == Buffer_PixelShader || scope == Buffer_Global)
+					{
+						device_context_1->PSSetConstantBuffers1(start_slot, buffer_count, buffer, &first_constant, &constant_count);
+					}
+				}
+				else
+				{
+					if (scope == Buffer_VertexShader || scope == Buffer_Global)
+					{
+						device_context->VSSetConstantBuffers(start_slot, buffer_count, buffer);
+					}
+
+					if (scope == Buffer_PixelShader || scope == Buffer_Global)
+					{
+						device_context->PSSetConstantBuffers(start_slot, buffer_count, buffer);
+					}
+				}
+
+				profiler->m_rhi_bindings_buffer_constant += (scope == Buffer_Global) ? 2 : 1;
+			}
+
+			void SetSamplers(const RHI_Cmd::Bindings& cmd)
+			{
+				device_context->PSSetSamplers
+				(
+					static_cast<UINT>(cmd.start_slot),
+					static_cast<UINT>(cmd.count),
+					reinterpret_cast<ID3D11SamplerState* const*>(cmd.Objects())
+				);
+
+				profiler->m_rhi_bindings_sampler++;
+			}
+
+			void SetTextures(const RHI_Cmd::Bindings& cmd)
+			{
+				const auto start_slot		= static_cast<UINT>(cmd.start_slot);
+				const auto texture_count	= static_cast<UINT>(cmd.count);
+				const auto textures			= reinterpret_cast<ID3D11ShaderResourceView* const*>(cmd.Objects());
+				const auto scope			= cmd.scope;
+
+				if (scope == Buffer_VertexShader || scope == Buffer_Global)
+				{
+					device_context->VSSetShaderResources(start_slot, texture_count, textures);
+				}
+
+				if (scope == Buffer_PixelShader || scope == Buffer_Global)
+				{
+					device_context->PSSetShaderResources(start_slot, texture_count, textures);
+				}
+
+				profiler->m_rhi_bindings_texture++;
+			}
+
+			void SetRenderTargets(const RHI_Cmd::RenderTargets& cmd)
+			{
+				device_context->OMSetRenderTargets
+				(
+					static_cast<UINT>(cmd.count),
+					reinterpret_cast<ID3D11RenderTargetView* const*>(cmd.Objects()),
+					static_cast<ID3D11DepthStencilView*>(cmd.depth_stencil)
+				);
+
+				profiler->m_rhi_bindings_render_target++;
+			}
+
+			void ClearRenderTarget(const RHI_Cmd::ClearRenderTarget& cmd)
+			{
+				device_context->ClearRenderTargetView
+				(
+					static_cast<ID3D11RenderTargetView*>(cmd.render_target),
+					cmd.color
+				);
+			}
+
+			void ClearDepthStencil(const RHI_Cmd::ClearDepthStencil& cmd)
+			{
+				UINT clear_flags = 0;
+				clear_flags |= cmd.flags & Clear_Depth ? D3D11_CLEAR_DEPTH : 0;
+				clear_flags |= cmd.flags & Clear_Stencil ? D3D11_CLEAR_STENCIL : 0;
+
+				device_context->ClearDepthStencilView
+				(
+					static_cast<ID3D11DepthStencilView*>(cmd.depth_stencil),
+					clear_flags,
+					static_cast<FLOAT>(cmd.depth),
+					static_cast<UINT8>(cmd.stencil)
+				);
+			}
+		};
+	}
+
 	RHI_CommandList::RHI_CommandList(const std::shared_ptr<RHI_Device>& rhi_device, Profiler* profiler)
 	{
-		m_commands.reserve(m_initial_capacity);
-		m_commands.resize(m_initial_capacity);
 		m_rhi_device	= rhi_device;
 		m_profiler		= profiler;
 	}
@@ -65,33 +356,29 @@ namespace Spartan
 		
 	}
 
-	void RHI_CommandList::Begin(const string& pass_name, void* render_pass, RHI_SwapChain* swap_chain)
+	void RHI_CommandList::Begin(const char* pass_name, void* render_pass, RHI_SwapChain* swap_chain)
 	{
-		RHI_Command& cmd	= GetCmd();
-		cmd.type			= RHI_Cmd_Begin;
-		cmd.pass_name		= pass_name;
+		m_stream.Begin(FrameAllocator::AllocateString(pass_name));
 	}
 
 	void RHI_CommandList::End()
 	{
-		RHI_Command& cmd	= GetCmd();
-		cmd.type			= RHI_Cmd_End;
+		m_stream.End();
 	}
 
 	void RHI_CommandList::Draw(unsigned int vertex_count)
 	{
-		RHI_Command& cmd	= GetCmd();
-		cmd.type			= RHI_Cmd_Draw;
-		cmd.vertex_count	= vertex_count;
+		m_stream.Draw(vertex_count);
 	}
 
 	void RHI_CommandList::DrawIndexed(unsigned int index_count, unsigned int index_offset, unsigned int vertex_offset)
 	{
-		RHI_Command& cmd	= GetCmd();
-		cmd.type			= RHI_Cmd_DrawIndexed;
-		cmd.index_count		= index_count;
-		cmd.index_offset	= index_offset;
-		cmd.vertex_offset	= vertex_offset;
+		m_stream.DrawIndexed(index_count, index_offset, vertex_offset);
+	}
+
+	void RHI_CommandList::DrawIndexedInstanced(unsigned int index_count, unsigned int instance_count, unsigned int index_offset, unsigned int vertex_offset, unsigned int instance_offset)
+	{
+		m_stream.DrawIndexedInstanced(index_count, instance_count, index_offset, vertex_offset, instance_offset);
 	}
 
 	void RHI_CommandList::SetPipeline(const RHI_Pipeline* pipeline)
@@ -107,129 +394,95 @@ namespace Spartan
 
 	void RHI_CommandList::SetViewport(const RHI_Viewport& viewport)
 	{
-		RHI_Command& cmd	= GetCmd();
-		cmd.type			= RHI_Cmd_SetViewport;
-		cmd.viewport		= viewport;
+		m_stream.SetViewport({ viewport.GetX(), viewport.GetY(), viewport.GetWidth(), viewport.GetHeight(), viewport.GetMinDepth(), viewport.GetMaxDepth() });
 	}
 
 	void RHI_CommandList::SetScissorRectangle(const Math::Rectangle& scissor_rectangle)
 	{
-		RHI_Command& cmd		= GetCmd();
-		cmd.type				= RHI_Cmd_SetScissorRectangle;
-		cmd.scissor_rectangle	= scissor_rectangle;
+		m_stream.SetScissorRectangle({ scissor_rectangle.x, scissor_rectangle.y, scissor_rectangle.width, scissor_rectangle.height });
 	}
 
 	void RHI_CommandList::SetPrimitiveTopology(RHI_PrimitiveTopology_Mode primitive_topology)
 	{
-		RHI_Command& cmd		= GetCmd();
-		cmd.type				= RHI_Cmd_SetPrimitiveTopology;
-		cmd.primitive_topology	= primitive_topology;
+		m_stream.SetPrimitiveTopology(primitive_topology);
 	}
 
 	void RHI_CommandList::SetInputLayout(const RHI_InputLayout* input_layout)
 	{
-		RHI_Command& cmd	= GetCmd();
-		cmd.type			= RHI_Cmd_SetInputLayout;
-		cmd.input_layout	= input_layout;
+		m_stream.SetState(RHI_Cmd_SetInputLayout, input_layout, input_layout->GetBuffer());
 	}
 
 	void RHI_CommandList::SetDepthStencilState(const RHI_DepthStencilState* depth_stencil_state)
 	{
-		RHI_Command& cmd		= GetCmd();
-		cmd.type				= RHI_Cmd_SetDepthStencilState;
-		cmd.depth_stencil_state = depth_stencil_state;
+		m_stream.SetState(RHI_Cmd_SetDepthStencilState, depth_stencil_state, depth_stencil_state->GetBuffer());
 	}
 
 	void RHI_CommandList::SetRasterizerState(const RHI_RasterizerState* rasterizer_state)
 	{
-		RHI_Command& cmd		= GetCmd();
-		cmd.type				= RHI_Cmd_SetRasterizerState;
-		cmd.rasterizer_state	= rasterizer_state;
+		m_stream.SetState(RHI_Cmd_SetRasterizerState, rasterizer_state, rasterizer_state->GetBuffer());
 	}
 
 	void RHI_CommandList::SetBlendState(const RHI_BlendState* blend_state)
 	{
-		RHI_Command& cmd	= GetCmd();
-		cmd.type			= RHI_Cmd_SetBlendState;
-		cmd.blend_state		= blend_state;
+		m_stream.SetState(RHI_Cmd_SetBlendState, blend_state, blend_state->GetBuffer());
 	}
 
 	void RHI_CommandList::SetBufferVertex(const RHI_VertexBuffer* buffer)
 	{
-		RHI_Command& cmd	= GetCmd();
-		cmd.type			= RHI_Cmd_SetVertexBuffer;
-		cmd.buffer_vertex	= buffer;
+		m_stream.SetState(RHI_Cmd_SetVertexBuffer, buffer, buffer->GetBuffer());
 	}
 
 	void RHI_CommandList::SetBufferIndex(const RHI_IndexBuffer* buffer)
 	{
-		RHI_Command& cmd	= GetCmd();
-		cmd.type			= RHI_Cmd_SetIndexBuffer;
-		cmd.buffer_index	= buffer;
+		m_stream.SetState(RHI_Cmd_SetIndexBuffer, buffer, buffer->GetBuffer());
 	}
 
 	void RHI_CommandList::SetShaderVertex(const RHI_Shader* shader)
 	{
-		RHI_Command& cmd	= GetCmd();
-		cmd.type			= RHI_Cmd_SetVertexShader;
-		cmd.shader_vertex	= shader;
+		m_stream.SetState(RHI_Cmd_SetVertexShader, shader, shader->GetVertexShaderBuffer());
 	}
 
 	void RHI_CommandList::SetShaderPixel(const RHI_Shader* shader)
 	{
-		RHI_Command& cmd	= GetCmd();
-		cmd.type			= RHI_Cmd_SetPixelShader;
-		cmd.shader_pixel	= shader;
+		m_stream.SetState(RHI_Cmd_SetPixelShader, shader, shader->GetPixelShaderBuffer());
 	}
 
-	void RHI_CommandList::SetConstantBuffers(unsigned int start_slot, RHI_Buffer_Scope scope, const vector<void*>& constant_buffers)
+	void RHI_CommandList::SetConstantBuffers(unsigned int start_slot, RHI_Buffer_Scope scope, void* const* constant_buffers, unsigned int constant_buffer_count)
 	{
-		RHI_Command& cmd				= GetCmd();
-		cmd.type						= RHI_Cmd_SetConstantBuffers;
-		cmd.constant_buffers_start_slot = start_slot;
-		cmd.constant_buffers_scope		= scope;
-		cmd.constant_buffers			= constant_buffers;
+		m_stream.SetConstantBuffers(start_slot, scope, constant_buffers, constant_buffer_count);
 	}
 
 	void RHI_CommandList::SetConstantBuffer(unsigned int start_slot, RHI_Buffer_Scope scope, const shared_ptr<RHI_ConstantBuffer>& constant_buffer)
 	{
-		RHI_Command& cmd				= GetCmd();
-		cmd.type						= RHI_Cmd_SetConstantBuffers;
-		cmd.constant_buffers_start_slot = start_slot;
-		cmd.constant_buffers_scope		= scope;
-		cmd.constant_buffers.emplace_back(constant_buffer->GetBufferView());
+		void* buffer = constant_buffer->GetBufferView();
+		m_stream.SetConstantBuffers(start_slot, scope, &buffer, 1);
+	}
+
+	void RHI_CommandList::SetConstantBuffer(unsigned int start_slot, RHI_Buffer_Scope scope, const shared_ptr<RHI_ConstantBuffer>& constant_buffer, unsigned int offset, unsigned int size)
+	{
+		void* buffer = constant_buffer->GetBufferView();
+		m_stream.SetConstantBuffers(start_slot, scope, &buffer, 1, offset, size);
 	}
 
-	void RHI_CommandList::SetSamplers(unsigned int start_slot, const vector<void*>& samplers)
+	void RHI_CommandList::SetSamplers(unsigned int start_slot, void* const* samplers, unsigned int sampler_count)
 	{
-		RHI_Command& cmd		= GetCmd();
-		cmd.type				= RHI_Cmd_SetSamplers;
-		cmd.samplers_start_slot = start_slot;
-		cmd.samplers			= samplers;
+		m_stream.SetSamplers(start_slot, samplers, sampler_count);
 	}
 
 	void RHI_CommandList::SetSampler(unsigned int start_slot, const shared_ptr<RHI_Sampler>& sampler)
 	{
-		RHI_Command& cmd		= GetCmd();
-		cmd.type				= RHI_Cmd_SetSamplers;
-		cmd.samplers_start_slot = start_slot;
-		cmd.samplers.emplace_back(sampler->GetBufferView());
+		void* buffer = sampler->GetBufferView();
+		m_stream.SetSamplers(start_slot, &buffer, 1);
 	}
 
-	void RHI_CommandList::SetTextures(unsigned int start_slot, const vector<void*>& textures)
+	void RHI_CommandList::SetTextures(unsigned int start_slot, void* const* textures, unsigned int texture_count)
 	{
-		RHI_Command& cmd		= GetCmd();
-		cmd.type				= RHI_Cmd_SetTextures;
-		cmd.textures_start_slot = start_slot;
-		cmd.textures			= textures;
+		m_stream.SetTextures(start_slot, Buffer_PixelShader, textures, texture_count);
 	}
 
 	void RHI_CommandList::SetTexture(unsigned int start_slot, void* texture)
 	{
-		RHI_Command& cmd		= GetCmd();
-		cmd.type				= RHI_Cmd_SetTextures;
-		cmd.textures_start_slot = start_slot;
-		cmd.textures.emplace_back(texture);
+		m_stream.SetTextures(start_slot, Buffer_PixelShader, &texture, 1);
 	}
 
 	void RHI_CommandList::SetTexture(unsigned int start_slot, const shared_ptr<RHI_Texture>& texture)
@@ -242,20 +495,20 @@ namespace Spartan
 		SetTexture(start_slot, texture->GetBufferView());
 	}
 
-	void RHI_CommandList::SetRenderTargets(const vector<void*>& render_targets, void* depth_stencil /*= nullptr*/)
+	void RHI_CommandList::SetStructuredBuffer(unsigned int slot, RHI_Buffer_Scope scope, const shared_ptr<RHI_StructuredBuffer>& buffer)
+	{
+		void* view = buffer->GetBufferView();
+		m_stream.SetTextures(slot, scope, &view, 1);
+	}
+
+	void RHI_CommandList::SetRenderTargets(void* const* render_targets, unsigned int render_target_count, void* depth_stencil /*= nullptr*/)
 	{
-		RHI_Command& cmd	= GetCmd();
-		cmd.type			= RHI_Cmd_SetRenderTargets;
-		cmd.render_targets	= render_targets;
-		cmd.depth_stencil	= depth_stencil;
+		m_stream.SetRenderTargets(render_targets, render_target_count, depth_stencil);
 	}
 
 	void RHI_CommandList::SetRenderTarget(void* render_target, void* depth_stencil /*= nullptr*/)
 	{
-		RHI_Command& cmd	= GetCmd();
-		cmd.type			= RHI_Cmd_SetRenderTargets;	
-		cmd.depth_stencil	= depth_stencil;
-		cmd.render_targets.emplace_back(render_target);
+		m_stream.SetRenderTargets(&render_target, 1, depth_stencil);
 	}
 
 	void RHI_CommandList::SetRenderTarget(const shared_ptr<RHI_RenderTexture>& render_target, void* depth_stencil /*= nullptr*/)
@@ -265,304 +518,38 @@ namespace Spartan
 
 	void RHI_CommandList::ClearRenderTarget(void* render_target, const Vector4& color)
 	{
-		RHI_Command& cmd				= GetCmd();
-		cmd.type						= RHI_Cmd_ClearRenderTarget;
-		cmd.render_target_clear			= render_target;
-		cmd.render_target_clear_color	= color;
+		m_stream.ClearRenderTarget(render_target, color.Data());
 	}
 
 	void RHI_CommandList::ClearDepthStencil(void* depth_stencil, unsigned int flags, float depth, unsigned int stencil /*= 0*/)
 	{
-		RHI_Command& cmd		= GetCmd();
-		cmd.type				= RHI_Cmd_ClearDepthStencil;
-		cmd.depth_stencil		= depth_stencil;
-		cmd.depth_clear_flags	= flags;
-		cmd.depth_clear			= depth;
-		cmd.depth_clear_stencil = stencil;
+		m_stream.ClearDepthStencil(depth_stencil, flags, depth, stencil);
 	}
 
-	bool RHI_CommandList::Submit()
+	void RHI_CommandList::ExecuteCommandList(RHI_CommandList* cmd_list)
 	{
-		auto context		= m_rhi_device->GetContext();
-		auto device_context	= m_rhi_device->GetContext()->device_context;
-
-		for (unsigned int cmd_index = 0; cmd_index < m_command_count; cmd_index++)
-		{
-			RHI_Command& cmd = m_commands[cmd_index];
-
-			switch (cmd.type)
-			{
-				case RHI_Cmd_Begin:
-				{
-					m_profiler->TimeBlockStart(cmd.pass_name, true, true);
-					#ifdef DEBUG
-					context->annotation->BeginEvent(FileSystem::StringToWstring(cmd.pass_name).c_str());
-					#endif
-					break;
-				}
-
-				case RHI_Cmd_End:
-				{
-					#ifdef DEBUG
-					context->annotation->EndEvent();
-					#endif
-					m_profiler->TimeBlockEnd();
-					break;
-				}
-
-				case RHI_Cmd_Draw:
-				{
-					device_context->Draw(static_cast<UINT>(cmd.vertex_count), 0);
-
-					m_profiler->m_rhi_draw_calls++;
-					break;
-				}
-
-				case RHI_Cmd_DrawIndexed:
-				{
-					SPARTAN_ASSERT(cmd.index_count != 0);
-
-					device_context->DrawIndexed
-					(
-						static_cast<UINT>(cmd.index_count),
-						static_cast<UINT>(cmd.index_offset),
-						static_cast<INT>(cmd.vertex_offset)
-					);
-
-					m_profiler->m_rhi_draw_calls++;
-					break;
-				}
-
-				case RHI_Cmd_SetViewport:
-				{
-					D3D11_VIEWPORT d3d11_viewport;
-					d3d11_viewport.TopLeftX	= cmd.viewport.GetX();
-					d3d11_viewport.TopLeftY	= cmd.viewport.GetY();
-					d3d11_viewport.Width	= cmd.viewport.GetWidth();
-					d3d11_viewport.Height	= cmd.viewport.GetHeight();
-					d3d11_viewport.MinDepth	= cmd.viewport.GetMinDepth();
-					d3d11_viewport.MaxDepth	= cmd.viewport.GetMaxDepth();
-
-					device_context->RSSetViewports(1, &d3d11_viewport);
-
-					break;
-				}
-
-				case RHI_Cmd_SetScissorRectangle:
-				{
-					const auto left		= cmd.scissor_rectangle.x;
-					const auto top		= cmd.scissor_rectangle.y;
-					const auto right	= cmd.scissor_rectangle.x + cmd.scissor_rectangle.width;
-					const auto bottom	= cmd.scissor_rectangle.y + cmd.scissor_rectangle.height;
-					const D3D11_RECT d3d11_rectangle = { static_cast<LONG>(left), static_cast<LONG>(top), static_cast<LONG>(right), static_cast<LONG>(bottom) };
-
-					device_context->RSSetScissorRects(1, &d3d11_rectangle);
-
-					break;
-				}
-
-				case RHI_Cmd_SetPrimitiveTopology:
-				{
-					device_context->IASetPrimitiveTopology(d3d11_primitive_topology[cmd.primitive_topology]);
-					break;
-				}
-
-				case RHI_Cmd_SetInputLayout:
-				{
-					device_context->IASetInputLayout(static_cast<ID3D11InputLayout*>(cmd.input_layout->GetBuffer()));
-					break;
-				}
-
-				case RHI_Cmd_SetDepthStencilState:
-				{
-					device_context->OMSetDepthStencilState(
-						static_cast<ID3D11DepthStencilState*>(cmd.depth_stencil_state->GetBuffer()), 1
-					);
-					break;
-				}
-
-				case RHI_Cmd_SetRasterizerState:
-				{
-					device_context->RSSetState(
-						static_cast<ID3D11RasterizerState*>(cmd.rasterizer_state->GetBuffer())
-					);
-
-					break;
-				}
-
-				case RHI_Cmd_SetBlendState:
-				{
-					FLOAT blend_factor[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
-
-					device_context->OMSetBlendState(
-						static_cast<ID3D11BlendState*>(cmd.blend_state->GetBuffer()),
-						blend_factor,
-						0xffffffff
-					);
-
-					break;
-				}
-
-				case RHI_Cmd_SetVertexBuffer:
-				{
-					auto ptr			= static_cast<ID3D11Buffer*>(cmd.buffer_vertex->GetBuffer());
-					auto stride			= cmd.buffer_vertex->GetStride();
-					unsigned int offset = 0;
-					device_context->IASetVertexBuffers(0, 1, &ptr, &stride, &offset);
-
-					m_profiler->m_rhi_bindings_buffer_vertex++;
-					break;
-				}
-
-				case RHI_Cmd_SetIndexBuffer:
-				{
-					device_context->IASetIndexBuffer
-					(
-						static_cast<ID3D11Buffer*>(cmd.buffer_index->GetBuffer()),
-						cmd.buffer_index->Is16Bit() ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT,
-						0
-					);
-
-					m_profiler->m_rhi_bindings_buffer_index++;
-					break;
-				}
-
-				case RHI_Cmd_SetVertexShader:
-				{
-					const auto ptr = static_cast<ID3D11VertexShader*>(cmd.shader_vertex->GetVertexShaderBuffer());
-					device_context->VSSetShader(ptr, nullptr, 0);
-
-					m_profiler->m_rhi_bindings_vertex_shader++;
-					break;
-				}
-
-				case RHI_Cmd_SetPixelShader:
-				{
-					const auto ptr = static_cast<ID3D11PixelShader*>(cmd.shader_pixel->GetPixelShaderBuffer());
-					device_context->PSSetShader(ptr, nullptr, 0);
-
-					m_profiler->m_rhi_bindings_pixel_shader++;
-					break;
-				}
-
-				case RHI_Cmd_SetConstantBuffers:
-				{
-					const auto start_slot	= static_cast<UINT>(cmd.constant_buffers_start_slot);
-					const auto buffer_count = static_cast<UINT>(cmd.constant_buffers.size());
-					const auto buffer		= reinterpret_cast<ID3D11Buffer*const*>(cmd.constant_buffers.data());
-					const auto scope		= cmd.constant_buffers_scope;
-
-					if (scope == Buffer_VertexShader || scope == Buffer_Global)
-					{
-						device_context->VSSetConstantBuffers(start_slot, buffer_count, buffer);
-					}
-
-					if (scope == Buffer_PixelShader || scope == Buffer_Global)
-					{
-						device_context->PSSetConstantBuffers(start_slot, buffer_count, buffer);
-					}
-
-					m_profiler->m_rhi_bindings_buffer_constant += (cmd.constant_buffers_scope == Buffer_Global) ? 2 : 1;
-					break;
-				}
-
-				case RHI_Cmd_SetSamplers:
-				{
-					device_context->PSSetSamplers
-					(
-						static_cast<UINT>(cmd.samplers_start_slot),
-						static_cast<UINT>(cmd.samplers.size()),
-						reinterpret_cast<ID3D11SamplerState* const*>(cmd.samplers.data())
-					);
-
-					m_profiler->m_rhi_bindings_sampler++;
-					break;
-				}
-
-				case RHI_Cmd_SetTextures:
-				{
-					device_context->PSSetShaderResources
-					(
-						static_cast<UINT>(cmd.textures_start_slot),
-						static_cast<UINT>(cmd.textures.size()),
-						reinterpret_cast<ID3D11ShaderResourceView* const*>(cmd.textures.data())
-					);
-
-					m_profiler->m_rhi_bindings_texture++;
-					break;
-				}
-
-				case RHI_Cmd_SetRenderTargets:
-				{
-					device_context->OMSetRenderTargets
-					(
-						static_cast<UINT>(cmd.render_targets.size()),
-						reinterpret_cast<ID3D11RenderTargetView* const*>(cmd.render_targets.data()),
-						static_cast<ID3D11DepthStencilView*>(cmd.depth_stencil)
-					);
-
-					m_profiler->m_rhi_bindings_render_target++;
-					break;
-				}
+		// Deferred contexts would replay on the driver's terms, the streams are merged instead, which also
+		// drops the binds that were only redundant across the lists
+		m_stream.Append(cmd_list->m_stream);
+		cmd_list->Clear();
+	}
 
-				case RHI_Cmd_ClearRenderTarget:
-				{
-					device_context->ClearRenderTargetView
-					(
-						static_cast<ID3D11RenderTargetView*>(cmd.render_target_clear),
-						cmd.render_target_clear_color.Data()
-					);
-					break;
-				}
+	bool RHI_CommandList::Submit()
+	{
+		auto context = m_rhi_device->GetContext();
 
-				case RHI_Cmd_ClearDepthStencil:
-				{
-					UINT clear_flags = 0;
-					clear_flags |= cmd.depth_clear_flags & Clear_Depth ? D3D11_CLEAR_DEPTH : 0;
-					clear_flags |= cmd.depth_clear_flags & Clear_Stencil ? D3D11_CLEAR_STENCIL : 0;
-
-					device_context->ClearDepthStencilView
-					(
-						static_cast<ID3D11DepthStencilView*>(cmd.depth_stencil),
-						clear_flags,
-						static_cast<FLOAT>(cmd.depth_clear),
-						static_cast<UINT8>(cmd.depth_clear_stencil)
-					);
-
-					break;
-				}
-			}
-		}
+		D3D11_Executor executor = { context, context->device_context, context->device_context_1, m_profiler };
+		m_stream.Replay(executor);
+		m_profiler->m_rhi_bindings_eliminated += m_stream.GetBindsEliminated();
 
 		Clear();
 		return true;
 	}
 
-	RHI_Command& RHI_CommandList::GetCmd()
-	{
-		// Grow capacity if needed
-		if (m_command_count >= m_commands.size())
-		{
-			unsigned int new_size = m_command_count + 100;
-			m_commands.reserve(new_size);
-			m_commands.resize(new_size);
-			LOGF_WARNING("Command list has grown to fit %d commands. Consider making the capacity larger to avoid re-allocations.", m_command_count + 1);
-		}
-
-		m_command_count++;
-		return m_commands[m_command_count - 1];	
-	}
-
 	void RHI_CommandList::Clear()
 	{
-		for (unsigned int cmd_index = 0; cmd_index < m_command_count; cmd_index++)
-		{
-			RHI_Command& cmd = m_commands[cmd_index];
-			cmd.Clear();
-		}
-
-		m_command_count = 0;
+		m_stream.Clear();
 	}
 }
 
-#endif
\ No newline at end of file
+#endif
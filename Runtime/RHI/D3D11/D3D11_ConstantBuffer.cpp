@@ -41,7 +41,7 @@ namespace Spartan
 		safe_release(static_cast<ID3D11Buffer*>(m_buffer));
 	}
 
-	void* RHI_ConstantBuffer::Map() const
+	void* RHI_ConstantBuffer::Map(const bool discard) const
 	{
 		if (!m_rhi_device || !m_rhi_device->GetContext()->device_context || !m_buffer)
 		{
@@ -49,8 +49,15 @@ namespace Spartan
 			return nullptr;
 		}
 
+		// Without D3D11.1 a dynamic constant buffer can only be mapped with WRITE_DISCARD
+		if (!discard && !m_rhi_device->IsConstantBufferOffsettingSupported())
+		{
+			LOG_ERROR("Constant buffers can't be mapped without discarding on this device.");
+			return nullptr;
+		}
+
 		D3D11_MAPPED_SUBRESOURCE mapped_resource;
-		const auto result = m_rhi_device->GetContext()->device_context->Map(static_cast<ID3D11Buffer*>(m_buffer), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped_resource);
+		const auto result = m_rhi_device->GetContext()->device_context->Map(static_cast<ID3D11Buffer*>(m_buffer), 0, discard ? D3D11_MAP_WRITE_DISCARD : D3D11_MAP_WRITE_NO_OVERWRITE, 0, &mapped_resource);
 		if (FAILED(result))
 		{
 			LOG_ERROR("Failed to map constant buffer.");
@@ -158,6 +158,28 @@ namespace Spartan
 			}
 		}
 
+		// Constant buffer offsets (D3D11.1)
+		{
+			D3D11_FEATURE_DATA_D3D11_OPTIONS options = {};
+			const auto result = m_rhi_context->device->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS, &options, sizeof(options));
+			if (FAILED(result))
+			{
+				LOGF_ERROR("Failed to query D3D11 options, %s.", D3D11_Common::dxgi_error_to_string(result));
+			}
+			else if (options.ConstantBufferOffsetting && options.MapNoOverwriteOnDynamicConstantBuffer)
+			{
+				m_constant_buffer_offsetting = SUCCEEDED(m_rhi_context->device_context->QueryInterface(IID_PPV_ARGS(&m_rhi_context->device_context_1)));
+			}
+
+			if (!m_constant_buffer_offsetting)
+			{
+				LOG_INFO("Constant buffer offsets are not supported, every constant buffer allocation will get a buffer of its own.");
+			}
+		}
+
+		// Command lists are merged by appending their streams
+		m_command_list_merging = true;
+
 		// Annotations
 		const auto result = m_rhi_context->device_context->QueryInterface(IID_PPV_ARGS(&m_rhi_context->annotation));
 		if (FAILED(result))
@@ -171,6 +193,7 @@ namespace Spartan
 
 	RHI_Device::~RHI_Device()
 	{
+		safe_release(m_rhi_context->device_context_1);
 		safe_release(m_rhi_context->device_context);
 		safe_release(m_rhi_context->device);
 		safe_release(m_rhi_context->annotation);
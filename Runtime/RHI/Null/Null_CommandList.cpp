@@ -0,0 +1,517 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= IMPLEMENTATION ===============
+#include "../RHI_Implementation.h"
+#ifdef API_GRAPHICS_NULL
+//================================
+
+//= INCLUDES ========================
+#include "../RHI_CommandList.h"
+#include "../RHI_Pipeline.h"
+#include "../RHI_Device.h"
+#include "../RHI_Sampler.h"
+#include "../RHI_Texture.h"
+#include "../RHI_Shader.h"
+#include "../RHI_RenderTexture.h"
+#include "../RHI_ConstantBuffer.h"
+#include "../RHI_StructuredBuffer.h"
+#include "../../Profiling/Profiler.h"
+#include "../../Logging/Log.h"
+#include "../../Core/FrameAllocator.h"
+#include "../RHI_VertexBuffer.h"
+#include "../RHI_IndexBuffer.h"
+#include "../RHI_BlendState.h"
+#include "../RHI_DepthStencilState.h"
+#include "../RHI_RasterizerState.h"
+#include "../RHI_InputLayout.h"
+//===================================
+
+//= NAMESPACES ================
+using namespace std;
+using namespace Spartan::Math;
+//=============================
+
+namespace Spartan
+{
+	namespace
+	{
+		// What the profiler counts, kept apart so that command lists also work without a profiler (tests, tools)
+		struct Null_Counters
+		{
+			unsigned int draw_calls					= 0;
+			unsigned int bindings_buffer_index		= 0;
+			unsigned int bindings_buffer_vertex		= 0;
+			unsigned int bindings_buffer_constant	= 0;
+			unsigned int bindings_sampler			= 0;
+			unsigned int bindings_texture			= 0;
+			unsigned int bindings_vertex_shader		= 0;
+			unsigned int bindings_pixel_shader		= 0;
+			unsigned int bindings_render_target		= 0;
+		};
+
+		// Executes the commands of an RHI_CommandStream against nothing, it validates them the way
+		// a debug layer would and counts them the way the other backends do. There is no GPU work
+		// to time, so unlike the other backends, Begin() and End() don't open profiler time blocks.
+		struct Null_Executor
+		{
+			RHI_Context* context;
+			Null_Counters counters;
+
+			void Begin(const RHI_Cmd::Begin& cmd)
+			{
+				context->event_depth++;
+			}
+
+			void End()
+			{
+				if (context->event_depth == 0)
+				{
+					LOG_ERROR("End() without a matching Begin()");
+					return;
+				}
+
+				context->event_depth--;
+			}
+
+			bool ValidateDraw() const
+			{
+				if (!context->vertex_shader)
+				{
+					LOG_ERROR("Draw without a vertex shader");
+					return false;
+				}
+
+				if (context->render_target_count == 0 && !context->depth_stencil)
+				{
+					LOG_ERROR("Draw without a render target or depth-stencil");
+					return false;
+				}
+
+				if (!context->viewport)
+				{
+					LOG_ERROR("Draw without a viewport");
+					return false;
+				}
+
+				return true;
+			}
+
+			bool ValidateDrawIndexed(const uint32_t index_count, const uint32_t index_offset, const uint32_t vertex_offset) const
+			{
+				if (!ValidateDraw())
+					return false;
+
+				if (context->index_count == 0 || context->vertex_count == 0 || !context->input_layout)
+				{
+					LOG_ERROR("Indexed draw without an index buffer, a vertex buffer or an input layout");
+					return false;
+				}
+
+				if (index_count == 0 || static_cast<uint64_t>(index_offset) + index_count > context->index_count)
+				{
+					LOGF_ERROR("Indices %d to %d are out of the bound index buffer's %d", index_offset, index_offset + index_count, context->index_count);
+					return false;
+				}
+
+				if (vertex_offset >= context->vertex_count)
+				{
+					LOGF_ERROR("Vertex offset %d is out of the bound vertex buffer's %d", vertex_offset, context->vertex_count);
+					return false;
+				}
+
+				return true;
+			}
+
+			void Draw(const RHI_Cmd::Draw& cmd)
+			{
+				if (!ValidateDraw())
+					return;
+
+				counters.draw_calls++;
+			}
+
+			void DrawIndexed(const RHI_Cmd::DrawIndexed& cmd)
+			{
+				if (!ValidateDrawIndexed(cmd.index_count, cmd.index_offset, cmd.vertex_offset))
+					return;
+
+				counters.draw_calls++;
+			}
+
+			void DrawIndexedInstanced(const RHI_Cmd::DrawIndexedInstanced& cmd)
+			{
+				if (cmd.instance_count == 0)
+				{
+					LOG_ERROR("Instanced draw without instances");
+					return;
+				}
+
+				if (!ValidateDrawIndexed(cmd.index_count, cmd.index_offset, cmd.vertex_offset))
+					return;
+
+				counters.draw_calls++;
+			}
+
+			void SetViewport(const RHI_Cmd::Viewport& cmd)
+			{
+				context->viewport = cmd.width > 0.0f && cmd.height > 0.0f && cmd.depth_min <= cmd.depth_max;
+				if (!context->viewport)
+				{
+					LOGF_ERROR("Invalid viewport %fx%f", cmd.width, cmd.height);
+				}
+			}
+
+			void SetScissorRectangle(const RHI_Cmd::ScissorRectangle& cmd)
+			{
+				if (cmd.width < 0.0f || cmd.height < 0.0f)
+				{
+					LOGF_ERROR("Invalid scissor rectangle %fx%f", cmd.width, cmd.height);
+				}
+			}
+
+			void SetPrimitiveTopology(const RHI_Cmd::PrimitiveTopology& cmd)
+			{
+
+			}
+
+			void SetState(const RHI_Cmd_Type type, const RHI_Cmd::State& cmd)
+			{
+				// The identity is the API object, null when the object failed to create
+				const auto valid = cmd.identity != nullptr;
+
+				switch (type)
+				{
+					case RHI_Cmd_SetInputLayout:
+						context->input_layout = valid;
+						break;
+
+					case RHI_Cmd_SetVertexBuffer:
+						context->vertex_count = valid ? static_cast<const RHI_VertexBuffer*>(cmd.object)->GetVertexCount() : 0;
+						counters.bindings_buffer_vertex++;
+						break;
+
+					case RHI_Cmd_SetIndexBuffer:
+						context->index_count = valid ? static_cast<const RHI_IndexBuffer*>(cmd.object)->GetIndexCount() : 0;
+						counters.bindings_buffer_index++;
+						break;
+
+					case RHI_Cmd_SetVertexShader:
+						context->vertex_shader = valid;
+						counters.bindings_vertex_shader++;
+						break;
+
+					case RHI_Cmd_SetPixelShader:
+						counters.bindings_pixel_shader++;
+						break;
+
+					default:
+						break;
+				}
+
+				if (!valid && type != RHI_Cmd_SetPixelShader) // depth only passes bind no pixel shader
+				{
+					LOGF_ERROR("Binding an object which was never created (command %d)", static_cast<int>(type));
+				}
+			}
+
+			void SetConstantBuffers(const RHI_Cmd::Bindings& cmd)
+			{
+				// A slice of a larger buffer
+				if (cmd.size != 0)
+				{
+					if (cmd.offset % 256 != 0 || cmd.size % 256 != 0)
+					{
+						LOGF_ERROR("Constant buffer slice %d+%d is not 256 byte aligned", cmd.offset, cmd.size);
+					}
+
+					for (uint32_t i = 0; i < cmd.count; i++)
+					{
+						const auto buffer = static_cast<const Null_Common::Resource*>(cmd.Objects()[i]);
+						if (buffer && static_cast<uint64_t>(cmd.offset) + cmd.size > buffer->size)
+						{
+							LOGF_ERROR("Constant buffer slice %d+%d is out of the buffer's %d bytes", cmd.offset, cmd.size, static_cast<unsigned int>(buffer->size));
+						}
+					}
+				}
+
+				counters.bindings_buffer_constant += (cmd.scope == Buffer_Global) ? 2 : 1;
+			}
+
+			void SetSamplers(const RHI_Cmd::Bindings& cmd)
+			{
+				counters.bindings_sampler++;
+			}
+
+			void SetTextures(const RHI_Cmd::Bindings& cmd)
+			{
+				counters.bindings_texture++;
+			}
+
+			void SetRenderTargets(const RHI_Cmd::RenderTargets& cmd)
+			{
+				context->render_target_count	= 0;
+				context->depth_stencil			= cmd.depth_stencil != nullptr;
+
+				for (uint32_t i = 0; i < cmd.count; i++)
+				{
+					context->render_target_count += cmd.Objects()[i] ? 1 : 0;
+				}
+
+				counters.bindings_render_target++;
+			}
+
+			void ClearRenderTarget(const RHI_Cmd::ClearRenderTarget& cmd)
+			{
+				if (!cmd.render_target)
+				{
+					LOG_ERROR("Clearing a render target which was never created");
+				}
+			}
+
+			void ClearDepthStencil(const RHI_Cmd::ClearDepthStencil& cmd)
+			{
+				if (!cmd.depth_stencil)
+				{
+					LOG_ERROR("Clearing a depth-stencil which was never created");
+				}
+			}
+		};
+	}
+
+	RHI_CommandList::RHI_CommandList(const std::shared_ptr<RHI_Device>& rhi_device, Profiler* profiler)
+	{
+		m_rhi_device	= rhi_device;
+		m_profiler		= profiler;
+	}
+
+	RHI_CommandList::~RHI_CommandList()
+	{
+		
+	}
+
+	void RHI_CommandList::Begin(const char* pass_name, void* render_pass, RHI_SwapChain* swap_chain)
+	{
+		m_stream.Begin(FrameAllocator::AllocateString(pass_name));
+	}
+
+	void RHI_CommandList::End()
+	{
+		m_stream.End();
+	}
+
+	void RHI_CommandList::Draw(unsigned int vertex_count)
+	{
+		m_stream.Draw(vertex_count);
+	}
+
+	void RHI_CommandList::DrawIndexed(unsigned int index_count, unsigned int index_offset, unsigned int vertex_offset)
+	{
+		m_stream.DrawIndexed(index_count, index_offset, vertex_offset);
+	}
+
+	void RHI_CommandList::DrawIndexedInstanced(unsigned int index_count, unsigned int instance_count, unsigned int index_offset, unsigned int vertex_offset, unsigned int instance_offset)
+	{
+		m_stream.DrawIndexedInstanced(index_count, instance_count, index_offset, vertex_offset, instance_offset);
+	}
+
+	void RHI_CommandList::SetPipeline(const RHI_Pipeline* pipeline)
+	{
+		SetViewport(pipeline->m_viewport);
+		SetBlendState(pipeline->m_blend_state);
+		SetDepthStencilState(pipeline->m_depth_stencil_state);
+		SetRasterizerState(pipeline->m_rasterizer_state);
+		SetInputLayout(pipeline->m_shader_vertex->GetInputLayout());
+		SetShaderVertex(pipeline->m_shader_vertex);
+		SetShaderPixel(pipeline->m_shader_pixel);	
+	}
+
+	void RHI_CommandList::SetViewport(const RHI_Viewport& viewport)
+	{
+		m_stream.SetViewport({ viewport.GetX(), viewport.GetY(), viewport.GetWidth(), viewport.GetHeight(), viewport.GetMinDepth(), viewport.GetMaxDepth() });
+	}
+
+	void RHI_CommandList::SetScissorRectangle(const Math::Rectangle& scissor_rectangle)
+	{
+		m_stream.SetScissorRectangle({ scissor_rectangle.x, scissor_rectangle.y, scissor_rectangle.width, scissor_rectangle.height });
+	}
+
+	void RHI_CommandList::SetPrimitiveTopology(RHI_PrimitiveTopology_Mode primitive_topology)
+	{
+		m_stream.SetPrimitiveTopology(primitive_topology);
+	}
+
+	void RHI_CommandList::SetInputLayout(const RHI_InputLayout* input_layout)
+	{
+		m_stream.SetState(RHI_Cmd_SetInputLayout, input_layout, input_layout->GetBuffer());
+	}
+
+	void RHI_CommandList::SetDepthStencilState(const RHI_DepthStencilState* depth_stencil_state)
+	{
+		m_stream.SetState(RHI_Cmd_SetDepthStencilState, depth_stencil_state, depth_stencil_state->GetBuffer());
+	}
+
+	void RHI_CommandList::SetRasterizerState(const RHI_RasterizerState* rasterizer_state)
+	{
+		m_stream.SetState(RHI_Cmd_SetRasterizerState, rasterizer_state, rasterizer_state->GetBuffer());
+	}
+
+	void RHI_CommandList::SetBlendState(const RHI_BlendState* blend_state)
+	{
+		m_stream.SetState(RHI_Cmd_SetBlendState, blend_state, blend_state->GetBuffer());
+	}
+
+	void RHI_CommandList::SetBufferVertex(const RHI_VertexBuffer* buffer)
+	{
+		m_stream.SetState(RHI_Cmd_SetVertexBuffer, buffer, buffer->GetBuffer());
+	}
+
+	void RHI_CommandList::SetBufferIndex(const RHI_IndexBuffer* buffer)
+	{
+		m_stream.SetState(RHI_Cmd_SetIndexBuffer, buffer, buffer->GetBuffer());
+	}
+
+	void RHI_CommandList::SetShaderVertex(const RHI_Shader* shader)
+	{
+		m_stream.SetState(RHI_Cmd_SetVertexShader, shader, shader->GetVertexShaderBuffer());
+	}
+
+	void RHI_CommandList::SetShaderPixel(const RHI_Shader* shader)
+	{
+		m_stream.SetState(RHI_Cmd_SetPixelShader, shader, shader->GetPixelShaderBuffer());
+	}
+
+	void RHI_CommandList::SetConstantBuffers(unsigned int start_slot, RHI_Buffer_Scope scope, void* const* constant_buffers, unsigned int constant_buffer_count)
+	{
+		m_stream.SetConstantBuffers(start_slot, scope, constant_buffers, constant_buffer_count);
+	}
+
+	void RHI_CommandList::SetConstantBuffer(unsigned int start_slot, RHI_Buffer_Scope scope, const shared_ptr<RHI_ConstantBuffer>& constant_buffer)
+	{
+		void* buffer = constant_buffer->GetBufferView();
+		m_stream.SetConstantBuffers(start_slot, scope, &buffer, 1);
+	}
+
+	void RHI_CommandList::SetConstantBuffer(unsigned int start_slot, RHI_Buffer_Scope scope, const shared_ptr<RHI_ConstantBuffer>& constant_buffer, unsigned int offset, unsigned int size)
+	{
+		void* buffer = constant_buffer->GetBufferView();
+		m_stream.SetConstantBuffers(start_slot, scope, &buffer, 1, offset, size);
+	}
+
+	void RHI_CommandList::SetSamplers(unsigned int start_slot, void* const* samplers, unsigned int sampler_count)
+	{
+		m_stream.SetSamplers(start_slot, samplers, sampler_count);
+	}
+
+	void RHI_CommandList::SetSampler(unsigned int start_slot, const shared_ptr<RHI_Sampler>& sampler)
+	{
+		void* buffer = sampler->GetBufferView();
+		m_stream.SetSamplers(start_slot, &buffer, 1);
+	}
+
+	void RHI_CommandList::SetTextures(unsigned int start_slot, void* const* textures, unsigned int texture_count)
+	{
+		m_stream.SetTextures(start_slot, Buffer_PixelShader, textures, texture_count);
+	}
+
+	void RHI_CommandList::SetTexture(unsigned int start_slot, void* texture)
+	{
+		m_stream.SetTextures(start_slot, Buffer_PixelShader, &texture, 1);
+	}
+
+	void RHI_CommandList::SetTexture(unsigned int start_slot, const shared_ptr<RHI_Texture>& texture)
+	{
+		SetTexture(start_slot, texture->GetBufferView());
+	}
+
+	void RHI_CommandList::SetTexture(unsigned int start_slot, const shared_ptr<RHI_RenderTexture>& texture)
+	{
+		SetTexture(start_slot, texture->GetBufferView());
+	}
+
+	void RHI_CommandList::SetStructuredBuffer(unsigned int slot, RHI_Buffer_Scope scope, const shared_ptr<RHI_StructuredBuffer>& buffer)
+	{
+		void* view = buffer->GetBufferView();
+		m_stream.SetTextures(slot, scope, &view, 1);
+	}
+
+	void RHI_CommandList::SetRenderTargets(void* const* render_targets, unsigned int render_target_count, void* depth_stencil /*= nullptr*/)
+	{
+		m_stream.SetRenderTargets(render_targets, render_target_count, depth_stencil);
+	}
+
+	void RHI_CommandList::SetRenderTarget(void* render_target, void* depth_stencil /*= nullptr*/)
+	{
+		m_stream.SetRenderTargets(&render_target, 1, depth_stencil);
+	}
+
+	void RHI_CommandList::SetRenderTarget(const shared_ptr<RHI_RenderTexture>& render_target, void* depth_stencil /*= nullptr*/)
+	{
+		SetRenderTarget(render_target->GetBufferRenderTargetView(), depth_stencil);
+	}
+
+	void RHI_CommandList::ClearRenderTarget(void* render_target, const Vector4& color)
+	{
+		m_stream.ClearRenderTarget(render_target, color.Data());
+	}
+
+	void RHI_CommandList::ClearDepthStencil(void* depth_stencil, unsigned int flags, float depth, unsigned int stencil /*= 0*/)
+	{
+		m_stream.ClearDepthStencil(depth_stencil, flags, depth, stencil);
+	}
+
+	void RHI_CommandList::ExecuteCommandList(RHI_CommandList* cmd_list)
+	{
+		m_stream.Append(cmd_list->m_stream);
+		cmd_list->Clear();
+	}
+
+	bool RHI_CommandList::Submit()
+	{
+		Null_Executor executor = { m_rhi_device->GetContext() };
+		m_stream.Replay(executor);
+
+		if (m_profiler)
+		{
+			const auto& counters = executor.counters;
+			m_profiler->m_rhi_draw_calls				+= counters.draw_calls;
+			m_profiler->m_rhi_bindings_buffer_index		+= counters.bindings_buffer_index;
+			m_profiler->m_rhi_bindings_buffer_vertex	+= counters.bindings_buffer_vertex;
+			m_profiler->m_rhi_bindings_buffer_constant	+= counters.bindings_buffer_constant;
+			m_profiler->m_rhi_bindings_sampler			+= counters.bindings_sampler;
+			m_profiler->m_rhi_bindings_texture			+= counters.bindings_texture;
+			m_profiler->m_rhi_bindings_vertex_shader	+= counters.bindings_vertex_shader;
+			m_profiler->m_rhi_bindings_pixel_shader		+= counters.bindings_pixel_shader;
+			m_profiler->m_rhi_bindings_render_target	+= counters.bindings_render_target;
+			m_profiler->m_rhi_bindings_eliminated		+= m_stream.GetBindsEliminated();
+		}
+
+		Clear();
+		return true;
+	}
+
+	void RHI_CommandList::Clear()
+	{
+		m_stream.Clear();
+	}
+}
+
+#endif
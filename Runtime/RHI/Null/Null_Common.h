@@ -0,0 +1,138 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= IMPLEMENTATION ===============
+#include "../RHI_Implementation.h"
+#ifdef API_GRAPHICS_NULL
+//================================
+
+//= INCLUDES =====================
+#include <cstddef>
+#include <cstring>
+#include "../../Logging/Log.h"
+#include "../../Core/EngineDefs.h"
+//================================
+
+namespace Spartan::Null_Common
+{
+	// Every API handle of the null backend points to one of these, so handles stay unique and non-null
+	// and the memory the GPU would have needed can be tracked
+	struct Resource
+	{
+		RHI_Context* context	= nullptr; // null for untracked resources
+		uint64_t size			= 0;
+		std::byte* memory		= nullptr; // CPU copy, only for resources which can be mapped
+		bool mapped				= false;
+	};
+
+	// Objects which don't keep the device alive (e.g. pipeline states) pass a null context, they hold no memory anyway
+	inline void* resource_create(RHI_Context* context, const uint64_t size = 0, const bool mappable = false, const void* data = nullptr)
+	{
+		auto resource		= new Resource();
+		resource->context	= context;
+		resource->size		= size;
+		resource->memory	= (mappable && size != 0) ? new std::byte[size] : nullptr;
+
+		if (resource->memory && data)
+		{
+			memcpy(resource->memory, data, size);
+		}
+
+		if (context)
+		{
+			context->resource_count++;
+			context->resource_memory += size;
+
+			if (data)
+			{
+				context->upload_count++;
+				context->upload_memory += size;
+			}
+		}
+
+		return static_cast<void*>(resource);
+	}
+
+	inline void resource_release(void*& handle)
+	{
+		if (!handle)
+			return;
+
+		auto resource = static_cast<Resource*>(handle);
+		if (resource->mapped)
+		{
+			LOG_WARNING("Releasing a resource which is still mapped");
+		}
+
+		if (auto context = resource->context)
+		{
+			context->resource_count--;
+			context->resource_memory -= resource->size;
+		}
+
+		delete[] resource->memory;
+		delete resource;
+		handle = nullptr;
+	}
+
+	// Mapping counts as an upload of the whole resource, that's what a discard would cost
+	inline void* resource_map(void* handle)
+	{
+		auto resource = static_cast<Resource*>(handle);
+		if (!resource->memory)
+		{
+			LOG_ERROR("Resource can't be mapped");
+			return nullptr;
+		}
+
+		if (resource->mapped)
+		{
+			LOG_ERROR("Resource is already mapped");
+			return nullptr;
+		}
+
+		resource->mapped = true;
+		if (auto context = resource->context)
+		{
+			context->upload_count++;
+			context->upload_memory += resource->size;
+		}
+
+		return static_cast<void*>(resource->memory);
+	}
+
+	inline bool resource_unmap(void* handle)
+	{
+		auto resource = static_cast<Resource*>(handle);
+		if (!resource->mapped)
+		{
+			LOG_ERROR("Resource is not mapped");
+			return false;
+		}
+
+		resource->mapped = false;
+		return true;
+	}
+}
+
+#endif
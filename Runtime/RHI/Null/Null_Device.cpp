@@ -0,0 +1,116 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= IMPLEMENTATION ===============
+#include "../RHI_Implementation.h"
+#ifdef API_GRAPHICS_NULL
+//================================
+
+//= INCLUDES ==================
+#include "../RHI_Device.h"
+#include "../../Logging/Log.h"
+#include "../../Core/Settings.h"
+//=============================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+	RHI_Device::RHI_Device()
+	{
+		m_rhi_context = new RHI_Context();
+
+		// A single adapter without memory, so nothing picks it for its capabilities
+		AddAdapter("Null", 0, 0, nullptr);
+		SetPrimaryAdapter(&GetAdapters().front());
+
+		Settings::Get().m_versionGraphicsAPI = "Null";
+		LOG_INFO(Settings::Get().m_versionGraphicsAPI);
+
+		m_constant_buffer_offsetting	= true;
+		m_command_list_merging			= true;
+		m_initialized					= true;
+	}
+
+	RHI_Device::~RHI_Device()
+	{
+		// Whatever is still alive here was never released
+		if (m_rhi_context->resource_count != 0)
+		{
+			LOGF_WARNING("%d resources (%d KB) are still alive", static_cast<unsigned int>(m_rhi_context->resource_count), static_cast<unsigned int>(m_rhi_context->resource_memory / 1024));
+		}
+
+		safe_delete(m_rhi_context);
+	}
+
+	bool RHI_Device::ProfilingCreateQuery(void** query, const RHI_Query_Type type) const
+	{
+		*query = Null_Common::resource_create(nullptr);
+		return true;
+	}
+
+	bool RHI_Device::ProfilingQueryStart(void* query_object) const
+	{
+		if (!query_object)
+		{
+			LOG_ERROR_INVALID_PARAMETER();
+			return false;
+		}
+
+		return true;
+	}
+
+	bool RHI_Device::ProfilingGetTimeStamp(void* query_object) const
+	{
+		if (!query_object)
+		{
+			LOG_ERROR_INVALID_PARAMETER();
+			return false;
+		}
+
+		return true;
+	}
+
+	float RHI_Device::ProfilingGetDuration(void* query_disjoint, void* query_start, void* query_end) const
+	{
+		// Nothing executes, so nothing takes time
+		return 0.0f;
+	}
+
+	void RHI_Device::ProfilingReleaseQuery(void* query_object)
+	{
+		Null_Common::resource_release(query_object);
+	}
+
+	unsigned int RHI_Device::ProfilingGetGpuMemory()
+	{
+		return 0;
+	}
+
+	unsigned int RHI_Device::ProfilingGetGpuMemoryUsage()
+	{
+		// What the GPU would be using
+		return static_cast<unsigned int>(m_rhi_context->resource_memory / 1024 / 1024); // convert to MBs
+	}
+}
+#endif
@@ -0,0 +1,93 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= IMPLEMENTATION ===============
+#include "../RHI_Implementation.h"
+#ifdef API_GRAPHICS_NULL
+//================================
+
+//= INCLUDES ==================
+#include "../RHI_Device.h"
+#include "../RHI_IndexBuffer.h"
+#include "../../Logging/Log.h"
+//=============================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+	RHI_IndexBuffer::~RHI_IndexBuffer()
+	{
+		Null_Common::resource_release(m_buffer);
+	}
+
+	bool RHI_IndexBuffer::Create(const void* indices)
+	{
+		if (!m_rhi_device)
+		{
+			LOG_ERROR_INVALID_INTERNALS();
+			return false;
+		}
+
+		if ((!m_is_dynamic && !indices) || m_index_count == 0)
+		{
+			LOG_ERROR_INVALID_PARAMETER();
+			return false;
+		}
+
+		if (!Is16Bit() && !Is32Bit())
+		{
+			LOGF_ERROR("Indices have to be 16 or 32 bit, not %d", m_stride * 8);
+			return false;
+		}
+
+		// Immutable buffers get their data once, dynamic ones get a CPU copy to map
+		Null_Common::resource_release(m_buffer);
+		m_buffer = Null_Common::resource_create(m_rhi_device->GetContext(), m_size, m_is_dynamic, m_is_dynamic ? nullptr : indices);
+
+		return true;
+	}
+
+	void* RHI_IndexBuffer::Map() const
+	{
+		if (!m_buffer)
+		{
+			LOG_ERROR_INVALID_INTERNALS();
+			return nullptr;
+		}
+
+		return Null_Common::resource_map(m_buffer);
+	}
+
+	bool RHI_IndexBuffer::Unmap() const
+	{
+		if (!m_buffer)
+		{
+			LOG_ERROR_INVALID_INTERNALS();
+			return false;
+		}
+
+		return Null_Common::resource_unmap(m_buffer);
+	}
+}
+#endif
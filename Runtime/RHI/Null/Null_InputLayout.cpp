@@ -0,0 +1,65 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= IMPLEMENTATION ===============
+#include "../RHI_Implementation.h"
+#ifdef API_GRAPHICS_NULL
+//================================
+
+//= INCLUDES =====================
+#include "../RHI_InputLayout.h"
+#include "../RHI_Device.h"
+#include "../../Logging/Log.h"
+//================================
+
+//==================
+using namespace std;
+//==================
+
+namespace Spartan
+{
+	RHI_InputLayout::RHI_InputLayout(const shared_ptr<RHI_Device>& rhi_device)
+	{
+		m_rhi_device = rhi_device;
+	}
+
+	RHI_InputLayout::~RHI_InputLayout()
+	{
+		Null_Common::resource_release(m_buffer);
+	}
+
+	bool RHI_InputLayout::Create(void* vertex_shader_blob, const RHI_Vertex_Attribute_Type vertex_attributes)
+	{
+		// The blob is the vertex shader handle, there is no bytecode to validate the attributes against
+		if (!vertex_shader_blob || vertex_attributes == Vertex_Attribute_None)
+		{
+			LOG_ERROR_INVALID_PARAMETER();
+			return false;
+		}
+		m_vertex_attributes = vertex_attributes;
+
+		Null_Common::resource_release(m_buffer);
+		m_buffer = Null_Common::resource_create(m_rhi_device->GetContext());
+
+		return true;
+	}
+}
+#endif
@@ -0,0 +1,117 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= IMPLEMENTATION ===============
+#include "../RHI_Implementation.h"
+#ifdef API_GRAPHICS_NULL
+//================================
+
+//= INCLUDES ====================
+#include "../RHI_RenderTexture.h"
+#include "../RHI_Device.h"
+#include "../../Logging/Log.h"
+#include "../RHI_CommandList.h"
+//===============================
+
+//= NAMESPACES ================
+using namespace Spartan::Math;
+using namespace std;
+//=============================
+
+namespace Spartan
+{
+	RHI_RenderTexture::RHI_RenderTexture(const shared_ptr<RHI_Device>& rhi_device, unsigned int width, unsigned int height, RHI_Format texture_format, bool depth, RHI_Format depth_format, unsigned int array_size)
+	{
+		m_rhi_device	= rhi_device;
+		m_depth_enabled	= depth;
+		m_format		= texture_format;
+		m_viewport		= RHI_Viewport(0.0f, 0.0f, static_cast<float>(width), static_cast<float>(height));
+		m_width			= width;
+		m_height		= height;
+		m_array_size	= array_size;
+
+		if (!m_rhi_device || width == 0 || height == 0 || array_size == 0)
+		{
+			LOG_ERROR_INVALID_PARAMETER();
+			return;
+		}
+
+		auto context = m_rhi_device->GetContext();
+
+		// The shader resource view carries the memory, the render target views only alias it
+		m_texture_view = Null_Common::resource_create(context, static_cast<uint64_t>(width) * height * array_size * null_format_size[m_format]);
+		for (unsigned int i = 0; i < array_size; i++)
+		{
+			m_buffer_render_target_views.emplace_back(Null_Common::resource_create(context));
+		}
+
+		if (m_depth_enabled)
+		{
+			m_depth_stencil_view = Null_Common::resource_create(context, static_cast<uint64_t>(width) * height * null_format_size[depth_format]);
+		}
+	}
+
+	RHI_RenderTexture::~RHI_RenderTexture()
+	{
+		for (auto& render_target_view : m_buffer_render_target_views)
+		{
+			Null_Common::resource_release(render_target_view);
+		}
+		Null_Common::resource_release(m_texture_view);
+		Null_Common::resource_release(m_depth_stencil_view);
+	}
+
+	bool RHI_RenderTexture::Clear(shared_ptr<RHI_CommandList>& cmd_list, const Vector4& clear_color)
+	{
+		if (!m_rhi_device)
+		{
+			LOG_ERROR_INVALID_INTERNALS();
+			return false;
+		}
+
+		// Clear back buffer
+		for (auto& render_target_view : m_buffer_render_target_views)
+		{ 
+			cmd_list->ClearRenderTarget(render_target_view, clear_color); 
+		}
+
+		// Clear depth buffer
+		if (m_depth_enabled)
+		{
+			if (!m_depth_stencil_view)
+			{
+				LOG_ERROR_INVALID_INTERNALS();
+				return false;
+			}
+
+			const auto depth = Settings::Get().GetReverseZ() ? 1.0f - m_viewport.GetMaxDepth() : m_viewport.GetMaxDepth();
+			cmd_list->ClearDepthStencil(m_depth_stencil_view, Clear_Depth, depth, 0);
+		}
+
+		return true;
+	}
+
+	bool RHI_RenderTexture::Clear(shared_ptr<RHI_CommandList>& cmd_list, const float red, const float green, const float blue, const float alpha)
+	{
+		return Clear(cmd_list, Vector4(red, green, blue, alpha));
+	}
+}
+#endif
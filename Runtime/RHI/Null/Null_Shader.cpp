@@ -0,0 +1,85 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= IMPLEMENTATION ===============
+#include "../RHI_Implementation.h"
+#ifdef API_GRAPHICS_NULL
+//================================
+
+//= INCLUDES ===========================
+#include "../RHI_Device.h"
+#include "../RHI_Shader.h"
+#include "../RHI_InputLayout.h"
+#include "../../Logging/Log.h"
+#include "../../FileSystem/FileSystem.h"
+//======================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+	RHI_Shader::~RHI_Shader()
+	{
+		Null_Common::resource_release(m_vertex_shader);
+		Null_Common::resource_release(m_pixel_shader);
+	}
+
+	void* RHI_Shader::_Compile(const Shader_Type type, const string& shader, RHI_Vertex_Attribute_Type vertex_attributes /*= Vertex_Attribute_None*/)
+	{
+		if (!m_rhi_device)
+		{
+			LOG_ERROR_INVALID_INTERNALS();
+			return nullptr;
+		}
+
+		// There is no compiler, only what a compiler would reject before parsing is caught
+		const auto entry_point = (type == Shader_Vertex) ? _RHI_Shader::entry_point_vertex : _RHI_Shader::entry_point_pixel;
+		if (FileSystem::IsSupportedShaderFile(shader))
+		{
+			if (!FileSystem::FileExists(shader))
+			{
+				LOGF_ERROR("Failed to find shader \"%s\" with path \"%s\".", FileSystem::GetFileNameFromFilePath(shader).c_str(), shader.c_str());
+				return nullptr;
+			}
+		}
+		else if (shader.find(entry_point) == string::npos)
+		{
+			LOGF_ERROR("Shader source has no \"%s\" entry point", entry_point.c_str());
+			return nullptr;
+		}
+
+		void* shader_view = Null_Common::resource_create(m_rhi_device->GetContext());
+
+		// Create input layout
+		if (type == Shader_Vertex && vertex_attributes != Vertex_Attribute_None)
+		{
+			if (!m_input_layout->Create(shader_view, vertex_attributes))
+			{
+				LOGF_ERROR("Failed to create input layout for %s", FileSystem::GetFileNameFromFilePath(m_file_path).c_str());
+			}
+		}
+
+		return shader_view;
+	}
+}
+#endif
@@ -0,0 +1,123 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= IMPLEMENTATION ===============
+#include "../RHI_Implementation.h"
+#ifdef API_GRAPHICS_NULL
+//================================
+
+//= INCLUDES ===================
+#include "../RHI_SwapChain.h"
+#include "../RHI_Device.h"
+#include "../../Logging/Log.h"
+//==============================
+
+//= NAMESPACES ================
+using namespace std;
+using namespace Spartan::Math;
+//=============================
+
+namespace Spartan
+{
+	RHI_SwapChain::RHI_SwapChain(
+		void* window_handle,
+		const std::shared_ptr<RHI_Device>& device,
+		unsigned int width,
+		unsigned int height,
+		const  RHI_Format format		/*= Format_R8G8B8A8_UNORM*/,
+		RHI_Present_Mode present_mode	/*= Present_Off */,
+		const unsigned int buffer_count	/*= 1 */,
+		void* render_pass				/*= nullptr */
+	)
+	{
+		// There is nothing to present to, so any window handle will do (including none)
+		if (!device || buffer_count == 0)
+		{
+			LOG_ERROR_INVALID_PARAMETER();
+			return;
+		}
+
+		// Return if resolution is invalid
+		if (width == 0 || width > m_max_resolution || height == 0 || height > m_max_resolution)
+		{
+			LOGF_WARNING("%dx%d is an invalid resolution", width, height);
+			return;
+		}
+
+		// Save parameters
+		m_format		= format;
+		m_rhi_device	= device;
+		m_buffer_count	= buffer_count;
+		m_windowed		= true;
+		m_width			= width;
+		m_height		= height;
+		m_present_mode	= present_mode;
+		m_window_handle	= window_handle;
+
+		m_swap_chain_view		= Null_Common::resource_create(m_rhi_device->GetContext());
+		m_render_target_view	= Null_Common::resource_create(m_rhi_device->GetContext(), static_cast<uint64_t>(width) * height * buffer_count * null_format_size[format]);
+
+		m_initialized = true;
+	}
+
+	RHI_SwapChain::~RHI_SwapChain()
+	{
+		Null_Common::resource_release(m_swap_chain_view);
+		Null_Common::resource_release(m_render_target_view);
+	}
+
+	bool RHI_SwapChain::Resize(const unsigned int width, const unsigned int height)
+	{	
+		if (!m_swap_chain_view)
+		{
+			LOG_ERROR_INVALID_INTERNALS();
+			return false;
+		}
+
+		// Return if resolution is invalid
+		if (width == 0 || width > m_max_resolution || height == 0 || height > m_max_resolution)
+		{
+			LOGF_WARNING("%dx%d is an invalid resolution", width, height);
+			return false;
+		}
+
+		m_width		= width;
+		m_height	= height;
+
+		// Recreate the back buffer at the new size
+		Null_Common::resource_release(m_render_target_view);
+		m_render_target_view = Null_Common::resource_create(m_rhi_device->GetContext(), static_cast<uint64_t>(width) * height * m_buffer_count * null_format_size[m_format]);
+
+		return true;
+	}
+
+	bool RHI_SwapChain::Present(void* semaphore_wait)
+	{
+		if (!m_swap_chain_view)
+		{
+			LOG_ERROR_INVALID_INTERNALS();
+			return false;
+		}
+
+		return true;
+	}
+}
+#endif
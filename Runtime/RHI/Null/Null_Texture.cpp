@@ -0,0 +1,124 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= IMPLEMENTATION ===============
+#include "../RHI_Implementation.h"
+#ifdef API_GRAPHICS_NULL
+//================================
+
+//= INCLUDES =====================
+#include "../RHI_Device.h"
+#include "../RHI_Texture.h"
+#include "../../Math/MathHelper.h"
+//================================
+
+//= NAMESPAECES ======================
+using namespace std;
+using namespace Spartan::Math::Helper;
+//====================================
+
+namespace Spartan
+{
+	RHI_Texture::~RHI_Texture()
+	{
+		ClearTextureBytes();
+		Null_Common::resource_release(m_texture_view);
+	}
+
+	bool RHI_Texture::ShaderResource_Create2D(unsigned int width, unsigned int height, unsigned int channels, RHI_Format format, const vector<vector<std::byte>>& mipmaps)
+	{
+		if (!m_rhi_device || mipmaps.empty() || width == 0 || height == 0)
+		{
+			LOG_ERROR_INVALID_PARAMETER();
+			return false;
+		}
+
+		// Validate the mip chain, each level has to hold at least as many bytes as its dimensions need
+		uint64_t size	= 0;
+		auto mip_width	= width;
+		auto mip_height	= height;
+		for (unsigned int i = 0; i < static_cast<unsigned int>(mipmaps.size()); i++)
+		{
+			const auto size_expected = static_cast<uint64_t>(mip_width) * mip_height * channels * (m_bpc / 8);
+			if (mipmaps[i].size() < size_expected)
+			{
+				LOGF_ERROR("Mipmap %d has invalid data.", i);
+				return false;
+			}
+
+			// Compute size of next mip-map
+			mip_width	= Max(mip_width / 2, static_cast<unsigned int>(1));
+			mip_height	= Max(mip_height / 2, static_cast<unsigned int>(1));
+
+			// Compute memory usage (rough estimation)
+			m_size	+= static_cast<unsigned int>(mipmaps[i].size()) * (m_bpc / 8);
+			size	+= mipmaps[i].size();
+		}
+
+		// Generated mipmaps add a third on top of the top level
+		if (m_mipmap_support && mipmaps.size() == 1 && width >= 4 && height >= 4)
+		{
+			size += size / 3;
+		}
+
+		Null_Common::resource_release(m_texture_view);
+		m_texture_view = Null_Common::resource_create(m_rhi_device->GetContext(), size, false, mipmaps.front().data());
+		return true;
+	}
+
+	bool RHI_Texture::ShaderResource_CreateCubemap(unsigned int width, unsigned int height, unsigned int channels, RHI_Format format, const vector<vector<vector<std::byte>>>& mipmaps)
+	{
+		if (!m_rhi_device || mipmaps.size() != 6)
+		{
+			LOG_ERROR_INVALID_PARAMETER();
+			return false;
+		}
+
+		uint64_t size			= 0;
+		const auto mip_levels	= mipmaps[0].size();
+		for (const auto& side : mipmaps)
+		{
+			if (side.empty() || side.size() != mip_levels)
+			{
+				LOG_ERROR("A side contains invalid data.");
+				return false;
+			}
+
+			for (const auto& mip : side)
+			{
+				if (mip.empty())
+				{
+					LOG_ERROR("A mip-map contains invalid data.");
+					return false;
+				}
+
+				// Compute memory usage (rough estimation)
+				m_size	+= static_cast<unsigned int>(mip.size()) * (m_bpc / 8);
+				size	+= mip.size();
+			}
+		}
+
+		Null_Common::resource_release(m_texture_view);
+		m_texture_view = Null_Common::resource_create(m_rhi_device->GetContext(), size, false, mipmaps.front().front().data());
+		return true;
+	}
+}
+#endif
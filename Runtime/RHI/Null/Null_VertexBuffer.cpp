@@ -0,0 +1,88 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= IMPLEMENTATION ===============
+#include "../RHI_Implementation.h"
+#ifdef API_GRAPHICS_NULL
+//================================
+
+//= INCLUDES =====================
+#include "../RHI_Device.h"
+#include "../RHI_VertexBuffer.h"
+#include "../RHI_Vertex.h"
+#include "../../Logging/Log.h"
+//================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+	RHI_VertexBuffer::~RHI_VertexBuffer()
+	{
+		Null_Common::resource_release(m_buffer);
+	}
+
+	bool RHI_VertexBuffer::Create(const void* vertices)
+	{
+		if (!m_rhi_device)
+		{
+			LOG_ERROR_INVALID_INTERNALS();
+			return false;
+		}
+
+		if (m_vertex_count == 0 || (!m_is_dynamic && !vertices))
+		{
+			LOG_ERROR_INVALID_PARAMETER();
+			return false;
+		}
+
+		// Immutable buffers get their data once, dynamic ones get a CPU copy to map
+		Null_Common::resource_release(m_buffer);
+		m_buffer = Null_Common::resource_create(m_rhi_device->GetContext(), m_size, m_is_dynamic, m_is_dynamic ? nullptr : vertices);
+
+		return true;
+	}
+
+	void* RHI_VertexBuffer::Map() const
+	{
+		if (!m_buffer)
+		{
+			LOG_ERROR_INVALID_INTERNALS();
+			return nullptr;
+		}
+
+		return Null_Common::resource_map(m_buffer);
+	}
+
+	bool RHI_VertexBuffer::Unmap() const
+	{
+		if (!m_buffer)
+		{
+			LOG_ERROR_INVALID_INTERNALS();
+			return false;
+		}
+
+		return Null_Common::resource_unmap(m_buffer);
+	}
+}
+#endif
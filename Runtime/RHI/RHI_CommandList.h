@@ -25,6 +25,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <vector>
 #include "RHI_Definition.h"
 #include "RHI_Viewport.h"
+#include "RHI_CommandStream.h"
 #include "../Math/Rectangle.h"
 #include "../Math/Vector4.h"
 //============================
@@ -33,151 +34,18 @@ namespace Spartan
 {
 	class Profiler;
 
-	enum RHI_Cmd_Type
-	{
-		RHI_Cmd_Begin,
-		RHI_Cmd_End,
-		RHI_Cmd_Draw,
-		RHI_Cmd_DrawIndexed,
-		RHI_Cmd_SetViewport,
-		RHI_Cmd_SetScissorRectangle,
-		RHI_Cmd_SetPrimitiveTopology,
-		RHI_Cmd_SetInputLayout,
-		RHI_Cmd_SetDepthStencilState,
-		RHI_Cmd_SetRasterizerState,
-		RHI_Cmd_SetBlendState,
-		RHI_Cmd_SetVertexBuffer,
-		RHI_Cmd_SetIndexBuffer,	
-		RHI_Cmd_SetVertexShader,
-		RHI_Cmd_SetPixelShader,
-		RHI_Cmd_SetConstantBuffers,
-		RHI_Cmd_SetSamplers,
-		RHI_Cmd_SetTextures,
-		RHI_Cmd_SetRenderTargets,
-		RHI_Cmd_ClearRenderTarget,
-		RHI_Cmd_ClearDepthStencil
-	};
-
-	struct RHI_Command
-	{
-		RHI_Command()
-		{
-			// Render targets
-			render_targets.reserve(10);
-			render_targets.resize(10);
-			// Textures
-			textures.reserve(10);
-			textures.resize(10);
-			// Samplers
-			samplers.reserve(10);
-			samplers.resize(10);
-			// Constant buffers
-			constant_buffers.reserve(10);
-			constant_buffers.resize(10);
-
-			Clear();
-		}
-
-		void Clear()
-		{
-			// Render targets
-			render_target_count = 0;
-			render_targets.clear();
-			// Textures
-			textures_start_slot = 0;
-			texture_count		= 0;
-			textures.clear();
-			// Samplers
-			samplers_start_slot = 0;
-			sampler_count		= 0;
-			samplers.clear();
-			// Constant buffers
-			constant_buffers_start_slot		= 0;
-			constant_buffer_count			= 0;
-			constant_buffers_scope			= Buffer_NotAssigned;
-			constant_buffers.clear();
-			// Depth-stencil
-			RHI_DepthStencilState* depth_stencil_state	= nullptr;
-			depth_stencil								= nullptr;
-			depth_clear									= 0;
-			depth_clear_stencil							= 0;
-			depth_clear_flags							= 0;
-			// Misc
-			pass_name = "N/A";
-			primitive_topology = PrimitiveTopology_NotAssigned;
-			vertex_count = 0;
-			vertex_offset = 0;
-			index_count = 0;
-			index_offset = 0;
-			input_layout = nullptr;
-			rasterizer_state = nullptr;
-			blend_state = nullptr;
-			buffer_index = nullptr;
-			buffer_vertex = nullptr;
-			shader_vertex = nullptr;
-			shader_pixel = nullptr;
-		}
-
-		RHI_Cmd_Type type;
-
-		// Render targets
-		unsigned int render_target_count;
-		std::vector<void*> render_targets;
-		void* render_target_clear;
-		Math::Vector4 render_target_clear_color;
-
-		// Texture
-		unsigned int textures_start_slot;
-		unsigned int texture_count;
-		std::vector<void*> textures;
-
-		// Samplers
-		unsigned int samplers_start_slot;
-		unsigned int sampler_count;
-		std::vector<void*> samplers;
-
-		// Constant buffers
-		unsigned int constant_buffers_start_slot;
-		unsigned int constant_buffer_count;
-		RHI_Buffer_Scope constant_buffers_scope;
-		std::vector<void*> constant_buffers;	
-
-		// Depth
-		const RHI_DepthStencilState* depth_stencil_state	= nullptr;
-		void* depth_stencil									= nullptr;
-		float depth_clear									= 0;
-		unsigned int depth_clear_stencil					= 0;
-		unsigned int depth_clear_flags						= 0;
-
-		// Misc	
-		std::string pass_name								= "N/A";
-		RHI_PrimitiveTopology_Mode primitive_topology		= PrimitiveTopology_NotAssigned;
-		unsigned int vertex_count							= 0;
-		unsigned int vertex_offset							= 0;
-		unsigned int index_count							= 0;
-		unsigned int index_offset							= 0;	
-		RHI_Viewport viewport;
-		Math::Rectangle scissor_rectangle;
-		const RHI_InputLayout* input_layout					= nullptr;	
-		const RHI_RasterizerState* rasterizer_state			= nullptr;
-		const RHI_BlendState* blend_state					= nullptr;
-		const RHI_IndexBuffer* buffer_index					= nullptr;
-		const RHI_VertexBuffer* buffer_vertex				= nullptr;
-		const RHI_Shader* shader_vertex						= nullptr;
-		const RHI_Shader* shader_pixel						= nullptr;
-	};
-
 	class SPARTAN_CLASS RHI_CommandList
 	{
 	public:
 		RHI_CommandList(const std::shared_ptr<RHI_Device>& rhi_device, Profiler* profiler);
 		~RHI_CommandList();
 
-		void Begin(const std::string& pass_name, void* render_pass = nullptr, RHI_SwapChain* swap_chain = nullptr);
+		void Begin(const char* pass_name, void* render_pass = nullptr, RHI_SwapChain* swap_chain = nullptr);
 		void End();
 
 		void Draw(unsigned int vertex_count);
 		void DrawIndexed(unsigned int index_count, unsigned int index_offset, unsigned int vertex_offset);
+		void DrawIndexedInstanced(unsigned int index_count, unsigned int instance_count, unsigned int index_offset, unsigned int vertex_offset, unsigned int instance_offset);
 
 		void SetPipeline(const RHI_Pipeline* pipeline);
 
@@ -209,24 +77,39 @@ namespace Spartan
 		void SetShaderPixel(const RHI_Shader* shader);
 		void SetShaderPixel(const std::shared_ptr<RHI_Shader>& shader) { SetShaderPixel(shader.get()); }
 
-		void SetConstantBuffers(unsigned int start_slot, RHI_Buffer_Scope scope, const std::vector<void*>& constant_buffers);
+		// The container overloads accept any contiguous container of void* (std::vector, FrameVector)
+		void SetConstantBuffers(unsigned int start_slot, RHI_Buffer_Scope scope, void* const* constant_buffers, unsigned int constant_buffer_count);
+		template <typename Container>
+		void SetConstantBuffers(unsigned int start_slot, RHI_Buffer_Scope scope, const Container& constant_buffers) { SetConstantBuffers(start_slot, scope, constant_buffers.data(), static_cast<unsigned int>(constant_buffers.size())); }
 		void SetConstantBuffer(unsigned int start_slot, RHI_Buffer_Scope scope, const std::shared_ptr<RHI_ConstantBuffer>& constant_buffer);
+		// Binds size bytes starting at offset, both have to be multiples of 256
+		void SetConstantBuffer(unsigned int start_slot, RHI_Buffer_Scope scope, const std::shared_ptr<RHI_ConstantBuffer>& constant_buffer, unsigned int offset, unsigned int size);
 			
-		void SetSamplers(unsigned int start_slot, const std::vector<void*>& samplers);
+		void SetSamplers(unsigned int start_slot, void* const* samplers, unsigned int sampler_count);
+		template <typename Container>
+		void SetSamplers(unsigned int start_slot, const Container& samplers) { SetSamplers(start_slot, samplers.data(), static_cast<unsigned int>(samplers.size())); }
 		void SetSampler(unsigned int start_slot, const std::shared_ptr<RHI_Sampler>& sampler);
 		
-		void SetTextures(unsigned int start_slot, const std::vector<void*>& textures);
+		void SetTextures(unsigned int start_slot, void* const* textures, unsigned int texture_count);
+		template <typename Container>
+		void SetTextures(unsigned int start_slot, const Container& textures) { SetTextures(start_slot, textures.data(), static_cast<unsigned int>(textures.size())); }
 		void SetTexture(unsigned int start_slot, void* texture);
 		void SetTexture(unsigned int start_slot, const std::shared_ptr<RHI_Texture>& texture);
 		void SetTexture(unsigned int start_slot, const std::shared_ptr<RHI_RenderTexture>& texture);
 		void ClearTextures() { SetTextures(0, m_textures_empty); }
 
-		void SetRenderTargets(const std::vector<void*>& render_targets, void* depth_stencil = nullptr);
+		// Structured buffers are bound like textures, but can also be read by vertex shaders
+		void SetStructuredBuffer(unsigned int slot, RHI_Buffer_Scope scope, const std::shared_ptr<RHI_StructuredBuffer>& buffer);
+
+		void SetRenderTargets(void* const* render_targets, unsigned int render_target_count, void* depth_stencil = nullptr);
+		template <typename Container>
+		void SetRenderTargets(const Container& render_targets, void* depth_stencil = nullptr) { SetRenderTargets(render_targets.data(), static_cast<unsigned int>(render_targets.size()), depth_stencil); }
 		void SetRenderTarget(void* render_target, void* depth_stencil = nullptr);
 		void SetRenderTarget(const std::shared_ptr<RHI_RenderTexture>&, void* depth_stencil = nullptr);
 
 		void ClearRenderTarget(void* render_target, const Math::Vector4& color);
-		void ClearRenderTargets(const std::vector<void*>& render_targets, const Math::Vector4& color)
+		template <typename Container>
+		void ClearRenderTargets(const Container& render_targets, const Math::Vector4& color)
 		{
 			for (const auto& render_target : render_targets)
 			{
@@ -235,6 +118,10 @@ namespace Spartan
 		}
 		void ClearDepthStencil(void* depth_stencil, unsigned int flags, float depth, unsigned int stencil = 0);
 
+		// Records the commands of a list which was recorded on another thread, which is left empty for reuse.
+		// Lists recorded in parallel have to be executed in the order their commands should run in.
+		void ExecuteCommandList(RHI_CommandList* cmd_list);
+
 		bool Submit();
 		const auto& GetSemaphoreRenderFinished() { return !m_semaphores_render_finished.empty() ? m_semaphores_render_finished[m_current_frame] : nullptr; }
 
@@ -244,13 +131,9 @@ namespace Spartan
 		RHI_SwapChain* m_swap_chain = nullptr;
 
 		// D3D11
-		RHI_Command& GetCmd();
-		std::vector<RHI_Command> m_commands;
-		unsigned int m_initial_capacity = 2500;
-		unsigned int m_command_count	= 0;
+		RHI_CommandStream m_stream;
 
 		// Vulkan
-		RHI_Command m_empty_cmd; // for GetCmd()
 		void* m_cmd_pool				= nullptr;
 		unsigned int m_current_frame	= 0;
 		bool m_is_recording				= false;
@@ -0,0 +1,379 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ==================
+#include "RHI_CommandStream.h"
+#include <cstring>
+//=============================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+	namespace
+	{
+		const uint32_t initial_capacity = 64 * 1024; // bytes, a frame's worth of commands
+
+		bool stage_vertex(const RHI_Buffer_Scope scope)	{ return scope == Buffer_VertexShader || scope == Buffer_Global; }
+		bool stage_pixel(const RHI_Buffer_Scope scope)	{ return scope == Buffer_PixelShader || scope == Buffer_Global; }
+
+		// Records the commands it's replayed with into another stream, which filters them against its own state
+		struct Recorder
+		{
+			RHI_CommandStream& stream;
+
+			void Begin(const RHI_Cmd::Begin& cmd)									{ stream.Begin(cmd.name); }
+			void End()																{ stream.End(); }
+			void Draw(const RHI_Cmd::Draw& cmd)										{ stream.Draw(cmd.vertex_count); }
+			void DrawIndexed(const RHI_Cmd::DrawIndexed& cmd)						{ stream.DrawIndexed(cmd.index_count, cmd.index_offset, cmd.vertex_offset); }
+			void DrawIndexedInstanced(const RHI_Cmd::DrawIndexedInstanced& cmd)		{ stream.DrawIndexedInstanced(cmd.index_count, cmd.instance_count, cmd.index_offset, cmd.vertex_offset, cmd.instance_offset); }
+			void SetViewport(const RHI_Cmd::Viewport& cmd)							{ stream.SetViewport(cmd); }
+			void SetScissorRectangle(const RHI_Cmd::ScissorRectangle& cmd)			{ stream.SetScissorRectangle(cmd); }
+			void SetPrimitiveTopology(const RHI_Cmd::PrimitiveTopology& cmd)		{ stream.SetPrimitiveTopology(cmd.mode); }
+			void SetState(const RHI_Cmd_Type type, const RHI_Cmd::State& cmd)		{ stream.SetState(type, cmd.object, cmd.identity); }
+			void SetConstantBuffers(const RHI_Cmd::Bindings& cmd)					{ stream.SetConstantBuffers(cmd.start_slot, cmd.scope, cmd.Objects(), cmd.count, cmd.offset, cmd.size); }
+			void SetSamplers(const RHI_Cmd::Bindings& cmd)							{ stream.SetSamplers(cmd.start_slot, cmd.Objects(), cmd.count); }
+			void SetTextures(const RHI_Cmd::Bindings& cmd)							{ stream.SetTextures(cmd.start_slot, cmd.scope, cmd.Objects(), cmd.count); }
+			void SetRenderTargets(const RHI_Cmd::RenderTargets& cmd)				{ stream.SetRenderTargets(cmd.Objects(), cmd.count, cmd.depth_stencil); }
+			void ClearRenderTarget(const RHI_Cmd::ClearRenderTarget& cmd)			{ stream.ClearRenderTarget(cmd.render_target, cmd.color); }
+			void ClearDepthStencil(const RHI_Cmd::ClearDepthStencil& cmd)			{ stream.ClearDepthStencil(cmd.depth_stencil, cmd.flags, cmd.depth, cmd.stencil); }
+		};
+	}
+
+	RHI_CommandStream::RHI_CommandStream()
+	{
+		m_buffer.resize(initial_capacity);
+		ResetShadow();
+	}
+
+	void RHI_CommandStream::Begin(const char* name)
+	{
+		Write<RHI_Cmd::Begin>(RHI_Cmd_Begin)->name = name;
+	}
+
+	void RHI_CommandStream::End()
+	{
+		Write<RHI_Cmd::Begin>(RHI_Cmd_End)->name = nullptr;
+	}
+
+	void RHI_CommandStream::Draw(const uint32_t vertex_count)
+	{
+		Write<RHI_Cmd::Draw>(RHI_Cmd_Draw)->vertex_count = vertex_count;
+	}
+
+	void RHI_CommandStream::DrawIndexed(const uint32_t index_count, const uint32_t index_offset, const uint32_t vertex_offset)
+	{
+		*Write<RHI_Cmd::DrawIndexed>(RHI_Cmd_DrawIndexed) = { index_count, index_offset, vertex_offset };
+	}
+
+	void RHI_CommandStream::DrawIndexedInstanced(const uint32_t index_count, const uint32_t instance_count, const uint32_t index_offset, const uint32_t vertex_offset, const uint32_t instance_offset)
+	{
+		*Write<RHI_Cmd::DrawIndexedInstanced>(RHI_Cmd_DrawIndexedInstanced) = { index_count, instance_count, index_offset, vertex_offset, instance_offset };
+	}
+
+	void RHI_CommandStream::SetViewport(const RHI_Cmd::Viewport& viewport)
+	{
+		if (m_shadow_viewport_known && memcmp(&m_shadow_viewport, &viewport, sizeof(RHI_Cmd::Viewport)) == 0)
+		{
+			m_binds_eliminated++;
+			return;
+		}
+
+		*Write<RHI_Cmd::Viewport>(RHI_Cmd_SetViewport)	= viewport;
+		m_shadow_viewport								= viewport;
+		m_shadow_viewport_known							= true;
+	}
+
+	void RHI_CommandStream::SetScissorRectangle(const RHI_Cmd::ScissorRectangle& scissor_rectangle)
+	{
+		if (m_shadow_scissor_known && memcmp(&m_shadow_scissor, &scissor_rectangle, sizeof(RHI_Cmd::ScissorRectangle)) == 0)
+		{
+			m_binds_eliminated++;
+			return;
+		}
+
+		*Write<RHI_Cmd::ScissorRectangle>(RHI_Cmd_SetScissorRectangle)	= scissor_rectangle;
+		m_shadow_scissor												= scissor_rectangle;
+		m_shadow_scissor_known											= true;
+	}
+
+	void RHI_CommandStream::SetPrimitiveTopology(const RHI_PrimitiveTopology_Mode mode)
+	{
+		if (mode != PrimitiveTopology_NotAssigned && mode == m_shadow_topology)
+		{
+			m_binds_eliminated++;
+			return;
+		}
+
+		Write<RHI_Cmd::PrimitiveTopology>(RHI_Cmd_SetPrimitiveTopology)->mode	= mode;
+		m_shadow_topology														= mode;
+	}
+
+	void RHI_CommandStream::SetState(const RHI_Cmd_Type type, const void* object, const void* identity)
+	{
+		if (m_shadow_states_known[type] && m_shadow_states[type] == identity)
+		{
+			m_binds_eliminated++;
+			return;
+		}
+
+		*Write<RHI_Cmd::State>(type)	= { object, identity };
+		m_shadow_states[type]			= identity;
+		m_shadow_states_known[type]		= true;
+	}
+
+	void RHI_CommandStream::SetConstantBuffers(const uint32_t start_slot, const RHI_Buffer_Scope scope, void* const* buffers, const uint32_t count, const uint32_t offset /*= 0*/, const uint32_t size /*= 0*/)
+	{
+		const bool stages[m_stage_count] = { stage_vertex(scope), stage_pixel(scope) };
+
+		// Redundant only if every slot of every stage it touches already holds the same range
+		bool redundant = (stages[0] || stages[1]) && start_slot + count <= m_slot_count;
+		for (uint32_t stage = 0; stage < m_stage_count && redundant; stage++)
+		{
+			if (!stages[stage])
+				continue;
+
+			for (uint32_t i = 0; i < count && redundant; i++)
+			{
+				const uint32_t slot				= start_slot + i;
+				const ShadowConstantBuffer& cb	= m_shadow_constant_buffers[stage][slot];
+				redundant = (m_shadow_constant_buffers_known[stage] & (1u << slot)) && cb.buffer == buffers[i] && cb.offset == offset && cb.size == size;
+			}
+		}
+
+		if (redundant)
+		{
+			m_binds_eliminated++;
+			return;
+		}
+
+		auto cmd		= Write<RHI_Cmd::Bindings>(RHI_Cmd_SetConstantBuffers, count * sizeof(void*));
+		*cmd			= { start_slot, count, scope, offset, size, 0 };
+		memcpy(const_cast<void**>(cmd->Objects()), buffers, count * sizeof(void*));
+
+		for (uint32_t stage = 0; stage < m_stage_count; stage++)
+		{
+			if (!stages[stage])
+				continue;
+
+			for (uint32_t i = 0; i < count && start_slot + i < m_slot_count; i++)
+			{
+				const uint32_t slot								= start_slot + i;
+				m_shadow_constant_buffers[stage][slot]			= { buffers[i], offset, size };
+				m_shadow_constant_buffers_known[stage]			|= 1u << slot;
+			}
+		}
+	}
+
+	void RHI_CommandStream::SetSamplers(uint32_t start_slot, void* const* samplers, uint32_t count)
+	{
+		// Skip the leading and trailing slots which already hold the same sampler
+		while (count != 0 && start_slot < m_slot_count && (m_shadow_samplers_known & (1u << start_slot)) && m_shadow_samplers[start_slot] == samplers[0])
+		{
+			start_slot++;
+			samplers++;
+			count--;
+		}
+		while (count != 0)
+		{
+			const uint32_t slot = start_slot + count - 1;
+			if (slot >= m_slot_count || !(m_shadow_samplers_known & (1u << slot)) || m_shadow_samplers[slot] != samplers[count - 1])
+				break;
+			count--;
+		}
+
+		if (count == 0)
+		{
+			m_binds_eliminated++;
+			return;
+		}
+
+		auto cmd	= Write<RHI_Cmd::Bindings>(RHI_Cmd_SetSamplers, count * sizeof(void*));
+		*cmd		= { start_slot, count, Buffer_PixelShader, 0, 0, 0 };
+		memcpy(const_cast<void**>(cmd->Objects()), samplers, count * sizeof(void*));
+
+		for (uint32_t i = 0; i < count && start_slot + i < m_slot_count; i++)
+		{
+			m_shadow_samplers[start_slot + i]	= samplers[i];
+			m_shadow_samplers_known				|= 1u << (start_slot + i);
+		}
+	}
+
+	void RHI_CommandStream::SetTextures(uint32_t start_slot, const RHI_Buffer_Scope scope, void* const* textures, uint32_t count)
+	{
+		const bool stages[m_stage_count] = { stage_vertex(scope), stage_pixel(scope) };
+		const auto slot_redundant = [this, &stages](const uint32_t slot, void* texture)
+		{
+			if (slot >= m_slot_count)
+				return false;
+
+			for (uint32_t stage = 0; stage < m_stage_count; stage++)
+			{
+				if (stages[stage] && (!(m_shadow_textures_known[stage] & (1u << slot)) || m_shadow_textures[stage][slot] != texture))
+					return false;
+			}
+
+			return true;
+		};
+
+		// Skip the leading and trailing slots which already hold the same texture, clearing the
+		// textures binds a whole range of nulls, most of which are usually unbound already
+		if (stages[0] || stages[1])
+		{
+			while (count != 0 && slot_redundant(start_slot, textures[0]))
+			{
+				start_slot++;
+				textures++;
+				count--;
+			}
+			while (count != 0 && slot_redundant(start_slot + count - 1, textures[count - 1]))
+			{
+				count--;
+			}
+
+			if (count == 0)
+			{
+				m_binds_eliminated++;
+				return;
+			}
+		}
+
+		auto cmd	= Write<RHI_Cmd::Bindings>(RHI_Cmd_SetTextures, count * sizeof(void*));
+		*cmd		= { start_slot, count, scope, 0, 0, 0 };
+		memcpy(const_cast<void**>(cmd->Objects()), textures, count * sizeof(void*));
+
+		for (uint32_t stage = 0; stage < m_stage_count; stage++)
+		{
+			if (!stages[stage])
+				continue;
+
+			for (uint32_t i = 0; i < count && start_slot + i < m_slot_count; i++)
+			{
+				m_shadow_textures[stage][start_slot + i]	= textures[i];
+				m_shadow_textures_known[stage]				|= 1u << (start_slot + i);
+			}
+		}
+	}
+
+	void RHI_CommandStream::SetRenderTargets(void* const* render_targets, const uint32_t count, void* depth_stencil)
+	{
+		if (m_shadow_render_targets_known && m_shadow_render_target_count == count && m_shadow_depth_stencil == depth_stencil && memcmp(m_shadow_render_targets, render_targets, count * sizeof(void*)) == 0)
+		{
+			m_binds_eliminated++;
+			return;
+		}
+
+		auto cmd			= Write<RHI_Cmd::RenderTargets>(RHI_Cmd_SetRenderTargets, count * sizeof(void*));
+		cmd->count			= count;
+		cmd->depth_stencil	= depth_stencil;
+		memcpy(const_cast<void**>(cmd->Objects()), render_targets, count * sizeof(void*));
+
+		m_shadow_render_targets_known = count <= m_target_count;
+		if (m_shadow_render_targets_known)
+		{
+			memcpy(m_shadow_render_targets, render_targets, count * sizeof(void*));
+			m_shadow_render_target_count	= count;
+			m_shadow_depth_stencil			= depth_stencil;
+		}
+
+		// The device unbinds shader resources which are now bound as outputs, so the textures can't be trusted anymore
+		for (auto& known : m_shadow_textures_known)
+		{
+			known = 0;
+		}
+	}
+
+	void RHI_CommandStream::ClearRenderTarget(void* render_target, const float* color)
+	{
+		auto cmd			= Write<RHI_Cmd::ClearRenderTarget>(RHI_Cmd_ClearRenderTarget);
+		cmd->render_target	= render_target;
+		memcpy(cmd->color, color, sizeof(cmd->color));
+	}
+
+	void RHI_CommandStream::ClearDepthStencil(void* depth_stencil, const uint32_t flags, const float depth, const uint32_t stencil)
+	{
+		*Write<RHI_Cmd::ClearDepthStencil>(RHI_Cmd_ClearDepthStencil) = { depth_stencil, flags, depth, stencil };
+	}
+
+	void RHI_CommandStream::Append(const RHI_CommandStream& other)
+	{
+		// Going through the recording functions again drops what the other stream couldn't know was redundant,
+		// e.g. the state a range of draws binds up front which the preceding range had already bound
+		Recorder recorder = { *this };
+		other.Replay(recorder);
+		m_binds_eliminated += other.m_binds_eliminated;
+	}
+
+	void RHI_CommandStream::Clear()
+	{
+		m_size				= 0;
+		m_command_count		= 0;
+		m_binds_eliminated	= 0;
+		ResetShadow();
+	}
+
+	template<typename T>
+	T* RHI_CommandStream::Write(const RHI_Cmd_Type type, const uint32_t extra_size /*= 0*/)
+	{
+		// Keep every command 8 byte aligned, so the payloads (and the pointers in them) are too
+		const uint32_t size = (sizeof(RHI_Cmd::Header) + sizeof(T) + extra_size + 7) & ~7u;
+
+		// Grow, the memory is kept across submissions so this only happens for the first few frames
+		if (m_size + size > m_buffer.size())
+		{
+			m_buffer.resize((m_size + size) * 2);
+		}
+
+		auto header		= reinterpret_cast<RHI_Cmd::Header*>(m_buffer.data() + m_size);
+		header->type	= type;
+		header->size	= static_cast<uint16_t>(size);
+		header->padding	= 0;
+
+		m_size += size;
+		m_command_count++;
+		return reinterpret_cast<T*>(header + 1);
+	}
+
+	void RHI_CommandStream::ResetShadow()
+	{
+		for (uint32_t i = 0; i < RHI_Cmd_Count; i++)
+		{
+			m_shadow_states[i]			= nullptr;
+			m_shadow_states_known[i]	= false;
+		}
+
+		for (uint32_t stage = 0; stage < m_stage_count; stage++)
+		{
+			m_shadow_constant_buffers_known[stage]	= 0;
+			m_shadow_textures_known[stage]			= 0;
+		}
+
+		m_shadow_viewport_known			= false;
+		m_shadow_scissor_known			= false;
+		m_shadow_topology				= PrimitiveTopology_NotAssigned;
+		m_shadow_samplers_known			= 0;
+		m_shadow_render_targets_known	= false;
+		m_shadow_render_target_count	= 0;
+		m_shadow_depth_stencil			= nullptr;
+	}
+}
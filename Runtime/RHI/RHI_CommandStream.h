@@ -0,0 +1,216 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ==================
+#include <vector>
+#include <cstdint>
+#include "RHI_Definition.h"
+#include "../Core/EngineDefs.h"
+//=============================
+
+namespace Spartan
+{
+	enum RHI_Cmd_Type : uint16_t
+	{
+		RHI_Cmd_Begin,
+		RHI_Cmd_End,
+		RHI_Cmd_Draw,
+		RHI_Cmd_DrawIndexed,
+		RHI_Cmd_DrawIndexedInstanced,
+		RHI_Cmd_SetViewport,
+		RHI_Cmd_SetScissorRectangle,
+		RHI_Cmd_SetPrimitiveTopology,
+		RHI_Cmd_SetInputLayout,
+		RHI_Cmd_SetDepthStencilState,
+		RHI_Cmd_SetRasterizerState,
+		RHI_Cmd_SetBlendState,
+		RHI_Cmd_SetVertexBuffer,
+		RHI_Cmd_SetIndexBuffer,	
+		RHI_Cmd_SetVertexShader,
+		RHI_Cmd_SetPixelShader,
+		RHI_Cmd_SetConstantBuffers,
+		RHI_Cmd_SetSamplers,
+		RHI_Cmd_SetTextures,
+		RHI_Cmd_SetRenderTargets,
+		RHI_Cmd_ClearRenderTarget,
+		RHI_Cmd_ClearDepthStencil,
+		RHI_Cmd_Count
+	};
+
+	// The payloads of the commands, plain data so they can be copied into the stream
+	namespace RHI_Cmd
+	{
+		struct Header
+		{
+			RHI_Cmd_Type type;
+			uint16_t size; // of the whole command, header included
+			uint32_t padding;
+		};
+
+		struct Begin					{ const char* name; }; // has to outlive the stream, e.g. frame allocated
+		struct Draw						{ uint32_t vertex_count; };
+		struct DrawIndexed				{ uint32_t index_count; uint32_t index_offset; uint32_t vertex_offset; };
+		struct DrawIndexedInstanced		{ uint32_t index_count; uint32_t instance_count; uint32_t index_offset; uint32_t vertex_offset; uint32_t instance_offset; };
+		struct Viewport					{ float x; float y; float width; float height; float depth_min; float depth_max; };
+		struct ScissorRectangle			{ float x; float y; float width; float height; };
+		struct PrimitiveTopology		{ RHI_PrimitiveTopology_Mode mode; };
+		struct ClearRenderTarget		{ void* render_target; float color[4]; };
+		struct ClearDepthStencil		{ void* depth_stencil; uint32_t flags; float depth; uint32_t stencil; };
+
+		// Input layout, depth-stencil/rasterizer/blend state, vertex/index buffer or shader, the command type tells which
+		struct State					{ const void* object; const void* identity; };
+
+		// Constant buffers, samplers and textures, followed by count API objects
+		struct Bindings
+		{
+			uint32_t start_slot;
+			uint32_t count;
+			RHI_Buffer_Scope scope;
+			uint32_t offset;	// constant buffers only, in bytes
+			uint32_t size;		// constant buffers only, in bytes, 0 for the whole buffer
+			uint32_t padding;	// keeps the objects pointer aligned
+			void* const* Objects() const { return reinterpret_cast<void* const*>(this + 1); }
+		};
+
+		// Followed by count render target views
+		struct RenderTargets
+		{
+			uint32_t count;
+			void* depth_stencil;
+			void* const* Objects() const { return reinterpret_cast<void* const*>(this + 1); }
+		};
+	}
+
+	// A command list recorded as variable-length POD commands into a single byte buffer, which is reused
+	// from submission to submission. The stream shadows the state its commands leave the device in and drops
+	// binds which wouldn't change it. The state is considered unknown again after Clear(), since other code
+	// can touch the device in between submissions.
+	class SPARTAN_CLASS RHI_CommandStream
+	{
+	public:
+		RHI_CommandStream();
+
+		//= RECORDING =====================================================================================================================================
+		void Begin(const char* name);
+		void End();
+		void Draw(uint32_t vertex_count);
+		void DrawIndexed(uint32_t index_count, uint32_t index_offset, uint32_t vertex_offset);
+		void DrawIndexedInstanced(uint32_t index_count, uint32_t instance_count, uint32_t index_offset, uint32_t vertex_offset, uint32_t instance_offset);
+		void SetViewport(const RHI_Cmd::Viewport& viewport);
+		void SetScissorRectangle(const RHI_Cmd::ScissorRectangle& scissor_rectangle);
+		void SetPrimitiveTopology(RHI_PrimitiveTopology_Mode mode);
+		// For the commands with an RHI_Cmd::State payload, identity is what redundancy is checked against, e.g. the
+		// API buffer behind a wrapper, so that a wrapper which re-created its buffer is bound again
+		void SetState(RHI_Cmd_Type type, const void* object, const void* identity);
+		void SetConstantBuffers(uint32_t start_slot, RHI_Buffer_Scope scope, void* const* buffers, uint32_t count, uint32_t offset = 0, uint32_t size = 0);
+		void SetSamplers(uint32_t start_slot, void* const* samplers, uint32_t count);
+		void SetTextures(uint32_t start_slot, RHI_Buffer_Scope scope, void* const* textures, uint32_t count);
+		void SetRenderTargets(void* const* render_targets, uint32_t count, void* depth_stencil);
+		void ClearRenderTarget(void* render_target, const float* color);
+		void ClearDepthStencil(void* depth_stencil, uint32_t flags, float depth, uint32_t stencil);
+		//=================================================================================================================================================
+
+		// Calls sink.Execute(payload) for every command, in the order they were recorded
+		template<typename Sink>
+		void Replay(Sink& sink) const
+		{
+			const uint8_t* cursor	= m_buffer.data();
+			const uint8_t* end		= cursor + m_size;
+			while (cursor < end)
+			{
+				const auto header	= reinterpret_cast<const RHI_Cmd::Header*>(cursor);
+				const auto payload	= cursor + sizeof(RHI_Cmd::Header);
+				switch (header->type)
+				{
+					case RHI_Cmd_Begin:					sink.Begin(*reinterpret_cast<const RHI_Cmd::Begin*>(payload));									break;
+					case RHI_Cmd_End:					sink.End();																						break;
+					case RHI_Cmd_Draw:					sink.Draw(*reinterpret_cast<const RHI_Cmd::Draw*>(payload));									break;
+					case RHI_Cmd_DrawIndexed:			sink.DrawIndexed(*reinterpret_cast<const RHI_Cmd::DrawIndexed*>(payload));						break;
+					case RHI_Cmd_DrawIndexedInstanced:	sink.DrawIndexedInstanced(*reinterpret_cast<const RHI_Cmd::DrawIndexedInstanced*>(payload));	break;
+					case RHI_Cmd_SetViewport:			sink.SetViewport(*reinterpret_cast<const RHI_Cmd::Viewport*>(payload));							break;
+					case RHI_Cmd_SetScissorRectangle:	sink.SetScissorRectangle(*reinterpret_cast<const RHI_Cmd::ScissorRectangle*>(payload));			break;
+					case RHI_Cmd_SetPrimitiveTopology:	sink.SetPrimitiveTopology(*reinterpret_cast<const RHI_Cmd::PrimitiveTopology*>(payload));		break;
+					case RHI_Cmd_SetConstantBuffers:	sink.SetConstantBuffers(*reinterpret_cast<const RHI_Cmd::Bindings*>(payload));					break;
+					case RHI_Cmd_SetSamplers:			sink.SetSamplers(*reinterpret_cast<const RHI_Cmd::Bindings*>(payload));							break;
+					case RHI_Cmd_SetTextures:			sink.SetTextures(*reinterpret_cast<const RHI_Cmd::Bindings*>(payload));							break;
+					case RHI_Cmd_SetRenderTargets:		sink.SetRenderTargets(*reinterpret_cast<const RHI_Cmd::RenderTargets*>(payload));				break;
+					case RHI_Cmd_ClearRenderTarget:		sink.ClearRenderTarget(*reinterpret_cast<const RHI_Cmd::ClearRenderTarget*>(payload));			break;
+					case RHI_Cmd_ClearDepthStencil:		sink.ClearDepthStencil(*reinterpret_cast<const RHI_Cmd::ClearDepthStencil*>(payload));			break;
+					default:							sink.SetState(header->type, *reinterpret_cast<const RHI_Cmd::State*>(payload));					break;
+				}
+				cursor += header->size;
+			}
+		}
+
+		// Records the commands of another stream after the ones of this stream, as if they had been recorded here.
+		// Streams recorded in parallel and appended in order are identical to recording the same commands serially.
+		void Append(const RHI_CommandStream& other);
+
+		// Drops the commands, keeping the memory, and forgets the shadowed state
+		void Clear();
+
+		unsigned int GetCommandCount() const	{ return m_command_count; }
+		unsigned int GetSize() const			{ return m_size; }
+		// Binds dropped as redundant since the last Clear()
+		unsigned int GetBindsEliminated() const	{ return m_binds_eliminated; }
+
+	private:
+		// Appends a command and returns its payload, extra_size bytes follow the payload
+		template<typename T>
+		T* Write(RHI_Cmd_Type type, uint32_t extra_size = 0);
+		void ResetShadow();
+
+		std::vector<uint8_t> m_buffer;
+		unsigned int m_size				= 0;
+		unsigned int m_command_count	= 0;
+		unsigned int m_binds_eliminated	= 0;
+
+		// Shadowed state, the slot arrays only cover what the engine uses, binds beyond them are never dropped
+		static const uint32_t m_slot_count		= 16;
+		static const uint32_t m_stage_count		= 2; // vertex, pixel
+		static const uint32_t m_target_count	= 8;
+		struct ShadowConstantBuffer
+		{
+			void* buffer;
+			uint32_t offset;
+			uint32_t size;
+		};
+		const void* m_shadow_states[RHI_Cmd_Count];
+		bool m_shadow_states_known[RHI_Cmd_Count];
+		RHI_Cmd::Viewport m_shadow_viewport;
+		bool m_shadow_viewport_known;
+		RHI_Cmd::ScissorRectangle m_shadow_scissor;
+		bool m_shadow_scissor_known;
+		RHI_PrimitiveTopology_Mode m_shadow_topology;
+		ShadowConstantBuffer m_shadow_constant_buffers[m_stage_count][m_slot_count];
+		void* m_shadow_samplers[m_slot_count];
+		void* m_shadow_textures[m_stage_count][m_slot_count];
+		uint32_t m_shadow_constant_buffers_known[m_stage_count];	// bit per slot
+		uint32_t m_shadow_samplers_known;							// bit per slot
+		uint32_t m_shadow_textures_known[m_stage_count];			// bit per slot
+		void* m_shadow_render_targets[m_target_count];
+		uint32_t m_shadow_render_target_count;
+		void* m_shadow_depth_stencil;
+		bool m_shadow_render_targets_known;
+	};
+}
@@ -46,7 +46,15 @@ namespace Spartan
 			return _Create();
 		}
 
-		void* Map() const;
+		// For buffers which are sub-allocated, e.g. the pages of a ConstantRing
+		bool Create(const unsigned int size)
+		{
+			m_size = size;
+			return _Create();
+		}
+
+		// Without discarding, the caller promises to only write parts of the buffer that pending draws don't read
+		void* Map(bool discard = true) const;
 		bool Unmap() const;
 		auto GetBufferView() const	{ return m_buffer; }
 		auto GetSize()	const		{ return m_size; }
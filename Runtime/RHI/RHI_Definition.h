@@ -38,6 +38,7 @@ namespace Spartan
 	class RHI_VertexBuffer;
 	class RHI_IndexBuffer;
 	class RHI_ConstantBuffer;
+	class RHI_StructuredBuffer;
 	class RHI_Sampler;
 	class RHI_Viewport;
 	class RHI_RenderTexture;
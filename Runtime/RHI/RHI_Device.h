@@ -100,11 +100,15 @@ namespace Spartan
 		const DisplayAdapter* GetPrimaryAdapter()				{ return m_primaryAdapter; }
 		//=======================================================================================================================================
 
-		auto IsInitialized() const	{ return m_initialized; }
-		auto GetContext() const		{ return m_rhi_context; }
+		auto IsInitialized() const							{ return m_initialized; }
+		auto IsConstantBufferOffsettingSupported() const	{ return m_constant_buffer_offsetting; }
+		auto IsCommandListMergingSupported() const			{ return m_command_list_merging; } // RHI_CommandList::ExecuteCommandList() replays the other list
+		auto GetContext() const								{ return m_rhi_context; }
 
 	private:	
 		bool m_initialized						= false;
+		bool m_constant_buffer_offsetting		= false;
+		bool m_command_list_merging				= false;
 		RHI_Context* m_rhi_context				= nullptr;
 		const DisplayAdapter* m_primaryAdapter	= nullptr;
 		std::vector<DisplayMode> m_displayModes;
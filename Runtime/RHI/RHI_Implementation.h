@@ -139,6 +139,7 @@ namespace Spartan
 	{
 		ID3D11Device* device					= nullptr;
 		ID3D11DeviceContext* device_context		= nullptr;
+		ID3D11DeviceContext1* device_context_1	= nullptr; // binds constant buffers by offset, null without D3D11.1
 		ID3DUserDefinedAnnotation* annotation	= nullptr;
 	};
 }
@@ -280,4 +281,55 @@ namespace Spartan
 #include "Vulkan/Vulkan_Common.h"
 #endif // VULKAN
 
+// NULL
+#if defined(API_GRAPHICS_NULL)
+#include <atomic>
+
+// Bytes per pixel, in the order of RHI_Format
+static const unsigned int null_format_size[] =
+{
+	1,	// R8_UNORM
+	2,	// R16_UINT
+	2,	// R16_FLOAT
+	4,	// R32_UINT
+	4,	// R32_FLOAT
+	4,	// D32_FLOAT
+
+	2,	// R8G8_UNORM
+	4,	// R16G16_FLOAT
+	8,	// R32G32_FLOAT
+
+	12,	// R32G32B32_FLOAT
+
+	4,	// R8G8B8A8_UNORM
+	8,	// R16G16B16A16_FLOAT
+	16	// R32G32B32A32_FLOAT
+};
+
+namespace Spartan
+{
+	// Nothing reaches a GPU, the context keeps track of what would have. Resources are created from
+	// worker threads too (shader compilation, asset loading), hence the atomics.
+	struct RHI_Context
+	{
+		std::atomic<uint64_t> resource_count	= 0;
+		std::atomic<uint64_t> resource_memory	= 0; // bytes
+		std::atomic<uint64_t> upload_count		= 0; // initial data and maps
+		std::atomic<uint64_t> upload_memory		= 0; // bytes
+
+		// Stands in for the immediate context, what submitted commands left bound. Only the
+		// counts of bound buffers are kept, the buffers themselves may be gone by the next draw.
+		uint32_t vertex_count			= 0; // 0 when no vertex buffer is bound
+		uint32_t index_count			= 0; // 0 when no index buffer is bound
+		uint32_t render_target_count	= 0;
+		uint32_t event_depth			= 0; // Begin() calls without an End() yet
+		bool input_layout				= false;
+		bool vertex_shader				= false;
+		bool depth_stencil				= false;
+		bool viewport					= false;
+	};
+}
+#include "Null/Null_Common.h"
+#endif // NULL
+
 #endif // RUNTIME
\ No newline at end of file
@@ -57,6 +57,8 @@ namespace Spartan
 		static const std::string shader_model		= "5_0";
 		#elif defined(API_GRAPHICS_VULKAN)
 		static const std::string shader_model		= "6_0";
+		#elif defined(API_GRAPHICS_NULL)
+		static const std::string shader_model		= "5_0";
 		#endif
 	}
 
@@ -0,0 +1,87 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ==================
+#include <memory>
+#include "RHI_Object.h"
+#include "RHI_Definition.h"
+#include "../Core/EngineDefs.h"
+//=============================
+
+namespace Spartan
+{
+	// A buffer of structures which shaders read as a StructuredBuffer<T>, it's bound like a texture
+	class SPARTAN_CLASS RHI_StructuredBuffer : public RHI_Object
+	{
+	public:
+		RHI_StructuredBuffer(const std::shared_ptr<RHI_Device>& rhi_device)
+		{
+			m_rhi_device = rhi_device;
+		}
+		~RHI_StructuredBuffer();
+
+		// Can be called again to resize the buffer, the previous contents are lost
+		template<typename T>
+		bool Create(const unsigned int element_count)
+		{
+			m_stride		= static_cast<unsigned int>(sizeof(T));
+			m_element_count	= element_count;
+			m_size			= static_cast<uint64_t>(m_stride) * element_count;
+			return _Create();
+		}
+
+		// Recreates the buffer with the next power of two that fits element_count, if it doesn't fit already
+		template<typename T>
+		bool Reserve(const unsigned int element_count)
+		{
+			if (element_count <= m_element_count && m_stride == sizeof(T))
+				return true;
+
+			unsigned int element_count_new = m_element_count ? m_element_count : 1;
+			while (element_count_new < element_count)
+			{
+				element_count_new *= 2;
+			}
+
+			return Create<T>(element_count_new);
+		}
+
+		void* Map() const;
+		bool Unmap() const;
+		auto GetBufferView() const		{ return m_buffer_view; }
+		auto GetStride() const			{ return m_stride; }
+		auto GetElementCount() const	{ return m_element_count; }
+
+	private:
+		bool _Create();
+
+		std::shared_ptr<RHI_Device> m_rhi_device;
+		unsigned int m_stride			= 0;
+		unsigned int m_element_count	= 0;
+
+		// API
+		void* m_buffer			= nullptr;
+		void* m_buffer_view		= nullptr;
+		void* m_buffer_memory	= nullptr;
+	};
+}
@@ -102,7 +102,7 @@ namespace Spartan
 		m_cmd_pool = nullptr;
 	}
 
-	void RHI_CommandList::Begin(const string& pass_name, void* render_pass, RHI_SwapChain* swap_chain)
+	void RHI_CommandList::Begin(const char* pass_name, void* render_pass, RHI_SwapChain* swap_chain)
 	{
 		if (!render_pass || !swap_chain)
 		{
@@ -184,6 +184,14 @@ namespace Spartan
 		vkCmdDrawIndexed(CMD_BUFFER_VK, index_count, 1, index_offset, vertex_offset, 0);
 	}
 
+	void RHI_CommandList::DrawIndexedInstanced(unsigned int index_count, unsigned int instance_count, unsigned int index_offset, unsigned int vertex_offset, unsigned int instance_offset)
+	{
+		if (!m_is_recording)
+			return;
+
+		vkCmdDrawIndexed(CMD_BUFFER_VK, index_count, instance_count, index_offset, vertex_offset, instance_offset);
+	}
+
 	void RHI_CommandList::SetPipeline(const RHI_Pipeline* pipeline)
 	{
 		if (!m_is_recording)
@@ -298,7 +306,7 @@ namespace Spartan
 			return;
 	}
 
-	void RHI_CommandList::SetConstantBuffers(unsigned int start_slot, RHI_Buffer_Scope scope, const vector<void*>& constant_buffers)
+	void RHI_CommandList::SetConstantBuffers(unsigned int start_slot, RHI_Buffer_Scope scope, void* const* constant_buffers, unsigned int constant_buffer_count)
 	{
 		if (!m_is_recording)
 			return;
@@ -311,7 +319,14 @@ namespace Spartan
 
 	}
 
-	void RHI_CommandList::SetSamplers(unsigned int start_slot, const vector<void*>& samplers)
+	void RHI_CommandList::SetConstantBuffer(unsigned int start_slot, RHI_Buffer_Scope scope, const shared_ptr<RHI_ConstantBuffer>& constant_buffer, unsigned int offset, unsigned int size)
+	{
+		if (!m_is_recording)
+			return;
+
+	}
+
+	void RHI_CommandList::SetSamplers(unsigned int start_slot, void* const* samplers, unsigned int sampler_count)
 	{
 		if (!m_is_recording)
 			return;
@@ -323,7 +338,7 @@ namespace Spartan
 			return;
 	}
 
-	void RHI_CommandList::SetTextures(unsigned int start_slot, const vector<void*>& textures)
+	void RHI_CommandList::SetTextures(unsigned int start_slot, void* const* textures, unsigned int texture_count)
 	{
 		if (!m_is_recording)
 			return;
@@ -347,7 +362,13 @@ namespace Spartan
 		SetTexture(start_slot, texture->GetBufferView());
 	}
 
-	void RHI_CommandList::SetRenderTargets(const vector<void*>& render_targets, void* depth_stencil /*= nullptr*/)
+	void RHI_CommandList::SetStructuredBuffer(unsigned int slot, RHI_Buffer_Scope scope, const shared_ptr<RHI_StructuredBuffer>& buffer)
+	{
+		if (!m_is_recording)
+			return;
+	}
+
+	void RHI_CommandList::SetRenderTargets(void* const* render_targets, unsigned int render_target_count, void* depth_stencil /*= nullptr*/)
 	{
 		if (!m_is_recording)
 			return;
@@ -377,6 +398,15 @@ namespace Spartan
 			return;
 	}
 
+	void RHI_CommandList::ExecuteCommandList(RHI_CommandList* cmd_list)
+	{
+		if (!m_is_recording)
+			return;
+
+		// Maps to vkCmdExecuteCommands, once the lists recorded in parallel allocate secondary command buffers.
+		// Until then the device doesn't report merging support and the renderer records everything on one list.
+	}
+
 	bool RHI_CommandList::Submit()
 	{
 		// Ensure the command list has stopped recording
@@ -413,11 +443,6 @@ namespace Spartan
 		return result == VK_SUCCESS;
 	}
 
-	RHI_Command& RHI_CommandList::GetCmd()
-	{
-		return m_empty_cmd;
-	}
-
 	void RHI_CommandList::Clear()
 	{
 
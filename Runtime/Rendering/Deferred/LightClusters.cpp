@@ -0,0 +1,302 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES =========================
+#include "LightClusters.h"
+#include <cmath>
+#include "../../Threading/Threading.h"
+//====================================
+
+//= NAMESPACES ========================
+using namespace std;
+using namespace Spartan::Math;
+using namespace Spartan::Math::Helper;
+//=====================================
+
+namespace Spartan
+{
+	namespace
+	{
+		bool SphereIntersectsBox(const Vector3& center, const float radius, const Vector3& box_min, const Vector3& box_max)
+		{
+			float distance_squared = 0.0f;
+			for (unsigned int i = 0; i < 3; i++)
+			{
+				const float v = (&center.x)[i];
+				if (v < (&box_min.x)[i]) distance_squared += ((&box_min.x)[i] - v) * ((&box_min.x)[i] - v);
+				if (v > (&box_max.x)[i]) distance_squared += (v - (&box_max.x)[i]) * (v - (&box_max.x)[i]);
+			}
+
+			return distance_squared <= radius * radius;
+		}
+
+		unsigned int ToTile(const float ndc, const unsigned int tile_count)
+		{
+			const float tile = (ndc * 0.5f + 0.5f) * static_cast<float>(tile_count);
+			return static_cast<unsigned int>(Clamp(tile, 0.0f, static_cast<float>(tile_count - 1)));
+		}
+	}
+
+	LightClusters::LightClusters(const unsigned int tiles_x, const unsigned int tiles_y, const unsigned int slices)
+	{
+		m_tiles_x	= Max(1u, tiles_x);
+		m_tiles_y	= Max(1u, tiles_y);
+		m_slices	= Max(1u, slices);
+
+		const unsigned int cluster_count = m_tiles_x * m_tiles_y * m_slices;
+		m_cluster_min.resize(cluster_count);
+		m_cluster_max.resize(cluster_count);
+		m_cluster_lights.resize(cluster_count);
+		m_clusters.resize(cluster_count);
+		m_slice_lights.resize(m_slices);
+	}
+
+	void LightClusters::Build(const Matrix& view, const Matrix& projection, const float near_plane, const float far_plane, const vector<Light>& lights, Threading* threading)
+	{
+		const auto parallel_for = [threading](const unsigned int count, const unsigned int grain_size, auto&& function)
+		{
+			if (threading)
+			{
+				threading->ParallelFor(count, function, grain_size, Job_Critical);
+			}
+			else
+			{
+				function(0u, count);
+			}
+		};
+
+		// Exponential slices, so clusters far away aren't much longer than they are wide
+		const float near_clamped	= Max(near_plane, M_EPSILON);
+		const float far_clamped		= Max(far_plane, near_clamped * 2.0f);
+		if (near_clamped != m_near_plane || far_clamped != m_far_plane || !(projection == m_projection))
+		{
+			m_near_plane	= near_clamped;
+			m_far_plane		= far_clamped;
+			m_slice_scale	= static_cast<float>(m_slices) / logf(m_far_plane / m_near_plane);
+			m_slice_bias	= -logf(m_near_plane) * m_slice_scale;
+			ComputeClusterBounds(projection);
+		}
+
+		// View space bounds of every light, and the range of clusters they can touch
+		const auto light_count = static_cast<unsigned int>(lights.size());
+		m_light_bounds.resize(light_count);
+		parallel_for(light_count, 256, [this, &lights, &view, &projection](const unsigned int start, const unsigned int end)
+		{
+			for (unsigned int i = start; i < end; i++)
+			{
+				ComputeLightBounds(lights[i], view, projection, m_light_bounds[i]);
+			}
+		});
+
+		// Bucket the lights by the slices they overlap, in order, so the cluster lists come out sorted
+		for (auto& slice_lights : m_slice_lights)
+		{
+			slice_lights.clear();
+		}
+		for (unsigned int i = 0; i < light_count; i++)
+		{
+			const auto& bounds = m_light_bounds[i];
+			if (!bounds.visible)
+				continue;
+
+			for (unsigned int slice = bounds.slice_min; slice <= bounds.slice_max; slice++)
+			{
+				m_slice_lights[slice].emplace_back(i);
+			}
+		}
+
+		// Bin, a row of tiles of a slice per job so no two jobs write the same cluster
+		const unsigned int row_count = m_slices * m_tiles_y;
+		parallel_for(row_count, 1, [this](const unsigned int start, const unsigned int end)
+		{
+			for (unsigned int row = start; row < end; row++)
+			{
+				const unsigned int slice	= row / m_tiles_y;
+				const unsigned int tile_y	= row % m_tiles_y;
+				const unsigned int first	= GetClusterIndex(0, tile_y, slice);
+
+				for (unsigned int tile_x = 0; tile_x < m_tiles_x; tile_x++)
+				{
+					m_cluster_lights[first + tile_x].clear();
+				}
+
+				for (const auto light_index : m_slice_lights[slice])
+				{
+					const auto& bounds = m_light_bounds[light_index];
+					if (tile_y < bounds.tile_min_y || tile_y > bounds.tile_max_y)
+						continue;
+
+					for (unsigned int tile_x = bounds.tile_min_x; tile_x <= bounds.tile_max_x; tile_x++)
+					{
+						const unsigned int cluster = first + tile_x;
+						if (SphereIntersectsBox(bounds.center, bounds.radius, m_cluster_min[cluster], m_cluster_max[cluster]))
+						{
+							m_cluster_lights[cluster].emplace_back(light_index);
+						}
+					}
+				}
+			}
+		});
+
+		// Compact the per cluster lists into a single one
+		uint32_t offset = 0;
+		for (unsigned int i = 0; i < static_cast<unsigned int>(m_clusters.size()); i++)
+		{
+			m_clusters[i].offset	= offset;
+			m_clusters[i].count		= static_cast<uint32_t>(m_cluster_lights[i].size());
+			offset					+= m_clusters[i].count;
+		}
+
+		m_light_indices.resize(offset);
+		parallel_for(static_cast<unsigned int>(m_clusters.size()), 64, [this](const unsigned int start, const unsigned int end)
+		{
+			for (unsigned int i = start; i < end; i++)
+			{
+				copy(m_cluster_lights[i].begin(), m_cluster_lights[i].end(), m_light_indices.begin() + m_clusters[i].offset);
+			}
+		});
+	}
+
+	unsigned int LightClusters::GetClusterIndex(const Vector3& position_view) const
+	{
+		const Vector3 position_ndc	= m_projection * position_view;
+		const float slice			= Clamp(floorf(logf(Max(position_view.z, m_near_plane)) * m_slice_scale + m_slice_bias), 0.0f, static_cast<float>(m_slices - 1));
+
+		return GetClusterIndex(ToTile(position_ndc.x, m_tiles_x), ToTile(position_ndc.y, m_tiles_y), static_cast<unsigned int>(slice));
+	}
+
+	void LightClusters::ComputeClusterBounds(const Matrix& projection)
+	{
+		m_projection = projection;
+
+		// Every tile corner is a line in view space, found by unprojecting two points of it
+		const Matrix projection_inverted	= projection.Inverted();
+		const unsigned int corners_x		= m_tiles_x + 1;
+		const unsigned int corners_y		= m_tiles_y + 1;
+		vector<Vector3> line_start(corners_x * corners_y);
+		vector<Vector3> line_direction(corners_x * corners_y);
+		for (unsigned int y = 0; y < corners_y; y++)
+		{
+			for (unsigned int x = 0; x < corners_x; x++)
+			{
+				const float ndc_x	= static_cast<float>(x) / m_tiles_x * 2.0f - 1.0f;
+				const float ndc_y	= static_cast<float>(y) / m_tiles_y * 2.0f - 1.0f;
+				const Vector3 a		= projection_inverted * Vector3(ndc_x, ndc_y, 0.0f);
+				const Vector3 b		= projection_inverted * Vector3(ndc_x, ndc_y, 1.0f);
+
+				line_start[y * corners_x + x]		= a;
+				line_direction[y * corners_x + x]	= (b - a) / (b.z - a.z);
+			}
+		}
+
+		// A cluster is bounded by its 4 corner lines, cut at the depths of its slice
+		for (unsigned int slice = 0; slice < m_slices; slice++)
+		{
+			const float depth[2] = { GetSliceDepth(slice), GetSliceDepth(slice + 1) };
+			for (unsigned int tile_y = 0; tile_y < m_tiles_y; tile_y++)
+			{
+				for (unsigned int tile_x = 0; tile_x < m_tiles_x; tile_x++)
+				{
+					Vector3 box_min = Vector3::Infinity;
+					Vector3 box_max = Vector3::InfinityNeg;
+					for (unsigned int corner = 0; corner < 4; corner++)
+					{
+						const unsigned int line = (tile_y + corner / 2) * corners_x + tile_x + corner % 2;
+						for (const float z : depth)
+						{
+							const Vector3 point = line_start[line] + line_direction[line] * (z - line_start[line].z);
+							box_min = Vector3(Min(box_min.x, point.x), Min(box_min.y, point.y), Min(box_min.z, point.z));
+							box_max = Vector3(Max(box_max.x, point.x), Max(box_max.y, point.y), Max(box_max.z, point.z));
+						}
+					}
+
+					const unsigned int cluster	= GetClusterIndex(tile_x, tile_y, slice);
+					m_cluster_min[cluster]		= box_min;
+					m_cluster_max[cluster]		= box_max;
+				}
+			}
+		}
+	}
+
+	void LightClusters::ComputeLightBounds(const Light& light, const Matrix& view, const Matrix& projection, LightBounds& bounds) const
+	{
+		// Bounding sphere of the lit volume, for spot lights it's the one of the cone
+		Vector3 center	= light.position;
+		float radius	= light.range;
+		if (light.type == Light_Spot)
+		{
+			const float angle_cos = Clamp(1.0f - light.angle, 0.0f, 1.0f);
+			if (angle_cos < 0.70710678f) // wider than 45 degrees
+			{
+				center	= light.position + light.direction * (light.range * angle_cos);
+				radius	= light.range * Sqrt(1.0f - angle_cos * angle_cos);
+			}
+			else
+			{
+				radius	= light.range / (2.0f * angle_cos);
+				center	= light.position + light.direction * radius;
+			}
+		}
+
+		bounds.center	= view * center;
+		bounds.radius	= radius;
+		bounds.visible	= false;
+
+		const float z_min = Max(bounds.center.z - radius, m_near_plane);
+		const float z_max = Min(bounds.center.z + radius, m_far_plane);
+		if (z_min > z_max)
+			return;
+
+		// Screen rectangle of the sphere's box, the part of it in front of the near plane projects without wrapping around
+		float ndc_min_x = INFINITY, ndc_min_y = INFINITY;
+		float ndc_max_x = -INFINITY, ndc_max_y = -INFINITY;
+		for (unsigned int corner = 0; corner < 8; corner++)
+		{
+			const Vector3 point_view
+			(
+				bounds.center.x + ((corner & 1) ? radius : -radius),
+				bounds.center.y + ((corner & 2) ? radius : -radius),
+				(corner & 4) ? z_max : z_min
+			);
+			const Vector3 point_ndc = projection * point_view;
+			ndc_min_x = Min(ndc_min_x, point_ndc.x);
+			ndc_min_y = Min(ndc_min_y, point_ndc.y);
+			ndc_max_x = Max(ndc_max_x, point_ndc.x);
+			ndc_max_y = Max(ndc_max_y, point_ndc.y);
+		}
+
+		if (ndc_max_x < -1.0f || ndc_min_x > 1.0f || ndc_max_y < -1.0f || ndc_min_y > 1.0f)
+			return;
+
+		bounds.tile_min_x	= ToTile(ndc_min_x, m_tiles_x);
+		bounds.tile_max_x	= ToTile(ndc_max_x, m_tiles_x);
+		bounds.tile_min_y	= ToTile(ndc_min_y, m_tiles_y);
+		bounds.tile_max_y	= ToTile(ndc_max_y, m_tiles_y);
+		bounds.slice_min	= static_cast<unsigned int>(Clamp(floorf(logf(z_min) * m_slice_scale + m_slice_bias), 0.0f, static_cast<float>(m_slices - 1)));
+		bounds.slice_max	= static_cast<unsigned int>(Clamp(floorf(logf(z_max) * m_slice_scale + m_slice_bias), 0.0f, static_cast<float>(m_slices - 1)));
+		bounds.visible		= true;
+	}
+
+	float LightClusters::GetSliceDepth(const unsigned int slice) const
+	{
+		return m_near_plane * powf(m_far_plane / m_near_plane, static_cast<float>(slice) / m_slices);
+	}
+}
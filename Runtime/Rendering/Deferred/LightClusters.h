@@ -0,0 +1,124 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES =======================
+#include <vector>
+#include "../../Core/EngineDefs.h"
+#include "../../Math/Matrix.h"
+#include "../../Math/Vector3.h"
+//==================================
+
+namespace Spartan
+{
+	class Threading;
+
+	// Clustered light assignment. The view frustum is split into tiles on screen and exponential slices in depth (froxels),
+	// point and spot lights are binned into every cluster their bounding sphere touches, a slice row per job.
+	// The result is an offset/count per cluster into a compact list of light indices, which the light pass walks per pixel.
+	class SPARTAN_CLASS LightClusters
+	{
+	public:
+		enum Light_Type : uint32_t
+		{
+			Light_Point,
+			Light_Spot
+		};
+
+		// Matches the structured buffer layout the light shader reads
+		struct Light
+		{
+			Math::Vector3 position;
+			float range;
+			Math::Vector3 color;
+			float intensity;
+			Math::Vector3 direction;
+			float angle;
+			uint32_t type;
+			float padding[3];
+		};
+
+		struct Cluster
+		{
+			uint32_t offset;
+			uint32_t count;
+		};
+
+		LightClusters(unsigned int tiles_x = 16, unsigned int tiles_y = 8, unsigned int slices = 24);
+		~LightClusters() = default;
+
+		// Bins the lights (in world space) into the clusters of the given view, runs the jobs on threading if given
+		void Build(const Math::Matrix& view, const Math::Matrix& projection, float near_plane, float far_plane, const std::vector<Light>& lights, Threading* threading = nullptr);
+
+		// Cluster which contains a view space position, the shader does the same math
+		unsigned int GetClusterIndex(const Math::Vector3& position_view) const;
+		unsigned int GetClusterIndex(unsigned int tile_x, unsigned int tile_y, unsigned int slice) const { return (slice * m_tiles_y + tile_y) * m_tiles_x + tile_x; }
+		// The slice of a view space depth is log(depth) * scale + bias
+		float GetSliceScale() const									{ return m_slice_scale; }
+		float GetSliceBias() const									{ return m_slice_bias; }
+
+		unsigned int GetTilesX() const								{ return m_tiles_x; }
+		unsigned int GetTilesY() const								{ return m_tiles_y; }
+		unsigned int GetSlices() const								{ return m_slices; }
+		const std::vector<Cluster>& GetClusters() const				{ return m_clusters; }
+		const std::vector<uint32_t>& GetLightIndices() const		{ return m_light_indices; }
+		const std::vector<Math::Vector3>& GetClusterMin() const		{ return m_cluster_min; }
+		const std::vector<Math::Vector3>& GetClusterMax() const		{ return m_cluster_max; }
+
+	private:
+		// View space bounding sphere of a light and the clusters it can touch
+		struct LightBounds
+		{
+			Math::Vector3 center;
+			float radius;
+			unsigned int tile_min_x, tile_max_x;
+			unsigned int tile_min_y, tile_max_y;
+			unsigned int slice_min, slice_max;
+			bool visible;
+		};
+
+		void ComputeClusterBounds(const Math::Matrix& projection);
+		void ComputeLightBounds(const Light& light, const Math::Matrix& view, const Math::Matrix& projection, LightBounds& bounds) const;
+		float GetSliceDepth(unsigned int slice) const;
+
+		unsigned int m_tiles_x;
+		unsigned int m_tiles_y;
+		unsigned int m_slices;
+		float m_near_plane	= 0.0f;
+		float m_far_plane	= 0.0f;
+		float m_slice_scale	= 0.0f;
+		float m_slice_bias	= 0.0f;
+
+		// View space bounds of every cluster, only recomputed when the projection changes
+		Math::Matrix m_projection;
+		std::vector<Math::Vector3> m_cluster_min;
+		std::vector<Math::Vector3> m_cluster_max;
+
+		std::vector<LightBounds> m_light_bounds;
+		// Lights whose depth range overlaps each slice
+		std::vector<std::vector<uint32_t>> m_slice_lights;
+		// Lights of each cluster, kept between builds so their memory is reused
+		std::vector<std::vector<uint32_t>> m_cluster_lights;
+		std::vector<Cluster> m_clusters;
+		std::vector<uint32_t> m_light_indices;
+	};
+}
@@ -22,6 +22,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES ================================
 #include "ShaderLight.h"
 #include "../../RHI/RHI_ConstantBuffer.h"
+#include "../../RHI/RHI_StructuredBuffer.h"
 #include "../../World/Entity.h"
 #include "../../World/Components/Light.h"
 #include "../../World/Components/Transform.h"
@@ -35,19 +36,51 @@ using namespace Spartan::Math;
 
 namespace Spartan
 {
+	namespace
+	{
+		// Copies data into a structured buffer, growing it to the next power of two when it doesn't fit
+		template<typename T>
+		bool Upload(const shared_ptr<RHI_StructuredBuffer>& buffer, const vector<T>& data)
+		{
+			if (!buffer->template Reserve<T>(static_cast<unsigned int>(data.size())))
+				return false;
+
+			auto mapped = static_cast<T*>(buffer->Map());
+			if (!mapped)
+			{
+				LOG_ERROR("Failed to map buffer.");
+				return false;
+			}
+
+			copy(data.begin(), data.end(), mapped);
+			return buffer->Unmap();
+		}
+	}
+
 	ShaderLight::ShaderLight(const std::shared_ptr<RHI_Device>& rhi_device) : RHI_Shader(rhi_device)
 	{
 		m_constant_buffer = make_shared<RHI_ConstantBuffer>(rhi_device);
 		m_constant_buffer->Create<LightBuffer>();
+
+		m_buffer_lights			= make_shared<RHI_StructuredBuffer>(rhi_device);
+		m_buffer_clusters		= make_shared<RHI_StructuredBuffer>(rhi_device);
+		m_buffer_light_indices	= make_shared<RHI_StructuredBuffer>(rhi_device);
+		m_buffer_lights->Create<LightClusters::Light>(64);
+		m_buffer_clusters->Create<LightClusters::Cluster>(static_cast<unsigned int>(m_clusters.GetClusters().size()));
+		m_buffer_light_indices->Create<uint32_t>(1024);
 	}
 
 	void ShaderLight::UpdateConstantBuffer(
 		const Matrix& mViewProjection_Orthographic,
 		const Matrix& mView,
 		const Matrix& mProjection,
+		const Matrix& mProjection_Unjittered,
+		const float near_plane,
+		const float far_plane,
 		const vector<Entity*>& lights,
-		bool doSSR
-	) const
+		bool doSSR,
+		Threading* threading
+	)
 	{
 		if (GetCompilationState() != Shader_Compiled)
 			return;
@@ -55,89 +88,64 @@ namespace Spartan
 		if (lights.empty())
 			return;
 
-		// Get a pointer to the data in the constant buffer.
-		auto buffer = static_cast<LightBuffer*>(m_constant_buffer->Map());
-		if (!buffer)
-		{
-			LOG_ERROR(" Failed to map buffer.");
-			return;
-		}
-
-		buffer->mvp						= mViewProjection_Orthographic;
-		buffer->viewProjectionInverse	= (mView * mProjection).Inverted();
-
-		// Reset any light buffer values because the shader will still use them
-		buffer->dirLightColor = Vector4::Zero;
-		buffer->dirLightDirection = Vector4::Zero;
-		buffer->dirLightIntensity = Vector4::Zero;
-		for (auto i = 0; i < maxLights; i++)
-		{
-			buffer->pointLightPosition[i]		= Vector4::Zero;
-			buffer->pointLightColor[i]			= Vector4::Zero;
-			buffer->pointLightIntenRange[i]		= Vector4::Zero;
-			buffer->spotLightPosition[i]		= Vector4::Zero;
-			buffer->spotLightColor[i]			= Vector4::Zero;
-			buffer->spotLightIntenRangeAngle[i] = Vector4::Zero;
-		}
-
-		// Fill with directional lights
+		// Gather the lights, the directional one goes to the constant buffer and the rest get clustered
+		Vector4 dir_light_color		= Vector4::Zero;
+		Vector4 dir_light_intensity	= Vector4::Zero;
+		Vector4 dir_light_direction	= Vector4::Zero;
+		m_lights.clear();
 		for (const auto& light : lights)
 		{
-			auto component = light->GetComponent<Light>();
+			auto component			= light->GetComponent_PtrRaw<Light>();
+			const auto direction	= component->GetDirection();
 
-			if (component->GetLightType() != LightType_Directional)
+			if (component->GetLightType() == LightType_Directional)
+			{
+				dir_light_color		= component->GetColor();
+				dir_light_intensity	= Vector4(component->GetIntensity());
+				dir_light_direction	= Vector4(direction.x, direction.y, direction.z, 0.0f);
 				continue;
-
-			const auto direction = component->GetDirection();
-
-			buffer->dirLightColor		= component->GetColor();
-			buffer->dirLightIntensity	= Vector4(component->GetIntensity());
-			buffer->dirLightDirection	= Vector4(direction.x, direction.y, direction.z, 0.0f);
+			}
+
+			const auto color	= component->GetColor();
+			auto& data			= m_lights.emplace_back();
+			data.position		= light->GetTransform_PtrRaw()->GetPosition();
+			data.range			= component->GetRange();
+			data.color			= Vector3(color.x, color.y, color.z);
+			data.intensity		= component->GetIntensity();
+			data.direction		= direction;
+			data.angle			= component->GetAngle();
+			data.type			= component->GetLightType() == LightType_Spot ? LightClusters::Light_Spot : LightClusters::Light_Point;
 		}
 
-		// Fill with point lights
-		auto point_index = 0;
-		for (const auto& light : lights)
-		{
-			auto component = light->GetComponent<Light>();
-
-			if (component->GetLightType() != LightType_Point)
-				continue;
+		// Clustered without the TAA jitter, which would change the projection and rebuild the clusters every frame
+		m_clusters.Build(mView, mProjection_Unjittered, near_plane, far_plane, m_lights, threading);
 
-			const auto pos = light->GetTransform_PtrRaw()->GetPosition();
-
-			buffer->pointLightPosition[point_index]		= Vector4(pos.x, pos.y, pos.z, 1.0f);
-			buffer->pointLightColor[point_index]		= component->GetColor();
-			buffer->pointLightIntenRange[point_index]	= Vector4(component->GetIntensity(), component->GetRange(), 0.0f, 0.0f);
-
-			point_index++;
-		}
+		// Upload the clusters
+		if (!m_lights.empty() && !Upload(m_buffer_lights, m_lights))
+			return;
+		if (!Upload(m_buffer_clusters, m_clusters.GetClusters()))
+			return;
+		if (!m_clusters.GetLightIndices().empty() && !Upload(m_buffer_light_indices, m_clusters.GetLightIndices()))
+			return;
 
-		// Fill with spot lights
-		auto spot_index = 0;
-		for (const auto& light : lights)
+		// Get a pointer to the data in the constant buffer.
+		auto buffer = static_cast<LightBuffer*>(m_constant_buffer->Map());
+		if (!buffer)
 		{
-			auto component = light->GetComponent<Light>();
-
-			if (component->GetLightType() != LightType_Spot)
-				continue;
-
-			const auto direction	= component->GetDirection();
-			const auto pos			= light->GetTransform_PtrRaw()->GetPosition();
-
-			buffer->spotLightColor[spot_index]				= component->GetColor();
-			buffer->spotLightPosition[spot_index]			= Vector4(pos.x, pos.y, pos.z, 1.0f);
-			buffer->spotLightDirection[spot_index]			= Vector4(direction.x, direction.y, direction.z, 0.0f);
-			buffer->spotLightIntenRangeAngle[spot_index]	= Vector4(component->GetIntensity(), component->GetRange(), component->GetAngle(), 0.0f);
-
-			spot_index++;
+			LOG_ERROR(" Failed to map buffer.");
+			return;
 		}
 
-		buffer->pointLightCount = static_cast<float>(point_index);
-		buffer->spotLightCount	= static_cast<float>(spot_index);
-		buffer->padding			= Vector2(doSSR ? 1.0f : 0.0f, 0.0f);
+		buffer->mvp						= mViewProjection_Orthographic;
+		buffer->viewProjectionInverse	= (mView * mProjection).Inverted();
+		buffer->dirLightColor			= dir_light_color;
+		buffer->dirLightIntensity		= dir_light_intensity;
+		buffer->dirLightDirection		= dir_light_direction;
+		buffer->clusterGrid				= Vector4(static_cast<float>(m_clusters.GetTilesX()), static_cast<float>(m_clusters.GetTilesY()), static_cast<float>(m_clusters.GetSlices()), static_cast<float>(m_lights.size()));
+		buffer->clusterSlicing			= Vector2(m_clusters.GetSliceScale(), m_clusters.GetSliceBias());
+		buffer->padding					= Vector2(doSSR ? 1.0f : 0.0f, 0.0f);
 
 		// Unmap buffer
 		m_constant_buffer->Unmap();
 	}
-}
+}
\ No newline at end of file
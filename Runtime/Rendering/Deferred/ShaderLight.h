@@ -27,12 +27,14 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../../Math/Vector4.h"
 #include "../../RHI/RHI_Shader.h"
 #include "../../RHI/RHI_Definition.h"
+#include "LightClusters.h"
 #include <vector>
 //===================================
 
 namespace Spartan
 {
 	class Entity;
+	class Threading;
 
 	class ShaderLight : public RHI_Shader
 	{
@@ -40,17 +42,25 @@ namespace Spartan
 		ShaderLight(const std::shared_ptr<RHI_Device>& rhi_device);
 		~ShaderLight() = default;
 
+		// Bins the point and spot lights into clusters and uploads them, the light pass reads them from the structured buffers
 		void UpdateConstantBuffer(
 			const Math::Matrix& mViewProjection_Orthographic,
 			const Math::Matrix& mView,
 			const Math::Matrix& mProjection,
+			const Math::Matrix& mProjection_Unjittered,
+			float near_plane,
+			float far_plane,
 			const std::vector<Entity*>& lights,
-			bool doSSR
-		) const;
-		const auto& GetConstantBuffer() { return m_constant_buffer; }
+			bool doSSR,
+			Threading* threading
+		);
+		const auto& GetConstantBuffer()		{ return m_constant_buffer; }
+		const auto& GetBufferLights()		{ return m_buffer_lights; }
+		const auto& GetBufferClusters()		{ return m_buffer_clusters; }
+		const auto& GetBufferLightIndices()	{ return m_buffer_light_indices; }
+		const auto& GetClusters() const		{ return m_clusters; }
 
 	private:
-		const static int maxLights = 64;
 		struct LightBuffer
 		{
 			Math::Matrix mvp;
@@ -58,19 +68,17 @@ namespace Spartan
 			Math::Vector4 dirLightColor;
 			Math::Vector4 dirLightIntensity;
 			Math::Vector4 dirLightDirection;
-			Math::Vector4 pointLightPosition[maxLights];
-			Math::Vector4 pointLightColor[maxLights];
-			Math::Vector4 pointLightIntenRange[maxLights];
-			Math::Vector4 spotLightColor[maxLights];
-			Math::Vector4 spotLightPosition[maxLights];
-			Math::Vector4 spotLightDirection[maxLights];
-			Math::Vector4 spotLightIntenRangeAngle[maxLights];
-			float pointLightCount;
-			float spotLightCount;
+			Math::Vector4 clusterGrid;		// tiles x, tiles y, slices, light count
+			Math::Vector2 clusterSlicing;	// slice scale, slice bias
 			Math::Vector2 padding;
 		};
 
+		LightClusters m_clusters;
+		std::vector<LightClusters::Light> m_lights;
 		std::shared_ptr<RHI_ConstantBuffer> m_constant_buffer;
+		std::shared_ptr<RHI_StructuredBuffer> m_buffer_lights;
+		std::shared_ptr<RHI_StructuredBuffer> m_buffer_clusters;
+		std::shared_ptr<RHI_StructuredBuffer> m_buffer_light_indices;
 		std::shared_ptr<RHI_Device> m_rhiDevice;
 	};
 }
\ No newline at end of file
@@ -22,6 +22,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #pragma once
 
 //= INCLUDES ======================
+#include <memory>
 #include "Transform_Enums.h"
 #include "../../Core/EngineDefs.h"
 #include "../../Math/Matrix.h"
@@ -120,8 +120,8 @@ namespace Spartan
 		xml->AddNode("Material");
 		xml->AddAttribute("Material", "Name",					GetResourceName());
 		xml->AddAttribute("Material", "Path",					GetResourceFilePath());
-		xml->AddAttribute("Material", "Cull_Mode",				unsigned int(m_cull_mode));	
-		xml->AddAttribute("Material", "Shading_Mode",			unsigned int(m_shading_mode));
+		xml->AddAttribute("Material", "Cull_Mode",				static_cast<unsigned int>(m_cull_mode));	
+		xml->AddAttribute("Material", "Shading_Mode",			static_cast<unsigned int>(m_shading_mode));
 		xml->AddAttribute("Material", "Color",					m_color_albedo);
 		xml->AddAttribute("Material", "Roughness_Multiplier",	m_roughness_multiplier);
 		xml->AddAttribute("Material", "Metallic_Multiplier",	m_metallic_multiplier);
@@ -43,8 +43,8 @@ namespace Spartan
 	unsigned int Mesh::Geometry_MemoryUsage()
 	{
 		unsigned int size = 0;
-		size += unsigned int(m_vertices.size()	* sizeof(RHI_Vertex_PosUvNorTan));
-		size += unsigned int(m_indices.size()	* sizeof(unsigned int));
+		size += static_cast<unsigned int>(m_vertices.size()	* sizeof(RHI_Vertex_PosUvNorTan));
+		size += static_cast<unsigned int>(m_indices.size()	* sizeof(unsigned int));
 
 		return size;
 	}
@@ -35,6 +35,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../RHI/RHI_IndexBuffer.h"
 #include "../RHI/RHI_Texture.h"
 #include "../Resource/ResourceCache.h"
+#include "../Threading/Threading.h"
+#include "../Math/TriangleBvh.h"
 //=========================================
 
 //= NAMESPACES ================
@@ -137,7 +139,39 @@ namespace Spartan
 
 		GeometryCreateBuffers();
 		m_normalized_scale	= GeometryComputeNormalizedScale();
-		m_aabb				= BoundingBox(m_mesh->Vertices_Get());
+		m_aabb				= GeometryComputeAabb();
+
+		// The geometry changed, hierarchies will be rebuilt when needed
+		lock_guard<mutex> guard(m_bvh_mutex);
+		m_bvhs.clear();
+	}
+
+	shared_ptr<TriangleBvh> Model::GeometryBvh(const unsigned int index_offset, const unsigned int index_count, const unsigned int vertex_offset)
+	{
+		const auto& indices		= m_mesh->Indices_Get();
+		const auto& vertices	= m_mesh->Vertices_Get();
+		if (index_count == 0 || index_offset + index_count > indices.size() || vertex_offset >= vertices.size())
+			return nullptr;
+
+		lock_guard<mutex> guard(m_bvh_mutex);
+
+		auto& bvh = m_bvhs[(static_cast<uint64_t>(index_offset) << 32) | index_count];
+		if (!bvh)
+		{
+			bvh = make_shared<TriangleBvh>(vertices.data() + vertex_offset, indices.data() + index_offset, index_count);
+		}
+
+		return bvh;
+	}
+
+	const vector<unsigned int>& Model::GeometryIndices() const
+	{
+		return m_mesh->Indices_Get();
+	}
+
+	const vector<RHI_Vertex_PosUvNorTan>& Model::GeometryVertices() const
+	{
+		return m_mesh->Vertices_Get();
 	}
 
 	void Model::AddMaterial(shared_ptr<Material>& material, const shared_ptr<Entity>& entity)
@@ -326,6 +360,16 @@ namespace Spartan
 		return 1.0f / scale_offset;
 	}
 
+	BoundingBox Model::GeometryComputeAabb() const
+	{
+		// Compute the AABB of vertex ranges in parallel and merge them
+		const auto& vertices = m_mesh->Vertices_Get();
+		return m_context->GetSubsystem<Threading>()->ParallelReduce(static_cast<unsigned int>(vertices.size()), BoundingBox(),
+			[&vertices](const unsigned int start, const unsigned int end, BoundingBox& aabb) { aabb.Merge(BoundingBox(vertices.data() + start, end - start)); },
+			[](BoundingBox& aabb, const BoundingBox& aabb_range) { aabb.Merge(aabb_range); }
+		);
+	}
+
 	unsigned int Model::GeometryComputeMemoryUsage() const
 	{
 		// Vertices & Indices
@@ -24,6 +24,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES =====================
 #include <memory>
 #include <vector>
+#include <mutex>
+#include <unordered_map>
 #include "Material.h"
 #include "../RHI/RHI_Definition.h"
 #include "../Resource/IResource.h"
@@ -40,6 +42,7 @@ namespace Spartan
 	namespace Math
 	{
 		class BoundingBox;
+		class TriangleBvh;
 	}
 
 	class SPARTAN_CLASS Model : public IResource
@@ -73,6 +76,11 @@ namespace Spartan
 		) const;
 		void GeometryUpdate();
 		const Math::BoundingBox& GeometryAabb() const { return m_aabb; }
+		// Triangle hierarchy of a range of the geometry, built on first use and cached
+		std::shared_ptr<Math::TriangleBvh> GeometryBvh(unsigned int index_offset, unsigned int index_count, unsigned int vertex_offset);
+		// Direct access to the geometry, for CPU side consumers which only read a range of it
+		const std::vector<unsigned int>& GeometryIndices() const;
+		const std::vector<RHI_Vertex_PosUvNorTan>& GeometryVertices() const;
 		//==============================================================
 
 		// Add resources to the model
@@ -96,6 +104,7 @@ namespace Spartan
 		// Geometry
 		bool GeometryCreateBuffers();
 		float GeometryComputeNormalizedScale() const;
+		Math::BoundingBox GeometryComputeAabb() const;
 		unsigned int GeometryComputeMemoryUsage() const;
 
 		// The root entity that represents this model in the scene
@@ -108,6 +117,10 @@ namespace Spartan
 		Math::BoundingBox m_aabb;
 		unsigned int mesh_count;
 
+		// Triangle hierarchies keyed by index offset and count
+		std::unordered_map<uint64_t, std::shared_ptr<Math::TriangleBvh>> m_bvhs;
+		std::mutex m_bvh_mutex;
+
 		// Material
 		std::vector<std::shared_ptr<Material>> m_materials;
 
@@ -0,0 +1,143 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ======================
+#include "RenderTargetPool.h"
+#include "../RHI/RHI_RenderTexture.h"
+#include <algorithm>
+//=================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+	RenderTargetPool::RenderTargetPool(const shared_ptr<RHI_Device>& rhi_device, const uint32_t free_frames_max /*= 30*/, const uint64_t free_memory_max /*= 256 * 1024 * 1024*/)
+	{
+		m_rhi_device		= rhi_device;
+		m_free_frames_max	= free_frames_max;
+		m_free_memory_max	= free_memory_max;
+	}
+
+	shared_ptr<RHI_RenderTexture> RenderTargetPool::Acquire(const FrameGraph::Texture_Desc& desc)
+	{
+		// The most recently used of the matching free textures
+		Entry* match = nullptr;
+		for (auto& entry : m_entries)
+		{
+			if (entry.desc == desc && IsFree(entry) && (!match || entry.frame_used > match->frame_used))
+			{
+				match = &entry;
+			}
+		}
+
+		if (!match)
+		{
+			m_entries.emplace_back(Entry{ desc, make_shared<RHI_RenderTexture>(m_rhi_device, desc.width, desc.height, desc.format, desc.depth), m_frame });
+			match			= &m_entries.back();
+			m_memory		+= FrameGraph::GetMemory(desc);
+			m_memory_peak	= max(m_memory_peak, m_memory);
+			m_count_created++;
+		}
+
+		match->frame_used = m_frame;
+		return match->texture;
+	}
+
+	void RenderTargetPool::Tick()
+	{
+		m_frame++;
+
+		// Free textures which have been free for too long
+		uint64_t memory_free = 0;
+		for (uint32_t i = 0; i < static_cast<uint32_t>(m_entries.size());)
+		{
+			auto& entry = m_entries[i];
+			if (!IsFree(entry))
+			{
+				entry.frame_used = m_frame;
+			}
+			else if (m_frame - entry.frame_used > m_free_frames_max)
+			{
+				Destroy(i);
+				continue;
+			}
+			else
+			{
+				memory_free += FrameGraph::GetMemory(entry.desc);
+			}
+			i++;
+		}
+
+		// Least recently used free textures, until the rest fits
+		while (memory_free > m_free_memory_max)
+		{
+			uint32_t oldest = 0;
+			for (uint32_t i = 1; i < static_cast<uint32_t>(m_entries.size()); i++)
+			{
+				if (IsFree(m_entries[i]) && (!IsFree(m_entries[oldest]) || m_entries[i].frame_used < m_entries[oldest].frame_used))
+				{
+					oldest = i;
+				}
+			}
+
+			memory_free -= FrameGraph::GetMemory(m_entries[oldest].desc);
+			Destroy(oldest);
+		}
+	}
+
+	void RenderTargetPool::Trim()
+	{
+		for (uint32_t i = 0; i < static_cast<uint32_t>(m_entries.size());)
+		{
+			if (IsFree(m_entries[i]))
+			{
+				Destroy(i);
+				continue;
+			}
+			i++;
+		}
+	}
+
+	uint32_t RenderTargetPool::GetCountFree() const
+	{
+		return static_cast<uint32_t>(count_if(m_entries.begin(), m_entries.end(), [this](const Entry& entry) { return IsFree(entry); }));
+	}
+
+	uint64_t RenderTargetPool::GetMemoryFree() const
+	{
+		uint64_t memory = 0;
+		for (const auto& entry : m_entries)
+		{
+			memory += IsFree(entry) ? FrameGraph::GetMemory(entry.desc) : 0;
+		}
+
+		return memory;
+	}
+
+	void RenderTargetPool::Destroy(const uint32_t index)
+	{
+		m_memory -= FrameGraph::GetMemory(m_entries[index].desc);
+		m_entries[index] = move(m_entries.back());
+		m_entries.pop_back();
+	}
+}
@@ -0,0 +1,79 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ====================
+#include <memory>
+#include <vector>
+#include "Utilities/FrameGraph.h"
+//===============================
+
+namespace Spartan
+{
+	class RHI_Device;
+	class RHI_RenderTexture;
+
+	// Recycles render textures by their description. A texture is free once nothing but the pool holds it, free textures
+	// are destroyed after some frames or, least recently used first, when they take up more memory than allowed.
+	// Textures survive settings and resolutions which change back and forth, instead of being created all over again.
+	class SPARTAN_CLASS RenderTargetPool
+	{
+	public:
+		RenderTargetPool(const std::shared_ptr<RHI_Device>& rhi_device, uint32_t free_frames_max = 30, uint64_t free_memory_max = 256 * 1024 * 1024);
+		~RenderTargetPool() = default;
+
+		// Returns a free texture matching the description, or a new one if there is none
+		std::shared_ptr<RHI_RenderTexture> Acquire(const FrameGraph::Texture_Desc& desc);
+		// Advances a frame and destroys the free textures which are over the limits, call once per frame
+		void Tick();
+		// Destroys all free textures
+		void Trim();
+
+		uint32_t GetCount() const			{ return static_cast<uint32_t>(m_entries.size()); }
+		uint32_t GetCountFree() const;
+		// Textures created over the lifetime of the pool, recycling doesn't add to it
+		uint64_t GetCountCreated() const	{ return m_count_created; }
+		uint64_t GetMemory() const			{ return m_memory; }
+		uint64_t GetMemoryFree() const;
+		uint64_t GetMemoryPeak() const		{ return m_memory_peak; }
+
+	private:
+		struct Entry
+		{
+			FrameGraph::Texture_Desc desc;
+			std::shared_ptr<RHI_RenderTexture> texture;
+			uint64_t frame_used; // the last frame it wasn't free
+		};
+
+		bool IsFree(const Entry& entry) const { return entry.texture.use_count() == 1; }
+		void Destroy(uint32_t index);
+
+		std::shared_ptr<RHI_Device> m_rhi_device;
+		std::vector<Entry> m_entries;
+		uint32_t m_free_frames_max;
+		uint64_t m_free_memory_max;
+		uint64_t m_frame			= 0;
+		uint64_t m_count_created	= 0;
+		uint64_t m_memory			= 0;
+		uint64_t m_memory_peak		= 0;
+	};
+}
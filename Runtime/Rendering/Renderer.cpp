@@ -25,7 +25,11 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "Gizmos/Grid.h"
 #include "Gizmos/Transform_Gizmo.h"
 #include "Deferred/ShaderLight.h"
+#include "Deferred/ShaderVariation.h"
 #include "Utilities/Sampling.h"
+#include "Utilities/OcclusionCuller.h"
+#include "RenderTargetPool.h"
+#include "Model.h"
 #include "Font/Font.h"
 #include "../Profiling/Profiler.h"
 #include "../Resource/ResourceCache.h"
@@ -33,6 +37,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../RHI/RHI_VertexBuffer.h"
 #include "../RHI/RHI_Sampler.h"
 #include "../RHI/RHI_ConstantBuffer.h"
+#include "../RHI/RHI_StructuredBuffer.h"
 #include "../RHI/RHI_DepthStencilState.h"
 #include "../RHI/RHI_RasterizerState.h"
 #include "../RHI/RHI_BlendState.h"
@@ -42,6 +47,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../World/Components/Renderable.h"
 #include "../World/Components/Skybox.h"
 #include "../World/Components/Camera.h"
+#include "../Threading/Threading.h"
+#include "../Core/FrameAllocator.h"
 #include <algorithm>
 //=========================================
 
@@ -56,6 +63,17 @@ namespace Spartan
 	static ResourceCache* g_resource_cache	= nullptr;
 	bool Renderer::m_is_rendering			= false;
 
+	// The flags FrameGraph_Declare() depends on, toggling the others doesn't change the passes
+	static const unsigned long frame_graph_flags =
+		Render_PostProcess_Bloom			|
+		Render_PostProcess_FXAA				|
+		Render_PostProcess_SSAO				|
+		Render_PostProcess_TAA				|
+		Render_PostProcess_MotionBlur		|
+		Render_PostProcess_Sharpening		|
+		Render_PostProcess_ChromaticAberration	|
+		Render_PostProcess_Dithering;
+
 	Renderer::Renderer(Context* context) : ISubsystem(context)
 	{	
 		m_near_plane	= 0.0f;
@@ -71,6 +89,9 @@ namespace Spartan
 		m_flags			|= Render_PostProcess_TAA;
 		m_flags			|= Render_PostProcess_Sharpening;	
 		m_flags			|= Render_PostProcess_SSR;
+		m_flags			|= Render_OcclusionCulling;
+		m_flags			|= Render_Instancing;
+		m_flags			|= Render_ParallelRecording;
 		//m_flags		|= Render_PostProcess_Dithering;			// Diasbled by default: It's only needed in very dark scenes to fix smooth color gradients
 		//m_flags		|= Render_PostProcess_ChromaticAberration;	// Disabled by default: It doesn't improve the image quality, it's more of a stylistic effect		
 		//m_flags		|= Render_PostProcess_FXAA;					// Disabled by default: TAA is superior
@@ -83,9 +104,18 @@ namespace Spartan
 			return;
 		}
 
+		// Without constant buffer offsets every allocation gets a small page of its own, bound from its start
+		if (!m_rhi_device->IsConstantBufferOffsettingSupported())
+		{
+			m_constant_ring = ConstantRing(4 * 1024, 256, true);
+		}
+
 		// Create command list
 		m_cmd_list = make_shared<RHI_CommandList>(m_rhi_device, m_context->GetSubsystem<Profiler>().get());
 
+		// Create render target pool
+		m_render_target_pool = make_unique<RenderTargetPool>(m_rhi_device);
+
 		// Log on-screen as the renderer is ready
 		LOG_TO_FILE(false);
 		m_initialized = true;
@@ -114,9 +144,11 @@ namespace Spartan
 		// Editor specific
 		m_gizmo_grid			= make_unique<Grid>(m_rhi_device);
 		m_gizmo_transform		= make_unique<Transform_Gizmo>(m_context);
-		// Create a constant buffer that will be used for most shaders
-		m_buffer_global	= make_shared<RHI_ConstantBuffer>(m_rhi_device);
-		m_buffer_global->Create<ConstantBufferGlobal>();
+		// Occlusion culling
+		m_occlusion_culler		= make_unique<OcclusionCuller>();
+		// Instancing
+		m_instances_gbuffer		= make_shared<RHI_StructuredBuffer>(m_rhi_device);
+		m_instances_depth		= make_shared<RHI_StructuredBuffer>(m_rhi_device);
 		// Line buffer
 		m_vertex_buffer_lines	= make_shared<RHI_VertexBuffer>(m_rhi_device);
 
@@ -211,29 +243,71 @@ namespace Spartan
 		m_quad = Rectangle(0, 0, m_resolution.x, m_resolution.y);
 		m_quad.CreateBuffers(this);
 
-		// G-Buffer
-		m_g_buffer_albedo	= make_shared<RHI_RenderTexture>(m_rhi_device, width, height, Format_R8G8B8A8_UNORM, false);
-		m_g_buffer_normal	= make_shared<RHI_RenderTexture>(m_rhi_device, width, height, Format_R16G16B16A16_FLOAT, false); // At Texture_Format_R8G8B8A8_UNORM, normals have noticeable banding
-		m_g_buffer_material = make_shared<RHI_RenderTexture>(m_rhi_device, width, height, Format_R8G8B8A8_UNORM, false);
-		m_g_buffer_velocity = make_shared<RHI_RenderTexture>(m_rhi_device, width, height, Format_R16G16_FLOAT, false);
-		m_g_buffer_depth	= make_shared<RHI_RenderTexture>(m_rhi_device, width, height, Format_R32G32_FLOAT, true, Format_D32_FLOAT);
-
-		// Full res
-		m_render_tex_full_hdr_light		= make_unique<RHI_RenderTexture>(m_rhi_device, width, height, Format_R32G32B32A32_FLOAT);
-		m_render_tex_full_hdr_light2	= make_unique<RHI_RenderTexture>(m_rhi_device, width, height, Format_R32G32B32A32_FLOAT);
-		m_render_tex_full_taa_current	= make_unique<RHI_RenderTexture>(m_rhi_device, width, height, Format_R16G16B16A16_FLOAT);
-		m_render_tex_full_taa_history	= make_unique<RHI_RenderTexture>(m_rhi_device, width, height, Format_R16G16B16A16_FLOAT);
-		m_render_tex_full_spare			= make_unique<RHI_RenderTexture>(m_rhi_device, width, height, Format_R16G16B16A16_FLOAT);
-
-		// Half res
-		m_render_tex_half_shadows	= make_unique<RHI_RenderTexture>(m_rhi_device, width / 2, height / 2, Format_R8_UNORM);
-		m_render_tex_half_ssao		= make_unique<RHI_RenderTexture>(m_rhi_device, width / 2, height / 2, Format_R8_UNORM);
-		m_render_tex_half_spare		= make_unique<RHI_RenderTexture>(m_rhi_device, width / 2, height / 2, Format_R8_UNORM);
-		m_render_tex_half_spare2	= make_unique<RHI_RenderTexture>(m_rhi_device, width / 2, height / 2, Format_R16G16B16A16_FLOAT);
-
-		// Quarter res
-		m_render_tex_quarter_blur1 = make_unique<RHI_RenderTexture>(m_rhi_device, width / 4, height / 4, Format_R16G16B16A16_FLOAT);
-		m_render_tex_quarter_blur2 = make_unique<RHI_RenderTexture>(m_rhi_device, width / 4, height / 4, Format_R16G16B16A16_FLOAT);
+		// Decide which passes run and where their textures live
+		FrameGraph_Declare(m_frame_graph, width, height, m_flags, m_tonemapping, m_debug_buffer);
+		m_frame_graph.Compile();
+		m_frame_graph_flags			= m_flags & frame_graph_flags;
+		m_frame_graph_tonemapping	= m_tonemapping;
+		m_frame_graph_debug_buffer	= m_debug_buffer;
+
+		// Textures which keep their contents between frames, passes swap the ones of a pair so either both exist or none
+		const auto create = [this, width, height](shared_ptr<RHI_RenderTexture>& texture, const bool needed, const RHI_Format format)
+		{
+			if (!needed)
+			{
+				texture = nullptr;
+			}
+			else if (!texture || texture->GetWidth() != width || texture->GetHeight() != height)
+			{
+				texture = m_render_target_pool->Acquire({ width, height, format, false });
+			}
+		};
+		create(m_render_tex_full_hdr_light,		true,										Format_R32G32B32A32_FLOAT);
+		create(m_render_tex_full_hdr_light2,	true,										Format_R32G32B32A32_FLOAT);
+		create(m_render_tex_full_taa_current,	m_frame_graph.IsPassActive("Pass_TAA"),	Format_R16G16B16A16_FLOAT);
+		create(m_render_tex_full_taa_history,	m_frame_graph.IsPassActive("Pass_TAA"),	Format_R16G16B16A16_FLOAT);
+
+		// Transient textures, one for every physical texture of the frame graph. The previous ones go back to the pool
+		// first, so whatever the graph still needs is reused.
+		m_frame_graph_textures.clear();
+		FrameGraph_Bind();
+		for (const auto& desc : m_frame_graph.GetPhysicalTextures())
+		{
+			m_frame_graph_textures.emplace_back(m_render_target_pool->Acquire(desc));
+		}
+		FrameGraph_Bind();
+
+		LOGF_INFO("%d transient render textures, %.1f MB (%.1f MB without aliasing), %.1f MB pooled",
+			static_cast<int>(m_frame_graph_textures.size()),
+			m_frame_graph.GetMemoryTransient() / (1024.0f * 1024.0f),
+			m_frame_graph.GetMemoryTransientUnaliased() / (1024.0f * 1024.0f),
+			m_render_target_pool->GetMemory() / (1024.0f * 1024.0f)
+		);
+	}
+
+	void Renderer::FrameGraph_Bind()
+	{
+		static const pair<const char*, shared_ptr<RHI_RenderTexture> Renderer::*> transients[] =
+		{
+			{ "g_buffer_albedo",	&Renderer::m_g_buffer_albedo },
+			{ "g_buffer_normal",	&Renderer::m_g_buffer_normal },
+			{ "g_buffer_material",	&Renderer::m_g_buffer_material },
+			{ "g_buffer_velocity",	&Renderer::m_g_buffer_velocity },
+			{ "g_buffer_depth",		&Renderer::m_g_buffer_depth },
+			{ "full_spare",			&Renderer::m_render_tex_full_spare },
+			{ "half_shadows",		&Renderer::m_render_tex_half_shadows },
+			{ "half_ssao",			&Renderer::m_render_tex_half_ssao },
+			{ "half_spare",			&Renderer::m_render_tex_half_spare },
+			{ "half_spare2",		&Renderer::m_render_tex_half_spare2 },
+			{ "quarter_blur1",		&Renderer::m_render_tex_quarter_blur1 },
+			{ "quarter_blur2",		&Renderer::m_render_tex_quarter_blur2 }
+		};
+
+		for (const auto& transient : transients)
+		{
+			const auto physical	= m_frame_graph.GetPhysical(m_frame_graph.GetTexture(transient.first));
+			this->*transient.second	= physical < m_frame_graph_textures.size() ? m_frame_graph_textures[physical] : nullptr;
+		}
 	}
 
 	void Renderer::CreateShaders()
@@ -280,10 +354,16 @@ namespace Spartan
 		// G-Buffer
 		m_vs_gbuffer = make_shared<RHI_Shader>(m_rhi_device);
 		m_vs_gbuffer->CompileAsync(m_context, Shader_Vertex, dir_shaders + "GBuffer.hlsl", Vertex_Attributes_PositionTextureNormalTangent);
+		m_vs_gbuffer_instanced = make_shared<RHI_Shader>(m_rhi_device);
+		m_vs_gbuffer_instanced->AddDefine("INSTANCED");
+		m_vs_gbuffer_instanced->CompileAsync(m_context, Shader_Vertex, dir_shaders + "GBuffer.hlsl", Vertex_Attributes_PositionTextureNormalTangent);
 
 		// Depth
 		m_vps_depth = make_shared<RHI_Shader>(m_rhi_device);
 		m_vps_depth->CompileAsync(m_context, Shader_VertexPixel, dir_shaders + "ShadowingDepth.hlsl", Vertex_Attribute_Position3d);
+		m_vs_depth_instanced = make_shared<RHI_Shader>(m_rhi_device);
+		m_vs_depth_instanced->AddDefine("INSTANCED");
+		m_vs_depth_instanced->CompileAsync(m_context, Shader_Vertex, dir_shaders + "ShadowingDepth.hlsl", Vertex_Attribute_Position3d);
 
 		// Quad
 		m_vs_quad = make_shared<RHI_Shader>(m_rhi_device);
@@ -444,14 +524,17 @@ namespace Spartan
 		m_frame_num++;
 		m_is_odd_frame = (m_frame_num % 2) == 1;
 		m_profiler->Reset();
+		m_constant_ring.Reset();
+		m_render_target_pool->Tick();
 
 		// Get camera matrices
 		{
-			m_near_plane	= m_camera->GetNearPlane();
-			m_far_plane		= m_camera->GetFarPlane();
-			m_view			= m_camera->GetViewMatrix();
-			m_view_base		= m_camera->GetBaseViewMatrix();
-			m_projection	= m_camera->GetProjectionMatrix();
+			m_near_plane			= m_camera->GetNearPlane();
+			m_far_plane				= m_camera->GetFarPlane();
+			m_view					= m_camera->GetViewMatrix();
+			m_view_base				= m_camera->GetBaseViewMatrix();
+			m_projection			= m_camera->GetProjectionMatrix();
+			m_projection_unjittered	= m_projection;
 
 			// TAA - Generate jitter
 			if (Flags_IsSet(Render_PostProcess_TAA))
@@ -478,6 +561,22 @@ namespace Spartan
 			m_view_projection_orthographic	= m_view_base * m_projection_orthographic;
 		}
 
+		// Frustum culling
+		CullFrustum(Renderable_ObjectOpaque);
+		CullFrustum(Renderable_ObjectTransparent);
+
+		// Occlusion culling
+		if (Flags_IsSet(Render_OcclusionCulling))
+		{
+			CullOcclusion();
+		}
+
+		// Recompile the frame graph if settings which change the passes did
+		if ((m_flags & frame_graph_flags) != m_frame_graph_flags || m_tonemapping != m_frame_graph_tonemapping || m_debug_buffer != m_frame_graph_debug_buffer)
+		{
+			CreateRenderTextures();
+		}
+
 		Pass_Main();
 
 		m_is_rendering = false;
@@ -544,12 +643,14 @@ namespace Spartan
 		DrawLine(Vector3(min.x, max.y, max.z), Vector3(min.x, min.y, max.z), color, depth);
 	}
 
-	void Renderer::SetDefaultBuffer(const unsigned int resolution_width, const unsigned int resolution_height, const Matrix& mMVP) const
+	void Renderer::SetDefaultBuffer(const unsigned int resolution_width, const unsigned int resolution_height, const Matrix& mMVP)
 	{
-		auto buffer = static_cast<ConstantBufferGlobal*>(m_buffer_global->Map());
+		// Every call gets a slice of its own, so a pass can change the buffer between draws
+		m_buffer_global	= m_constant_ring.Allocate(static_cast<unsigned int>(sizeof(ConstantBufferGlobal)));
+		auto buffer		= static_cast<ConstantBufferGlobal*>(m_buffer_global.data);
 		if (!buffer)
 		{
-			LOGF_ERROR("Failed to map buffer");
+			LOG_ERROR("Failed to allocate buffer.");
 			return;
 		}
 
@@ -578,110 +679,264 @@ namespace Spartan
 		buffer->exposure				= m_exposure;
 		buffer->gamma					= m_gamma;
 
-		m_buffer_global->Unmap();
+		ConstantRingFlush();
+	}
+
+	void Renderer::ConstantRingFlush()
+	{
+		m_constant_ring.Flush(m_constant_ring_ranges);
+		for (const auto& range : m_constant_ring_ranges)
+		{
+			// A GPU buffer for every page of the ring
+			while (range.page >= m_constant_ring_pages.size())
+			{
+				auto page = make_shared<RHI_ConstantBuffer>(m_rhi_device);
+				page->Create(m_constant_ring.GetPageSize());
+				m_constant_ring_pages.emplace_back(page);
+			}
+
+			// The first upload of a page in a frame discards it, the next ones only append to what draws already read.
+			// With a page per allocation every range starts at 0, so devices without WRITE_NO_OVERWRITE only ever discard.
+			const auto& page	= m_constant_ring_pages[range.page];
+			const auto mapped	= static_cast<uint8_t*>(page->Map(range.offset == 0));
+			if (!mapped)
+			{
+				LOGF_ERROR("Failed to map page %d", range.page);
+				continue;
+			}
+
+			memcpy(mapped + range.offset, m_constant_ring.GetPageData(range.page) + range.offset, range.size);
+			page->Unmap();
+		}
+	}
+
+	void Renderer::SetConstantBuffer(RHI_CommandList* cmd_list, const unsigned int slot, const RHI_Buffer_Scope scope, const ConstantRing::Allocation& allocation)
+	{
+		if (!allocation.data || allocation.page >= m_constant_ring_pages.size())
+			return;
+
+		cmd_list->SetConstantBuffer(slot, scope, m_constant_ring_pages[allocation.page], allocation.offset, allocation.size);
+	}
+
+	void Renderer::RecordParallel(const unsigned int count, void* record, void (*invoke)(void*, RHI_CommandList*, unsigned int, unsigned int))
+	{
+		if (count == 0)
+			return;
+
+		auto threading = m_context->GetSubsystem<Threading>().get();
+
+		// A range per thread at most, and a single one when the lists can't be merged back into the main one
+		const bool parallel				= Flags_IsSet(Render_ParallelRecording) && m_rhi_device->IsCommandListMergingSupported();
+		const unsigned int range_count	= parallel ? Min(count / m_record_range_min, threading->GetThreadCount() + 1) : 1;
+		if (range_count <= 1)
+		{
+			invoke(record, m_cmd_list.get(), 0, count);
+			return;
+		}
+
+		while (m_cmd_lists_worker.size() < range_count)
+		{
+			m_cmd_lists_worker.emplace_back(make_shared<RHI_CommandList>(m_rhi_device, m_profiler));
+		}
+
+		threading->ParallelFor(range_count, [this, record, invoke, count, range_count](const unsigned int range_start, const unsigned int range_end)
+		{
+			for (unsigned int i = range_start; i < range_end; i++)
+			{
+				const auto start	= static_cast<unsigned int>((static_cast<uint64_t>(count) * i) / range_count);
+				const auto end		= static_cast<unsigned int>((static_cast<uint64_t>(count) * (i + 1)) / range_count);
+				invoke(record, m_cmd_lists_worker[i].get(), start, end);
+			}
+		}, 1, Job_Critical);
+
+		for (unsigned int i = 0; i < range_count; i++)
+		{
+			m_cmd_list->ExecuteCommandList(m_cmd_lists_worker[i].get());
+		}
 	}
 
 	void Renderer::RenderablesAcquire(const Variant& entities_variant)
 	{
 		TIME_BLOCK_START_CPU(m_profiler);
 
-		// Clear previous state
-		m_entities.clear();
+		// Clear previous state (keeping the capacity of the lists)
+		for (auto& it : m_entities)
+		{
+			it.second.clear();
+		}
 		m_camera = nullptr;
 		m_skybox = nullptr;
 		
-		auto entities_vec = entities_variant.Get<vector<shared_ptr<Entity>>>();
-		for (const auto& entitieshared : entities_vec)
+		const auto& entities_vec = entities_variant.Get<vector<shared_ptr<Entity>>>();
+
+		// What a range of entities contributes, the lists live in frame memory so classifying doesn't touch the heap
+		struct Acquired
 		{
-			auto entity = entitieshared.get();
-			if (!entity)
-				continue;
+			FrameVector<Entity*> entities[Renderable_Camera + 1];
+			Entity* camera = nullptr;
+			Entity* skybox = nullptr;
+		};
+
+		// Classify ranges of entities in parallel, the ranges are combined in order so the result is identical to a serial pass
+		auto acquired = m_context->GetSubsystem<Threading>()->ParallelReduce(static_cast<unsigned int>(entities_vec.size()), Acquired(),
+		[&entities_vec](const unsigned int start, const unsigned int end, Acquired& acquired)
+		{
+			for (unsigned int i = start; i < end; i++)
+			{
+				auto entity = entities_vec[i].get();
+				if (!entity)
+					continue;
 
-			// Get all the components we are interested in
-			auto renderable = entity->GetComponent<Renderable>();
-			auto light		= entity->GetComponent<Light>();
-			auto skybox		= entity->GetComponent<Skybox>();
-			auto camera		= entity->GetComponent<Camera>();
+				// Get all the components we are interested in
+				auto renderable = entity->GetComponent_PtrRaw<Renderable>();
+				auto light		= entity->GetComponent_PtrRaw<Light>();
+				auto skybox		= entity->GetComponent_PtrRaw<Skybox>();
+				auto camera		= entity->GetComponent_PtrRaw<Camera>();
 
-			if (renderable)
-			{
-				const auto is_transparent = !renderable->MaterialExists() ? false : renderable->MaterialPtr()->GetColorAlbedo().w < 1.0f;
-				if (!skybox) // Ignore skybox
+				if (renderable)
 				{
-					m_entities[is_transparent ? Renderable_ObjectTransparent : Renderable_ObjectOpaque].emplace_back(entity);
+					const auto is_transparent = !renderable->MaterialExists() ? false : renderable->MaterialPtr()->GetColorAlbedo().w < 1.0f;
+					if (!skybox) // Ignore skybox
+					{
+						acquired.entities[is_transparent ? Renderable_ObjectTransparent : Renderable_ObjectOpaque].emplace_back(entity);
+					}
 				}
-			}
 
-			if (light)
-			{
-				m_entities[Renderable_Light].emplace_back(entity);
-			}
+				if (light)
+				{
+					acquired.entities[Renderable_Light].emplace_back(entity);
+				}
 
-			if (skybox)
-			{
-				m_skybox = skybox;
-			}
+				if (skybox)
+				{
+					acquired.skybox = entity;
+				}
 
-			if (camera)
+				if (camera)
+				{
+					acquired.entities[Renderable_Camera].emplace_back(entity);
+					acquired.camera = entity;
+				}
+			}
+		},
+		[](Acquired& acquired, const Acquired& acquired_range)
+		{
+			for (unsigned int type = Renderable_ObjectOpaque; type <= Renderable_Camera; type++)
 			{
-				m_entities[Renderable_Camera].emplace_back(entity);
-				m_camera = camera;
+				auto& entities = acquired.entities[type];
+				entities.insert(entities.end(), acquired_range.entities[type].begin(), acquired_range.entities[type].end());
 			}
+
+			if (acquired_range.skybox) acquired.skybox = acquired_range.skybox;
+			if (acquired_range.camera) acquired.camera = acquired_range.camera;
+		}, 0, Job_Critical);
+
+		for (unsigned int type = Renderable_ObjectOpaque; type <= Renderable_Camera; type++)
+		{
+			auto& entities = m_entities[static_cast<RenderableType>(type)];
+			entities.insert(entities.end(), acquired.entities[type].begin(), acquired.entities[type].end());
 		}
+		m_camera	= acquired.camera ? acquired.camera->GetComponent<Camera>() : nullptr;
+		m_skybox	= acquired.skybox ? acquired.skybox->GetComponent<Skybox>() : nullptr;
 
-		RenderablesSort(&m_entities[Renderable_ObjectOpaque]);
-		RenderablesSort(&m_entities[Renderable_ObjectTransparent]);
+		RenderablesSort(Renderable_ObjectOpaque);
+		RenderablesSort(Renderable_ObjectTransparent);
 
 		TIME_BLOCK_END(m_profiler);
 	}
 
-	void Renderer::RenderablesSort(vector<Entity*>* renderables)
+	void Renderer::RenderablesSort(const RenderableType type)
 	{
-		if (renderables->size() <= 2)
+		auto& renderables	= m_entities[type];
+		const auto count	= static_cast<unsigned int>(renderables.size());
+		if (count <= 2)
 			return;
 
-		// Sort by depth (front to back)
-		if (m_camera)
+		// Resolve any transform which changed after the world ticked, so the jobs below only read them
+		for (const auto& entity : renderables)
 		{
-			sort(renderables->begin(), renderables->end(), [this](Entity* a, Entity* b)
+			entity->GetTransform_PtrRaw()->GetMatrix();
+		}
+
+		// What the key of each draw is made of
+		auto& states = m_sort_states;
+		states.resize(count);
+		const Vector3 camera_position = m_camera ? m_camera->GetTransform()->GetPosition() : Vector3::Zero;
+		auto threading = m_context->GetSubsystem<Threading>().get();
+		threading->ParallelFor(count, [&renderables, &states, &camera_position](const unsigned int start, const unsigned int end)
+		{
+			for (unsigned int i = start; i < end; i++)
 			{
-				// Get renderable component
-				auto a_renderable = a->GetRenderable_PtrRaw();
-				auto b_renderable = b->GetRenderable_PtrRaw();
-				if (!a_renderable || !b_renderable)
-					return false;
-
-				// Get materials
-				const auto a_material = a_renderable->MaterialPtr();
-				const auto b_material = b_renderable->MaterialPtr();
-				if (!a_material || !b_material)
-					return false;
-
-				const auto a_depth = (a_renderable->GeometryAabb().GetCenter() - m_camera->GetTransform()->GetPosition()).LengthSquared();
-				const auto b_depth = (b_renderable->GeometryAabb().GetCenter() - m_camera->GetTransform()->GetPosition()).LengthSquared();
-
-				return a_depth < b_depth;
-			});
+				auto renderable	= renderables[i]->GetRenderable_PtrRaw();
+				auto material	= renderable ? renderable->MaterialPtr().get() : nullptr;
+				auto model		= renderable ? renderable->GeometryModel().get() : nullptr;
+				auto& state		= states[i];
+
+				state.shader	= material && material->GetShader() ? material->GetShader()->RHI_GetID() : 0;
+				state.material	= material ? material->GetResourceId() : 0;
+				state.mesh		= model ? model->GetResourceId() : 0;
+				state.depth		= renderable ? (renderable->GeometryAabb().GetCenter() - camera_position).Length() : 0.0f;
+			}
+		}, 0, Job_Critical);
+
+		// Ids are replaced by their rank among the distinct ids of the frame, so they fit in the bits the key has for them
+		auto& ids = m_sort_ids;
+		for (auto& ids_type : ids)
+		{
+			ids_type.clear();
 		}
+		for (const auto& state : states)
+		{
+			ids[0].emplace_back(state.shader);
+			ids[1].emplace_back(state.material);
+			ids[2].emplace_back(state.mesh);
+		}
+		for (auto& ids_type : ids)
+		{
+			sort(ids_type.begin(), ids_type.end());
+			ids_type.erase(unique(ids_type.begin(), ids_type.end()), ids_type.end());
+		}
+		const auto rank = [](const vector<unsigned int>& ids, const unsigned int id, const uint64_t rank_max)
+		{
+			return Min(static_cast<uint64_t>(lower_bound(ids.begin(), ids.end(), id) - ids.begin()), rank_max);
+		};
 
-		// Sort by material
-		sort(renderables->begin(), renderables->end(), [](Entity* a, Entity* b)
+		// Opaque:		pass (2) | shader (10) | material (14) | mesh (14) | depth (24), fewest state changes and then front to back
+		// Transparent:	pass (2) | inverted depth (24) | shader (10) | material (14) | mesh (14), back to front so blending is correct
+		m_sort_keys.resize(count);
+		for (unsigned int i = 0; i < count; i++)
 		{
-			// Get renderable component
-			const auto a_renderable = a->GetRenderable_PtrRaw();
-			const auto b_renderable = b->GetRenderable_PtrRaw();
-			if (!a_renderable || !b_renderable)
-				return false;
+			const auto& state		= states[i];
+			const uint64_t shader	= rank(ids[0], state.shader, 0x3FF);
+			const uint64_t material	= rank(ids[1], state.material, 0x3FFF);
+			const uint64_t mesh		= rank(ids[2], state.mesh, 0x3FFF);
+
+			// The bits of a positive float sort like the float, the top 24 keep the exponent and 15 bits of mantissa
+			uint32_t depth_bits;
+			memcpy(&depth_bits, &state.depth, sizeof(depth_bits));
+			const uint64_t depth = depth_bits >> 8;
+
+			uint64_t key = static_cast<uint64_t>(type) << 62;
+			if (type == Renderable_ObjectTransparent)
+			{
+				key |= ((~depth & 0xFFFFFF) << 38) | (shader << 28) | (material << 14) | mesh;
+			}
+			else
+			{
+				key |= (shader << 52) | (material << 38) | (mesh << 24) | depth;
+			}
+
+			m_sort_keys[i] = { key, i };
+		}
 
-			// Get materials
-			const auto a_material = a_renderable->MaterialPtr();
-			const auto b_material = b_renderable->MaterialPtr();
-			if (!a_material || !b_material)
-				return false;
+		Utility::Sorting::RadixSort(m_sort_keys, m_sort_scratch, threading);
 
-			// Order doesn't matter, as long as they are not mixed
-			return a_material->GetResourceId() < b_material->GetResourceId();
-		});
+		m_sort_entities.resize(count);
+		for (unsigned int i = 0; i < count; i++)
+		{
+			m_sort_entities[i] = renderables[m_sort_keys[i].index];
+		}
+		renderables.swap(m_sort_entities);
 	}
 
 	shared_ptr<RHI_RasterizerState>& Renderer::GetRasterizerState(const RHI_Cull_Mode cull_mode, const RHI_Fill_Mode fill_mode)
@@ -693,13 +948,139 @@ namespace Spartan
 		return m_rasterizer_cull_back_solid;
 	}
 
+	void Renderer::CullFrustum(const RenderableType type)
+	{
+		auto& entities				= m_entities[type];
+		auto& bounds				= m_frustum_bounds[type];
+		auto& visibility			= m_frustum_visibility[type];
+		const auto count			= static_cast<unsigned int>(entities.size());
+		const unsigned int word_count	= (count + 31) / 32;
+
+		bounds.Resize(count);
+		visibility.assign(word_count, 0);
+
+		// Resolve any transform which changed after the world ticked, so the jobs below only read them
+		for (const auto& entity : entities)
+		{
+			entity->GetTransform_PtrRaw()->GetMatrix();
+		}
+
+		// Every range covers whole words of the visibility bitset, 1024 entities at least
+		const auto& frustum = m_camera->GetFrustum();
+		m_context->GetSubsystem<Threading>()->ParallelFor(word_count, [&entities, &bounds, &visibility, &frustum, count](const unsigned int word_start, const unsigned int word_end)
+		{
+			const unsigned int start	= word_start * 32;
+			const unsigned int end		= Min(word_end * 32, count);
+
+			// World space bounding boxes
+			for (unsigned int i = start; i < end; i++)
+			{
+				auto renderable = entities[i]->GetRenderable_PtrRaw();
+				bounds.Set(i, renderable ? renderable->GeometryAabb() : BoundingBox::Zero);
+			}
+
+			frustum.CheckCubes(bounds, start, end, visibility.data());
+		}, 32, Job_Critical);
+	}
+
+	void Renderer::CullOcclusion()
+	{
+		// Only large and simple entities are worth rasterizing as occluders
+		const unsigned int occluder_count_max		= 32;
+		const unsigned int occluder_index_count_max	= 3 * 4096;
+		const float occluder_screen_size_min		= 0.2f;
+
+		auto& entities_opaque			= m_entities[Renderable_ObjectOpaque];
+		const auto& bounds_opaque		= m_frustum_bounds[Renderable_ObjectOpaque];
+		const auto& visibility_opaque	= m_frustum_visibility[Renderable_ObjectOpaque];
+		const auto camera_position		= m_camera->GetTransform()->GetPosition();
+
+		// Pick the visible entities which cover the most of the screen, measured as the size of their bounds over their distance
+		FrameVector<pair<float, unsigned int>> occluders;
+		for (unsigned int i = 0; i < static_cast<unsigned int>(entities_opaque.size()); i++)
+		{
+			if (!(visibility_opaque[i / 32] & (1u << (i % 32))))
+				continue;
+
+			auto renderable = entities_opaque[i]->GetRenderable_PtrRaw();
+			if (!renderable || !renderable->GeometryModel() || renderable->GeometryIndexCount() > occluder_index_count_max)
+				continue;
+
+			const Vector3 center	= Vector3(bounds_opaque.center_x[i], bounds_opaque.center_y[i], bounds_opaque.center_z[i]);
+			const Vector3 extent	= Vector3(bounds_opaque.extent_x[i], bounds_opaque.extent_y[i], bounds_opaque.extent_z[i]);
+			const float distance	= Max((center - camera_position).Length(), m_near_plane);
+			const float screen_size	= extent.Length() / distance;
+			if (screen_size >= occluder_screen_size_min)
+			{
+				occluders.emplace_back(screen_size, i);
+			}
+		}
+
+		if (occluders.empty())
+			return;
+
+		const auto occluder_count = Min(static_cast<unsigned int>(occluders.size()), occluder_count_max);
+		partial_sort(occluders.begin(), occluders.begin() + occluder_count, occluders.end(), [](const pair<float, unsigned int>& a, const pair<float, unsigned int>& b) { return a.first > b.first; });
+
+		// Rasterize them
+		m_occlusion_culler->Begin(m_view_projection);
+		for (unsigned int i = 0; i < occluder_count; i++)
+		{
+			auto entity		= entities_opaque[occluders[i].second];
+			auto renderable	= entity->GetRenderable_PtrRaw();
+			auto model		= renderable->GeometryModel();
+
+			m_occlusion_culler->AddOccluder
+			(
+				model->GeometryVertices().data() + renderable->GeometryVertexOffset(),
+				model->GeometryIndices().data() + renderable->GeometryIndexOffset(),
+				renderable->GeometryIndexCount(),
+				entity->GetTransform_PtrRaw()->GetMatrix()
+			);
+		}
+		auto threading = m_context->GetSubsystem<Threading>().get();
+		m_occlusion_culler->Rasterize(threading);
+
+		// Test everything that survived frustum culling against them
+		const OcclusionCuller* occlusion_culler = m_occlusion_culler.get();
+		for (const auto type : { Renderable_ObjectOpaque, Renderable_ObjectTransparent })
+		{
+			const auto& bounds	= m_frustum_bounds[type];
+			auto& visibility	= m_frustum_visibility[type];
+			const auto count	= bounds.GetCount();
+
+			threading->ParallelFor(static_cast<unsigned int>(visibility.size()), [&bounds, &visibility, occlusion_culler, count](const unsigned int word_start, const unsigned int word_end)
+			{
+				for (unsigned int word = word_start; word < word_end; word++)
+				{
+					for (unsigned int bit = 0; bit < 32; bit++)
+					{
+						const unsigned int i = word * 32 + bit;
+						if (i >= count)
+							break;
+
+						if (!(visibility[word] & (1u << bit)))
+							continue;
+
+						const Vector3 center = Vector3(bounds.center_x[i], bounds.center_y[i], bounds.center_z[i]);
+						const Vector3 extent = Vector3(bounds.extent_x[i], bounds.extent_y[i], bounds.extent_z[i]);
+						if (occlusion_culler->IsOccluded(BoundingBox(center - extent, center + extent)))
+						{
+							visibility[word] &= ~(1u << bit);
+						}
+					}
+				}
+			}, 4, Job_Critical);
+		}
+	}
+
 	Light* Renderer::GetLightDirectional()
 	{
-		auto entities = m_entities[Renderable_Light];
+		const auto& entities = m_entities[Renderable_Light];
 
 		for (const auto& entity : entities)
 		{
-			auto light = entity->GetComponent<Light>().get();
+			auto light = entity->GetComponent_PtrRaw<Light>();
 			if (light->GetLightType() == LightType_Directional)
 				return light;
 		}
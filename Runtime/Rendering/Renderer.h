@@ -24,14 +24,21 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES =====================
 #include <memory>
 #include <vector>
+#include <functional>
+#include <type_traits>
 #include <unordered_map>
 #include "../Core/ISubsystem.h"
 #include "../Math/Matrix.h"
 #include "../Math/Vector2.h"
 #include "../Math/Rectangle.h"
+#include "../Math/BoundingBox.h"
 #include "../Core/Settings.h"
 #include "../RHI/RHI_Definition.h"
 #include "../RHI/RHI_Viewport.h"
+#include "Utilities/Sorting.h"
+#include "Utilities/InstanceBatcher.h"
+#include "Utilities/ConstantRing.h"
+#include "Utilities/FrameGraph.h"
 //================================
 
 namespace Spartan
@@ -48,6 +55,8 @@ namespace Spartan
 	class ShaderLight;
 	class ShaderBuffered;
 	class Profiler;
+	class OcclusionCuller;
+	class RenderTargetPool;
 
 	namespace Math
 	{
@@ -72,7 +81,10 @@ namespace Spartan
 		Render_PostProcess_MotionBlur			= 1UL << 12,
 		Render_PostProcess_Sharpening			= 1UL << 13,
 		Render_PostProcess_ChromaticAberration	= 1UL << 14,
-		Render_PostProcess_Dithering			= 1UL << 15
+		Render_PostProcess_Dithering			= 1UL << 15,
+		Render_OcclusionCulling					= 1UL << 16,
+		Render_Instancing						= 1UL << 17,
+		Render_ParallelRecording				= 1UL << 18
 	};
 
 	enum RendererDebug_Buffer
@@ -168,6 +180,19 @@ namespace Spartan
 		RendererDebug_Buffer GetDebugBuffer() const				{ return m_debug_buffer; }
 		//==================================================================================
 
+		//= INSTANCING ========================================================================
+		// The batches the last frame was drawn with, for inspection
+		const InstanceBatcher& GetInstanceBatcherGBuffer() const	{ return m_batcher_gbuffer; }
+		const InstanceBatcher& GetInstanceBatcherDepth() const		{ return m_batcher_depth; }
+		//=====================================================================================
+
+		//= FRAME GRAPH ========================================================================================================================================================
+		// Declares the passes Pass_Main() runs with the given settings, along with the render textures they read and write
+		static void FrameGraph_Declare(FrameGraph& graph, unsigned int width, unsigned int height, unsigned long flags, ToneMapping_Type tonemapping, RendererDebug_Buffer debug_buffer);
+		const FrameGraph& GetFrameGraph() const					{ return m_frame_graph; }
+		const RenderTargetPool* GetRenderTargetPool() const		{ return m_render_target_pool.get(); }
+		//======================================================================================================================================================================
+
 		//= RHI INTERNALS ==========================================
 		const auto& GetRhiDevice() const	{ return m_rhi_device; }
 		const auto& GetCmdList() const		{ return m_cmd_list; }
@@ -191,9 +216,10 @@ namespace Spartan
 		void CreateShaders();
 		void CreateSamplers();
 		void CreateRenderTextures();
-		void SetDefaultBuffer(unsigned int resolution_width, unsigned int resolution_height, const Math::Matrix& mMVP = Math::Matrix::Identity) const;
+		void SetDefaultBuffer(unsigned int resolution_width, unsigned int resolution_height, const Math::Matrix& mMVP = Math::Matrix::Identity);
 		void RenderablesAcquire(const Variant& renderables);
-		void RenderablesSort(std::vector<Entity*>* renderables);
+		// Orders m_entities[type] by a 64-bit key per draw, opaque by state then front to back, transparent back to front
+		void RenderablesSort(RenderableType type);
 		std::shared_ptr<RHI_RasterizerState>& GetRasterizerState(RHI_Cull_Mode cull_mode, RHI_Fill_Mode fill_mode);
 
 		//= PASSES ===========================================================================================================================================================================
@@ -249,6 +275,7 @@ namespace Spartan
 		
 		//= SHADERS =================================================
 		std::shared_ptr<RHI_Shader> m_vs_gbuffer;
+		std::shared_ptr<RHI_Shader> m_vs_gbuffer_instanced;
 		std::shared_ptr<ShaderLight> m_vps_light;		
 		std::shared_ptr<ShaderBuffered> m_vps_color;
 		std::shared_ptr<ShaderBuffered> m_vps_font;
@@ -257,6 +284,7 @@ namespace Spartan
 		std::shared_ptr<ShaderBuffered> m_vps_gizmo_transform;
 		std::shared_ptr<ShaderBuffered> m_vps_transparent;
 		std::shared_ptr<RHI_Shader> m_vps_depth;
+		std::shared_ptr<RHI_Shader> m_vs_depth_instanced;
 		std::shared_ptr<RHI_Shader> m_vs_quad;
 		std::shared_ptr<RHI_Shader> m_ps_texture;
 		std::shared_ptr<RHI_Shader> m_ps_fxaa;
@@ -345,6 +373,7 @@ namespace Spartan
 		Math::Matrix m_view;
 		Math::Matrix m_view_base;
 		Math::Matrix m_projection;
+		Math::Matrix m_projection_unjittered;
 		Math::Matrix m_projection_orthographic;
 		Math::Matrix m_view_projection;
 		Math::Matrix m_view_projection_inv;
@@ -359,6 +388,31 @@ namespace Spartan
 		//= ENTITIES/COMPONENTS ============================================
 		Light* GetLightDirectional();
 		std::unordered_map<RenderableType, std::vector<Entity*>> m_entities;
+		// What the sort key of each draw is made of, and the rank of every id seen in the current sort
+		struct DrawState
+		{
+			unsigned int shader;
+			unsigned int material;
+			unsigned int mesh;
+			float depth;
+		};
+		std::vector<DrawState> m_sort_states;
+		std::vector<unsigned int> m_sort_ids[3]; // the distinct shader, material and mesh ids of the frame, sorted
+		std::vector<Utility::Sorting::KeyIndex> m_sort_keys;
+		std::vector<Utility::Sorting::KeyIndex> m_sort_scratch;
+		std::vector<Entity*> m_sort_entities;
+		// Culls m_entities[type] against the camera frustum, bit i of m_frustum_visibility[type] is set when entity i is visible
+		void CullFrustum(RenderableType type);
+		std::unordered_map<RenderableType, Math::BoundingBoxes> m_frustum_bounds;
+		std::unordered_map<RenderableType, std::vector<uint32_t>> m_frustum_visibility;
+		// Clears the visibility bits of entities hidden behind the largest opaque entities on screen
+		void CullOcclusion();
+		std::unique_ptr<OcclusionCuller> m_occlusion_culler;
+		// Visible opaque draws grouped by what they bind, rebuilt by the passes that draw instanced
+		InstanceBatcher m_batcher_gbuffer;
+		InstanceBatcher m_batcher_depth;
+		std::shared_ptr<RHI_StructuredBuffer> m_instances_gbuffer;
+		std::shared_ptr<RHI_StructuredBuffer> m_instances_depth;
 		float m_near_plane;
 		float m_far_plane;
 		std::shared_ptr<Camera> m_camera;
@@ -407,6 +461,50 @@ namespace Spartan
 			float exposure;
 			Math::Vector3 padding;
 		};
-		std::shared_ptr<RHI_ConstantBuffer> m_buffer_global;
+		ConstantRing::Allocation m_buffer_global;
+
+		//= CONSTANT RING ==========================================================================================
+		// Uploads what was allocated from the ring since the last flush, has to happen before binding the allocations
+		void ConstantRingFlush();
+		void SetConstantBuffer(unsigned int slot, RHI_Buffer_Scope scope, const ConstantRing::Allocation& allocation) { SetConstantBuffer(m_cmd_list.get(), slot, scope, allocation); }
+		void SetConstantBuffer(RHI_CommandList* cmd_list, unsigned int slot, RHI_Buffer_Scope scope, const ConstantRing::Allocation& allocation);
+		ConstantRing m_constant_ring;
+		std::vector<ConstantRing::Range> m_constant_ring_ranges;
+		std::vector<std::shared_ptr<RHI_ConstantBuffer>> m_constant_ring_pages;
+		std::vector<ConstantRing::Allocation> m_constant_ring_allocations; // scratch for passes that allocate ahead of drawing
+		std::vector<unsigned int> m_batch_allocations; // index of the first allocation of every batch, so ranges of batches can be recorded on their own
+		//==========================================================================================================
+
+		//= FRAME GRAPH =============================================================================================================
+		// Points the transient render textures at the physical textures the frame graph assigned them to, passes swap them around
+		void FrameGraph_Bind();
+		FrameGraph m_frame_graph;
+		std::vector<std::shared_ptr<RHI_RenderTexture>> m_frame_graph_textures;
+		// Every render texture of the passes comes from here, so recompiling only creates the ones it didn't have
+		std::unique_ptr<RenderTargetPool> m_render_target_pool;
+		// The settings the frame graph was compiled for
+		unsigned long m_frame_graph_flags					= 0;
+		ToneMapping_Type m_frame_graph_tonemapping			= ToneMapping_Off;
+		RendererDebug_Buffer m_frame_graph_debug_buffer		= RendererDebug_None;
+		//===========================================================================================================================
+
+		//= PARALLEL RECORDING =====================================================================================================
+		// Splits [0, count) into ranges which record(cmd_list, start, end) records on the worker threads, each into its own command
+		// list, and executes the lists in range order. The commands end up the same as recording [0, count) into m_cmd_list directly,
+		// as long as every range binds all the state it depends on. Resources can't be updated while recording, only before.
+		template <typename Function>
+		void RecordParallel(const unsigned int count, Function&& record)
+		{
+			// Passed on by address instead of wrapped in a std::function, which would allocate for captures of this size
+			using Record = std::remove_reference_t<Function>;
+			RecordParallel(count, &record, [](void* function, RHI_CommandList* cmd_list, const unsigned int start, const unsigned int end)
+			{
+				(*static_cast<Record*>(function))(cmd_list, start, end);
+			});
+		}
+		void RecordParallel(unsigned int count, void* record, void (*invoke)(void*, RHI_CommandList*, unsigned int, unsigned int));
+		std::vector<std::shared_ptr<RHI_CommandList>> m_cmd_lists_worker;
+		const unsigned int m_record_range_min = 64; // draws, smaller ranges aren't worth the merge
+		//==========================================================================================================================
 	};
 }
\ No newline at end of file
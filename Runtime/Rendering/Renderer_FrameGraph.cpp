@@ -0,0 +1,184 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ==========
+#include "Renderer.h"
+//=====================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+	// The passes of Pass_Main() as a frame graph, kept apart from the passes so it builds without a device
+	void Renderer::FrameGraph_Declare(FrameGraph& graph, const unsigned int width, const unsigned int height, const unsigned long flags, const ToneMapping_Type tonemapping, const RendererDebug_Buffer debug_buffer)
+	{
+		const auto is_set = [flags](const Renderer_Option flag) { return (flags & flag) != 0; };
+		graph.Clear();
+
+		// Imported, they keep their contents between frames
+		const auto shadow_map				= graph.Import("light_shadow_map"); // owned by the directional light
+		auto hdr_light						= graph.Import("full_hdr_light");
+		auto hdr_light2						= graph.Import("full_hdr_light2");
+		auto taa_current					= graph.Import("full_taa_current");
+		auto taa_history					= graph.Import("full_taa_history");
+		// Transient
+		const auto g_buffer_albedo			= graph.Create("g_buffer_albedo", { width, height, Format_R8G8B8A8_UNORM, false });
+		const auto g_buffer_normal			= graph.Create("g_buffer_normal", { width, height, Format_R16G16B16A16_FLOAT, false });
+		const auto g_buffer_material		= graph.Create("g_buffer_material", { width, height, Format_R8G8B8A8_UNORM, false });
+		const auto g_buffer_velocity		= graph.Create("g_buffer_velocity", { width, height, Format_R16G16_FLOAT, false });
+		const auto g_buffer_depth			= graph.Create("g_buffer_depth", { width, height, Format_R32G32_FLOAT, true });
+		const auto full_spare				= graph.Create("full_spare", { width, height, Format_R16G16B16A16_FLOAT, false });
+		auto half_shadows					= graph.Create("half_shadows", { width / 2, height / 2, Format_R8_UNORM, false });
+		auto half_ssao						= graph.Create("half_ssao", { width / 2, height / 2, Format_R8_UNORM, false });
+		auto half_spare						= graph.Create("half_spare", { width / 2, height / 2, Format_R8_UNORM, false });
+		const auto half_spare2				= graph.Create("half_spare2", { width / 2, height / 2, Format_R16G16B16A16_FLOAT, false });
+		const auto quarter_blur1			= graph.Create("quarter_blur1", { width / 4, height / 4, Format_R16G16B16A16_FLOAT, false });
+		const auto quarter_blur2			= graph.Create("quarter_blur2", { width / 4, height / 4, Format_R16G16B16A16_FLOAT, false });
+
+		// The passes follow Pass_Main(), swapping textures wherever it swaps them
+
+		auto pass = graph.AddPass("Pass_DepthDirectionalLight");
+		graph.Write(pass, shadow_map, FrameGraph::State_DepthStencil);
+
+		pass = graph.AddPass("Pass_GBuffer");
+		graph.Write(pass, g_buffer_albedo);
+		graph.Write(pass, g_buffer_normal);
+		graph.Write(pass, g_buffer_material);
+		graph.Write(pass, g_buffer_velocity);
+		graph.Write(pass, g_buffer_depth, FrameGraph::State_RenderTarget | FrameGraph::State_DepthStencil);
+
+		// Pass_PreLight, the bilateral blur ends up in its input and swaps it with its output
+		pass = graph.AddPass("Pass_ShadowMapping");
+		graph.Read(pass, shadow_map);
+		graph.Read(pass, g_buffer_normal);
+		graph.Read(pass, g_buffer_depth);
+		graph.Write(pass, half_spare);
+		graph.Write(pass, half_shadows);
+		graph.Read(pass, half_spare);
+		graph.Read(pass, half_shadows);
+		swap(half_spare, half_shadows);
+
+		pass = graph.AddPass("Pass_SSAO", is_set(Render_PostProcess_SSAO));
+		graph.Read(pass, g_buffer_normal);
+		graph.Read(pass, g_buffer_depth);
+		graph.Write(pass, half_spare);
+		graph.Write(pass, half_ssao);
+		graph.Read(pass, half_spare);
+		graph.Read(pass, half_ssao);
+		if (is_set(Render_PostProcess_SSAO))
+		{
+			swap(half_spare, half_ssao);
+		}
+
+		pass = graph.AddPass("Pass_Light");
+		graph.Read(pass, g_buffer_albedo);
+		graph.Read(pass, g_buffer_normal);
+		graph.Read(pass, g_buffer_depth);
+		graph.Read(pass, g_buffer_material);
+		graph.Read(pass, half_shadows);
+		if (is_set(Render_PostProcess_SSAO))
+		{
+			graph.Read(pass, half_ssao);
+		}
+		graph.Read(pass, hdr_light2); // previous frame
+		graph.Write(pass, hdr_light);
+
+		pass = graph.AddPass("Pass_Transparent");
+		graph.Read(pass, g_buffer_depth);
+		graph.ReadWrite(pass, g_buffer_depth, FrameGraph::State_DepthStencil);
+		graph.ReadWrite(pass, hdr_light);
+
+		// Pass_PostLight, every pass goes from one hdr texture to the other and swaps them
+		const auto post_process = [&graph, &hdr_light, &hdr_light2](const char* name, const bool enabled, const bool swap_targets = true)
+		{
+			const auto pass = graph.AddPass(name, enabled);
+			graph.Read(pass, hdr_light);
+			graph.Write(pass, hdr_light2);
+			if (enabled && swap_targets)
+			{
+				swap(hdr_light, hdr_light2);
+			}
+			return pass;
+		};
+
+		pass = post_process("Pass_TAA", is_set(Render_PostProcess_TAA));
+		graph.Read(pass, taa_history);
+		graph.Read(pass, g_buffer_velocity);
+		graph.Read(pass, g_buffer_depth);
+		graph.Write(pass, taa_current);
+		graph.Read(pass, taa_current);
+		if (is_set(Render_PostProcess_TAA))
+		{
+			swap(taa_current, taa_history);
+		}
+
+		pass = post_process("Pass_Bloom", is_set(Render_PostProcess_Bloom));
+		graph.Write(pass, quarter_blur1);
+		graph.Read(pass, quarter_blur1);
+		graph.Write(pass, quarter_blur2);
+		graph.Read(pass, quarter_blur2);
+		graph.Write(pass, half_spare2);
+		graph.Read(pass, half_spare2);
+		graph.Write(pass, full_spare);
+		graph.Read(pass, full_spare);
+
+		pass = post_process("Pass_MotionBlur", is_set(Render_PostProcess_MotionBlur));
+		graph.Read(pass, g_buffer_velocity);
+
+		post_process("Pass_Dithering",				is_set(Render_PostProcess_Dithering));
+		post_process("Pass_ToneMapping",			tonemapping != ToneMapping_Off);
+		post_process("Pass_FXAA",					is_set(Render_PostProcess_FXAA));
+		post_process("Pass_Sharpening",				is_set(Render_PostProcess_Sharpening));
+		post_process("Pass_ChromaticAberration",	is_set(Render_PostProcess_ChromaticAberration));
+		post_process("Pass_GammaCorrection",		true, false);
+
+		// What Pass_PostLight() ended in is the frame, and the TAA history is read by the next one
+		const auto frame = hdr_light2;
+		graph.SetOutput(frame);
+		graph.SetOutput(taa_history);
+
+		pass = graph.AddPass("Pass_Lines");
+		graph.Read(pass, g_buffer_depth, FrameGraph::State_DepthStencil);
+		graph.ReadWrite(pass, frame);
+
+		pass = graph.AddPass("Pass_Gizmos");
+		graph.ReadWrite(pass, frame);
+
+		// The debug buffer covers the whole frame
+		pass = graph.AddPass("Pass_DebugBuffer", debug_buffer != RendererDebug_None);
+		graph.Write(pass, frame);
+		switch (debug_buffer)
+		{
+			case RendererDebug_Albedo:		graph.Read(pass, g_buffer_albedo);		break;
+			case RendererDebug_Normal:		graph.Read(pass, g_buffer_normal);		break;
+			case RendererDebug_Material:	graph.Read(pass, g_buffer_material);	break;
+			case RendererDebug_Velocity:	graph.Read(pass, g_buffer_velocity);	break;
+			case RendererDebug_Depth:		graph.Read(pass, g_buffer_depth);		break;
+			case RendererDebug_SSAO:		if (is_set(Render_PostProcess_SSAO)) { graph.Read(pass, half_ssao); } break;
+			default: break;
+		}
+
+		pass = graph.AddPass("Pass_PerformanceMetrics");
+		graph.ReadWrite(pass, frame);
+	}
+}
@@ -30,11 +30,13 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "Gizmos/Transform_Gizmo.h"
 #include "Font/Font.h"
 #include "../Profiling/Profiler.h"
+#include "../Core/FrameAllocator.h"
 #include "../Resource/IResource.h"
 #include "../RHI/RHI_Device.h"
 #include "../RHI/RHI_VertexBuffer.h"
 #include "../RHI/RHI_RenderTexture.h"
 #include "../RHI/RHI_ConstantBuffer.h"
+#include "../RHI/RHI_StructuredBuffer.h"
 #include "../RHI/RHI_Texture.h"
 #include "../RHI/RHI_Sampler.h"
 #include "../RHI/RHI_CommandList.h"
@@ -44,6 +46,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../World/Components/Skybox.h"
 #include "../World/Components/Light.h"
 #include "../World/Components/Camera.h"
+#include "../Threading/Threading.h"
 //=========================================
 
 //= NAMESPACES ================
@@ -57,6 +60,24 @@ using namespace Helper;
 
 namespace Spartan
 {
+	namespace
+	{
+		// Has to match the InstanceBuffer of GBuffer.hlsl
+		struct InstanceBufferGBuffer
+		{
+			uint32_t offset;
+			uint32_t padding[3];
+		};
+
+		// Has to match the InstanceBuffer of ShadowingDepth.hlsl
+		struct InstanceBufferDepth
+		{
+			Matrix view_projection;
+			uint32_t offset;
+			uint32_t padding[3];
+		};
+	}
+
 	void Renderer::Pass_Main()
 	{
 #ifdef API_GRAPHICS_VULKAN
@@ -64,30 +85,37 @@ namespace Spartan
 #endif
 		m_cmd_list->Begin("Pass_Main");
 
-		Pass_DepthDirectionalLight(GetLightDirectional());
-		Pass_GBuffer();
+		// Passes which the frame graph culled are skipped, their textures may not exist
+		FrameGraph_Bind();
+		const auto is_active = [this](const char* name) { return m_frame_graph.IsPassActive(name); };
+
+		if (is_active("Pass_DepthDirectionalLight"))	Pass_DepthDirectionalLight(GetLightDirectional());
+		if (is_active("Pass_GBuffer"))					Pass_GBuffer();
 		Pass_PreLight
 		(
 			m_render_tex_half_spare,	// IN:	
 			m_render_tex_half_shadows,	// OUT: Shadows
 			m_render_tex_half_ssao		// OUT: DO
 		);
-		Pass_Light
-		(
-			m_render_tex_half_shadows,	// IN:	Shadows
-			m_render_tex_half_ssao,		// IN:	SSAO
-			m_render_tex_full_hdr_light	// Out: Result
-		);
-		Pass_Transparent(m_render_tex_full_hdr_light);
+		if (is_active("Pass_Light"))
+		{
+			Pass_Light
+			(
+				m_render_tex_half_shadows,	// IN:	Shadows
+				m_render_tex_half_ssao,		// IN:	SSAO
+				m_render_tex_full_hdr_light	// Out: Result
+			);
+		}
+		if (is_active("Pass_Transparent")) Pass_Transparent(m_render_tex_full_hdr_light);
 		Pass_PostLight
 		(
 			m_render_tex_full_hdr_light,	// IN:	Light pass result
 			m_render_tex_full_hdr_light2	// OUT: Result
 		);
-		Pass_Lines(m_render_tex_full_hdr_light2);
-		Pass_Gizmos(m_render_tex_full_hdr_light2);
-		Pass_DebugBuffer(m_render_tex_full_hdr_light2);
-		Pass_PerformanceMetrics(m_render_tex_full_hdr_light2);
+		if (is_active("Pass_Lines"))				Pass_Lines(m_render_tex_full_hdr_light2);
+		if (is_active("Pass_Gizmos"))				Pass_Gizmos(m_render_tex_full_hdr_light2);
+		if (is_active("Pass_DebugBuffer"))			Pass_DebugBuffer(m_render_tex_full_hdr_light2);
+		if (is_active("Pass_PerformanceMetrics"))	Pass_PerformanceMetrics(m_render_tex_full_hdr_light2);
 
 		m_cmd_list->End();
 		m_cmd_list->Submit();
@@ -100,7 +128,7 @@ namespace Spartan
 			return;
 
 		// Validate light's shadow map
-		auto& shadow_map = light_directional->GetShadowMap();
+		const auto& shadow_map = light_directional->GetShadowMap();
 		if (!shadow_map)
 			return;
 
@@ -109,6 +137,65 @@ namespace Spartan
 		if (entities.empty())
 			return;
 
+		// Group the shadow casters by geometry, the depth shader doesn't depend on the material
+		m_batcher_depth.Clear();
+		for (unsigned int i = 0; i < static_cast<unsigned int>(entities.size()); i++)
+		{
+			// Acquire renderable component
+			auto renderable = entities[i]->GetRenderable_PtrRaw();
+			if (!renderable)
+				continue;
+
+			// Acquire material
+			auto material = renderable->MaterialPtr();
+			if (!material)
+				continue;
+
+			// Acquire geometry
+			auto model = renderable->GeometryModel();
+			if (!model || !model->GetVertexBuffer() || !model->GetIndexBuffer())
+				continue;
+
+			// Skip meshes that don't cast shadows
+			if (!renderable->GetCastShadows())
+				continue;
+
+			// Skip transparent meshes (for now)
+			if (material->GetColorAlbedo().w < 1.0f)
+				continue;
+
+			m_batcher_depth.Add({ model.get(), nullptr, nullptr, renderable->GeometryIndexCount(), renderable->GeometryIndexOffset(), renderable->GeometryVertexOffset(), i });
+		}
+		m_batcher_depth.Build();
+
+		const auto& batches		= m_batcher_depth.GetBatches();
+		const auto& instances	= m_batcher_depth.GetInstances();
+		if (batches.empty())
+			return;
+
+		// Upload the world matrices of the batches which are drawn instanced
+		auto instancing = Flags_IsSet(Render_Instancing) && m_vs_depth_instanced->GetCompilationState() == Shader_Compiled;
+		if (instancing && m_batcher_depth.GetBatchCount() != m_batcher_depth.GetDrawCount())
+		{
+			instancing = m_instances_depth->Reserve<Matrix>(static_cast<unsigned int>(instances.size()));
+			auto mapped = instancing ? static_cast<Matrix*>(m_instances_depth->Map()) : nullptr;
+			if (mapped)
+			{
+				for (const auto& batch : batches)
+				{
+					if (batch.instance_count < 2)
+						continue;
+
+					for (auto j = batch.instance_offset; j < batch.instance_offset + batch.instance_count; j++)
+					{
+						mapped[j] = entities[instances[j]]->GetTransform_PtrRaw()->GetMatrix();
+					}
+				}
+				m_instances_depth->Unmap();
+			}
+			instancing = mapped != nullptr;
+		}
+
 		// Begin command list
 		m_cmd_list->Begin("Pass_DepthDirectionalLight");
 		m_cmd_list->SetDepthStencilState(m_depth_stencil_enabled);
@@ -122,59 +209,91 @@ namespace Spartan
 		m_cmd_list->ClearRenderTarget(shadow_map->GetBufferRenderTargetView(0), Vector4::Zero);
 		m_cmd_list->ClearRenderTarget(shadow_map->GetBufferRenderTargetView(1), Vector4::Zero);
 		m_cmd_list->ClearRenderTarget(shadow_map->GetBufferRenderTargetView(2), Vector4::Zero);
+		if (instancing)
+		{
+			m_cmd_list->SetStructuredBuffer(0, Buffer_VertexShader, m_instances_depth);
+		}
 		
-		// Variables that help reduce state changes
-		unsigned int currently_bound_geometry = 0;
-
 		auto clear_depth = Settings::Get().GetReverseZ() ? 1.0f - m_viewport.GetMaxDepth() : m_viewport.GetMaxDepth();
 		for (unsigned int i = 0; i < light_directional->GetShadowMap()->GetArraySize(); i++)
 		{	
-			unsigned int cascade_index = i;
+			unsigned int cascade_index	= i;
+			const auto view_projection	= light_directional->GetViewMatrix() * light_directional->ShadowMap_GetProjectionMatrix(cascade_index);
 
-			m_cmd_list->Begin("Cascade_" + to_string(cascade_index + 1));
-			m_cmd_list->SetRenderTarget(shadow_map->GetBufferRenderTargetView(i), shadow_map->GetDepthStencilView());
-			m_cmd_list->ClearDepthStencil(shadow_map->GetDepthStencilView(), Clear_Depth, clear_depth);
-
-			for (const auto& entity : entities)
+			// Write the constants of every draw of the cascade, in the order they are drawn
+			m_constant_ring_allocations.clear();
+			m_batch_allocations.clear();
+			for (const auto& batch : batches)
 			{
-				// Acquire renderable component
-				auto renderable = entity->GetRenderable_PtrRaw();
-				if (!renderable)
-					continue;
-	
-				// Acquire material
-				auto material = renderable->MaterialPtr();
-				if (!material)
-					continue;
+				m_batch_allocations.emplace_back(static_cast<unsigned int>(m_constant_ring_allocations.size()));
 
-				// Acquire geometry
-				auto model = renderable->GeometryModel();
-				if (!model || !model->GetVertexBuffer() || !model->GetIndexBuffer())
+				if (instancing && batch.instance_count > 1)
+				{
+					InstanceBufferDepth data;
+					data.view_projection	= view_projection;
+					data.offset				= batch.instance_offset;
+					m_constant_ring_allocations.emplace_back(m_constant_ring.AllocateValue(data));
 					continue;
+				}
 
-				// Skip meshes that don't cast shadows
-				if (!renderable->GetCastShadows())
-					continue;
+				for (auto j = batch.instance_offset; j < batch.instance_offset + batch.instance_count; j++)
+				{
+					m_constant_ring_allocations.emplace_back(m_constant_ring.AllocateValue(entities[instances[j]]->GetTransform_PtrRaw()->GetMatrix() * view_projection));
+				}
+			}
+			ConstantRingFlush();
 
-				// Skip transparent meshes (for now)
-				if (material->GetColorAlbedo().w < 1.0f)
-					continue;
+			char cascade_name[16];
+			snprintf(cascade_name, sizeof(cascade_name), "Cascade_%u", cascade_index + 1);
+			m_cmd_list->Begin(cascade_name);
+			m_cmd_list->SetRenderTarget(shadow_map->GetBufferRenderTargetView(i), shadow_map->GetDepthStencilView());
+			m_cmd_list->ClearDepthStencil(shadow_map->GetDepthStencilView(), Clear_Depth, clear_depth);
 
-				// Bind geometry
-				if (currently_bound_geometry != model->GetResourceId())
+			// Ranges of batches are recorded in parallel, each binds everything it uses
+			RecordParallel(static_cast<unsigned int>(batches.size()), [this, &batches, &instances, &entities, instancing](RHI_CommandList* cmd_list, const unsigned int batch_start, const unsigned int batch_end)
+			{
+				// Variables that help reduce state changes
+				unsigned int currently_bound_geometry	= 0;
+				RHI_Shader* currently_bound_vertex		= nullptr;
+				unsigned int allocation_index			= m_batch_allocations[batch_start];
+
+				for (auto batch_index = batch_start; batch_index < batch_end; batch_index++)
 				{
-					m_cmd_list->SetBufferIndex(model->GetIndexBuffer());
-					m_cmd_list->SetBufferVertex(model->GetVertexBuffer());
-					currently_bound_geometry = model->GetResourceId();
-				}
+					const auto& batch	= batches[batch_index];
+					auto renderable		= entities[instances[batch.instance_offset]]->GetRenderable_PtrRaw();
+					auto model			= renderable->GeometryModel();
+
+					// Bind geometry
+					if (currently_bound_geometry != model->GetResourceId())
+					{
+						cmd_list->SetBufferIndex(model->GetIndexBuffer());
+						cmd_list->SetBufferVertex(model->GetVertexBuffer());
+						currently_bound_geometry = model->GetResourceId();
+					}
 
-				// Update constant buffer
-				Transform* transform = entity->GetTransform_PtrRaw();
-				transform->UpdateConstantBufferLight(m_rhi_device, light_directional->GetViewMatrix() * light_directional->ShadowMap_GetProjectionMatrix(cascade_index), cascade_index);
-				m_cmd_list->SetConstantBuffer(1, Buffer_VertexShader, transform->GetConstantBufferLight(cascade_index));
+					// Bind vertex shader
+					const bool instanced	= instancing && batch.instance_count > 1;
+					const auto& vertex		= instanced ? m_vs_depth_instanced : m_vps_depth;
+					if (currently_bound_vertex != vertex.get())
+					{
+						cmd_list->SetShaderVertex(vertex);
+						currently_bound_vertex = vertex.get();
+					}
 
-				m_cmd_list->DrawIndexed(renderable->GeometryIndexCount(), renderable->GeometryIndexOffset(), renderable->GeometryVertexOffset());
-			}
+					if (instanced)
+					{
+						SetConstantBuffer(cmd_list, 1, Buffer_VertexShader, m_constant_ring_allocations[allocation_index++]);
+						cmd_list->DrawIndexedInstanced(batch.draw.index_count, batch.instance_count, batch.draw.index_offset, batch.draw.vertex_offset, 0);
+						continue;
+					}
+
+					for (auto j = batch.instance_offset; j < batch.instance_offset + batch.instance_count; j++)
+					{
+						SetConstantBuffer(cmd_list, 1, Buffer_VertexShader, m_constant_ring_allocations[allocation_index++]);
+						cmd_list->DrawIndexed(batch.draw.index_count, batch.draw.index_offset, batch.draw.vertex_offset);
+					}
+				}
+			});
 			m_cmd_list->End(); // end of cascade
 		}
 		m_cmd_list->End();
@@ -206,8 +325,7 @@ namespace Spartan
 
 		// Prepare resources
 		SetDefaultBuffer(static_cast<unsigned int>(m_resolution.x), static_cast<unsigned int>(m_resolution.y));
-		vector<void*> textures(8);
-		vector<void*> render_targets
+		FrameVector<void*> render_targets
 		{
 			m_g_buffer_albedo->GetBufferRenderTargetView(),
 			m_g_buffer_normal->GetBufferRenderTargetView(),
@@ -227,18 +345,21 @@ namespace Spartan
 		m_cmd_list->ClearDepthStencil(m_g_buffer_depth->GetDepthStencilView(), Clear_Depth, depth);		
 		m_cmd_list->SetShaderVertex(m_vs_gbuffer);
 		m_cmd_list->SetInputLayout(m_vs_gbuffer->GetInputLayout());
-		m_cmd_list->SetConstantBuffer(0, Buffer_Global, m_buffer_global);
+		SetConstantBuffer(0, Buffer_Global, m_buffer_global);
 		m_cmd_list->SetSampler(0, m_sampler_anisotropic_wrap);	
 		
-		// Variables that help reduce state changes
-		unsigned int currently_bound_geometry	= 0;
-		unsigned int currently_bound_shader		= 0;
-		unsigned int currently_bound_material	= 0;
-
-		for (auto entity : m_entities[Renderable_ObjectOpaque])
+		// Group the visible draws by what they bind
+		const auto& entities_opaque	= m_entities[Renderable_ObjectOpaque];
+		const auto& visibility		= m_frustum_visibility[Renderable_ObjectOpaque];
+		m_batcher_gbuffer.Clear();
+		for (unsigned int i = 0; i < static_cast<unsigned int>(entities_opaque.size()); i++)
 		{
+			// Skip objects outside of the view frustum
+			if (!(visibility[i / 32] & (1u << (i % 32))))
+				continue;
+
 			// Get renderable and material
-			auto renderable = entity->GetRenderable_PtrRaw();
+			auto renderable = entities_opaque[i]->GetRenderable_PtrRaw();
 			auto material	= renderable ? renderable->MaterialPtr().get() : nullptr;
 
 			if (!renderable || !material)
@@ -256,59 +377,164 @@ namespace Spartan
 			if (!model || !model->GetVertexBuffer() || !model->GetIndexBuffer())
 				continue;
 
-			// Skip objects outside of the view frustum
-			if (!m_camera->IsInViewFrustrum(renderable))
-				continue;
+			m_batcher_gbuffer.Add({ model.get(), material, shader.get(), renderable->GeometryIndexCount(), renderable->GeometryIndexOffset(), renderable->GeometryVertexOffset(), i });
+		}
+		m_batcher_gbuffer.Build();
 
-			// Set face culling (changes only if required)
-			m_cmd_list->SetRasterizerState(GetRasterizerState(material->GetCullMode(), Fill_Solid));
+		const auto& batches		= m_batcher_gbuffer.GetBatches();
+		const auto& instances	= m_batcher_gbuffer.GetInstances();
 
-			// Bind geometry
-			if (currently_bound_geometry != model->GetResourceId())
+		// Upload the transforms of the batches which are drawn instanced
+		auto instancing = Flags_IsSet(Render_Instancing) && m_vs_gbuffer_instanced->GetCompilationState() == Shader_Compiled;
+		if (instancing && m_batcher_gbuffer.GetBatchCount() != m_batcher_gbuffer.GetDrawCount())
+		{
+			instancing = m_instances_gbuffer->Reserve<Transform::CB_Gbuffer>(static_cast<unsigned int>(instances.size()));
+			auto mapped = instancing ? static_cast<Transform::CB_Gbuffer*>(m_instances_gbuffer->Map()) : nullptr;
+			if (mapped)
 			{
-				m_cmd_list->SetBufferIndex(model->GetIndexBuffer());
-				m_cmd_list->SetBufferVertex(model->GetVertexBuffer());
-				currently_bound_geometry = model->GetResourceId();
+				for (const auto& batch : batches)
+				{
+					if (batch.instance_count < 2)
+						continue;
+
+					for (auto j = batch.instance_offset; j < batch.instance_offset + batch.instance_count; j++)
+					{
+						entities_opaque[instances[j]]->GetTransform_PtrRaw()->UpdateInstanceData(m_view_projection, &mapped[j]);
+					}
+				}
+				m_instances_gbuffer->Unmap();
 			}
+			instancing = mapped != nullptr;
+		}
+
+		if (instancing)
+		{
+			m_cmd_list->SetStructuredBuffer(0, Buffer_VertexShader, m_instances_gbuffer);
+		}
 
-			// Bind shader
-			if (currently_bound_shader != shader->RHI_GetID())
+		// Write the object buffers of the single draws and the instance offsets of the batches, in the order they are drawn.
+		// The material buffers are updated here too, nothing can be updated once the batches are being recorded.
+		m_constant_ring_allocations.clear();
+		m_batch_allocations.clear();
+		const Material* updated_material = nullptr;
+		for (const auto& batch : batches)
+		{
+			auto material = entities_opaque[instances[batch.instance_offset]]->GetRenderable_PtrRaw()->MaterialPtr().get();
+			if (material != updated_material)
 			{
-				m_cmd_list->SetShaderPixel(static_pointer_cast<RHI_Shader>(shader));
-				currently_bound_shader = shader->RHI_GetID();
+				material->UpdateConstantBuffer();
+				updated_material = material;
 			}
 
-			// Bind material
-			if (currently_bound_material != material->GetResourceId())
+			m_batch_allocations.emplace_back(static_cast<unsigned int>(m_constant_ring_allocations.size()));
+			m_profiler->m_renderer_meshes_rendered += batch.instance_count;
+
+			if (instancing && batch.instance_count > 1)
 			{
-				// Bind material textures
-				textures[0] = material->GetTextureShaderResourceByType(TextureType_Albedo);
-				textures[1] = material->GetTextureShaderResourceByType(TextureType_Roughness);
-				textures[2] = material->GetTextureShaderResourceByType(TextureType_Metallic);
-				textures[3] = material->GetTextureShaderResourceByType(TextureType_Normal);
-				textures[4] = material->GetTextureShaderResourceByType(TextureType_Height);
-				textures[5] = material->GetTextureShaderResourceByType(TextureType_Occlusion);
-				textures[6] = material->GetTextureShaderResourceByType(TextureType_Emission);
-				textures[7] = material->GetTextureShaderResourceByType(TextureType_Mask);
-				m_cmd_list->SetTextures(0, textures);
-
-				// Bind material buffer
-				material->UpdateConstantBuffer();
-				m_cmd_list->SetConstantBuffer(1, Buffer_PixelShader, material->GetConstantBuffer());
+				InstanceBufferGBuffer data;
+				data.offset = batch.instance_offset;
+				m_constant_ring_allocations.emplace_back(m_constant_ring.AllocateValue(data));
+				m_profiler->m_renderer_batches_instanced++;
+				continue;
+			}
 
-				currently_bound_material = material->GetResourceId();
+			for (auto j = batch.instance_offset; j < batch.instance_offset + batch.instance_count; j++)
+			{
+				auto allocation = m_constant_ring.Allocate(static_cast<unsigned int>(sizeof(Transform::CB_Gbuffer)));
+				if (allocation.data)
+				{
+					entities_opaque[instances[j]]->GetTransform_PtrRaw()->UpdateInstanceData(m_view_projection, static_cast<Transform::CB_Gbuffer*>(allocation.data));
+				}
+				m_constant_ring_allocations.emplace_back(allocation);
 			}
+		}
+		ConstantRingFlush();
 
-			// Bind object buffer
-			Transform* transform = entity->GetTransform_PtrRaw();
-			transform->UpdateConstantBuffer(m_rhi_device, m_view_projection);
-			m_cmd_list->SetConstantBuffer(2, Buffer_VertexShader, transform->GetConstantBuffer());
+		// Ranges of batches are recorded in parallel, each binds everything it uses
+		RecordParallel(static_cast<unsigned int>(batches.size()), [this, &batches, &instances, &entities_opaque, instancing](RHI_CommandList* cmd_list, const unsigned int batch_start, const unsigned int batch_end)
+		{
+			// Variables that help reduce state changes
+			unsigned int currently_bound_geometry	= 0;
+			unsigned int currently_bound_shader		= 0;
+			unsigned int currently_bound_material	= 0;
+			RHI_Shader* currently_bound_vertex		= nullptr;
+			unsigned int allocation_index			= m_batch_allocations[batch_start];
+			void* textures[8];
+
+			for (auto batch_index = batch_start; batch_index < batch_end; batch_index++)
+			{
+				// All the instances of a batch share these
+				const auto& batch	= batches[batch_index];
+				auto renderable		= entities_opaque[instances[batch.instance_offset]]->GetRenderable_PtrRaw();
+				auto material		= renderable->MaterialPtr().get();
+				auto shader			= material->GetShader();
+				auto model			= renderable->GeometryModel();
 
-			// Render	
-			m_cmd_list->DrawIndexed(renderable->GeometryIndexCount(), renderable->GeometryIndexOffset(), renderable->GeometryVertexOffset());
-			m_profiler->m_renderer_meshes_rendered++;
+				// Set face culling (changes only if required)
+				cmd_list->SetRasterizerState(GetRasterizerState(material->GetCullMode(), Fill_Solid));
+
+				// Bind geometry
+				if (currently_bound_geometry != model->GetResourceId())
+				{
+					cmd_list->SetBufferIndex(model->GetIndexBuffer());
+					cmd_list->SetBufferVertex(model->GetVertexBuffer());
+					currently_bound_geometry = model->GetResourceId();
+				}
+
+				// Bind shader
+				if (currently_bound_shader != shader->RHI_GetID())
+				{
+					cmd_list->SetShaderPixel(static_pointer_cast<RHI_Shader>(shader));
+					currently_bound_shader = shader->RHI_GetID();
+				}
+
+				// Bind material
+				if (currently_bound_material != material->GetResourceId())
+				{
+					// Bind material textures
+					textures[0] = material->GetTextureShaderResourceByType(TextureType_Albedo);
+					textures[1] = material->GetTextureShaderResourceByType(TextureType_Roughness);
+					textures[2] = material->GetTextureShaderResourceByType(TextureType_Metallic);
+					textures[3] = material->GetTextureShaderResourceByType(TextureType_Normal);
+					textures[4] = material->GetTextureShaderResourceByType(TextureType_Height);
+					textures[5] = material->GetTextureShaderResourceByType(TextureType_Occlusion);
+					textures[6] = material->GetTextureShaderResourceByType(TextureType_Emission);
+					textures[7] = material->GetTextureShaderResourceByType(TextureType_Mask);
+					cmd_list->SetTextures(0, textures, 8);
+
+					// Bind material buffer
+					cmd_list->SetConstantBuffer(1, Buffer_PixelShader, material->GetConstantBuffer());
+
+					currently_bound_material = material->GetResourceId();
+				}
+
+				// Bind vertex shader
+				const bool instanced	= instancing && batch.instance_count > 1;
+				const auto& vertex		= instanced ? m_vs_gbuffer_instanced : m_vs_gbuffer;
+				if (currently_bound_vertex != vertex.get())
+				{
+					cmd_list->SetShaderVertex(vertex);
+					currently_bound_vertex = vertex.get();
+				}
+
+				// Render all the instances with a single draw
+				if (instanced)
+				{
+					SetConstantBuffer(cmd_list, 2, Buffer_VertexShader, m_constant_ring_allocations[allocation_index++]);
+					cmd_list->DrawIndexedInstanced(batch.draw.index_count, batch.instance_count, batch.draw.index_offset, batch.draw.vertex_offset, 0);
+					continue;
+				}
 
-		} // ENTITY/MESH ITERATION
+				for (auto j = batch.instance_offset; j < batch.instance_offset + batch.instance_count; j++)
+				{
+					// Bind object buffer
+					SetConstantBuffer(cmd_list, 2, Buffer_VertexShader, m_constant_ring_allocations[allocation_index++]);
+
+					// Render	
+					cmd_list->DrawIndexed(batch.draw.index_count, batch.draw.index_offset, batch.draw.vertex_offset);
+				}
+			} // BATCH ITERATION
+		});
 
 		m_cmd_list->End();
 		m_cmd_list->Submit();
@@ -324,31 +550,42 @@ namespace Spartan
 		m_cmd_list->SetBufferVertex(m_quad.GetVertexBuffer());
 		m_cmd_list->SetBufferIndex(m_quad.GetIndexBuffer());
 
+		// The blur leaves its result in tex_in and swaps it with its output. The frame graph expects
+		// the textures to be swapped the same way whether the shadows are mapped, cleared, or culled.
+
 		// Shadow mapping + Blur
-		auto shadow_mapped = false;
-		if (auto light_dir = GetLightDirectional())
+		auto light_dir = GetLightDirectional();
+		if (!m_frame_graph.IsPassActive("Pass_ShadowMapping"))
 		{
-			if (light_dir->GetCastShadows())
-			{
-				Pass_ShadowMapping(tex_in, GetLightDirectional());
-				const auto sigma		= 1.0f;
-				const auto pixel_stride	= 1.0f;
-				Pass_BlurBilateralGaussian(tex_in, tex_shadows_out, sigma, pixel_stride);
-				shadow_mapped = true;
-			}
+			tex_in.swap(tex_shadows_out);
+		}
+		else if (light_dir && light_dir->GetCastShadows())
+		{
+			Pass_ShadowMapping(tex_in, light_dir);
+			const auto sigma		= 1.0f;
+			const auto pixel_stride	= 1.0f;
+			Pass_BlurBilateralGaussian(tex_in, tex_shadows_out, sigma, pixel_stride);
 		}
-		if (!shadow_mapped)
+		else
 		{
-			tex_shadows_out->Clear(m_cmd_list, 1, 1, 1, 1);
+			tex_in->Clear(m_cmd_list, 1, 1, 1, 1);
+			tex_in.swap(tex_shadows_out);
 		}
 
 		// SSAO + Blur
 		if (m_flags & Render_PostProcess_SSAO)
 		{
-			Pass_SSAO(tex_in);
-			const auto sigma		= 1.0f;
-			const auto pixel_stride	= 1.0f;
-			Pass_BlurBilateralGaussian(tex_in, tex_ssao_out, sigma, pixel_stride);
+			if (m_frame_graph.IsPassActive("Pass_SSAO"))
+			{
+				Pass_SSAO(tex_in);
+				const auto sigma		= 1.0f;
+				const auto pixel_stride	= 1.0f;
+				Pass_BlurBilateralGaussian(tex_in, tex_ssao_out, sigma, pixel_stride);
+			}
+			else
+			{
+				tex_in.swap(tex_ssao_out);
+			}
 		}
 
 		m_cmd_list->End();
@@ -368,15 +605,18 @@ namespace Spartan
 			m_view_projection_orthographic,
 			m_view,
 			m_projection,
+			m_projection_unjittered,
+			m_near_plane,
+			m_far_plane,
 			m_entities[Renderable_Light],
-			Flags_IsSet(Render_PostProcess_SSR)
+			Flags_IsSet(Render_PostProcess_SSR),
+			m_context->GetSubsystem<Threading>().get()
 		);
 
 		// Prepare resources
 		auto shader						= static_pointer_cast<RHI_Shader>(m_vps_light);
-		vector<void*> samplers			= { m_sampler_trilinear_clamp->GetBufferView(), m_sampler_point_clamp->GetBufferView() };
-		vector<void*> constant_buffers	= { m_buffer_global->GetBufferView(),  m_vps_light->GetConstantBuffer()->GetBufferView() };
-		vector<void*> textures =
+		FrameVector<void*> samplers			= { m_sampler_trilinear_clamp->GetBufferView(), m_sampler_point_clamp->GetBufferView() };
+		FrameVector<void*> textures =
 		{
 			m_g_buffer_albedo->GetBufferView(),																		// Albedo	
 			m_g_buffer_normal->GetBufferView(),																		// Normal
@@ -386,7 +626,10 @@ namespace Spartan
 			Flags_IsSet(Render_PostProcess_SSAO) ? tex_ssao->GetBufferView() : m_tex_white->GetBufferView(),	// SSAO
 			m_render_tex_full_hdr_light2->GetBufferView(),															// Previous frame
 			m_skybox ? m_skybox->GetTexture()->GetBufferView() : m_tex_white->GetBufferView(),					// Environment
-			m_tex_lut_ibl->GetBufferView()																			// LutIBL
+			m_tex_lut_ibl->GetBufferView(),																			// LutIBL
+			m_vps_light->GetBufferLights()->GetBufferView(),														// Lights
+			m_vps_light->GetBufferClusters()->GetBufferView(),														// Clusters
+			m_vps_light->GetBufferLightIndices()->GetBufferView()													// Light indices
 		};
 
 		// Setup command list
@@ -401,7 +644,8 @@ namespace Spartan
 		m_cmd_list->SetInputLayout(shader->GetInputLayout());
 		m_cmd_list->SetSamplers(0, samplers);
 		m_cmd_list->SetTextures(0, textures);
-		m_cmd_list->SetConstantBuffers(0, Buffer_Global, constant_buffers);
+		SetConstantBuffer(0, Buffer_Global, m_buffer_global);
+		m_cmd_list->SetConstantBuffer(1, Buffer_Global, m_vps_light->GetConstantBuffer());
 		m_cmd_list->SetBufferIndex(m_quad.GetIndexBuffer());
 		m_cmd_list->SetBufferVertex(m_quad.GetVertexBuffer());
 		m_cmd_list->DrawIndexed(m_quad.GetIndexCount(), 0, 0);
@@ -419,7 +663,7 @@ namespace Spartan
 			return;
 
 		// Prepare resources
-		vector<void*> textures = { m_g_buffer_depth->GetBufferView(), m_skybox ? m_skybox->GetTexture()->GetBufferView() : nullptr };
+		FrameVector<void*> textures = { m_g_buffer_depth->GetBufferView(), m_skybox ? m_skybox->GetTexture()->GetBufferView() : nullptr };
 
 		// Begin command list
 		m_cmd_list->Begin("Pass_Transparent");
@@ -434,9 +678,18 @@ namespace Spartan
 		m_cmd_list->SetInputLayout(m_vps_transparent->GetInputLayout());
 		m_cmd_list->SetShaderPixel(m_vps_transparent);
 
-		for (auto& entity : entities_transparent)
+		// Write the object buffers, in the order they are drawn
+		const auto& visibility = m_frustum_visibility[Renderable_ObjectTransparent];
+		FrameVector<Entity*> entities;
+		m_constant_ring_allocations.clear();
+		for (unsigned int i = 0; i < static_cast<unsigned int>(entities_transparent.size()); i++)
 		{
+			// Skip objects outside of the view frustum
+			if (!(visibility[i / 32] & (1u << (i % 32))))
+				continue;
+
 			// Get renderable and material
+			auto entity		= entities_transparent[i];
 			auto renderable	= entity->GetRenderable_PtrRaw();
 			auto material	= renderable ? renderable->MaterialPtr().get() : nullptr;
 
@@ -448,17 +701,7 @@ namespace Spartan
 			if (!model || !model->GetVertexBuffer() || !model->GetIndexBuffer())
 				continue;
 
-			// Skip objects outside of the view frustum
-			if (!m_camera->IsInViewFrustrum(renderable))
-				continue;
-
-			// Set the following per object
-			m_cmd_list->SetRasterizerState(GetRasterizerState(material->GetCullMode(), Fill_Solid));
-			m_cmd_list->SetBufferIndex(model->GetIndexBuffer());
-			m_cmd_list->SetBufferVertex(model->GetVertexBuffer());
-
-			// Constant buffer - TODO: Make per object
-			auto buffer = Struct_Transparency
+			const auto buffer = Struct_Transparency
 			(
 				entity->GetTransform_PtrRaw()->GetMatrix(),
 				m_view,
@@ -468,13 +711,28 @@ namespace Spartan
 				GetLightDirectional()->GetDirection(),
 				material->GetRoughnessMultiplier()
 			);
-			m_vps_transparent->UpdateBuffer(&buffer);
-			m_cmd_list->SetConstantBuffer(1, Buffer_Global, m_vps_transparent->GetConstantBuffer());
-			m_cmd_list->DrawIndexed(renderable->GeometryIndexCount(), renderable->GeometryIndexOffset(), renderable->GeometryVertexOffset());
+			m_constant_ring_allocations.emplace_back(m_constant_ring.AllocateValue(buffer));
+			entities.emplace_back(entity);
 
 			m_profiler->m_renderer_meshes_rendered++;
+		}
+		ConstantRingFlush();
 
-		} // ENTITY/MESH ITERATION
+		// Ranges of entities are recorded in parallel, everything is set per object
+		RecordParallel(static_cast<unsigned int>(entities.size()), [this, &entities](RHI_CommandList* cmd_list, const unsigned int start, const unsigned int end)
+		{
+			for (auto i = start; i < end; i++)
+			{
+				auto renderable	= entities[i]->GetRenderable_PtrRaw();
+				auto model		= renderable->GeometryModel();
+
+				cmd_list->SetRasterizerState(GetRasterizerState(renderable->MaterialPtr()->GetCullMode(), Fill_Solid));
+				cmd_list->SetBufferIndex(model->GetIndexBuffer());
+				cmd_list->SetBufferVertex(model->GetVertexBuffer());
+				SetConstantBuffer(cmd_list, 1, Buffer_Global, m_constant_ring_allocations[i]);
+				cmd_list->DrawIndexed(renderable->GeometryIndexCount(), renderable->GeometryIndexOffset(), renderable->GeometryVertexOffset());
+			}
+		});
 
 		m_cmd_list->End();
 		m_cmd_list->Submit();
@@ -491,9 +749,8 @@ namespace Spartan
 		SetDefaultBuffer(tex_out->GetWidth(), tex_out->GetHeight(), m_view_projection_orthographic);
 		auto buffer = Struct_ShadowMapping((m_view_projection).Inverted(), light_directional_in, m_camera.get());
 		m_vps_shadow_mapping->UpdateBuffer(&buffer);
-		vector<void*> constant_buffers	= { m_buffer_global->GetBufferView(),  m_vps_shadow_mapping->GetConstantBuffer()->GetBufferView() };
-		vector<void*> textures			= { m_g_buffer_normal->GetBufferView(), m_g_buffer_depth->GetBufferView(), light_directional_in->GetShadowMap()->GetBufferView() };
-		vector<void*> samplers			= { m_sampler_compare_depth->GetBufferView(), m_sampler_bilinear_clamp->GetBufferView() };
+		FrameVector<void*> textures			= { m_g_buffer_normal->GetBufferView(), m_g_buffer_depth->GetBufferView(), light_directional_in->GetShadowMap()->GetBufferView() };
+		FrameVector<void*> samplers			= { m_sampler_compare_depth->GetBufferView(), m_sampler_bilinear_clamp->GetBufferView() };
 
 		m_cmd_list->SetRenderTarget(tex_out);
 		m_cmd_list->SetViewport(tex_out->GetViewport());
@@ -502,7 +759,8 @@ namespace Spartan
 		m_cmd_list->SetInputLayout(m_vps_shadow_mapping->GetInputLayout());
 		m_cmd_list->SetTextures(0, textures);
 		m_cmd_list->SetSamplers(0, samplers);
-		m_cmd_list->SetConstantBuffers(0, Buffer_Global, constant_buffers);
+		SetConstantBuffer(0, Buffer_Global, m_buffer_global);
+		m_cmd_list->SetConstantBuffer(1, Buffer_Global, m_vps_shadow_mapping->GetConstantBuffer());
 		m_cmd_list->DrawIndexed(m_quad.GetIndexCount(), 0, 0);
 		m_cmd_list->End();
 		m_cmd_list->Submit();
@@ -521,67 +779,94 @@ namespace Spartan
 		m_cmd_list->SetShaderVertex(m_vs_quad);
 		m_cmd_list->SetInputLayout(m_vs_quad->GetInputLayout());
 
-		// Render target swapping
+		// Render target swapping, passes which the frame graph culled still swap since the graph expects them to
 		const auto swap_targets = [this, &tex_in, &tex_out]() { m_cmd_list->Submit(); tex_out.swap(tex_in); };
 
 		// TAA	
 		if (Flags_IsSet(Render_PostProcess_TAA))
 		{
-			Pass_TAA(tex_in, tex_out);
+			if (m_frame_graph.IsPassActive("Pass_TAA"))
+			{
+				Pass_TAA(tex_in, tex_out);
+			}
 			swap_targets();
 		}
 
 		// Bloom
 		if (Flags_IsSet(Render_PostProcess_Bloom))
 		{
-			Pass_Bloom(tex_in, tex_out);
+			if (m_frame_graph.IsPassActive("Pass_Bloom"))
+			{
+				Pass_Bloom(tex_in, tex_out);
+			}
 			swap_targets();
 		}
 
 		// Motion Blur
 		if (Flags_IsSet(Render_PostProcess_MotionBlur))
 		{
-			Pass_MotionBlur(tex_in, tex_out);
+			if (m_frame_graph.IsPassActive("Pass_MotionBlur"))
+			{
+				Pass_MotionBlur(tex_in, tex_out);
+			}
 			swap_targets();
 		}
 
 		// Dithering
 		if (Flags_IsSet(Render_PostProcess_Dithering))
 		{
-			Pass_Dithering(tex_in, tex_out);
+			if (m_frame_graph.IsPassActive("Pass_Dithering"))
+			{
+				Pass_Dithering(tex_in, tex_out);
+			}
 			swap_targets();
 		}
 
 		// Tone-Mapping
 		if (m_tonemapping != ToneMapping_Off)
 		{
-			Pass_ToneMapping(tex_in, tex_out);
+			if (m_frame_graph.IsPassActive("Pass_ToneMapping"))
+			{
+				Pass_ToneMapping(tex_in, tex_out);
+			}
 			swap_targets();
 		}
 
 		// FXAA
 		if (Flags_IsSet(Render_PostProcess_FXAA))
 		{
-			Pass_FXAA(tex_in, tex_out);
+			if (m_frame_graph.IsPassActive("Pass_FXAA"))
+			{
+				Pass_FXAA(tex_in, tex_out);
+			}
 			swap_targets();
 		}
 
 		// Sharpening
 		if (Flags_IsSet(Render_PostProcess_Sharpening))
 		{
-			Pass_Sharpening(tex_in, tex_out);
+			if (m_frame_graph.IsPassActive("Pass_Sharpening"))
+			{
+				Pass_Sharpening(tex_in, tex_out);
+			}
 			swap_targets();
 		}
 
 		// Chromatic aberration
 		if (Flags_IsSet(Render_PostProcess_ChromaticAberration))
 		{
-			Pass_ChromaticAberration(tex_in, tex_out);
+			if (m_frame_graph.IsPassActive("Pass_ChromaticAberration"))
+			{
+				Pass_ChromaticAberration(tex_in, tex_out);
+			}
 			swap_targets();
 		}
 
 		// Gamma correction
-		Pass_GammaCorrection(tex_in, tex_out);
+		if (m_frame_graph.IsPassActive("Pass_GammaCorrection"))
+		{
+			Pass_GammaCorrection(tex_in, tex_out);
+		}
 
 		m_cmd_list->End();
 		m_cmd_list->Submit();
@@ -592,8 +877,8 @@ namespace Spartan
 		m_cmd_list->Begin("Pass_SSAO");
 
 		// Prepare resources
-		vector<void*> textures = { m_g_buffer_normal->GetBufferView(), m_g_buffer_depth->GetBufferView(), m_tex_noise_normal->GetBufferView() };
-		vector<void*> samplers = { m_sampler_bilinear_clamp->GetBufferView() /*SSAO (clamp) */, m_sampler_bilinear_wrap->GetBufferView() /*SSAO noise texture (wrap)*/};
+		FrameVector<void*> textures = { m_g_buffer_normal->GetBufferView(), m_g_buffer_depth->GetBufferView(), m_tex_noise_normal->GetBufferView() };
+		FrameVector<void*> samplers = { m_sampler_bilinear_clamp->GetBufferView() /*SSAO (clamp) */, m_sampler_bilinear_wrap->GetBufferView() /*SSAO noise texture (wrap)*/};
 		SetDefaultBuffer(tex_out->GetWidth(), tex_out->GetHeight());
 
 		m_cmd_list->ClearTextures(); // avoids d3d11 warning where the render target is already bound as an input texture (from some previous pass)
@@ -604,7 +889,7 @@ namespace Spartan
 		m_cmd_list->SetShaderPixel(m_vps_ssao);
 		m_cmd_list->SetTextures(0, textures);
 		m_cmd_list->SetSamplers(0, samplers);
-		m_cmd_list->SetConstantBuffer(0, Buffer_Global, m_buffer_global);
+		SetConstantBuffer(0, Buffer_Global, m_buffer_global);
 		m_cmd_list->DrawIndexed(m_quad.GetIndexCount(), 0, 0);
 		m_cmd_list->End();
 		m_cmd_list->Submit();
@@ -621,7 +906,7 @@ namespace Spartan
 		m_cmd_list->SetShaderPixel(m_ps_blur_box);
 		m_cmd_list->SetTexture(0, tex_in); // Shadows are in the alpha channel
 		m_cmd_list->SetSampler(0, m_sampler_trilinear_clamp);
-		m_cmd_list->SetConstantBuffer(0, Buffer_Global, m_buffer_global);
+		SetConstantBuffer(0, Buffer_Global, m_buffer_global);
 		m_cmd_list->DrawIndexed(m_quad.GetIndexCount(), 0, 0);
 		m_cmd_list->End();
 		m_cmd_list->Submit();
@@ -642,7 +927,7 @@ namespace Spartan
 		m_cmd_list->SetViewport(tex_out->GetViewport());
 		m_cmd_list->SetShaderPixel(m_ps_blur_gaussian);
 		m_cmd_list->SetSampler(0, m_sampler_bilinear_clamp);
-		m_cmd_list->SetConstantBuffer(0, Buffer_Global, m_buffer_global);
+		SetConstantBuffer(0, Buffer_Global, m_buffer_global);
 
 		// Horizontal Gaussian blur	
 		m_cmd_list->Begin("Pass_BlurBilateralGaussian_Horizontal");
@@ -698,7 +983,7 @@ namespace Spartan
 		m_cmd_list->SetInputLayout(m_vs_quad->GetInputLayout());
 		m_cmd_list->SetShaderPixel(m_ps_blur_gaussian_bilateral);	
 		m_cmd_list->SetSampler(0, m_sampler_bilinear_clamp);
-		m_cmd_list->SetConstantBuffer(0, Buffer_Global, m_buffer_global);
+		SetConstantBuffer(0, Buffer_Global, m_buffer_global);
 
 		// Horizontal Gaussian blur
 		m_cmd_list->Begin("Pass_BlurBilateralGaussian_Horizontal");
@@ -707,7 +992,7 @@ namespace Spartan
 			auto direction	= Vector2(pixel_stride, 0.0f);
 			auto buffer		= Struct_Blur(direction, sigma);
 			m_ps_blur_gaussian_bilateral->UpdateBuffer(&buffer, 0);
-			vector<void*> textures = { tex_in->GetBufferView(), m_g_buffer_depth->GetBufferView(), m_g_buffer_normal->GetBufferView() };
+			FrameVector<void*> textures = { tex_in->GetBufferView(), m_g_buffer_depth->GetBufferView(), m_g_buffer_normal->GetBufferView() };
 			
 			m_cmd_list->ClearTextures(); // avoids d3d11 warning where render target is also bound as texture (from Pass_PreLight)
 			m_cmd_list->SetRenderTarget(tex_out);
@@ -724,7 +1009,7 @@ namespace Spartan
 			auto direction	= Vector2(0.0f, pixel_stride);
 			auto buffer		= Struct_Blur(direction, sigma);
 			m_ps_blur_gaussian_bilateral->UpdateBuffer(&buffer, 1);
-			vector<void*> textures = { tex_out->GetBufferView(), m_g_buffer_depth->GetBufferView(), m_g_buffer_normal->GetBufferView() };
+			FrameVector<void*> textures = { tex_out->GetBufferView(), m_g_buffer_depth->GetBufferView(), m_g_buffer_normal->GetBufferView() };
 
 			m_cmd_list->ClearTextures(); // avoids d3d11 warning where render target is also bound as texture (from above pass)
 			m_cmd_list->SetRenderTarget(tex_in);
@@ -748,7 +1033,7 @@ namespace Spartan
 		{
 			// Prepare resources
 			SetDefaultBuffer(m_render_tex_full_taa_current->GetWidth(), m_render_tex_full_taa_current->GetHeight());
-			vector<void*> textures = { m_render_tex_full_taa_history->GetBufferView(), tex_in->GetBufferView(), m_g_buffer_velocity->GetBufferView(), m_g_buffer_depth->GetBufferView() };
+			FrameVector<void*> textures = { m_render_tex_full_taa_history->GetBufferView(), tex_in->GetBufferView(), m_g_buffer_velocity->GetBufferView(), m_g_buffer_depth->GetBufferView() };
 
 			m_cmd_list->ClearTextures(); // avoids d3d11 warning where the render target is already bound as an input texture (from some previous pass)
 			m_cmd_list->SetRenderTarget(m_render_tex_full_taa_current);
@@ -756,7 +1041,7 @@ namespace Spartan
 			m_cmd_list->SetShaderPixel(m_ps_taa);
 			m_cmd_list->SetSampler(0, m_sampler_bilinear_clamp);
 			m_cmd_list->SetTextures(0, textures);
-			m_cmd_list->SetConstantBuffer(0, Buffer_Global, m_buffer_global);
+			SetConstantBuffer(0, Buffer_Global, m_buffer_global);
 			m_cmd_list->DrawIndexed(m_quad.GetIndexCount(), 0, 0);
 		}
 
@@ -770,7 +1055,7 @@ namespace Spartan
 			m_cmd_list->SetShaderPixel(m_ps_texture);
 			m_cmd_list->SetSampler(0, m_sampler_point_clamp);
 			m_cmd_list->SetTexture(0, m_render_tex_full_taa_current);
-			m_cmd_list->SetConstantBuffer(0, Buffer_Global, m_buffer_global);
+			SetConstantBuffer(0, Buffer_Global, m_buffer_global);
 			m_cmd_list->DrawIndexed(m_quad.GetIndexCount(), 0, 0);
 		}
 
@@ -795,7 +1080,7 @@ namespace Spartan
 			m_cmd_list->SetViewport(m_render_tex_quarter_blur1->GetViewport());
 			m_cmd_list->SetShaderPixel(m_ps_downsample_box);
 			m_cmd_list->SetTexture(0, tex_in);
-			m_cmd_list->SetConstantBuffer(0, Buffer_Global, m_buffer_global);
+			SetConstantBuffer(0, Buffer_Global, m_buffer_global);
 			m_cmd_list->DrawIndexed(m_quad.GetIndexCount(), 0, 0);
 		}
 		m_cmd_list->End();
@@ -809,7 +1094,7 @@ namespace Spartan
 			m_cmd_list->SetViewport(m_render_tex_quarter_blur2->GetViewport());	
 			m_cmd_list->SetShaderPixel(m_ps_bloom_bright);
 			m_cmd_list->SetTexture(0, m_render_tex_quarter_blur1);
-			m_cmd_list->SetConstantBuffer(0, Buffer_Global, m_buffer_global);
+			SetConstantBuffer(0, Buffer_Global, m_buffer_global);
 			m_cmd_list->DrawIndexed(m_quad.GetIndexCount(), 0, 0);
 		}
 		m_cmd_list->End();
@@ -829,7 +1114,7 @@ namespace Spartan
 			m_cmd_list->SetViewport(m_render_tex_half_spare2->GetViewport());
 			m_cmd_list->SetShaderPixel(m_ps_upsample_box);
 			m_cmd_list->SetTexture(0, m_render_tex_quarter_blur2);
-			m_cmd_list->SetConstantBuffer(0, Buffer_Global, m_buffer_global);
+			SetConstantBuffer(0, Buffer_Global, m_buffer_global);
 			m_cmd_list->DrawIndexed(m_quad.GetIndexCount(), 0, 0);
 		}
 		m_cmd_list->End();
@@ -843,7 +1128,7 @@ namespace Spartan
 			m_cmd_list->SetViewport(m_render_tex_full_spare->GetViewport());
 			m_cmd_list->SetShaderPixel(m_ps_upsample_box);
 			m_cmd_list->SetTexture(0, m_render_tex_half_spare2);
-			m_cmd_list->SetConstantBuffer(0, Buffer_Global, m_buffer_global);
+			SetConstantBuffer(0, Buffer_Global, m_buffer_global);
 			m_cmd_list->DrawIndexed(m_quad.GetIndexCount(), 0, 0);
 		}
 		m_cmd_list->End();
@@ -852,13 +1137,13 @@ namespace Spartan
 		{
 			// Prepare resources
 			SetDefaultBuffer(tex_out->GetWidth(), tex_out->GetHeight());
-			vector<void*> textures = { tex_in->GetBufferView(), m_render_tex_full_spare->GetBufferView() };
+			FrameVector<void*> textures = { tex_in->GetBufferView(), m_render_tex_full_spare->GetBufferView() };
 
 			m_cmd_list->SetRenderTarget(tex_out);
 			m_cmd_list->SetViewport(tex_out->GetViewport());
 			m_cmd_list->SetShaderPixel(m_ps_bloom_blend);
 			m_cmd_list->SetTextures(0, textures);
-			m_cmd_list->SetConstantBuffer(0, Buffer_Global, m_buffer_global);
+			SetConstantBuffer(0, Buffer_Global, m_buffer_global);
 			m_cmd_list->DrawIndexed(m_quad.GetIndexCount(), 0, 0);
 		}
 		m_cmd_list->End();
@@ -880,7 +1165,7 @@ namespace Spartan
 		m_cmd_list->SetShaderPixel(m_ps_tone_mapping);
 		m_cmd_list->SetTexture(0, tex_in);
 		m_cmd_list->SetSampler(0, m_sampler_point_clamp);
-		m_cmd_list->SetConstantBuffer(0, Buffer_Global, m_buffer_global);
+		SetConstantBuffer(0, Buffer_Global, m_buffer_global);
 		m_cmd_list->DrawIndexed(m_quad.GetIndexCount(), 0, 0);
 		m_cmd_list->End();
 		m_cmd_list->Submit();
@@ -899,7 +1184,7 @@ namespace Spartan
 		m_cmd_list->SetShaderPixel(m_ps_gamma_correction);
 		m_cmd_list->SetTexture(0, tex_in);
 		m_cmd_list->SetSampler(0, m_sampler_point_clamp);
-		m_cmd_list->SetConstantBuffer(0, Buffer_Global, m_buffer_global);
+		SetConstantBuffer(0, Buffer_Global, m_buffer_global);
 		m_cmd_list->DrawIndexed(m_quad.GetIndexCount(), 0, 0);
 		m_cmd_list->End();
 		m_cmd_list->Submit();
@@ -916,7 +1201,7 @@ namespace Spartan
 		m_cmd_list->SetRenderTarget(tex_out);
 		m_cmd_list->SetViewport(tex_out->GetViewport());
 		m_cmd_list->SetSampler(0, m_sampler_bilinear_clamp);
-		m_cmd_list->SetConstantBuffer(0, Buffer_Global, m_buffer_global);
+		SetConstantBuffer(0, Buffer_Global, m_buffer_global);
 
 		// Luma
 		m_cmd_list->SetRenderTarget(tex_out);	
@@ -950,7 +1235,7 @@ namespace Spartan
 		m_cmd_list->SetShaderPixel(m_ps_chromatic_aberration);
 		m_cmd_list->SetTexture(0, tex_in);
 		m_cmd_list->SetSampler(0, m_sampler_bilinear_clamp);
-		m_cmd_list->SetConstantBuffer(0, Buffer_Global, m_buffer_global);
+		SetConstantBuffer(0, Buffer_Global, m_buffer_global);
 		m_cmd_list->DrawIndexed(m_quad.GetIndexCount(), 0, 0);
 		m_cmd_list->End();
 		m_cmd_list->Submit();
@@ -961,7 +1246,7 @@ namespace Spartan
 		m_cmd_list->Begin("Pass_MotionBlur");
 
 		// Prepare resources
-		vector<void*> textures = { tex_in->GetBufferView(), m_g_buffer_velocity->GetBufferView() };
+		FrameVector<void*> textures = { tex_in->GetBufferView(), m_g_buffer_velocity->GetBufferView() };
 		SetDefaultBuffer(tex_out->GetWidth(), tex_out->GetHeight());
 
 		m_cmd_list->ClearTextures(); // avoids d3d11 warning where the render target is already bound as an input texture (from previous pass)
@@ -970,7 +1255,7 @@ namespace Spartan
 		m_cmd_list->SetShaderPixel(m_ps_motion_blur);
 		m_cmd_list->SetSampler(0, m_sampler_bilinear_clamp);
 		m_cmd_list->SetTextures(0, textures);
-		m_cmd_list->SetConstantBuffer(0, Buffer_Global, m_buffer_global);
+		SetConstantBuffer(0, Buffer_Global, m_buffer_global);
 		m_cmd_list->DrawIndexed(m_quad.GetIndexCount(), 0, 0);
 		m_cmd_list->End();
 		m_cmd_list->Submit();
@@ -989,7 +1274,7 @@ namespace Spartan
 		m_cmd_list->SetShaderPixel(m_ps_dithering);
 		m_cmd_list->SetSampler(0, m_sampler_point_clamp);
 		m_cmd_list->SetTexture(0, tex_in);
-		m_cmd_list->SetConstantBuffer(0, Buffer_Global, m_buffer_global);
+		SetConstantBuffer(0, Buffer_Global, m_buffer_global);
 		m_cmd_list->DrawIndexed(m_quad.GetIndexCount(), 0, 0);
 		m_cmd_list->End();
 		m_cmd_list->Submit();
@@ -1008,7 +1293,7 @@ namespace Spartan
 		m_cmd_list->SetShaderPixel(m_ps_sharpening);
 		m_cmd_list->SetTexture(0, tex_in);
 		m_cmd_list->SetSampler(0, m_sampler_bilinear_clamp);
-		m_cmd_list->SetConstantBuffer(0, Buffer_Global, m_buffer_global);
+		SetConstantBuffer(0, Buffer_Global, m_buffer_global);
 		m_cmd_list->DrawIndexed(m_quad.GetIndexCount(), 0, 0);
 		m_cmd_list->End();
 		m_cmd_list->Submit();
@@ -1085,7 +1370,7 @@ namespace Spartan
 				m_cmd_list->SetBufferIndex(m_gizmo_grid->GetIndexBuffer());
 				m_cmd_list->SetBufferVertex(m_gizmo_grid->GetVertexBuffer());
 				m_cmd_list->SetBlendState(m_blend_enabled);
-				m_cmd_list->SetConstantBuffer(0, Buffer_Global, m_buffer_global);
+				SetConstantBuffer(0, Buffer_Global, m_buffer_global);
 				m_cmd_list->DrawIndexed(m_gizmo_grid->GetIndexCount(), 0, 0);
 			}
 
@@ -1106,7 +1391,7 @@ namespace Spartan
 
 				SetDefaultBuffer(static_cast<unsigned int>(m_resolution.x), static_cast<unsigned int>(m_resolution.y), view_projection_unjittered);
 				m_cmd_list->SetBufferVertex(m_vertex_buffer_lines);
-				m_cmd_list->SetConstantBuffer(0, Buffer_Global, m_buffer_global);
+				SetConstantBuffer(0, Buffer_Global, m_buffer_global);
 				m_cmd_list->Draw(line_vertex_buffer_size);
 
 				m_lines_list_depth_enabled.clear();
@@ -1185,7 +1470,7 @@ namespace Spartan
 
 				// Choose texture based on light type
 				shared_ptr<RHI_Texture> light_tex = nullptr;
-				auto type = entity->GetComponent<Light>()->GetLightType();
+				auto type = entity->GetComponent_PtrRaw<Light>()->GetLightType();
 				if (type == LightType_Directional)	light_tex = m_gizmo_tex_light_directional;
 				else if (type == LightType_Point)	light_tex = m_gizmo_tex_light_point;
 				else if (type == LightType_Spot)	light_tex = m_gizmo_tex_light_spot;
@@ -1207,7 +1492,7 @@ namespace Spartan
 				m_cmd_list->SetShaderPixel(m_ps_texture);
 				m_cmd_list->SetInputLayout(m_vs_quad->GetInputLayout());
 				m_cmd_list->SetSampler(0, m_sampler_bilinear_clamp);
-				m_cmd_list->SetConstantBuffer(0, Buffer_Global, m_buffer_global);
+				SetConstantBuffer(0, Buffer_Global, m_buffer_global);
 				m_cmd_list->SetTexture(0, light_tex);
 				m_cmd_list->SetBufferIndex(m_gizmo_light_rect.GetIndexBuffer());
 				m_cmd_list->SetBufferVertex(m_gizmo_light_rect.GetVertexBuffer());
@@ -1229,7 +1514,7 @@ namespace Spartan
 			m_cmd_list->SetInputLayout(m_vps_gizmo_transform->GetInputLayout());
 			m_cmd_list->SetBufferIndex(m_gizmo_transform->GetIndexBuffer());
 			m_cmd_list->SetBufferVertex(m_gizmo_transform->GetVertexBuffer());
-			m_cmd_list->SetConstantBuffer(0, Buffer_Global, m_buffer_global);
+			SetConstantBuffer(0, Buffer_Global, m_buffer_global);
 
 			// Axis - X
 			auto buffer = Struct_Matrix_Vector3(m_gizmo_transform->GetHandle().GetTransform(Vector3::Right), m_gizmo_transform->GetHandle().GetColor(Vector3::Right));
@@ -1360,7 +1645,7 @@ namespace Spartan
 		m_cmd_list->SetShaderVertex(m_vs_quad);
 		m_cmd_list->SetInputLayout(m_vs_quad->GetInputLayout());
 		m_cmd_list->SetSampler(0, m_sampler_bilinear_clamp);
-		m_cmd_list->SetConstantBuffer(0, Buffer_Global, m_buffer_global);
+		SetConstantBuffer(0, Buffer_Global, m_buffer_global);
 		m_cmd_list->SetBufferVertex(m_quad.GetVertexBuffer());
 		m_cmd_list->SetBufferIndex(m_quad.GetIndexBuffer());
 		m_cmd_list->DrawIndexed(m_quad.GetIndexCount(), 0, 0);
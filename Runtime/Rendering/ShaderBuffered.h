@@ -27,6 +27,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../World/Components/Light.h"
 #include "../RHI/RHI_RenderTexture.h"
 #include "../RHI/RHI_Shader.h"
+#include "../RHI/RHI_ConstantBuffer.h"
 //====================================
 
 namespace Spartan
@@ -263,7 +264,7 @@ namespace Spartan
 		template <typename T>
 		void AddBuffer()
 		{
-			m_buffers.emplace_back(std::make_shared<RHI_ConstantBuffer>(m_rhi_device))->Create<T>();
+			m_buffers.emplace_back(std::make_shared<RHI_ConstantBuffer>(m_rhi_device))->template Create<T>();
 
 		}
 		
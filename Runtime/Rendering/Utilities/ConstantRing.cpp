@@ -0,0 +1,94 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ===========
+#include "ConstantRing.h"
+//======================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+	ConstantRing::ConstantRing(const unsigned int page_size, const unsigned int alignment, const bool page_per_allocation)
+	{
+		m_alignment				= alignment;
+		m_page_size				= (page_size + alignment - 1) & ~(alignment - 1);
+		m_page_per_allocation	= page_per_allocation;
+	}
+
+	void ConstantRing::Reset()
+	{
+		fill(m_page_used.begin(), m_page_used.end(), 0);
+		fill(m_page_flushed.begin(), m_page_flushed.end(), 0);
+		m_page_current		= 0;
+		m_allocation_count	= 0;
+		m_bytes_allocated	= 0;
+	}
+
+	ConstantRing::Allocation ConstantRing::Allocate(const unsigned int size)
+	{
+		Allocation allocation;
+		allocation.size = (size + m_alignment - 1) & ~(m_alignment - 1);
+		if (allocation.size == 0 || allocation.size > m_page_size)
+			return allocation;
+
+		// Move on to the next page when this one is full, allocations never straddle pages
+		if (m_page_current < m_pages.size())
+		{
+			const auto used = m_page_used[m_page_current];
+			if (m_page_per_allocation ? used != 0 : used + allocation.size > m_page_size)
+			{
+				m_page_current++;
+			}
+		}
+
+		if (m_page_current == m_pages.size())
+		{
+			m_pages.emplace_back(make_unique<uint8_t[]>(m_page_size));
+			m_page_used.emplace_back(0);
+			m_page_flushed.emplace_back(0);
+		}
+
+		allocation.page				= m_page_current;
+		allocation.offset			= m_page_used[m_page_current];
+		allocation.data				= m_pages[m_page_current].get() + allocation.offset;
+		m_page_used[m_page_current]	+= allocation.size;
+		m_allocation_count++;
+		m_bytes_allocated			+= allocation.size;
+
+		return allocation;
+	}
+
+	void ConstantRing::Flush(vector<Range>& ranges)
+	{
+		ranges.clear();
+		for (unsigned int page = 0; page < static_cast<unsigned int>(m_pages.size()); page++)
+		{
+			if (m_page_used[page] == m_page_flushed[page])
+				continue;
+
+			ranges.push_back({ page, m_page_flushed[page], m_page_used[page] - m_page_flushed[page] });
+			m_page_flushed[page] = m_page_used[page];
+		}
+	}
+}
@@ -0,0 +1,97 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ==================
+#include <vector>
+#include <memory>
+#include <cstring>
+#include "../../Core/EngineDefs.h"
+//=============================
+
+namespace Spartan
+{
+	// Sub-allocates the constant data of a frame out of a few large pages, so that draws bind a slice by offset
+	// instead of owning a buffer each. Only the bookkeeping and a CPU copy of every page live here, uploading
+	// the ranges returned by Flush() is up to the caller. Pages are kept from frame to frame.
+	class SPARTAN_CLASS ConstantRing
+	{
+	public:
+		struct Allocation
+		{
+			unsigned int page	= 0;
+			unsigned int offset	= 0;
+			unsigned int size	= 0;		// aligned
+			void* data			= nullptr;	// where to write, null if the allocation failed
+		};
+
+		struct Range
+		{
+			unsigned int page;
+			unsigned int offset;
+			unsigned int size;
+		};
+
+		// The alignment has to be a power of two, D3D11.1 binds constant buffers in multiples of 256 bytes.
+		// Devices that can't bind a slice by offset need page_per_allocation, so that every allocation starts its own page.
+		ConstantRing(unsigned int page_size = 64 * 1024, unsigned int alignment = 256, bool page_per_allocation = false);
+
+		// Starts a new frame, everything allocated so far is given up
+		void Reset();
+
+		// Fails when size doesn't fit in a page, AllocateValue() also copies value into the allocation
+		Allocation Allocate(unsigned int size);
+		template<typename T>
+		Allocation AllocateValue(const T& value)
+		{
+			auto allocation = Allocate(static_cast<unsigned int>(sizeof(T)));
+			if (allocation.data)
+			{
+				memcpy(allocation.data, &value, sizeof(T));
+			}
+			return allocation;
+		}
+
+		// Outputs the ranges allocated since the previous flush, one per page. A range starting
+		// at offset 0 is the first upload of that page in this frame, so its old contents can be discarded.
+		void Flush(std::vector<Range>& ranges);
+
+		const uint8_t* GetPageData(const unsigned int page) const	{ return m_pages[page].get(); }
+		unsigned int GetPageCount() const							{ return static_cast<unsigned int>(m_pages.size()); }
+		unsigned int GetPageSize() const							{ return m_page_size; }
+		unsigned int GetAlignment() const							{ return m_alignment; }
+		bool IsPagePerAllocation() const							{ return m_page_per_allocation; }
+		unsigned int GetAllocationCount() const						{ return m_allocation_count; }
+		unsigned int GetBytesAllocated() const						{ return m_bytes_allocated; }
+
+	private:
+		unsigned int m_page_size;
+		unsigned int m_alignment;
+		bool m_page_per_allocation;
+		std::vector<std::unique_ptr<uint8_t[]>> m_pages;
+		std::vector<unsigned int> m_page_used;
+		std::vector<unsigned int> m_page_flushed;
+		unsigned int m_page_current		= 0;
+		unsigned int m_allocation_count	= 0;
+		unsigned int m_bytes_allocated	= 0;
+	};
+}
@@ -0,0 +1,302 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES =================
+#include "FrameGraph.h"
+#include "../../Logging/Log.h"
+#include <algorithm>
+#include <cstring>
+//============================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+	namespace
+	{
+		// Bytes per pixel, in the order of RHI_Format
+		const uint32_t format_size[] =
+		{
+			1,	// R8_UNORM
+			2,	// R16_UINT
+			2,	// R16_FLOAT
+			4,	// R32_UINT
+			4,	// R32_FLOAT
+			4,	// D32_FLOAT
+			2,	// R8G8_UNORM
+			4,	// R16G16_FLOAT
+			8,	// R32G32_FLOAT
+			12,	// R32G32B32_FLOAT
+			4,	// R8G8B8A8_UNORM
+			8,	// R16G16B16A16_FLOAT
+			16	// R32G32B32A32_FLOAT
+		};
+	}
+
+	void FrameGraph::Clear()
+	{
+		m_textures.clear();
+		m_passes.clear();
+		m_order.clear();
+		m_physical.clear();
+		m_memory_transient				= 0;
+		m_memory_transient_unaliased	= 0;
+	}
+
+	uint32_t FrameGraph::Create(const char* name, const Texture_Desc& desc)
+	{
+		return AddTexture(name, desc, false);
+	}
+
+	uint32_t FrameGraph::Import(const char* name)
+	{
+		return AddTexture(name, Texture_Desc(), true);
+	}
+
+	uint32_t FrameGraph::GetTexture(const char* name) const
+	{
+		for (uint32_t i = 0; i < static_cast<uint32_t>(m_textures.size()); i++)
+		{
+			if (m_textures[i].name == name)
+				return i;
+		}
+
+		return invalid;
+	}
+
+	uint32_t FrameGraph::AddPass(const char* name, const bool enabled /*= true*/)
+	{
+		Pass pass;
+		pass.name		= name;
+		pass.enabled	= enabled;
+		pass.active		= false;
+		m_passes.emplace_back(pass);
+
+		return static_cast<uint32_t>(m_passes.size() - 1);
+	}
+
+	void FrameGraph::SetOutput(const uint32_t texture)
+	{
+		if (texture >= m_textures.size())
+		{
+			LOG_ERROR_INVALID_PARAMETER();
+			return;
+		}
+
+		m_textures[texture].output = true;
+	}
+
+	bool FrameGraph::IsPassActive(const char* name) const
+	{
+		for (const auto& pass : m_passes)
+		{
+			if (pass.name == name)
+				return pass.active;
+		}
+
+		return false;
+	}
+
+	bool FrameGraph::Compile()
+	{
+		m_order.clear();
+		m_physical.clear();
+		m_memory_transient				= 0;
+		m_memory_transient_unaliased	= 0;
+		for (auto& texture : m_textures)
+		{
+			texture.first		= invalid;
+			texture.last		= invalid;
+			texture.physical	= invalid;
+		}
+
+		// Cull, walking back from the outputs. A pass is kept if it writes something that a kept pass after it, or the output, needs.
+		vector<bool> needed(m_textures.size());
+		for (uint32_t i = 0; i < static_cast<uint32_t>(m_textures.size()); i++)
+		{
+			needed[i] = m_textures[i].output;
+		}
+		for (auto pass = m_passes.rbegin(); pass != m_passes.rend(); ++pass)
+		{
+			pass->active = false;
+			pass->barriers.clear();
+			if (!pass->enabled)
+				continue;
+
+			for (const auto& use : pass->uses)
+			{
+				pass->active = pass->active || (use.write && needed[use.texture]);
+			}
+			if (!pass->active)
+				continue;
+
+			// Whatever the pass overwrites isn't needed before it, unless it reads it as well
+			for (const auto& use : pass->uses)
+			{
+				if (use.write && !use.read)
+				{
+					needed[use.texture] = false;
+				}
+			}
+			for (const auto& use : pass->uses)
+			{
+				if (use.read)
+				{
+					needed[use.texture] = true;
+				}
+			}
+		}
+
+		// Order, lifetimes and validation
+		auto valid = true;
+		vector<bool> written(m_textures.size(), false);
+		vector<uint32_t> state(m_textures.size(), State_Undefined);
+		for (uint32_t i = 0; i < static_cast<uint32_t>(m_passes.size()); i++)
+		{
+			if (!m_passes[i].active)
+				continue;
+
+			const auto position = static_cast<uint32_t>(m_order.size());
+			m_order.emplace_back(i);
+
+			for (const auto& use : m_passes[i].uses)
+			{
+				auto& texture = m_textures[use.texture];
+				if (use.read && !texture.imported && !written[use.texture])
+				{
+					LOGF_ERROR("\"%s\" reads \"%s\" before anything writes it", m_passes[i].name.c_str(), texture.name.c_str());
+					valid = false;
+				}
+
+				written[use.texture]	= written[use.texture] || use.write;
+				state[use.texture]		= use.state;
+				texture.first			= texture.first == invalid ? position : texture.first;
+				texture.last			= position;
+			}
+		}
+
+		// Barriers. Transient textures start undefined, imported ones in the state the previous frame left them in.
+		for (uint32_t i = 0; i < static_cast<uint32_t>(m_textures.size()); i++)
+		{
+			if (!m_textures[i].imported)
+			{
+				state[i] = State_Undefined;
+			}
+		}
+		for (const auto i : m_order)
+		{
+			for (const auto& use : m_passes[i].uses)
+			{
+				if (state[use.texture] != use.state)
+				{
+					m_passes[i].barriers.emplace_back(Barrier{ use.texture, state[use.texture], use.state });
+					state[use.texture] = use.state;
+				}
+			}
+		}
+
+		// Aliasing, in the order they start to live every transient texture takes the first physical texture
+		// with the same description which nothing uses anymore, or a new one if there is none
+		vector<uint32_t> transients;
+		for (uint32_t i = 0; i < static_cast<uint32_t>(m_textures.size()); i++)
+		{
+			if (!m_textures[i].imported && m_textures[i].first != invalid)
+			{
+				transients.emplace_back(i);
+			}
+		}
+		stable_sort(transients.begin(), transients.end(), [this](const uint32_t a, const uint32_t b) { return m_textures[a].first < m_textures[b].first; });
+
+		vector<uint32_t> physical_last;
+		for (const auto i : transients)
+		{
+			auto& texture = m_textures[i];
+			for (uint32_t physical = 0; physical < static_cast<uint32_t>(m_physical.size()); physical++)
+			{
+				if (m_physical[physical] == texture.desc && physical_last[physical] < texture.first)
+				{
+					texture.physical = physical;
+					break;
+				}
+			}
+
+			if (texture.physical == invalid)
+			{
+				texture.physical = static_cast<uint32_t>(m_physical.size());
+				m_physical.emplace_back(texture.desc);
+				physical_last.emplace_back(0);
+				m_memory_transient += GetMemory(texture.desc);
+			}
+
+			physical_last[texture.physical] = texture.last;
+			m_memory_transient_unaliased += GetMemory(texture.desc);
+		}
+
+		return valid;
+	}
+
+	uint64_t FrameGraph::GetMemory(const Texture_Desc& desc)
+	{
+		const uint64_t pixels = static_cast<uint64_t>(desc.width) * desc.height;
+		return pixels * format_size[desc.format] + (desc.depth ? pixels * format_size[Format_D32_FLOAT] : 0);
+	}
+
+	void FrameGraph::Access(const uint32_t pass, const uint32_t texture, const uint32_t state, const bool read, const bool write)
+	{
+		if (pass >= m_passes.size() || texture >= m_textures.size())
+		{
+			LOG_ERROR_INVALID_PARAMETER();
+			return;
+		}
+
+		// Merge with an earlier use by the same pass, what it reads after writing doesn't depend on earlier passes
+		auto& uses = m_passes[pass].uses;
+		for (auto& use : uses)
+		{
+			if (use.texture == texture)
+			{
+				use.state	|= state;
+				use.read	= use.read || (read && !use.write);
+				use.write	= use.write || write;
+				return;
+			}
+		}
+
+		uses.emplace_back(Use{ texture, state, read, write });
+	}
+
+	uint32_t FrameGraph::AddTexture(const char* name, const Texture_Desc& desc, const bool imported)
+	{
+		Texture texture;
+		texture.name		= name;
+		texture.desc		= desc;
+		texture.imported	= imported;
+		texture.output		= false;
+		texture.first		= invalid;
+		texture.last		= invalid;
+		texture.physical	= invalid;
+		m_textures.emplace_back(texture);
+
+		return static_cast<uint32_t>(m_textures.size() - 1);
+	}
+}
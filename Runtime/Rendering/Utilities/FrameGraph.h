@@ -0,0 +1,154 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES =======================
+#include <vector>
+#include <string>
+#include "../../Core/EngineDefs.h"
+#include "../../RHI/RHI_Definition.h"
+//==================================
+
+namespace Spartan
+{
+	// Passes declare the textures they read and write, in the order they run. Compile() culls the passes whose results nothing
+	// ends up using, works out how long every texture lives and assigns transient textures to physical ones, so that textures
+	// which are never alive at the same time share one. It only keeps books, creating the physical textures is up to the caller.
+	class SPARTAN_CLASS FrameGraph
+	{
+	public:
+		struct Texture_Desc
+		{
+			uint32_t width;
+			uint32_t height;
+			RHI_Format format;
+			bool depth; // comes with a Format_D32_FLOAT depth-stencil
+
+			bool operator==(const Texture_Desc& rhs) const { return width == rhs.width && height == rhs.height && format == rhs.format && depth == rhs.depth; }
+		};
+
+		// How a pass uses a texture, a pass can use a texture in more than one way
+		enum Texture_State : uint32_t
+		{
+			State_Undefined		= 0,
+			State_ShaderRead	= 1 << 0,
+			State_RenderTarget	= 1 << 1,
+			State_DepthStencil	= 1 << 2
+		};
+
+		// A texture has to go from one state to another before the pass runs
+		struct Barrier
+		{
+			uint32_t texture;
+			uint32_t before;
+			uint32_t after;
+		};
+
+		static constexpr uint32_t invalid = ~0u;
+
+		void Clear();
+
+		//= TEXTURES =========================================================================================================================
+		// Transient textures only live during the frame, their contents are lost between passes that don't use them
+		uint32_t Create(const char* name, const Texture_Desc& desc);
+		// Imported textures are owned by the caller and keep their contents, they are never shared
+		uint32_t Import(const char* name);
+		uint32_t GetTexture(const char* name) const;
+		//====================================================================================================================================
+
+		//= PASSES ===========================================================================================================================
+		// Disabled passes are culled, along with the passes that only they needed
+		uint32_t AddPass(const char* name, bool enabled = true);
+		// Reads the contents of a texture, reading after writing in the same pass reads what the pass wrote
+		void Read(uint32_t pass, uint32_t texture, uint32_t state = State_ShaderRead)			{ Access(pass, texture, state, true, false); }
+		// Overwrites the contents of a texture
+		void Write(uint32_t pass, uint32_t texture, uint32_t state = State_RenderTarget)		{ Access(pass, texture, state, false, true); }
+		// Writes on top of the contents of a texture, e.g. blending or depth testing
+		void ReadWrite(uint32_t pass, uint32_t texture, uint32_t state = State_RenderTarget)	{ Access(pass, texture, state, true, true); }
+		// The contents of the texture are needed after the frame, e.g. it gets presented or read by the next frame
+		void SetOutput(uint32_t texture);
+		//====================================================================================================================================
+
+		// Culls, validates and assigns, returns false if a pass reads a transient texture that nothing wrote
+		bool Compile();
+
+		//= COMPILED =========================================================================================================================
+		bool IsPassActive(uint32_t pass) const										{ return pass < m_passes.size() && m_passes[pass].active; }
+		bool IsPassActive(const char* name) const;
+		// The passes which survived culling, in the order they run
+		const std::vector<uint32_t>& GetPassOrder() const							{ return m_order; }
+		const std::vector<Barrier>& GetBarriers(uint32_t pass) const				{ return m_passes[pass].barriers; }
+		// Whether any active pass uses the texture
+		bool IsTextureUsed(uint32_t texture) const									{ return texture < m_textures.size() && m_textures[texture].first != invalid; }
+		// The physical texture a transient texture was assigned to, invalid if unused or imported
+		uint32_t GetPhysical(uint32_t texture) const								{ return texture < m_textures.size() ? m_textures[texture].physical : invalid; }
+		const std::vector<Texture_Desc>& GetPhysicalTextures() const				{ return m_physical; }
+		const std::string& GetPassName(uint32_t pass) const							{ return m_passes[pass].name; }
+		const std::string& GetTextureName(uint32_t texture) const					{ return m_textures[texture].name; }
+		// Memory of the physical textures, and what it would be if every transient texture had its own
+		uint64_t GetMemoryTransient() const											{ return m_memory_transient; }
+		uint64_t GetMemoryTransientUnaliased() const								{ return m_memory_transient_unaliased; }
+		//====================================================================================================================================
+
+		static uint64_t GetMemory(const Texture_Desc& desc);
+
+	private:
+		struct Texture
+		{
+			std::string name;
+			Texture_Desc desc;
+			bool imported;
+			bool output;
+			// Position of the first and last active pass that use it, in the pass order
+			uint32_t first;
+			uint32_t last;
+			uint32_t physical;
+		};
+
+		struct Use
+		{
+			uint32_t texture;
+			uint32_t state;
+			bool read; // depends on what earlier passes wrote
+			bool write;
+		};
+
+		struct Pass
+		{
+			std::string name;
+			bool enabled;
+			bool active;
+			std::vector<Use> uses;
+			std::vector<Barrier> barriers;
+		};
+
+		void Access(uint32_t pass, uint32_t texture, uint32_t state, bool read, bool write);
+		uint32_t AddTexture(const char* name, const Texture_Desc& desc, bool imported);
+
+		std::vector<Texture> m_textures;
+		std::vector<Pass> m_passes;
+		std::vector<uint32_t> m_order;
+		std::vector<Texture_Desc> m_physical;
+		uint64_t m_memory_transient				= 0;
+		uint64_t m_memory_transient_unaliased	= 0;
+	};
+}
@@ -0,0 +1,119 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ==============
+#include "InstanceBatcher.h"
+#include <functional>
+//=========================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+	size_t InstanceBatcher::KeyHash::operator()(const Key& key) const
+	{
+		size_t hash = 0;
+		const auto combine = [&hash](const size_t value) { hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2); };
+		combine(std::hash<const void*>()(key.geometry));
+		combine(std::hash<const void*>()(key.material));
+		combine(std::hash<const void*>()(key.shader));
+		combine(key.index_count);
+		combine(key.index_offset);
+		combine(key.vertex_offset);
+		return hash;
+	}
+
+	void InstanceBatcher::Clear()
+	{
+		m_draws.clear();
+		m_batches.clear();
+		m_instances.clear();
+		m_batch_lookup.clear();
+	}
+
+	void InstanceBatcher::Build()
+	{
+		m_batches.clear();
+
+		// Assign every draw to a batch, batches are created in the order their first draw comes in
+		// Draws come in sorted by state, so most of them share the key of the previous draw and skip the lookup.
+		m_draw_batch.resize(m_draws.size());
+
+		// Keep the table at most half full, with a power of two size so probing can wrap with a mask
+		size_t slot_count = 16;
+		while (slot_count < m_draws.size() * 2)
+		{
+			slot_count <<= 1;
+		}
+		m_batch_lookup.assign(slot_count, 0);
+		const size_t slot_mask = slot_count - 1;
+
+		Key key_previous		= {};
+		uint32_t batch_previous	= 0;
+		for (unsigned int i = 0; i < static_cast<unsigned int>(m_draws.size()); i++)
+		{
+			const Draw& draw	= m_draws[i];
+			const Key key		= { draw.geometry, draw.material, draw.shader, draw.index_count, draw.index_offset, draw.vertex_offset };
+			if (i == 0 || !(key == key_previous))
+			{
+				size_t slot = KeyHash()(key) & slot_mask;
+				while (m_batch_lookup[slot] != 0)
+				{
+					const Draw& first = m_batches[m_batch_lookup[slot] - 1].draw;
+					if (key == Key{ first.geometry, first.material, first.shader, first.index_count, first.index_offset, first.vertex_offset })
+						break;
+
+					slot = (slot + 1) & slot_mask;
+				}
+
+				if (m_batch_lookup[slot] == 0)
+				{
+					m_batches.push_back({ draw, 0, 0 });
+					m_batch_lookup[slot] = static_cast<uint32_t>(m_batches.size());
+				}
+
+				key_previous	= key;
+				batch_previous	= m_batch_lookup[slot] - 1;
+			}
+
+			m_draw_batch[i] = batch_previous;
+			m_batches[batch_previous].instance_count++;
+		}
+
+		// Lay the instances out a batch after the other
+		uint32_t offset = 0;
+		for (auto& batch : m_batches)
+		{
+			batch.instance_offset	= offset;
+			offset					+= batch.instance_count;
+			batch.instance_count	= 0;
+		}
+
+		m_instances.resize(m_draws.size());
+		for (unsigned int i = 0; i < static_cast<unsigned int>(m_draws.size()); i++)
+		{
+			Batch& batch = m_batches[m_draw_batch[i]];
+			m_instances[batch.instance_offset + batch.instance_count++] = m_draws[i].item;
+		}
+	}
+}
@@ -0,0 +1,99 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ==================
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "../../Core/EngineDefs.h"
+//=============================
+
+namespace Spartan
+{
+	// Groups draws which share geometry, material and shader into instanced batches. Batches are ordered
+	// by their first draw and instances keep the order they were added in, so the result only depends on the input.
+	class SPARTAN_CLASS InstanceBatcher
+	{
+	public:
+		struct Draw
+		{
+			// Identities of the state a draw binds, only compared
+			const void* geometry;
+			const void* material;
+			const void* shader;
+			uint32_t index_count;
+			uint32_t index_offset;
+			uint32_t vertex_offset;
+			// Whatever the caller needs to find the instance again, e.g. an entity index
+			uint32_t item;
+		};
+
+		struct Batch
+		{
+			// The first draw of the batch, the others only differ in their item
+			Draw draw;
+			uint32_t instance_offset;
+			uint32_t instance_count;
+		};
+
+		void Clear();
+		void Add(const Draw& draw) { m_draws.emplace_back(draw); }
+		// Forms the batches out of the draws added since Clear()
+		void Build();
+
+		const std::vector<Batch>& GetBatches() const	{ return m_batches; }
+		// Items of every batch, a contiguous range per batch
+		const std::vector<uint32_t>& GetInstances() const	{ return m_instances; }
+		unsigned int GetDrawCount() const				{ return static_cast<unsigned int>(m_draws.size()); }
+		unsigned int GetBatchCount() const				{ return static_cast<unsigned int>(m_batches.size()); }
+
+	private:
+		struct Key
+		{
+			const void* geometry;
+			const void* material;
+			const void* shader;
+			uint32_t index_count;
+			uint32_t index_offset;
+			uint32_t vertex_offset;
+
+			bool operator==(const Key& rhs) const
+			{
+				return geometry == rhs.geometry && material == rhs.material && shader == rhs.shader &&
+					index_count == rhs.index_count && index_offset == rhs.index_offset && vertex_offset == rhs.vertex_offset;
+			}
+		};
+
+		struct KeyHash
+		{
+			size_t operator()(const Key& key) const;
+		};
+
+		std::vector<Draw> m_draws;
+		std::vector<uint32_t> m_draw_batch;
+		std::vector<Batch> m_batches;
+		std::vector<uint32_t> m_instances;
+		// Open addressed, a slot holds a batch index plus one and zero when empty. It keeps its capacity across frames.
+		std::vector<uint32_t> m_batch_lookup;
+	};
+}
@@ -0,0 +1,390 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES =========================
+#include "OcclusionCuller.h"
+#include <cmath>
+#include <algorithm>
+#include "../../Math/BoundingBox.h"
+#include "../../Math/SIMD.h"
+#include "../../RHI/RHI_Vertex.h"
+#include "../../Threading/Threading.h"
+//====================================
+
+//= NAMESPACES ========================
+using namespace std;
+using namespace Spartan::Math;
+using namespace Spartan::Math::Helper;
+//=====================================
+
+namespace Spartan
+{
+	namespace
+	{
+		// Tiles are what a job rasterizes, their width has to be a multiple of 4 (the SIMD width)
+		constexpr unsigned int tile_size = 32;
+		// Geometry closer than this (in view space depth) is clipped, it would otherwise project to infinity
+		constexpr float w_near = 0.01f;
+
+		struct Vertex { float x, y, z, w; };
+
+		unsigned int LevelSize(const unsigned int size, const unsigned int level) { return Max(1u, (size + (1u << level) - 1) >> level); }
+	}
+
+	OcclusionCuller::OcclusionCuller(const unsigned int width, const unsigned int height)
+	{
+		m_tiles_x	= Max(1u, (width + tile_size - 1) / tile_size);
+		m_tiles_y	= Max(1u, (height + tile_size - 1) / tile_size);
+		m_width		= m_tiles_x * tile_size;
+		m_height	= m_tiles_y * tile_size;
+		m_bins.resize(m_tiles_x * m_tiles_y);
+
+		// Levels go down to a single texel
+		for (unsigned int level = 0; ; level++)
+		{
+			const unsigned int level_width	= LevelSize(m_width, level);
+			const unsigned int level_height	= LevelSize(m_height, level);
+			m_levels.emplace_back(level_width * level_height, 0.0f);
+
+			if (level_width == 1 && level_height == 1)
+				break;
+		}
+	}
+
+	void OcclusionCuller::Begin(const Matrix& view_projection)
+	{
+		m_view_projection = view_projection;
+		m_occluders.clear();
+		m_triangles.clear();
+		fill(m_levels.front().begin(), m_levels.front().end(), 0.0f);
+	}
+
+	void OcclusionCuller::AddOccluder(const RHI_Vertex_PosUvNorTan* vertices, const unsigned int* indices, const unsigned int index_count, const Matrix& world)
+	{
+		if (!vertices || !indices || index_count < 3)
+			return;
+
+		m_occluders.push_back({ vertices, indices, index_count, world * m_view_projection });
+	}
+
+	void OcclusionCuller::Rasterize(Threading* threading)
+	{
+		const auto parallel_for = [threading](const unsigned int count, auto&& function)
+		{
+			if (threading)
+			{
+				threading->ParallelFor(count, function, 1, Job_Critical);
+			}
+			else
+			{
+				function(0u, count);
+			}
+		};
+
+		// Transform and clip the occluders, an occluder per job
+		m_occluder_triangles.resize(m_occluders.size());
+		parallel_for(static_cast<unsigned int>(m_occluders.size()), [this](const unsigned int start, const unsigned int end)
+		{
+			for (unsigned int i = start; i < end; i++)
+			{
+				m_occluder_triangles[i].clear();
+				Setup(m_occluders[i], m_occluder_triangles[i]);
+			}
+		});
+
+		for (unsigned int i = 0; i < static_cast<unsigned int>(m_occluders.size()); i++)
+		{
+			m_triangles.insert(m_triangles.end(), m_occluder_triangles[i].begin(), m_occluder_triangles[i].end());
+		}
+
+		// Bin the triangles into the tiles they overlap
+		for (auto& bin : m_bins)
+		{
+			bin.clear();
+		}
+		for (unsigned int i = 0; i < static_cast<unsigned int>(m_triangles.size()); i++)
+		{
+			const Triangle& triangle = m_triangles[i];
+			for (int tile_y = triangle.min_y / tile_size; tile_y <= triangle.max_y / static_cast<int>(tile_size); tile_y++)
+			{
+				for (int tile_x = triangle.min_x / tile_size; tile_x <= triangle.max_x / static_cast<int>(tile_size); tile_x++)
+				{
+					m_bins[tile_y * m_tiles_x + tile_x].emplace_back(i);
+				}
+			}
+		}
+
+		// Rasterize, a tile per job so no two jobs write the same pixels
+		parallel_for(static_cast<unsigned int>(m_bins.size()), [this](const unsigned int start, const unsigned int end)
+		{
+			for (unsigned int tile = start; tile < end; tile++)
+			{
+				RasterizeTile(tile);
+			}
+		});
+
+		BuildHierarchy();
+	}
+
+	bool OcclusionCuller::IsOccluded(const BoundingBox& box) const
+	{
+		const Vector3& min = box.GetMin();
+		const Vector3& max = box.GetMax();
+
+		// Screen rectangle and closest depth of the corners
+		float x_min		= INFINITY;
+		float y_min		= INFINITY;
+		float x_max		= -INFINITY;
+		float y_max		= -INFINITY;
+		float depth_max	= 0.0f;
+		for (unsigned int i = 0; i < 8; i++)
+		{
+			Vertex corner;
+			Simd::Store(&corner.x, Simd::MatrixTransformPoint(m_view_projection.Data(), (i & 1) ? max.x : min.x, (i & 2) ? max.y : min.y, (i & 4) ? max.z : min.z));
+
+			// Crosses the near plane, can't be hidden
+			if (corner.w < w_near)
+				return false;
+
+			const float w_inv	= 1.0f / corner.w;
+			const float x		= (corner.x * w_inv * 0.5f + 0.5f) * m_width;
+			const float y		= (0.5f - corner.y * w_inv * 0.5f) * m_height;
+			x_min		= Min(x_min, x);
+			y_min		= Min(y_min, y);
+			x_max		= Max(x_max, x);
+			y_max		= Max(y_max, y);
+			depth_max	= Max(depth_max, w_inv);
+		}
+
+		// Off screen, that's for frustum culling to decide
+		if (x_max < 0.0f || y_max < 0.0f || x_min >= m_width || y_min >= m_height)
+			return false;
+
+		// Occluders are sampled at pixel centers, so grow the rectangle by a pixel to stay conservative along their silhouettes
+		const int x_0 = Max(0, static_cast<int>(floorf(x_min)) - 1);
+		const int y_0 = Max(0, static_cast<int>(floorf(y_min)) - 1);
+		const int x_1 = Min(static_cast<int>(m_width) - 1, static_cast<int>(floorf(x_max)) + 1);
+		const int y_1 = Min(static_cast<int>(m_height) - 1, static_cast<int>(floorf(y_max)) + 1);
+
+		// Pick the level where the rectangle covers at most 4x4 texels
+		unsigned int level = 0;
+		while (((x_1 >> level) - (x_0 >> level)) > 3 || ((y_1 >> level) - (y_0 >> level)) > 3)
+		{
+			level++;
+		}
+
+		// Hidden only if every texel has an occluder closer than the closest point of the box
+		const auto& depth			= m_levels[level];
+		const unsigned int width	= LevelSize(m_width, level);
+		for (int y = y_0 >> level; y <= (y_1 >> level); y++)
+		{
+			for (int x = x_0 >> level; x <= (x_1 >> level); x++)
+			{
+				if (depth[y * width + x] <= depth_max)
+					return false;
+			}
+		}
+
+		return true;
+	}
+
+	void OcclusionCuller::Setup(const Occluder& occluder, vector<Triangle>& triangles) const
+	{
+		const auto emit = [this, &triangles](const Vertex& v0, const Vertex& v1, const Vertex& v2)
+		{
+			Triangle triangle;
+			const Vertex* vertices[3] = { &v0, &v1, &v2 };
+			for (unsigned int i = 0; i < 3; i++)
+			{
+				const float w_inv	= 1.0f / vertices[i]->w;
+				triangle.x[i]		= (vertices[i]->x * w_inv * 0.5f + 0.5f) * m_width;
+				triangle.y[i]		= (0.5f - vertices[i]->y * w_inv * 0.5f) * m_height;
+				triangle.z[i]		= w_inv;
+			}
+
+			// Degenerate
+			const float area = (triangle.x[1] - triangle.x[0]) * (triangle.y[2] - triangle.y[0]) - (triangle.x[2] - triangle.x[0]) * (triangle.y[1] - triangle.y[0]);
+			if (Abs(area) < M_EPSILON)
+				return;
+
+			// Pixels whose center could be inside, clamped to the screen
+			triangle.min_x = Max(0, static_cast<int>(floorf(Min(Min(triangle.x[0], triangle.x[1]), triangle.x[2]))));
+			triangle.min_y = Max(0, static_cast<int>(floorf(Min(Min(triangle.y[0], triangle.y[1]), triangle.y[2]))));
+			triangle.max_x = Min(static_cast<int>(m_width) - 1, static_cast<int>(floorf(Max(Max(triangle.x[0], triangle.x[1]), triangle.x[2]))));
+			triangle.max_y = Min(static_cast<int>(m_height) - 1, static_cast<int>(floorf(Max(Max(triangle.y[0], triangle.y[1]), triangle.y[2]))));
+			if (triangle.min_x > triangle.max_x || triangle.min_y > triangle.max_y)
+				return;
+
+			triangles.emplace_back(triangle);
+		};
+
+		const float* matrix = occluder.world_view_projection.Data();
+		for (unsigned int i = 0; i + 2 < occluder.index_count; i += 3)
+		{
+			Vertex clip[3];
+			unsigned int inside = 0;
+			for (unsigned int j = 0; j < 3; j++)
+			{
+				const float* position = occluder.vertices[occluder.indices[i + j]].pos;
+				Simd::Store(&clip[j].x, Simd::MatrixTransformPoint(matrix, position[0], position[1], position[2]));
+				inside += clip[j].w >= w_near ? 1 : 0;
+			}
+
+			if (inside == 0)
+				continue;
+
+			if (inside == 3)
+			{
+				emit(clip[0], clip[1], clip[2]);
+				continue;
+			}
+
+			// Clip against the near plane, a triangle becomes a triangle or a quad
+			Vertex polygon[4];
+			unsigned int count = 0;
+			for (unsigned int j = 0; j < 3; j++)
+			{
+				const Vertex& a = clip[j];
+				const Vertex& b = clip[(j + 1) % 3];
+				if (a.w >= w_near)
+				{
+					polygon[count++] = a;
+				}
+				if ((a.w >= w_near) != (b.w >= w_near))
+				{
+					const float t = (w_near - a.w) / (b.w - a.w);
+					polygon[count++] = { a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, a.z + (b.z - a.z) * t, w_near };
+				}
+			}
+
+			emit(polygon[0], polygon[1], polygon[2]);
+			if (count == 4)
+			{
+				emit(polygon[0], polygon[2], polygon[3]);
+			}
+		}
+	}
+
+	void OcclusionCuller::RasterizeTile(const unsigned int tile)
+	{
+		const int tile_x_0	= static_cast<int>((tile % m_tiles_x) * tile_size);
+		const int tile_y_0	= static_cast<int>((tile / m_tiles_x) * tile_size);
+		const int tile_x_1	= tile_x_0 + tile_size - 1;
+		const int tile_y_1	= tile_y_0 + tile_size - 1;
+		float* depth		= m_levels.front().data();
+
+		const Simd::Float4 zero			= Simd::Splat(0.0f);
+		const Simd::Float4 offsets_x	= Simd::Set(0.5f, 1.5f, 2.5f, 3.5f);
+
+		for (const unsigned int index : m_bins[tile])
+		{
+			const Triangle& triangle = m_triangles[index];
+			const float* x = triangle.x;
+			const float* y = triangle.y;
+			const float* z = triangle.z;
+
+			// Edge functions a * x + b * y + c, each one is zero on the edge opposite of its vertex and positive inside
+			float area	= (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+			float a[3]	= { y[1] - y[2], y[2] - y[0], y[0] - y[1] };
+			float b[3]	= { x[2] - x[1], x[0] - x[2], x[1] - x[0] };
+			float c[3]	= { x[1] * y[2] - x[2] * y[1], x[2] * y[0] - x[0] * y[2], x[0] * y[1] - x[1] * y[0] };
+			if (area < 0.0f)
+			{
+				for (unsigned int i = 0; i < 3; i++)
+				{
+					a[i] = -a[i]; b[i] = -b[i]; c[i] = -c[i];
+				}
+				area = -area;
+			}
+
+			// Depth is interpolated with the barycentrics of the second and third vertex, which are edge functions over the area
+			const float area_inv	= 1.0f / area;
+			const float z_1			= (z[1] - z[0]) * area_inv;
+			const float z_2			= (z[2] - z[0]) * area_inv;
+			const float z_a			= z_1 * a[1] + z_2 * a[2];
+			const float z_b			= z_1 * b[1] + z_2 * b[2];
+			const float z_c			= z[0] + z_1 * c[1] + z_2 * c[2];
+
+			const int x_start	= Max(triangle.min_x, tile_x_0) & ~3;
+			const int x_end		= Min(triangle.max_x, tile_x_1);
+			const int y_start	= Max(triangle.min_y, tile_y_0);
+			const int y_end		= Min(triangle.max_y, tile_y_1);
+
+			const Simd::Float4 a_0 = Simd::Splat(a[0]);
+			const Simd::Float4 a_1 = Simd::Splat(a[1]);
+			const Simd::Float4 a_2 = Simd::Splat(a[2]);
+			const Simd::Float4 z_x = Simd::Splat(z_a);
+
+			for (int pixel_y = y_start; pixel_y <= y_end; pixel_y++)
+			{
+				const float center_y			= pixel_y + 0.5f;
+				const Simd::Float4 row_0		= Simd::Splat(b[0] * center_y + c[0]);
+				const Simd::Float4 row_1		= Simd::Splat(b[1] * center_y + c[1]);
+				const Simd::Float4 row_2		= Simd::Splat(b[2] * center_y + c[2]);
+				const Simd::Float4 row_z		= Simd::Splat(z_b * center_y + z_c);
+				float* row						= depth + pixel_y * m_width;
+
+				for (int pixel_x = x_start; pixel_x <= x_end; pixel_x += 4)
+				{
+					const Simd::Float4 center_x	= Simd::Add(Simd::Splat(static_cast<float>(pixel_x)), offsets_x);
+					const Simd::Float4 edge_0	= Simd::MulAdd(a_0, center_x, row_0);
+					const Simd::Float4 edge_1	= Simd::MulAdd(a_1, center_x, row_1);
+					const Simd::Float4 edge_2	= Simd::MulAdd(a_2, center_x, row_2);
+					const Simd::Float4 outside	= Simd::CompareLess(Simd::Min(Simd::Min(edge_0, edge_1), edge_2), zero);
+
+					// Keep the closest depth of the pixels inside
+					const Simd::Float4 depth_old = Simd::Load(row + pixel_x);
+					const Simd::Float4 depth_new = Simd::MulAdd(z_x, center_x, row_z);
+					Simd::Store(row + pixel_x, Simd::Select(outside, depth_old, Simd::Max(depth_old, depth_new)));
+				}
+			}
+		}
+	}
+
+	void OcclusionCuller::BuildHierarchy()
+	{
+		for (unsigned int level = 1; level < static_cast<unsigned int>(m_levels.size()); level++)
+		{
+			const auto& source					= m_levels[level - 1];
+			auto& destination					= m_levels[level];
+			const unsigned int source_width		= LevelSize(m_width, level - 1);
+			const unsigned int source_height	= LevelSize(m_height, level - 1);
+			const unsigned int width			= LevelSize(m_width, level);
+			const unsigned int height			= LevelSize(m_height, level);
+
+			// Farthest of the 2x2 texels below, odd edges only have one
+			for (unsigned int y = 0; y < height; y++)
+			{
+				const unsigned int y_0 = y * 2;
+				const unsigned int y_1 = Min(y_0 + 1, source_height - 1);
+				for (unsigned int x = 0; x < width; x++)
+				{
+					const unsigned int x_0 = x * 2;
+					const unsigned int x_1 = Min(x_0 + 1, source_width - 1);
+					destination[y * width + x] = Min(
+						Min(source[y_0 * source_width + x_0], source[y_0 * source_width + x_1]),
+						Min(source[y_1 * source_width + x_0], source[y_1 * source_width + x_1])
+					);
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,98 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES =======================
+#include <vector>
+#include "../../Core/EngineDefs.h"
+#include "../../Math/Matrix.h"
+//==================================
+
+namespace Spartan
+{
+	class Threading;
+	struct RHI_Vertex_PosUvNorTan;
+	namespace Math { class BoundingBox; }
+
+	// Software occlusion culling. Occluders are rasterized into a small depth buffer on the CPU, a tile per job,
+	// which is then reduced into a hierarchy of farthest depths that the bounding boxes of occludees are tested against.
+	// Depth is stored as 1 / w, so it doesn't depend on how the projection maps z (reverse or not), larger is closer.
+	class SPARTAN_CLASS OcclusionCuller
+	{
+	public:
+		OcclusionCuller(unsigned int width = 256, unsigned int height = 128);
+		~OcclusionCuller() = default;
+
+		// Clears the occluders and the depth buffer
+		void Begin(const Math::Matrix& view_projection);
+		// Queues the triangles of an occluder, indices are relative to vertices, which are transformed by world.
+		// The geometry is only read by Rasterize(), so it has to stay alive until then.
+		void AddOccluder(const RHI_Vertex_PosUvNorTan* vertices, const unsigned int* indices, unsigned int index_count, const Math::Matrix& world);
+		// Rasterizes the queued occluders and builds the depth hierarchy, runs the jobs on threading if given
+		void Rasterize(Threading* threading = nullptr);
+		// Returns true if the box is completely hidden behind the occluders
+		bool IsOccluded(const Math::BoundingBox& box) const;
+
+		unsigned int GetWidth() const				{ return m_width; }
+		unsigned int GetHeight() const				{ return m_height; }
+		const std::vector<float>& GetDepth() const	{ return m_levels.front(); }
+		unsigned int GetOccluderCount() const		{ return static_cast<unsigned int>(m_occluders.size()); }
+		unsigned int GetTriangleCount() const		{ return static_cast<unsigned int>(m_triangles.size()); }
+
+	private:
+		struct Occluder
+		{
+			const RHI_Vertex_PosUvNorTan* vertices;
+			const unsigned int* indices;
+			unsigned int index_count;
+			Math::Matrix world_view_projection;
+		};
+
+		// A triangle in screen space, z is 1 / w
+		struct Triangle
+		{
+			float x[3];
+			float y[3];
+			float z[3];
+			int min_x, min_y, max_x, max_y;
+		};
+
+		void Setup(const Occluder& occluder, std::vector<Triangle>& triangles) const;
+		void RasterizeTile(unsigned int tile);
+		void BuildHierarchy();
+
+		unsigned int m_width;
+		unsigned int m_height;
+		unsigned int m_tiles_x;
+		unsigned int m_tiles_y;
+		Math::Matrix m_view_projection;
+
+		std::vector<Occluder> m_occluders;
+		// Screen space triangles of each occluder and of all of them
+		std::vector<std::vector<Triangle>> m_occluder_triangles;
+		std::vector<Triangle> m_triangles;
+		// Indices into m_triangles of the triangles which overlap each tile
+		std::vector<std::vector<unsigned int>> m_bins;
+		// Level 0 is the depth buffer, every other level keeps the farthest depth of 2x2 texels of the previous one
+		std::vector<std::vector<float>> m_levels;
+	};
+}
@@ -23,7 +23,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 //= INCLUDES =====================
 #include <vector>
-#include "../RHI/RHI_Definition.h"
+#include "../../RHI/RHI_Definition.h"
 #include "../../Math/Vector2.h"
 //================================
 
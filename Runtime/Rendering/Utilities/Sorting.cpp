@@ -0,0 +1,159 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ========================
+#include "Sorting.h"
+#include <algorithm>
+#include "../../Math/MathHelper.h"
+#include "../../Core/FrameAllocator.h"
+#include "../../Threading/Threading.h"
+//===================================
+
+//= NAMESPACES ========================
+using namespace std;
+using namespace Spartan::Math::Helper;
+//=====================================
+
+namespace Spartan::Utility::Sorting
+{
+	namespace
+	{
+		constexpr unsigned int radix			= 256;
+		constexpr unsigned int digit_count		= 8;
+		// Blocks smaller than this aren't worth a job
+		constexpr unsigned int block_size_min	= 16384;
+
+		uint32_t Digit(const uint64_t key, const unsigned int digit) { return static_cast<uint32_t>(key >> (digit * 8)) & (radix - 1); }
+	}
+
+	void RadixSort(vector<KeyIndex>& items, vector<KeyIndex>& scratch, Threading* threading)
+	{
+		const auto count = static_cast<unsigned int>(items.size());
+		if (count < 2)
+			return;
+
+		scratch.resize(count);
+
+		const unsigned int block_count	= threading ? Clamp(count / block_size_min, 1u, threading->GetThreadCount() + 1) : 1;
+		const auto block_start			= [count, block_count](const unsigned int block) { return static_cast<unsigned int>(static_cast<uint64_t>(count) * block / block_count); };
+		const auto parallel_for			= [threading, block_count](auto&& function)
+		{
+			if (threading && block_count > 1)
+			{
+				threading->ParallelFor(block_count, function, 1, Job_Critical);
+			}
+			else
+			{
+				function(0u, block_count);
+			}
+		};
+
+		// Count every digit of every block in a single read. Together they tell which digits can be skipped,
+		// and as long as nothing moved (or there is a single block) they are also the counts of the first pass.
+		FrameVector<uint32_t> histograms(block_count * digit_count * radix, 0);
+		parallel_for([&items, &histograms, &block_start](const unsigned int start, const unsigned int end)
+		{
+			for (unsigned int block = start; block < end; block++)
+			{
+				uint32_t* histogram = &histograms[block * digit_count * radix];
+				for (unsigned int i = block_start(block); i < block_start(block + 1); i++)
+				{
+					const uint64_t key = items[i].key;
+					for (unsigned int digit = 0; digit < digit_count; digit++)
+					{
+						histogram[digit * radix + Digit(key, digit)]++;
+					}
+				}
+			}
+		});
+
+		KeyIndex* source		= items.data();
+		KeyIndex* destination	= scratch.data();
+		FrameVector<uint32_t> offsets(block_count * radix);
+		bool moved = false;
+		for (unsigned int digit = 0; digit < digit_count; digit++)
+		{
+			// Skip the digit if all the keys fall in the same bucket
+			bool skip = false;
+			for (unsigned int bucket = 0; bucket < radix && !skip; bucket++)
+			{
+				uint32_t total = 0;
+				for (unsigned int block = 0; block < block_count; block++)
+				{
+					total += histograms[(block * digit_count + digit) * radix + bucket];
+				}
+				skip = total == count;
+			}
+			if (skip)
+				continue;
+
+			// The blocks hold different items after a pass, so they have to be counted again
+			if (moved && block_count > 1)
+			{
+				parallel_for([source, digit, &histograms, &block_start](const unsigned int start, const unsigned int end)
+				{
+					for (unsigned int block = start; block < end; block++)
+					{
+						uint32_t* histogram = &histograms[(block * digit_count + digit) * radix];
+						fill(histogram, histogram + radix, 0u);
+						for (unsigned int i = block_start(block); i < block_start(block + 1); i++)
+						{
+							histogram[Digit(source[i].key, digit)]++;
+						}
+					}
+				});
+			}
+
+			// Offsets are ordered by bucket and then by block, which is what keeps the sort stable
+			uint32_t offset = 0;
+			for (unsigned int bucket = 0; bucket < radix; bucket++)
+			{
+				for (unsigned int block = 0; block < block_count; block++)
+				{
+					offsets[block * radix + bucket]	= offset;
+					offset							+= histograms[(block * digit_count + digit) * radix + bucket];
+				}
+			}
+
+			// Scatter
+			parallel_for([source, destination, digit, &offsets, &block_start](const unsigned int start, const unsigned int end)
+			{
+				for (unsigned int block = start; block < end; block++)
+				{
+					uint32_t* offset = &offsets[block * radix];
+					for (unsigned int i = block_start(block); i < block_start(block + 1); i++)
+					{
+						destination[offset[Digit(source[i].key, digit)]++] = source[i];
+					}
+				}
+			});
+
+			swap(source, destination);
+			moved = true;
+		}
+
+		// An odd number of passes leaves the result in the scratch buffer
+		if (source != items.data())
+		{
+			items.swap(scratch);
+		}
+	}
+}
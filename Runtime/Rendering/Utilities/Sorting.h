@@ -0,0 +1,48 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ==================
+#include <vector>
+#include <cstdint>
+#include "../../Core/EngineDefs.h"
+//=============================
+
+namespace Spartan
+{
+	class Threading;
+
+	namespace Utility::Sorting
+	{
+		// A sort key and the index of what it describes
+		struct KeyIndex
+		{
+			uint64_t key;
+			uint32_t index;
+		};
+
+		// Stable LSD radix sort by key, a byte per pass. Passes where every key has the same byte are skipped.
+		// The items are split in blocks which are counted and scattered as separate jobs if threading is given.
+		// Scratch is resized to fit, keep it around between calls to avoid allocating. The counts live in frame memory.
+		void RadixSort(std::vector<KeyIndex>& items, std::vector<KeyIndex>& scratch, Threading* threading = nullptr);
+	}
+}
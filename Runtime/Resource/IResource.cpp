@@ -41,7 +41,7 @@ IResource::IResource(Context* context, const Resource_Type type)
 }
 
 template <typename T>
-constexpr Resource_Type IResource::TypeToEnum() { return Resource_Unknown; }
+Resource_Type IResource::TypeToEnum() { return Resource_Unknown; }
 
 // Explicit template instantiation
 #define INSTANTIATE_TO_RESOURCE_TYPE(T, enumT) template<> SPARTAN_CLASS Resource_Type IResource::TypeToEnum<T>() { return enumT; }
@@ -83,7 +83,7 @@ namespace Spartan
 
 		//= TYPE ===================================
 		template <typename T>
-		static constexpr Resource_Type TypeToEnum();
+		static Resource_Type TypeToEnum();
 		//==========================================
 
 		//= PTR ==========================================
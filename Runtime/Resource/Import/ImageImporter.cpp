@@ -46,7 +46,6 @@ namespace _ImagImporter
 		unsigned int height		= 0;
 		unsigned int channels	= 0;
 		vector<byte>* data		= nullptr;
-		bool done				= false;
 
 		RescaleJob(const unsigned int width, const unsigned int height, const unsigned int channels)
 		{
@@ -213,6 +212,7 @@ namespace Spartan
 
 		// Parallelize mipmap generation using multiple threads (because FreeImage_Rescale() using FILTER_LANCZOS3 is expensive)
 		auto threading = m_context->GetSubsystem<Threading>();
+		JobCounter counter;
 		for (auto& job : jobs)
 		{
 			threading->AddTask([this, &job, &bitmap]()
@@ -223,23 +223,11 @@ namespace Spartan
 					LOGF_ERROR("Failed to create mip level %dx%d", job.width, job.height);
 				}
 				FreeImage_Unload(bitmap_scaled);
-				job.done = true;
-			});
+			}, Job_Normal, &counter);
 		}
 
 		// Wait until all mipmaps have been generated
-		auto ready = false;
-		while (!ready)
-		{
-			ready = true;
-			for (const auto& job : jobs)
-			{
-				if (!job.done)
-				{
-					ready = false;
-				}
-			}
-		}
+		threading->Wait(&counter);
 	}
 
 	unsigned int ImageImporter::ComputeChannelCount(FIBITMAP* bitmap)
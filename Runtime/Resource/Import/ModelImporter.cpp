@@ -32,6 +32,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../../Rendering/Material.h"
 #include "../../World/World.h"
 #include "../../World/Components/Renderable.h"
+#include "../../Threading/Threading.h"
 //============================================
 
 //= NAMESPACES ================
@@ -253,6 +254,8 @@ namespace Spartan
 			return;
 		}
 
+		auto threading = m_context->GetSubsystem<Threading>();
+
 		// Vertices
 		vector<RHI_Vertex_PosUvNorTan> vertices;
 		{
@@ -261,43 +264,47 @@ namespace Spartan
 			vertices.reserve(vertex_count);
 			vertices.resize(vertex_count);
 
-			for (unsigned int i = 0; i < vertex_count; i++)
+			// Copy vertex ranges in parallel
+			threading->ParallelFor(vertex_count, [&vertices, assimp_mesh](const unsigned int start, const unsigned int end)
 			{
-				auto& vertex = vertices[i];
+				for (unsigned int i = start; i < end; i++)
+				{
+					auto& vertex = vertices[i];
 
-				// Position
-				const auto& pos = assimp_mesh->mVertices[i];
-				vertex.pos[0] = pos.x;
-				vertex.pos[1] = pos.y;
-				vertex.pos[2] = pos.z;
+					// Position
+					const auto& pos = assimp_mesh->mVertices[i];
+					vertex.pos[0] = pos.x;
+					vertex.pos[1] = pos.y;
+					vertex.pos[2] = pos.z;
 
-				// Normal
-				if (assimp_mesh->mNormals)
-				{
-					const auto& normal = assimp_mesh->mNormals[i];
-					vertex.normal[0] = normal.x;
-					vertex.normal[1] = normal.y;
-					vertex.normal[2] = normal.z;
-				}
+					// Normal
+					if (assimp_mesh->mNormals)
+					{
+						const auto& normal = assimp_mesh->mNormals[i];
+						vertex.normal[0] = normal.x;
+						vertex.normal[1] = normal.y;
+						vertex.normal[2] = normal.z;
+					}
 
-				// Tangent
-				if (assimp_mesh->mTangents)
-				{
-					const auto& tangent = assimp_mesh->mTangents[i];
-					vertex.tangent[0] = tangent.x;
-					vertex.tangent[1] = tangent.y;
-					vertex.tangent[2] = tangent.z;
-				}
+					// Tangent
+					if (assimp_mesh->mTangents)
+					{
+						const auto& tangent = assimp_mesh->mTangents[i];
+						vertex.tangent[0] = tangent.x;
+						vertex.tangent[1] = tangent.y;
+						vertex.tangent[2] = tangent.z;
+					}
 
-				// Texture coordinates
-				const unsigned int uv_channel = 0;
-				if (assimp_mesh->HasTextureCoords(uv_channel))
-				{
-					const auto& tex_coords = assimp_mesh->mTextureCoords[uv_channel][i];
-					vertex.uv[0] = tex_coords.x;
-					vertex.uv[1] = tex_coords.y;
+					// Texture coordinates
+					const unsigned int uv_channel = 0;
+					if (assimp_mesh->HasTextureCoords(uv_channel))
+					{
+						const auto& tex_coords = assimp_mesh->mTextureCoords[uv_channel][i];
+						vertex.uv[0] = tex_coords.x;
+						vertex.uv[1] = tex_coords.y;
+					}
 				}
-			}
+			});
 		}
 
 		// Indices
@@ -321,7 +328,10 @@ namespace Spartan
 		}
 
 		// Compute AABB (before doing move operation on vertices)
-		const auto aabb = BoundingBox(vertices);
+		const auto aabb = threading->ParallelReduce(static_cast<unsigned int>(vertices.size()), BoundingBox(),
+			[&vertices](const unsigned int start, const unsigned int end, BoundingBox& aabb) { aabb.Merge(BoundingBox(vertices.data() + start, end - start)); },
+			[](BoundingBox& aabb, const BoundingBox& aabb_range) { aabb.Merge(aabb_range); }
+		);
 
 		// Add the mesh to the model
 		unsigned int index_offset;
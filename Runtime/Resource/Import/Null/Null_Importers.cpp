@@ -0,0 +1,73 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= IMPLEMENTATION ===================
+#include "../../../Core/EngineDefs.h"
+#ifdef SPARTAN_HEADLESS
+//===================================
+
+//= INCLUDES ====================
+#include "../FontImporter.h"
+#include "../ImageImporter.h"
+#include "../ModelImporter.h"
+#include "../../../Logging/Log.h"
+//===============================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+// The headless build doesn't link FreeType, FreeImage and Assimp, so nothing can be imported.
+// Resources which are created in code (render textures, meshes, materials) work as usual.
+
+namespace Spartan
+{
+	FontImporter::FontImporter(Context* context)	{ m_context = context; }
+	FontImporter::~FontImporter()					= default;
+
+	bool FontImporter::LoadFromFile(Font* font, const string& file_path)
+	{
+		LOGF_WARNING("Can't import \"%s\", the headless build has no font importer.", file_path.c_str());
+		return false;
+	}
+
+	ImageImporter::ImageImporter(Context* context)	{ m_context = context; }
+	ImageImporter::~ImageImporter()					= default;
+
+	bool ImageImporter::Load(const string& file_path, RHI_Texture* texture)
+	{
+		LOGF_WARNING("Can't import \"%s\", the headless build has no image importer.", file_path.c_str());
+		return false;
+	}
+
+	ModelImporter::ModelImporter(Context* context)
+	{
+		m_context	= context;
+		m_world		= nullptr;
+	}
+
+	bool ModelImporter::Load(shared_ptr<Model> model, const string& file_path)
+	{
+		LOGF_WARNING("Can't import \"%s\", the headless build has no model importer.", file_path.c_str());
+		return false;
+	}
+}
+#endif
@@ -103,7 +103,7 @@ namespace Spartan
 			}
 
 			// Cache the resource
-			std::lock_guard<mutex> guard(m_mutex);
+			std::lock_guard<std::mutex> guard(m_mutex);
 			m_resource_groups[resource->GetResourceType()].emplace_back(resource);
 		}
 		bool IsCached(const std::string& resource_name, Resource_Type resource_type);
@@ -117,7 +117,7 @@ namespace Spartan
 			if (!FileSystem::FileExists(file_path))
 			{
 				LOGF_ERROR("Path \"%s\" is invalid.", file_path.c_str());
-				return false;
+				return nullptr;
 			}
 
 			// Try to make the path relative to the engine (in case it isn't)
@@ -0,0 +1,87 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ==========
+#include "JobQueue.h"
+//=====================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+	JobQueue::JobQueue(unsigned int capacity)
+	{
+		// Round the capacity up to a power of two so that wrapping is a mask
+		unsigned int size = 1;
+		while (size < capacity)
+		{
+			size <<= 1;
+		}
+
+		m_jobs.resize(size);
+		m_mask = size - 1;
+	}
+
+	bool JobQueue::Push(Job* job)
+	{
+		lock_guard<mutex> lock(m_mutex);
+
+		if (m_bottom - m_top > m_mask)
+			return false;
+
+		m_jobs[m_bottom & m_mask] = job;
+		m_bottom++;
+
+		return true;
+	}
+
+	Job* JobQueue::Pop()
+	{
+		lock_guard<mutex> lock(m_mutex);
+
+		if (m_bottom == m_top)
+			return nullptr;
+
+		m_bottom--;
+		return m_jobs[m_bottom & m_mask];
+	}
+
+	Job* JobQueue::Steal()
+	{
+		lock_guard<mutex> lock(m_mutex);
+
+		if (m_bottom == m_top)
+			return nullptr;
+
+		Job* job = m_jobs[m_top & m_mask];
+		m_top++;
+
+		return job;
+	}
+
+	unsigned int JobQueue::GetCount() const
+	{
+		lock_guard<mutex> lock(m_mutex);
+		return m_bottom - m_top;
+	}
+}
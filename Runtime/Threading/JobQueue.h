@@ -0,0 +1,62 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ==============
+#include <vector>
+#include <mutex>
+#include "../Core/EngineDefs.h"
+//=========================
+
+namespace Spartan
+{
+	class Job;
+
+	// A bounded double-ended queue of jobs. Jobs are pushed and popped at the back (LIFO, so recently
+	// submitted work is still warm in the cache), while other workers steal from the front (FIFO).
+	// Every worker owns one, so submission never contends on a single global lock. Every operation
+	// takes the queue's mutex, so a queue is shared between its owner, thieves and outside submitters.
+	class SPARTAN_CLASS JobQueue
+	{
+	public:
+		JobQueue(unsigned int capacity = 1024);
+		~JobQueue() = default;
+
+		// Any thread - the owner pushes its own jobs, threads which aren't workers spread theirs round-robin.
+		// Returns false without queuing the job if the queue is full, the caller then tries the next queue
+		// and runs the job itself if every queue is full.
+		bool Push(Job* job);
+		// Owner
+		Job* Pop();
+		// Any other thread
+		Job* Steal();
+
+		unsigned int GetCount() const;
+
+	private:
+		std::vector<Job*> m_jobs;
+		unsigned int m_mask		= 0;
+		unsigned int m_top		= 0;
+		unsigned int m_bottom	= 0;
+		mutable std::mutex m_mutex;
+	};
+}
@@ -22,6 +22,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES ================
 #include "Threading.h"
 #include "../Core/Settings.h"
+#include "../Math/MathHelper.h"
 //===========================
 
 //= NAMESPACES =====
@@ -30,68 +31,325 @@ using namespace std;
 
 namespace Spartan
 {
+	// Index of the queue owned by the calling thread, -1 for threads which are not workers
+	static thread_local int g_worker_index = -1;
+
 	Threading::Threading(Context* context) : ISubsystem(context)
 	{
-		m_stopping		= false;
-		m_threadCount	= Settings::Get().GetMaxThreadCount() - 1;
+		m_thread_count = Settings::Get().GetMaxThreadCount() - 1;
+
+		// Allocate the job pool, one queue per worker and priority, and a shared queue for I/O
+		m_jobs = make_unique<Job[]>(m_job_capacity);
+		for (unsigned int priority = Job_Critical; priority < Job_Io; priority++)
+		{
+			for (unsigned int i = 0; i < m_thread_count; i++)
+			{
+				m_queues[priority].emplace_back(make_unique<JobQueue>(m_job_capacity));
+			}
+		}
+		m_queues[Job_Io].emplace_back(make_unique<JobQueue>(m_job_capacity));
+
+		for (unsigned int i = 0; i < m_thread_count; i++)
+		{
+			m_threads.emplace_back(thread(&Threading::Invoke, this, i));
+		}
 
-		for (unsigned int i = 0; i < m_threadCount; i++)
+		for (unsigned int i = 0; i < m_thread_count_io; i++)
 		{
-			m_threads.emplace_back(thread(&Threading::Invoke, this));
+			m_threads_io.emplace_back(thread(&Threading::InvokeIo, this));
 		}
-		LOGF_INFO("%d threads have been created", m_threadCount);
+		LOGF_INFO("%d threads have been created (+%d for I/O)", m_thread_count, m_thread_count_io);
 	}
 
 	Threading::~Threading()
 	{
-		// Put unique lock on task mutex.
-		unique_lock<mutex> lock(m_tasksMutex);
-
-		// Set termination flag to true.
-		m_stopping = true;
-
-		// Unlock the mutex
-		lock.unlock();
+		// Set termination flag to true
+		{
+			lock_guard<mutex> lock(m_sleep_mutex);
+			m_stopping = true;
+		}
 
-		// Wake up all threads.
-		m_conditionVar.notify_all();
+		// Wake up all threads
+		m_condition_var.notify_all();
+		m_condition_var_io.notify_all();
 
-		// Join all threads.
+		// Join all threads (they drain any remaining jobs before exiting)
 		for (auto& thread : m_threads)
 		{
 			thread.join();
 		}
 
-		// Empty worker threads.
+		for (auto& thread : m_threads_io)
+		{
+			thread.join();
+		}
+
+		// Empty worker threads
 		m_threads.clear();
+		m_threads_io.clear();
+	}
+
+	void Threading::Invoke(const unsigned int thread_index)
+	{
+		g_worker_index = static_cast<int>(thread_index);
+		const bool allow_background = IsBackgroundAllowed(g_worker_index);
+
+		while (true)
+		{
+			// Highest priority first, own queue first, then steal from the others
+			if (Job* job = JobAcquire(thread_index, allow_background))
+			{
+				JobExecute(job);
+				continue;
+			}
+
+			// Nothing to do, go to sleep until a job is submitted
+			unique_lock<mutex> lock(m_sleep_mutex);
+			m_threads_sleeping++;
+			m_condition_var.wait(lock, [this, allow_background] { return HasPendingJobs(allow_background) || m_stopping; });
+			m_threads_sleeping--;
+
+			// If m_stopping is true and there is no work left, it's time to shut everything down
+			if (m_stopping && !HasPendingJobs(allow_background))
+				return;
+		}
 	}
 
-	void Threading::Invoke()
+	void Threading::InvokeIo()
 	{
-		shared_ptr<Task> task;
+		JobQueue* queue = m_queues[Job_Io][0].get();
+
 		while (true)
 		{
-			// Lock tasks mutex
-			unique_lock<mutex> lock(m_tasksMutex);
+			// I/O jobs are executed in submission order
+			if (Job* job = queue->Steal())
+			{
+				m_jobs_pending[Job_Io]--;
+				JobExecute(job);
+				continue;
+			}
 
-			// Check condition on notification
-			m_conditionVar.wait(lock, [this] { return !m_tasks.empty() || m_stopping; });
+			// Nothing to do, go to sleep until a job is submitted
+			unique_lock<mutex> lock(m_sleep_mutex);
+			m_threads_sleeping_io++;
+			m_condition_var_io.wait(lock, [this] { return m_jobs_pending[Job_Io].load() != 0 || m_stopping; });
+			m_threads_sleeping_io--;
 
-			// If m_stopping is true, it's time to shut everything down
-			if (m_stopping && m_tasks.empty())
+			// If m_stopping is true and there is no work left, it's time to shut everything down
+			if (m_stopping && m_jobs_pending[Job_Io].load() == 0)
 				return;
+		}
+	}
+
+	bool Threading::ExecutePendingJob()
+	{
+		if (m_threads.empty())
+			return false;
+
+		// Threads which are not workers never pick up background jobs, as they are typically waiting on something more urgent
+		const unsigned int queue_index = g_worker_index != -1 ? static_cast<unsigned int>(g_worker_index) : m_queue_next.load() % m_thread_count;
+		if (Job* job = JobAcquire(queue_index, IsBackgroundAllowed(g_worker_index)))
+		{
+			JobExecute(job);
+			return true;
+		}
+
+		return false;
+	}
+
+	void Threading::Wait(JobCounter* counter)
+	{
+		if (!counter)
+			return;
+
+		WaitUntil([counter]() { return counter->IsDone(); });
+
+		// The last job may still be releasing its continuations, make sure it's done with the counter
+		lock_guard<mutex> lock(counter->m_mutex);
+	}
+
+	void Threading::WaitIdle()
+	{
+		while (m_jobs_unfinished.load() != 0)
+		{
+			// Help out instead of blocking, jobs which are executing elsewhere will finish shortly
+			if (!ExecutePendingJob())
+			{
+				this_thread::yield();
+			}
+		}
+	}
+
+	unsigned int Threading::GetRangeCount(const unsigned int count, unsigned int grain_size) const
+	{
+		if (m_threads.empty() || count == 0)
+			return 1;
+
+		// A few ranges per thread, so that threads which finish early can steal the remaining ones
+		const unsigned int range_count_max = (m_thread_count + 1) * 4;
+
+		// Automatic grain size, big enough for the job overhead to be negligible
+		if (grain_size == 0)
+		{
+			grain_size = Math::Helper::Max(count / range_count_max, m_grain_size_min);
+		}
+
+		return Math::Helper::Clamp((count + grain_size - 1) / grain_size, 1u, range_count_max);
+	}
+
+	JobStats Threading::GetStats(const Job_Priority priority)
+	{
+		JobStats stats;
+		stats.queued = m_jobs_pending[priority].load();
+
+		const uint64_t executed = m_stats_executed[priority].exchange(0);
+		const uint64_t time_wait_us = m_stats_time_wait_us[priority].exchange(0);
+		const uint64_t time_execution_us = m_stats_time_execution_us[priority].exchange(0);
+		if (executed != 0)
+		{
+			stats.executed			= static_cast<unsigned int>(executed);
+			stats.time_wait_ms		= static_cast<float>(static_cast<double>(time_wait_us) / executed / 1000.0);
+			stats.time_execution_ms	= static_cast<float>(static_cast<double>(time_execution_us) / executed / 1000.0);
+		}
+
+		return stats;
+	}
+
+	Job* Threading::JobAllocate()
+	{
+		// Scan the pool once, starting from a rolling index so that concurrent callers spread out
+		for (unsigned int i = 0; i < m_job_capacity; i++)
+		{
+			Job* job = &m_jobs[m_job_next.fetch_add(1, memory_order_relaxed) % m_job_capacity];
+			if (job->Acquire())
+				return job;
+		}
+
+		return nullptr;
+	}
+
+	void Threading::JobSubmit(Job* job)
+	{
+		const Job_Priority priority = job->GetPriority();
+		auto& queues = m_queues[priority];
+		job->SetTimeSubmitted(chrono::steady_clock::now());
+		m_jobs_pending[priority]++;
+
+		// Workers push to their own queue, other threads distribute jobs round-robin
+		const unsigned int queue_count	= static_cast<unsigned int>(queues.size());
+		const unsigned int start		= g_worker_index != -1 ? static_cast<unsigned int>(g_worker_index) : m_queue_next.fetch_add(1, memory_order_relaxed);
+		bool pushed = false;
+		for (unsigned int i = 0; i < queue_count && !pushed; i++)
+		{
+			pushed = queues[(start + i) % queue_count]->Push(job);
+		}
+
+		// All queues are full, execute in the same thread
+		if (!pushed)
+		{
+			m_jobs_pending[priority]--;
+			JobExecute(job);
+			return;
+		}
+
+		// Only wake a thread if there is one sleeping, the mutex is taken briefly so that
+		// a thread which is about to sleep can't miss the notification
+		if (priority == Job_Io)
+		{
+			if (m_threads_sleeping_io.load() != 0)
+			{
+				{ lock_guard<mutex> lock(m_sleep_mutex); }
+				m_condition_var_io.notify_one();
+			}
+		}
+		else if (m_threads_sleeping.load() != 0)
+		{
+			{ lock_guard<mutex> lock(m_sleep_mutex); }
 
-			// Get next task in the queue.
-			task = m_tasks.front();
+			// Not every worker picks up background jobs, so wake them all to make sure one of them does
+			if (priority == Job_Background)
+			{
+				m_condition_var.notify_all();
+			}
+			else
+			{
+				m_condition_var.notify_one();
+			}
+		}
+	}
+
+	void Threading::JobExecute(Job* job)
+	{
+		const Job_Priority priority	= job->GetPriority();
+		const auto time_start		= chrono::steady_clock::now();
+		const auto time_wait		= time_start - job->GetTimeSubmitted();
 
-			// Remove it from the queue.
-			m_tasks.pop();
+		job->Execute();
 
-			// Unlock the mutex
-			lock.unlock();
+		const auto time_execution = chrono::steady_clock::now() - time_start;
+		m_stats_executed[priority]++;
+		m_stats_time_wait_us[priority]		+= chrono::duration_cast<chrono::microseconds>(time_wait).count();
+		m_stats_time_execution_us[priority]	+= chrono::duration_cast<chrono::microseconds>(time_execution).count();
 
-			// Execute the task.
-			task->Execute();
+		JobCounter* counter = job->GetCounter();
+		job->SetCounter(nullptr);
+		job->Release();
+
+		// Decrement the counter and, if this was the last job, release the jobs that depend on it
+		if (counter)
+		{
+			vector<Job*> continuations;
+			{
+				lock_guard<mutex> lock(counter->m_mutex);
+				if (--counter->m_count == 0)
+				{
+					continuations.swap(counter->m_continuations);
+				}
+			}
+
+			for (Job* continuation : continuations)
+			{
+				JobSubmit(continuation);
+			}
 		}
+
+		m_jobs_unfinished--;
+	}
+
+	Job* Threading::JobAcquire(const unsigned int queue_index, const bool allow_background)
+	{
+		const unsigned int priority_end = allow_background ? Job_Io : Job_Background;
+		for (unsigned int priority = Job_Critical; priority < priority_end; priority++)
+		{
+			// Fast path, nothing is queued anywhere
+			if (m_jobs_pending[priority].load() == 0)
+				continue;
+
+			auto& queues = m_queues[priority];
+			Job* job = queues[queue_index]->Pop();
+			for (unsigned int i = 1; i < m_thread_count && !job; i++)
+			{
+				job = queues[(queue_index + i) % m_thread_count]->Steal();
+			}
+
+			if (job)
+			{
+				m_jobs_pending[priority]--;
+				return job;
+			}
+		}
+
+		return nullptr;
+	}
+
+	bool Threading::IsBackgroundAllowed(const int worker_index) const
+	{
+		// The first worker is kept free of background jobs so that there is always a worker for critical jobs
+		return worker_index > 0 || (worker_index == 0 && m_thread_count == 1);
+	}
+
+	bool Threading::HasPendingJobs(const bool allow_background) const
+	{
+		return m_jobs_pending[Job_Critical].load() != 0 || m_jobs_pending[Job_Normal].load() != 0 || (allow_background && m_jobs_pending[Job_Background].load() != 0);
 	}
-}
\ No newline at end of file
+}
@@ -25,66 +25,302 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <vector>
 #include <thread>
 #include <mutex>
-#include <queue>
+#include <atomic>
+#include <memory>
+#include <condition_variable>
+#include <type_traits>
+#include <cstddef>
+#include <cstdint>
+#include <chrono>
+#include "JobQueue.h"
 #include "../Core/ISubsystem.h"
+#include "../Core/FrameAllocator.h"
 #include "../Logging/Log.h"
 //============================
 
 namespace Spartan
 {
-	//= TASK ===============================================================================
-	class Task
+	class Job;
+
+	// Workers pick up jobs in this order, background jobs never occupy every worker.
+	// Blocking file I/O goes to a separate, smaller set of threads so it can't stall compute work.
+	enum Job_Priority
+	{
+		Job_Critical,	// frame work, latency sensitive
+		Job_Normal,
+		Job_Background,	// long running work which can be late
+		Job_Io			// blocking file I/O (resource loading/saving)
+	};
+	static const unsigned int job_priority_count = 4;
+
+	struct JobStats
+	{
+		unsigned int queued		= 0;	// jobs waiting to be executed
+		unsigned int executed	= 0;	// jobs executed since the previous query
+		float time_wait_ms		= 0.0f;	// average time between submission and execution
+		float time_execution_ms	= 0.0f;	// average execution time
+	};
+
+	//= JOB COUNTER =======================================================================================
+	// Tracks a group of jobs. Jobs added with a counter increment it and decrement it once they are done,
+	// jobs added with a dependency are held back until that counter reaches zero. Must outlive its jobs.
+	class JobCounter
 	{
 	public:
-		typedef std::function<void()> functionType;
+		JobCounter() = default;
+		JobCounter(const JobCounter&) = delete;
+		JobCounter& operator=(const JobCounter&) = delete;
+
+		bool IsDone() const { return m_count.load() == 0; }
+
+	private:
+		friend class Threading;
+		std::atomic<unsigned int> m_count = 0;
+		std::vector<Job*> m_continuations;
+		std::mutex m_mutex;
+	};
+	//=====================================================================================================
+
+	//= JOB ===============================================================================================
+	// A unit of work. The callable is stored in-place (no std::function, no heap allocation),
+	// only callables larger than the inline storage fall back to a heap allocation.
+	class Job
+	{
+	public:
+		static const unsigned int storage_size = 64;
+
+		template <typename Function>
+		void Set(Function&& function)
+		{
+			using function_type = std::decay_t<Function>;
+
+			if constexpr (sizeof(function_type) <= storage_size && alignof(function_type) <= alignof(std::max_align_t))
+			{
+				new (m_storage) function_type(std::forward<Function>(function));
+				m_invoke	= [](void* storage) { (*static_cast<function_type*>(storage))(); };
+				m_destroy	= [](void* storage) { static_cast<function_type*>(storage)->~function_type(); };
+			}
+			else
+			{
+				*reinterpret_cast<function_type**>(m_storage) = new function_type(std::forward<Function>(function));
+				m_invoke	= [](void* storage) { (**static_cast<function_type**>(storage))(); };
+				m_destroy	= [](void* storage) { delete *static_cast<function_type**>(storage); };
+			}
+		}
+
+		void Execute()
+		{
+			m_invoke(m_storage);
+			m_destroy(m_storage);
+			m_invoke	= nullptr;
+			m_destroy	= nullptr;
+		}
+
+		// The counter to decrement once the job has executed
+		void SetCounter(JobCounter* counter)	{ m_counter = counter; }
+		JobCounter* GetCounter() const			{ return m_counter; }
+
+		void SetPriority(const Job_Priority priority)	{ m_priority = priority; }
+		Job_Priority GetPriority() const				{ return m_priority; }
+
+		void SetTimeSubmitted(const std::chrono::steady_clock::time_point& time)	{ m_time_submitted = time; }
+		const auto& GetTimeSubmitted() const										{ return m_time_submitted; }
 
-		Task(functionType&& function) { m_function = std::forward<functionType>(function); }
-		void Execute() { m_function(); }
+		// Claims the job slot, returns false if it's already in use
+		bool Acquire()	{ bool expected = false; return m_in_use.compare_exchange_strong(expected, true, std::memory_order_acquire); }
+		void Release()	{ m_in_use.store(false, std::memory_order_release); }
 
 	private:
-		functionType m_function;
+		alignas(std::max_align_t) unsigned char m_storage[storage_size];
+		void (*m_invoke)(void*)		= nullptr;
+		void (*m_destroy)(void*)	= nullptr;
+		JobCounter* m_counter		= nullptr;
+		Job_Priority m_priority		= Job_Normal;
+		std::chrono::steady_clock::time_point m_time_submitted;
+		std::atomic<bool> m_in_use	= false;
 	};
-	//======================================================================================
+	//=====================================================================================================
 
-	class Threading : public ISubsystem
+	class SPARTAN_CLASS Threading : public ISubsystem
 	{
 	public:
 		Threading(Context* context);
 		~Threading();
 
-		// This function is invoked by the threads
-		void Invoke();
+		// These functions are invoked by the threads
+		void Invoke(unsigned int thread_index);
+		void InvokeIo();
 
-		// Add a task
+		// Add a task, optionally tracked by a counter and/or held back until a dependency counter reaches zero
 		template <typename Function>
-		void AddTask(Function&& function)
+		void AddTask(Function&& function, const Job_Priority priority = Job_Normal, JobCounter* counter = nullptr, JobCounter* dependency = nullptr)
 		{
-			if (m_threads.empty())
+			if (priority == Job_Io ? m_threads_io.empty() : m_threads.empty())
 			{
 				LOG_WARNING("Threading::AddTask: No available threads, function will execute in the same thread");
+				if (dependency) Wait(dependency);
 				function();
 				return;
 			}
 
-			// Lock tasks mutex
-			std::unique_lock<std::mutex> lock(m_tasksMutex);
+			// Get a free job from the pool
+			Job* job = JobAllocate();
+			if (!job)
+			{
+				LOG_WARNING("Threading::AddTask: Job pool is exhausted, function will execute in the same thread");
+				if (dependency) Wait(dependency);
+				function();
+				return;
+			}
+
+			job->Set(std::forward<Function>(function));
+			job->SetCounter(counter);
+			job->SetPriority(priority);
+			if (counter)
+			{
+				counter->m_count++;
+			}
+			m_jobs_unfinished++;
+
+			// Defer the job if its dependency is still running, it will be submitted once the dependency completes
+			if (dependency)
+			{
+				std::lock_guard<std::mutex> lock(dependency->m_mutex);
+				if (dependency->m_count.load() != 0)
+				{
+					dependency->m_continuations.emplace_back(job);
+					return;
+				}
+			}
+
+			JobSubmit(job);
+		}
+
+		// Waits until the counter reaches zero, executing jobs in the meantime (instead of blocking)
+		void Wait(JobCounter* counter);
+
+		// Waits until predicate() returns true, executing jobs in the meantime (instead of blocking).
+		// Whatever makes the predicate true has to happen in a job or on another thread.
+		template <typename Predicate>
+		void WaitUntil(Predicate&& predicate)
+		{
+			while (!predicate())
+			{
+				if (!ExecutePendingJob())
+				{
+					std::this_thread::yield();
+				}
+			}
+		}
+
+		// Splits [0, count) into ranges and executes function(start, end) for each of them in parallel.
+		// A grain size of 0 selects one automatically, loops which fit in a single grain run serially in the calling thread.
+		template <typename Function>
+		void ParallelFor(const unsigned int count, Function&& function, const unsigned int grain_size = 0, const Job_Priority priority = Job_Normal)
+		{
+			const unsigned int range_count = GetRangeCount(count, grain_size);
+			if (range_count <= 1)
+			{
+				function(0u, count);
+				return;
+			}
+
+			// Submit all ranges but the first one, which the calling thread executes itself
+			JobCounter counter;
+			for (unsigned int i = 1; i < range_count; i++)
+			{
+				const unsigned int start	= GetRangeStart(count, range_count, i);
+				const unsigned int end		= GetRangeStart(count, range_count, i + 1);
+				AddTask([&function, start, end]() { function(start, end); }, priority, &counter);
+			}
+
+			function(0u, GetRangeStart(count, range_count, 1));
+			Wait(&counter);
+		}
+
+		// Splits [0, count) into ranges, executes function(start, end, T& partial) for each of them in parallel and
+		// combines the partial results in range order via combine(T& result, const T& partial), so the result is deterministic.
+		// The partial results live in frame memory.
+		template <typename T, typename Function, typename Combine>
+		T ParallelReduce(const unsigned int count, const T& identity, Function&& function, Combine&& combine, const unsigned int grain_size = 0, const Job_Priority priority = Job_Normal)
+		{
+			const unsigned int range_count = GetRangeCount(count, grain_size);
+			if (range_count <= 1)
+			{
+				T result = identity;
+				function(0u, count, result);
+				return result;
+			}
 
-			// Save the task
-			m_tasks.push(std::make_shared<Task>(std::bind(std::forward<Function>(function))));
+			FrameVector<T> partials(range_count, identity);
+			ParallelFor(range_count, [this, &function, &partials, count, range_count](const unsigned int range_start, const unsigned int range_end)
+			{
+				for (unsigned int i = range_start; i < range_end; i++)
+				{
+					function(GetRangeStart(count, range_count, i), GetRangeStart(count, range_count, i + 1), partials[i]);
+				}
+			}, 1, priority);
 
-			// Unlock the mutex
-			lock.unlock();
+			T result = std::move(partials[0]);
+			for (unsigned int i = 1; i < range_count; i++)
+			{
+				combine(result, partials[i]);
+			}
 
-			// Wake up a thread
-			m_conditionVar.notify_one();
+			return result;
 		}
 
+		// Executes a single pending job on the calling thread, returns false if there was nothing to do
+		bool ExecutePendingJob();
+
+		// Waits until all submitted jobs have completed, executing jobs in the meantime (instead of blocking)
+		void WaitIdle();
+
+		unsigned int GetThreadCount() const { return m_thread_count; }
+
+		// Returns the statistics of a priority, averaged since the previous query
+		JobStats GetStats(Job_Priority priority);
+
 	private:
-		unsigned int m_threadCount;
+		unsigned int GetRangeCount(unsigned int count, unsigned int grain_size) const;
+		static unsigned int GetRangeStart(const unsigned int count, const unsigned int range_count, const unsigned int range_index)
+		{
+			return static_cast<unsigned int>((static_cast<uint64_t>(count) * range_index) / range_count);
+		}
+
+		Job* JobAllocate();
+		void JobSubmit(Job* job);
+		void JobExecute(Job* job);
+		Job* JobAcquire(unsigned int queue_index, bool allow_background);
+		bool IsBackgroundAllowed(int worker_index) const;
+		bool HasPendingJobs(bool allow_background) const;
+
+		unsigned int m_thread_count		= 0;
+		unsigned int m_thread_count_io	= 2;
 		std::vector<std::thread> m_threads;
-		std::queue<std::shared_ptr<Task>> m_tasks;
-		std::mutex m_tasksMutex;
-		std::condition_variable m_conditionVar;
-		bool m_stopping;
+		std::vector<std::thread> m_threads_io;
+		const unsigned int m_grain_size_min = 256;
+
+		// Jobs
+		std::unique_ptr<Job[]> m_jobs;
+		unsigned int m_job_capacity = 4096;
+		std::atomic<unsigned int> m_job_next = 0;
+		std::vector<std::unique_ptr<JobQueue>> m_queues[job_priority_count]; // one per worker, a single shared one for I/O
+		std::atomic<unsigned int> m_queue_next							= 0;
+		std::atomic<unsigned int> m_jobs_pending[job_priority_count]	= {}; // queued, not yet picked up
+		std::atomic<unsigned int> m_jobs_unfinished						= 0;  // queued or executing
+
+		// Stats
+		std::atomic<uint64_t> m_stats_executed[job_priority_count]			= {};
+		std::atomic<uint64_t> m_stats_time_wait_us[job_priority_count]		= {};
+		std::atomic<uint64_t> m_stats_time_execution_us[job_priority_count]	= {};
+
+		// Sleeping
+		std::mutex m_sleep_mutex;
+		std::condition_variable m_condition_var;
+		std::condition_variable m_condition_var_io;
+		std::atomic<unsigned int> m_threads_sleeping	= 0;
+		std::atomic<unsigned int> m_threads_sleeping_io	= 0;
+		std::atomic<bool> m_stopping = false;
 	};
-}
\ No newline at end of file
+}
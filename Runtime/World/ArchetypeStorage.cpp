@@ -0,0 +1,164 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES =====================
+#include "ArchetypeStorage.h"
+#include "Entity.h"
+#include "Components/Transform.h"
+#include "Components/Renderable.h"
+//================================
+
+//= NAMESPACES ================
+using namespace std;
+using namespace Spartan::Math;
+//=============================
+
+namespace Spartan
+{
+	unsigned int Archetype::Add(Entity* entity)
+	{
+		const unsigned int row = m_count++;
+		if (row / ArchetypeChunk::capacity >= m_chunks.size())
+		{
+			m_chunks.emplace_back(make_unique<ArchetypeChunk>());
+		}
+
+		ArchetypeChunk& chunk = *m_chunks[row / ArchetypeChunk::capacity];
+		chunk.entities[chunk.count++] = entity;
+		Write(row);
+
+		return row;
+	}
+
+	Entity* Archetype::Remove(const unsigned int row)
+	{
+		const unsigned int row_last	= --m_count;
+		ArchetypeChunk& chunk		= *m_chunks[row / ArchetypeChunk::capacity];
+		ArchetypeChunk& chunk_last	= *m_chunks[row_last / ArchetypeChunk::capacity];
+		const unsigned int i		= row % ArchetypeChunk::capacity;
+		const unsigned int i_last	= row_last % ArchetypeChunk::capacity;
+
+		// Move the last row into the removed one
+		Entity* moved = nullptr;
+		if (row != row_last)
+		{
+			chunk.entities[i]	= chunk_last.entities[i_last];
+			chunk.positions[i]	= chunk_last.positions[i_last];
+			chunk.rotations[i]	= chunk_last.rotations[i_last];
+			chunk.scales[i]		= chunk_last.scales[i_last];
+			chunk.matrices[i]	= chunk_last.matrices[i_last];
+			chunk.bounds[i]		= chunk_last.bounds[i_last];
+			moved				= chunk.entities[i];
+		}
+
+		// Release the last chunk once it's empty, so that queries never see one
+		if (--chunk_last.count == 0)
+		{
+			m_chunks.pop_back();
+		}
+
+		return moved;
+	}
+
+	const BoundingBox& Archetype::Write(const unsigned int row)
+	{
+		ArchetypeChunk& chunk	= *m_chunks[row / ArchetypeChunk::capacity];
+		const unsigned int i	= row % ArchetypeChunk::capacity;
+		Entity* entity			= chunk.entities[i];
+		Transform* transform	= entity->GetTransform_PtrRaw();
+
+		chunk.positions[i]	= transform->GetPositionLocal();
+		chunk.rotations[i]	= transform->GetRotationLocal();
+		chunk.scales[i]		= transform->GetScaleLocal();
+		chunk.matrices[i]	= transform->GetMatrix();
+
+		// The geometry's bounds in model space, transformed by the matrix copied above
+		chunk.bounds[i] = BoundingBox();
+		if (const Renderable* renderable = entity->GetRenderable_PtrRaw())
+		{
+			BoundingBox box = renderable->GeometryAabb();
+			if (box.Defined())
+			{
+				chunk.bounds[i] = box.Transformed(chunk.matrices[i]);
+			}
+		}
+
+		return chunk.bounds[i];
+	}
+
+	const BoundingBox& ArchetypeStorage::Update(Entity* entity)
+	{
+		const ComponentMask mask = entity->GetComponentsMask();
+
+		// Same set of component types, only the data may have changed
+		auto it = m_records.find(entity);
+		if (it != m_records.end() && m_archetypes[it->second.archetype]->GetMask() == mask)
+			return m_archetypes[it->second.archetype]->Write(it->second.row);
+
+		if (it != m_records.end())
+		{
+			Remove(entity);
+		}
+
+		Record record;
+		record.archetype	= GetArchetype(mask);
+		record.row			= m_archetypes[record.archetype]->Add(entity);
+		m_records[entity]	= record;
+
+		return m_archetypes[record.archetype]->GetChunks()[record.row / ArchetypeChunk::capacity]->bounds[record.row % ArchetypeChunk::capacity];
+	}
+
+	void ArchetypeStorage::Remove(Entity* entity)
+	{
+		const auto it = m_records.find(entity);
+		if (it == m_records.end())
+			return;
+
+		const Record record = it->second;
+		m_records.erase(it);
+
+		// The last row of the archetype took the place of the removed one
+		if (Entity* moved = m_archetypes[record.archetype]->Remove(record.row))
+		{
+			m_records[moved].row = record.row;
+		}
+	}
+
+	void ArchetypeStorage::Clear()
+	{
+		m_archetypes.clear();
+		m_archetype_lookup.clear();
+		m_records.clear();
+	}
+
+	unsigned int ArchetypeStorage::GetArchetype(const ComponentMask mask)
+	{
+		const auto it = m_archetype_lookup.find(mask);
+		if (it != m_archetype_lookup.end())
+			return it->second;
+
+		const auto index = static_cast<unsigned int>(m_archetypes.size());
+		m_archetypes.emplace_back(make_unique<Archetype>(mask));
+		m_archetype_lookup[mask] = index;
+
+		return index;
+	}
+}
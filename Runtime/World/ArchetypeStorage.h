@@ -0,0 +1,129 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES =====================
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include "Components/IComponent.h"
+#include "../Math/Vector3.h"
+#include "../Math/Quaternion.h"
+#include "../Math/Matrix.h"
+#include "../Math/BoundingBox.h"
+//================================
+
+namespace Spartan
+{
+	class Entity;
+
+	// A fixed number of entities of one archetype and the data that is read about them every frame, stored by value with
+	// one contiguous array per field. Transform and Renderable remain the components that are edited, the world copies
+	// their values in here once they are resolved, so everything in a chunk is as of the last tick.
+	struct ArchetypeChunk
+	{
+		static const unsigned int capacity = 64;
+
+		unsigned int count = 0;
+		Entity* entities[capacity];
+		// Local position, rotation and scale
+		Math::Vector3 positions[capacity];
+		Math::Quaternion rotations[capacity];
+		Math::Vector3 scales[capacity];
+		// World matrices
+		Math::Matrix matrices[capacity];
+		// World space bounds of the geometry, undefined for entities without any
+		Math::BoundingBox bounds[capacity];
+	};
+
+	// All entities with the same set of component types. Rows are removed by moving the last row into them,
+	// so every chunk is full except for the last one.
+	class Archetype
+	{
+	public:
+		Archetype(const ComponentMask mask) : m_mask(mask) {}
+
+		// Appends a row and returns its index
+		unsigned int Add(Entity* entity);
+		// Removes a row by moving the last row into it, returns the entity which was moved (if any)
+		Entity* Remove(unsigned int row);
+		// Copies the transform and the bounds of the entity of a row
+		const Math::BoundingBox& Write(unsigned int row);
+
+		ComponentMask GetMask() const									{ return m_mask; }
+		unsigned int GetCount() const									{ return m_count; }
+		const std::vector<std::unique_ptr<ArchetypeChunk>>& GetChunks() const	{ return m_chunks; }
+
+	private:
+		ComponentMask m_mask;
+		unsigned int m_count = 0;
+		std::vector<std::unique_ptr<ArchetypeChunk>> m_chunks;
+	};
+
+	// Keeps track of the archetype and the row of every entity of the world and answers queries over the chunks.
+	// Not thread safe, it's meant to be used from the thread that ticks the world.
+	class SPARTAN_CLASS ArchetypeStorage
+	{
+	public:
+		ArchetypeStorage() = default;
+		~ArchetypeStorage() = default;
+
+		// Starts tracking the entity if needed, moves it to another archetype if its components changed and copies
+		// its transform and bounds. Returns the world space bounds that were stored.
+		const Math::BoundingBox& Update(Entity* entity);
+		void Remove(Entity* entity);
+		void Clear();
+
+		// Invokes function(const ArchetypeChunk&) for every chunk of entities which have all of the components T and none of mask_exclude
+		template <typename... T, typename Function>
+		void Query(Function&& function, const ComponentMask mask_exclude = 0) const
+		{
+			const ComponentMask mask = GetComponentMask<T...>();
+			for (const auto& archetype : m_archetypes)
+			{
+				if ((archetype->GetMask() & mask) != mask || (archetype->GetMask() & mask_exclude) != 0)
+					continue;
+
+				for (const auto& chunk : archetype->GetChunks())
+				{
+					function(static_cast<const ArchetypeChunk&>(*chunk));
+				}
+			}
+		}
+
+		unsigned int GetArchetypeCount() const	{ return static_cast<unsigned int>(m_archetypes.size()); }
+		unsigned int GetCount() const			{ return static_cast<unsigned int>(m_records.size()); }
+
+	private:
+		struct Record
+		{
+			unsigned int archetype	= 0;
+			unsigned int row		= 0;
+		};
+
+		unsigned int GetArchetype(ComponentMask mask);
+
+		std::vector<std::unique_ptr<Archetype>> m_archetypes;
+		std::unordered_map<ComponentMask, unsigned int> m_archetype_lookup;
+		std::unordered_map<Entity*, Record> m_records;
+	};
+}
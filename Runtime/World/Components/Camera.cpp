@@ -86,7 +86,7 @@ namespace Spartan
 	void Camera::Serialize(FileStream* stream)
 	{
 		stream->Write(m_clear_color);
-		stream->Write(unsigned int(m_projection_type));
+		stream->Write(static_cast<unsigned int>(m_projection_type));
 		stream->Write(m_fov_horizontal_rad);
 		stream->Write(m_near_plane);
 		stream->Write(m_far_plane);
@@ -162,21 +162,10 @@ namespace Spartan
 		if (x_outside || y_outside)
 			return false;
 
-		// Trace ray
-		m_ray		= Ray(GetTransform()->GetPosition(), ScreenToWorldPoint(mouse_position_relative));
-		auto hits	= m_ray.Trace(m_context);
-
-		// Get closest hit that doesn't start inside an entity
-		for (const auto& hit : hits)
-		{
-			if (hit.m_inside)
-				continue;
-
-			entity = hit.m_entity;
-			return true;
-		}
-
-		entity = nullptr;
+		// Trace ray, picking the closest triangle
+		m_ray = Ray(GetTransform()->GetPosition(), ScreenToWorldPoint(mouse_position_relative));
+		RayHit hit;
+		entity = m_ray.TraceClosest(m_context, &hit) ? hit.m_entity : nullptr;
 		return true;
 	}
 
@@ -88,7 +88,7 @@ namespace Spartan
 
 	void Collider::Serialize(FileStream* stream)
 	{
-		stream->Write(unsigned int(m_shapeType));
+		stream->Write(static_cast<unsigned int>(m_shapeType));
 		stream->Write(m_size);
 		stream->Write(m_center);
 	}
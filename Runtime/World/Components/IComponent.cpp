@@ -60,23 +60,4 @@ namespace Spartan
 
 		return m_entity->GetName();
 	}
-
-	template <typename T>
-	constexpr ComponentType IComponent::TypeToEnum() { return ComponentType_Unknown; }
-
-	// Explicit template instantiation
-	#define REGISTER_COMPONENT(T, enumT) template<> SPARTAN_CLASS ComponentType IComponent::TypeToEnum<T>() { return enumT; }
-
-	// To add a new component to the engine, simply register it here
-	REGISTER_COMPONENT(AudioListener,	ComponentType_AudioListener)
-	REGISTER_COMPONENT(AudioSource,		ComponentType_AudioSource)
-	REGISTER_COMPONENT(Camera,			ComponentType_Camera)
-	REGISTER_COMPONENT(Collider,		ComponentType_Collider)
-	REGISTER_COMPONENT(Constraint,		ComponentType_Constraint)
-	REGISTER_COMPONENT(Light,			ComponentType_Light)
-	REGISTER_COMPONENT(Renderable,		ComponentType_Renderable)
-	REGISTER_COMPONENT(RigidBody,		ComponentType_RigidBody)
-	REGISTER_COMPONENT(Script,			ComponentType_Script)
-	REGISTER_COMPONENT(Skybox,			ComponentType_Skybox)
-	REGISTER_COMPONENT(Transform,		ComponentType_Transform)
 }
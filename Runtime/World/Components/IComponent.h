@@ -27,15 +27,26 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <any>
 #include <vector>
 #include <functional>
+#include <cstdint>
 #include "../../Core/EngineDefs.h"
 //================================
 
 namespace Spartan
 {
 	class Entity;
-	class Transform;
 	class Context;
 	class FileStream;
+	class AudioListener;
+	class AudioSource;
+	class Camera;
+	class Collider;
+	class Constraint;
+	class Light;
+	class Renderable;
+	class RigidBody;
+	class Script;
+	class Skybox;
+	class Transform;
 
 	enum ComponentType : unsigned int
 	{
@@ -86,10 +97,11 @@ namespace Spartan
 		// Runs when the entity is being loaded
 		virtual void Deserialize(FileStream* stream) {}
 
-		//= TYPE ===================================
+		//= TYPE ===================================================================
+		// Resolved at compile time, so it can index tables and build masks
 		template <typename T>
-		static constexpr ComponentType TypeToEnum();
-		//==========================================
+		static constexpr ComponentType TypeToEnum() { return ComponentType_Unknown; }
+		//==========================================================================
 
 		//= PROPERTIES ==========================================================================
 		Entity*						GetEntity_PtrRaw() const	{ return m_entity; }	
@@ -153,4 +165,25 @@ namespace Spartan
 		// The attributes of the component
 		std::vector<Attribute> m_attributes;
 	};
-}
\ No newline at end of file
+
+	// A bit per ComponentType
+	using ComponentMask = uint32_t;
+
+	template <typename... T>
+	constexpr ComponentMask GetComponentMask() { return ((ComponentMask(1) << IComponent::TypeToEnum<T>()) | ... | ComponentMask(0)); }
+
+	#define REGISTER_COMPONENT(T, enumT) template<> constexpr ComponentType IComponent::TypeToEnum<T>() { return enumT; }
+
+	// To add a new component to the engine, simply register it here
+	REGISTER_COMPONENT(AudioListener,	ComponentType_AudioListener)
+	REGISTER_COMPONENT(AudioSource,		ComponentType_AudioSource)
+	REGISTER_COMPONENT(Camera,			ComponentType_Camera)
+	REGISTER_COMPONENT(Collider,		ComponentType_Collider)
+	REGISTER_COMPONENT(Constraint,		ComponentType_Constraint)
+	REGISTER_COMPONENT(Light,			ComponentType_Light)
+	REGISTER_COMPONENT(Renderable,		ComponentType_Renderable)
+	REGISTER_COMPONENT(RigidBody,		ComponentType_RigidBody)
+	REGISTER_COMPONENT(Script,			ComponentType_Script)
+	REGISTER_COMPONENT(Skybox,			ComponentType_Skybox)
+	REGISTER_COMPONENT(Transform,		ComponentType_Transform)
+}
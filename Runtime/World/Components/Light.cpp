@@ -111,7 +111,7 @@ namespace Spartan
 
 	void Light::Serialize(FileStream* stream)
 	{
-		stream->Write(unsigned int(m_lightType));
+		stream->Write(static_cast<unsigned int>(m_lightType));
 		stream->Write(m_castShadows);
 		stream->Write(m_color);
 		stream->Write(m_range);
@@ -27,6 +27,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../../Rendering/Utilities/Geometry.h"
 #include "../../Rendering/Material.h"
 #include "../../Rendering/Model.h"
+#include "../World.h"
 //=============================================
 
 //= NAMESPACES ================
@@ -151,6 +152,10 @@ namespace Spartan
 		{
 			GeometrySet(m_geometry_type);
 		}
+		else if (const auto world = m_context->GetSubsystem<World>())
+		{
+			world->EntitySpatialUpdate(GetEntity_PtrRaw());
+		}
 
 		// Material
 		stream->Read(&m_castShadows);
@@ -179,6 +184,12 @@ namespace Spartan
 		m_geometryVertexCount	= vertex_count;
 		m_geometryAABB			= aabb;
 		m_model					= model;
+
+		// The bounds changed, let the world know
+		if (const auto world = m_context->GetSubsystem<World>())
+		{
+			world->EntitySpatialUpdate(GetEntity_PtrRaw());
+		}
 	}
 
 	void Renderable::GeometrySet(const Geometry_Type type)
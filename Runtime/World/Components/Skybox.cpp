@@ -86,7 +86,7 @@ namespace Spartan
 			{
 				CreateFromSphere(m_texturePaths.front());
 			}
-		});
+		}, Job_Io);
 	}
 
 	void Skybox::OnTick()
@@ -21,12 +21,12 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 //= INCLUDES ============================
 #include "Transform.h"
+#include <algorithm>
 #include "../World.h"
 #include "../Entity.h"
 #include "../../Core/Context.h"
 #include "../../IO/FileStream.h"
 #include "../../FileSystem/FileSystem.h"
-#include "../../RHI/RHI_ConstantBuffer.h"
 //=======================================
 
 //= NAMESPACES ================
@@ -86,29 +86,62 @@ namespace Spartan
 			}
 		}
 
-		UpdateTransform();
+		MarkDirty();
 	}
 	//===============================================================================================
 	void Transform::UpdateTransform()
+	{
+		// The parent resolves itself first if it's dirty
+		ComputeMatrices(HasParent() ? &GetParent()->GetMatrix() : nullptr);
+	}
+
+	void Transform::ComputeMatrices(const Matrix* matrix_parent)
 	{
 		// Compute local transform
 		m_matrixLocal = Matrix(m_positionLocal, m_rotationLocal, m_scaleLocal);
 
 		// Compute world transform
-		if (!HasParent())
+		if (!matrix_parent)
 		{
 			m_matrix = m_matrixLocal;
 		}
 		else
 		{
-			m_matrix = m_matrixLocal * GetParentTransformMatrix();
+			m_matrix = m_matrixLocal * (*matrix_parent);
 		}
-		
-		// Update children
+
+		m_is_dirty		= false;
+		m_is_decomposed	= false;
+		m_has_moved		= true;
+	}
+
+	void Transform::MarkDirty()
+	{
+		// The descendants of a dirty transform are always dirty as well
+		if (m_is_dirty)
+			return;
+
+		m_is_dirty = true;
+
 		for (const auto& child : m_children)
 		{
-			child->UpdateTransform();
+			child->MarkDirty();
+		}
+	}
+
+	void Transform::Decompose()
+	{
+		if (m_is_dirty)
+		{
+			UpdateTransform();
 		}
+
+		if (m_is_decomposed)
+			return;
+
+		m_scale			= m_matrix.GetScale();
+		m_rotation		= m_matrix.GetRotation(m_scale);
+		m_is_decomposed	= true;
 	}
 
 	//= TRANSLATION ==================================================================================
@@ -126,7 +159,7 @@ namespace Spartan
 			return;
 
 		m_positionLocal = position;
-		UpdateTransform();
+		MarkDirty();
 	}
 	//================================================================================================
 
@@ -145,7 +178,7 @@ namespace Spartan
 			return;
 
 		m_rotationLocal = rotation;
-		UpdateTransform();
+		MarkDirty();
 	}
 	//================================================================================================
 
@@ -171,7 +204,7 @@ namespace Spartan
 		m_scaleLocal.y = (m_scaleLocal.y == 0.0f) ? M_EPSILON : m_scaleLocal.y;
 		m_scaleLocal.z = (m_scaleLocal.z == 0.0f) ? M_EPSILON : m_scaleLocal.z;
 
-		UpdateTransform();
+		MarkDirty();
 	}
 	//================================================================================================
 
@@ -247,8 +280,9 @@ namespace Spartan
 			// if this transform already has a parent
 			if (this->HasParent())
 			{
-				// assign the parent of this transform to the children
-				for (const auto& child : m_children)
+				// assign the parent of this transform to the children (copied, as they detach themselves while we iterate)
+				const auto children = m_children;
+				for (const auto& child : children)
 				{
 					child->SetParent(GetParent());
 				}
@@ -256,7 +290,8 @@ namespace Spartan
 			else // if this transform doesn't have a parent
 			{
 				// make the children orphans
-				for (const auto& child : m_children)
+				const auto children = m_children;
+				for (const auto& child : children)
 				{
 					child->BecomeOrphan();
 				}
@@ -266,15 +301,21 @@ namespace Spartan
 		// Switch parent but keep a pointer to the old one
 		auto parent_old = m_parent;
 		m_parent = new_parent;
-		if (parent_old) parent_old->AcquireChildren(); // update the old parent (so it removes this child)
+		if (parent_old) parent_old->ChildRemove(this); // update the old parent (so it removes this child)
 
 		// make the new parent "aware" of this transform/child
 		if (m_parent)
 		{
-			m_parent->AcquireChildren();
+			m_parent->ChildAdd(this);
 		}
 
-		UpdateTransform();
+		// The world has to flatten the hierarchy again
+		if (const auto world = GetContext()->GetSubsystem<World>())
+		{
+			world->TransformHierarchyChanged();
+		}
+
+		MarkDirty();
 	}
 
 	void Transform::AddChild(Transform* child)
@@ -325,7 +366,7 @@ namespace Spartan
 		m_children.clear();
 		m_children.shrink_to_fit();
 
-		auto entities = GetContext()->GetSubsystem<World>()->Entities_GetAll();
+		const auto& entities = GetContext()->GetSubsystem<World>()->Entities_GetAll();
 		for (const auto& entity : entities)
 		{
 			if (!entity)
@@ -375,66 +416,17 @@ namespace Spartan
 		}
 	}
 
-	void Transform::UpdateConstantBuffer(const shared_ptr<RHI_Device>& rhi_device, const Matrix& view_projection)
+	void Transform::UpdateInstanceData(const Matrix& view_projection, CB_Gbuffer* instance)
 	{
-		// Has to match GBuffer.hlsl
-		if (!m_cb_gbuffer_gpu)
-		{
-			m_cb_gbuffer_gpu = make_shared<RHI_ConstantBuffer>(rhi_device);
-			m_cb_gbuffer_gpu->Create<CB_Gbuffer>();
-		}
-
-		auto mvp_current = m_matrix * view_projection;
-	
-		// Determine if the buffer needs to update
-		auto update	= false;
-		update				= m_cb_gbuffer_cpu.model		!= m_matrix	? true : update;
-		bool new_input		= m_cb_gbuffer_cpu.mvp_current	!= mvp_current;
-		bool non_zero_delta = m_cb_gbuffer_cpu.mvp_current	!= m_cb_gbuffer_cpu.mvp_previous;
-		update				= new_input || non_zero_delta ? true : update;
-		if (!update)
-			return;
-
-		// Update buffer
-		auto buffer = static_cast<CB_Gbuffer*>(m_cb_gbuffer_gpu->Map());
+		const auto mvp_current = m_matrix * view_projection;
 
-		buffer->model			= m_cb_gbuffer_cpu.model		= m_matrix;
-		buffer->mvp_current		= m_cb_gbuffer_cpu.mvp_current	= mvp_current;
-		buffer->mvp_previous	= m_cb_gbuffer_cpu.mvp_previous	= m_wvp_previous;
-
-		m_cb_gbuffer_gpu->Unmap();
+		instance->model			= m_matrix;
+		instance->mvp_current	= mvp_current;
+		instance->mvp_previous	= m_wvp_previous;
 
 		m_wvp_previous = mvp_current;
 	}
 
-	void Transform::UpdateConstantBufferLight(const shared_ptr<RHI_Device>& rhi_device, const Matrix& view_projection, unsigned int cascade_index)
-	{
-		// Has to match GBuffer.hlsl
-		if (cascade_index >=  static_cast<unsigned int>(m_light_cascades.size()))
-		{
-			LightCascade cb_light;
-			cb_light.buffer = make_shared<RHI_ConstantBuffer>(rhi_device);
-			cb_light.buffer->Create<Matrix>();
-			m_light_cascades.emplace_back(cb_light);
-		}
-		auto& cb_light = m_light_cascades[cascade_index];
-
-		// Determine if the buffer needs to update
-		auto mvp = m_matrix * view_projection;
-		if (cb_light.data == mvp)
-			return;
-
-		// Update buffer
-		Matrix& data = *static_cast<Matrix*>(cb_light.buffer->Map());
-		data = mvp;
-		cb_light.buffer->Unmap();
-	}
-
-	Matrix Transform::GetParentTransformMatrix() const
-	{
-		return HasParent() ? GetParent()->GetMatrix() : Matrix::Identity;
-	}
-
 	// Makes this transform have no parent
 	void Transform::BecomeOrphan()
 	{
@@ -448,15 +440,32 @@ namespace Spartan
 		// delete the original reference
 		m_parent = nullptr;
 
-		// Update the transform without the parent now
-		UpdateTransform();
+		// The world has to flatten the hierarchy again
+		if (const auto world = GetContext()->GetSubsystem<World>())
+		{
+			world->TransformHierarchyChanged();
+		}
+
+		// The transform has to be resolved without the parent now
+		MarkDirty();
 
-		// make the parent search for children,
-		// that's indirect way of making tha parent "forget"
-		// about this child, since it won't be able to find it
+		// make the parent forget about this child
 		if (temp_ref)
 		{
-			temp_ref->AcquireChildren();
+			temp_ref->ChildRemove(this);
+		}
+	}
+
+	void Transform::ChildAdd(Transform* child)
+	{
+		if (find(m_children.begin(), m_children.end(), child) == m_children.end())
+		{
+			m_children.emplace_back(child);
 		}
 	}
+
+	void Transform::ChildRemove(Transform* child)
+	{
+		m_children.erase(remove(m_children.begin(), m_children.end(), child), m_children.end());
+	}
 }
\ No newline at end of file
@@ -32,11 +32,9 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 namespace Spartan
 {
-	class RHI_Device;
-	class RHI_ConstantBuffer;
-
 	class SPARTAN_CLASS Transform : public IComponent
 	{
+		friend class TransformHierarchy;
 	public:
 		Transform(Context* context, Entity* entity, Transform* transform);
 		~Transform() = default;
@@ -47,24 +45,26 @@ namespace Spartan
 		void Deserialize(FileStream* stream) override;
 		//============================================
 
+		// Setters only mark the transform (and its descendants) dirty, this resolves the world matrix and any dirty ancestors
 		void UpdateTransform();
+		bool IsDirty() const { return m_is_dirty; }
 
 		//= POSITION ========================================================================
-		Math::Vector3 GetPosition()						{ return m_matrix.GetTranslation(); }
+		Math::Vector3 GetPosition()						{ return GetMatrix().GetTranslation(); }
 		const Math::Vector3& GetPositionLocal() const	{ return m_positionLocal; }
 		void SetPosition(const Math::Vector3& position);
 		void SetPositionLocal(const Math::Vector3& position);
 		//===================================================================================
 
 		//= ROTATION =========================================================================
-		Math::Quaternion GetRotation()						{ return m_matrix.GetRotation(); }
+		Math::Quaternion GetRotation()						{ Decompose(); return m_rotation; }
 		const Math::Quaternion& GetRotationLocal() const	{ return m_rotationLocal; }
 		void SetRotation(const Math::Quaternion& rotation);
 		void SetRotationLocal(const Math::Quaternion& rotation);
 		//====================================================================================
 
 		//= SCALE =================================================================
-		Math::Vector3 GetScale()					{ return m_matrix.GetScale(); }
+		Math::Vector3 GetScale()					{ Decompose(); return m_scale; }
 		const Math::Vector3& GetScaleLocal() const	{ return m_scaleLocal; }
 		void SetScale(const Math::Vector3& scale);
 		void SetScaleLocal(const Math::Vector3& scale);
@@ -101,18 +101,30 @@ namespace Spartan
 		//==============================================================================================
 
 		void LookAt(const Math::Vector3& v) { m_lookAt = v; }
-		Math::Matrix& GetMatrix()			{ return m_matrix; }
-		Math::Matrix& GetLocalMatrix()		{ return m_matrixLocal; }
+		Math::Matrix& GetMatrix()			{ if (m_is_dirty) UpdateTransform(); return m_matrix; }
+		Math::Matrix& GetLocalMatrix()		{ if (m_is_dirty) UpdateTransform(); return m_matrixLocal; }
 
-		//= CONSTANT BUFFERS ==========================================================================================================================
-		void UpdateConstantBuffer(const std::shared_ptr<RHI_Device>& rhi_device, const Math::Matrix& view_projection);
-		const auto& GetConstantBuffer() { return m_cb_gbuffer_gpu; }
-		void UpdateConstantBufferLight(const std::shared_ptr<RHI_Device>& rhi_device, const Math::Matrix& view_projection, unsigned int cascade_index);
-		const auto& GetConstantBufferLight(unsigned int cascade_index) { return m_light_cascades[cascade_index].buffer; }
-		//=============================================================================================================================================
+		//= CONSTANT BUFFERS ==========================================================================================
+		// Has to match GBuffer.hlsl, also the layout of an instance when drawing instanced
+		struct CB_Gbuffer
+		{
+			Math::Matrix model;
+			Math::Matrix mvp_current;
+			Math::Matrix mvp_previous;
+		};
+		// Writes the G-Buffer constants into memory the renderer sub-allocated, once per frame as it also advances the previous mvp
+		void UpdateInstanceData(const Math::Matrix& view_projection, CB_Gbuffer* instance);
+		//=============================================================================================================
 
 	private:
-		Math::Matrix GetParentTransformMatrix() const;
+		void MarkDirty();
+		void Decompose();
+		// Computes the local and world matrices, the parent matrix has to be resolved already
+		void ComputeMatrices(const Math::Matrix* matrix_parent);
+
+		// Incremental maintenance of m_children, done by SetParent() and BecomeOrphan()
+		void ChildAdd(Transform* child);
+		void ChildRemove(Transform* child);
 
 		// local
 		Math::Vector3 m_positionLocal;
@@ -123,26 +135,18 @@ namespace Spartan
 		Math::Matrix m_matrixLocal;
 		Math::Vector3 m_lookAt;
 
+		// world, decomposed from m_matrix on demand
+		Math::Quaternion m_rotation;
+		Math::Vector3 m_scale;
+
+		bool m_is_dirty			= true;
+		bool m_is_decomposed	= false;
+		bool m_has_moved		= false; // set whenever the matrices are computed, consumed by TransformHierarchy
+
 		Transform* m_parent; // the parent of this transform
 		std::vector<Transform*> m_children; // the children of this transform
 
-		// Constant buffer
-		struct CB_Gbuffer
-		{
-			Math::Matrix model;
-			Math::Matrix mvp_current;
-			Math::Matrix mvp_previous;
-		};
-		CB_Gbuffer m_cb_gbuffer_cpu;
-		std::shared_ptr<RHI_ConstantBuffer> m_cb_gbuffer_gpu;
+		// Previous frame's mvp, for the velocity buffer
 		Math::Matrix m_wvp_previous;
-
-		// Constant buffer
-		struct LightCascade
-		{
-			Math::Matrix data;
-			std::shared_ptr<RHI_ConstantBuffer> buffer;
-		};
-		std::vector<LightCascade> m_light_cascades;
 	};
 }
\ No newline at end of file
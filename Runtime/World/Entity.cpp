@@ -55,7 +55,7 @@ namespace Spartan
 
 	Entity::~Entity()
 	{
-		// delete components
+		// delete components, the slots go last since OnRemove() can look up the other components
 		for (auto it = m_components.begin(); it != m_components.end();)
 		{
 			(*it)->OnRemove();
@@ -63,6 +63,11 @@ namespace Spartan
 			it = m_components.erase(it);
 		}
 		m_components.clear();
+		for (auto& slot : m_component_slots)
+		{
+			slot = nullptr;
+		}
+		m_component_mask = 0;
 
 		m_name.clear();
 		m_id					= NOT_ASSIGNED_HASH;
@@ -70,6 +75,18 @@ namespace Spartan
 		m_hierarchy_visibility	= true;
 	}
 
+	void Entity::SetId(const unsigned int id)
+	{
+		const auto id_previous = m_id;
+		m_id = id;
+
+		// Keep the world's id lookup valid
+		if (const auto world = m_context->GetSubsystem<World>())
+		{
+			world->EntityIdUpdate(this, id_previous);
+		}
+	}
+
 	void Entity::Initialize(Transform* transform)
 	{
 		m_transform = transform;
@@ -210,7 +227,7 @@ namespace Spartan
 		//= BASIC DATA =====================
 		stream->Read(&m_is_active);
 		stream->Read(&m_hierarchy_visibility);
-		stream->Read(&m_id);
+		SetId(stream->ReadAs<unsigned int>()); // through SetId(), so the world can still find this entity by id
 		stream->Read(&m_name);
 		//==================================
 
@@ -251,9 +268,10 @@ namespace Spartan
 		vector<std::weak_ptr<Entity>> children;
 		for (unsigned int i = 0; i < children_count; i++)
 		{
-			auto child = scene->EntityCreate();
-			child->SetId(stream->ReadAs<unsigned int>());
-			children.emplace_back(child);
+			// What's stored is the id of the child's transform, the child reads its own id when it deserializes.
+			// Taking it on as an entity id in the meantime could collide with the id of another entity.
+			stream->ReadAs<unsigned int>();
+			children.emplace_back(scene->EntityCreate());
 		}
 
 		// 3rd - children
@@ -263,11 +281,6 @@ namespace Spartan
 		}
 		//=============================================
 
-		if (m_transform)
-		{
-			m_transform->AcquireChildren();
-		}
-
 		// Make the scene resolve
 		FIRE_EVENT(Event_World_Resolve);
 	}
@@ -279,15 +292,17 @@ namespace Spartan
 		shared_ptr<IComponent> component;
 		switch (type)
 		{
+#ifndef SPARTAN_HEADLESS // No audio, physics or scripting in the headless build
 			case ComponentType_AudioListener:	component = AddComponent<AudioListener>();	break;
 			case ComponentType_AudioSource:		component = AddComponent<AudioSource>();	break;
-			case ComponentType_Camera:			component = AddComponent<Camera>();			break;
 			case ComponentType_Collider:		component = AddComponent<Collider>();		break;
 			case ComponentType_Constraint:		component = AddComponent<Constraint>();		break;
-			case ComponentType_Light:			component = AddComponent<Light>();			break;
-			case ComponentType_Renderable:		component = AddComponent<Renderable>();		break;
 			case ComponentType_RigidBody:		component = AddComponent<RigidBody>();		break;
 			case ComponentType_Script:			component = AddComponent<Script>();			break;
+#endif
+			case ComponentType_Camera:			component = AddComponent<Camera>();			break;
+			case ComponentType_Light:			component = AddComponent<Light>();			break;
+			case ComponentType_Renderable:		component = AddComponent<Renderable>();		break;
 			case ComponentType_Skybox:			component = AddComponent<Skybox>();			break;
 			case ComponentType_Transform:		component = AddComponent<Transform>();		break;
 			case ComponentType_Unknown:														break;
@@ -318,6 +333,34 @@ namespace Spartan
 		}
 
 		// Make the scene resolve
+		OnComponentsChanged();
 		FIRE_EVENT(Event_World_Resolve);
 	}
+
+	void Entity::OnComponentsChanged()
+	{
+		m_component_mask = 0;
+		for (auto& slot : m_component_slots)
+		{
+			slot = nullptr;
+		}
+
+		for (const auto& component : m_components)
+		{
+			const auto type = component->GetType();
+			if (type == ComponentType_Unknown || HasComponent(type))
+				continue;
+
+			m_component_slots[type]	= component;
+			m_component_mask		|= ComponentMask(1) << type;
+		}
+
+		// Caching of rendering performance critical components
+		m_renderable = GetComponent_PtrRaw<Renderable>();
+
+		if (const auto world = m_context->GetSubsystem<World>())
+		{
+			world->EntitySpatialUpdate(this);
+		}
+	}
 }
@@ -25,6 +25,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <vector>
 #include "Components/IComponent.h"
 #include "../Core/EventSystem.h"
+#include "../Core/PoolAllocator.h"
 //================================
 
 namespace Spartan
@@ -32,7 +33,9 @@ namespace Spartan
 	class Context;
 	class Transform;
 	class Renderable;
-	#define VALIDATE_COMPONENT_TYPE(T) static_assert(std::is_base_of<IComponent, T>::value, "Provided type does not implement IComponent")
+	#define VALIDATE_COMPONENT_TYPE(T)																					\
+	static_assert(std::is_base_of<IComponent, T>::value, "Provided type does not implement IComponent");				\
+	static_assert(IComponent::TypeToEnum<T>() != ComponentType_Unknown, "Provided type is not a registered component")
 
 	class SPARTAN_CLASS Entity : public std::enable_shared_from_this<Entity>
 	{
@@ -57,7 +60,7 @@ namespace Spartan
 		void SetName(const std::string& name)							{ m_name = name; }
 
 		unsigned int GetId() const										{ return m_id; }
-		void SetId(const unsigned int id)								{ m_id = id; }
+		void SetId(unsigned int id);
 
 		bool IsActive() const											{ return m_is_active; }
 		void SetActive(const bool active)								{ m_is_active = active; }
@@ -80,11 +83,12 @@ namespace Spartan
 			if (HasComponent(type) && type != ComponentType_Script)
 				return GetComponent<T>();
 
-			// Add component
+			// Add component (pooled, so components of the same type are packed together)
 			m_components.emplace_back
 			(	
-				std::make_shared<T>
+				std::allocate_shared<T>
 				(
+					PoolAllocator<T>(),
 					m_context,
 					this,
 					GetTransform_PtrRaw()
@@ -93,14 +97,9 @@ namespace Spartan
 
 			auto new_component = std::static_pointer_cast<T>(m_components.back());
 			new_component->SetType(IComponent::TypeToEnum<T>());
+			OnComponentsChanged();
 			new_component->OnInitialize();
 
-			// Caching of rendering performance critical components
-			if constexpr (std::is_same<T, Renderable>::value)
-			{
-				m_renderable = static_cast<Renderable*>(new_component.get());
-			}
-
 			// Make the scene resolve
 			FIRE_EVENT(Event_World_Resolve);
 
@@ -112,17 +111,20 @@ namespace Spartan
 		constexpr std::shared_ptr<T> GetComponent()
 		{
 			VALIDATE_COMPONENT_TYPE(T);
-			const ComponentType type = IComponent::TypeToEnum<T>();
-
-			for (const auto& component : m_components)
-			{
-				if (component->GetType() == type)
-					return std::static_pointer_cast<T>(component);
-			}
+			return std::static_pointer_cast<T>(m_component_slots[IComponent::TypeToEnum<T>()]);
+		}
 
-			return nullptr;
+		// Returns a component of type T (if it exists), without touching the reference count
+		template <class T>
+		constexpr T* GetComponent_PtrRaw() const
+		{
+			VALIDATE_COMPONENT_TYPE(T);
+			return static_cast<T*>(m_component_slots[IComponent::TypeToEnum<T>()].get());
 		}
 
+		// Returns a component of ComponentType (if it exists), without touching the reference count
+		IComponent* GetComponent_PtrRaw(const ComponentType type) const { return type < ComponentType_Unknown ? m_component_slots[type].get() : nullptr; }
+
 		// Returns any components of type T (if they exist)
 		template <class T>
 		constexpr std::vector<std::shared_ptr<T>> GetComponents()
@@ -131,6 +133,16 @@ namespace Spartan
 			const ComponentType type = IComponent::TypeToEnum<T>();
 
 			std::vector<std::shared_ptr<T>> components;
+			if (!HasComponent(type))
+				return components;
+
+			// Only scripts can exist multiple times, everything else lives in its slot
+			if (type != ComponentType_Script)
+			{
+				components.emplace_back(std::static_pointer_cast<T>(m_component_slots[type]));
+				return components;
+			}
+
 			for (const auto& component : m_components)
 			{
 				if (component->GetType() != type)
@@ -143,23 +155,14 @@ namespace Spartan
 		}
 		
 		// Checks if a component of ComponentType exists
-		bool HasComponent(const ComponentType type) 
-		{ 
-			for (const auto& component : m_components)
-			{
-				if (component->GetType() == type)
-					return true;
-			}
-
-			return false;
-		}
+		bool HasComponent(const ComponentType type) const { return type < ComponentType_Unknown && (m_component_mask & (ComponentMask(1) << type)) != 0; }
 
 		// Checks if a component of type T exists
 		template <class T>
-		constexpr bool HasComponent() 
+		constexpr bool HasComponent() const
 		{ 
 			VALIDATE_COMPONENT_TYPE(T);
-			return HasComponent(IComponent::TypeToEnum<T>()); 
+			return (m_component_mask & GetComponentMask<T>()) != 0;
 		}
 
 		// Removes a component of type T (if it exists)
@@ -185,11 +188,13 @@ namespace Spartan
 			}
 
 			// Make the scene resolve
+			OnComponentsChanged();
 			FIRE_EVENT(Event_World_Resolve);
 		}
 
 		void RemoveComponentById(unsigned int id);
 		const auto& GetAllComponents() const { return m_components; }
+		ComponentMask GetComponentsMask() const { return m_component_mask; }
 
 		// Direct access for performance critical usage (not safe)
 		Transform* GetTransform_PtrRaw() const		{ return m_transform; }
@@ -197,6 +202,9 @@ namespace Spartan
 		std::shared_ptr<Entity> GetPtrShared()		{ return shared_from_this(); }
 
 	private:
+		// Rebuilds the component slots and lets the world know the entity's bounds may have changed
+		void OnComponentsChanged();
+
 		unsigned int m_id			= 0;
 		std::string m_name			= "Entity";
 		bool m_is_active			= true;
@@ -207,6 +215,9 @@ namespace Spartan
 
 		// Components
 		std::vector<std::shared_ptr<IComponent>> m_components;
+		// The first component of every type, indexed by ComponentType
+		std::shared_ptr<IComponent> m_component_slots[ComponentType_Unknown];
+		ComponentMask m_component_mask = 0;
 		std::shared_ptr<Entity> m_component_empty;
 
 		// Misc
@@ -0,0 +1,388 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ==============
+#include "SpatialTree.h"
+#include <algorithm>
+//=========================
+
+//= NAMESPACES ================
+using namespace std;
+using namespace Spartan::Math;
+//=============================
+
+namespace Spartan
+{
+	namespace
+	{
+		BoundingBox Merged(const BoundingBox& a, const BoundingBox& b)
+		{
+			BoundingBox box = a;
+			box.Merge(b);
+			return box;
+		}
+
+		float SurfaceArea(const BoundingBox& box)
+		{
+			const Vector3 size = box.GetSize();
+			return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+		}
+
+		BoundingBox Enlarged(const BoundingBox& box, const float margin)
+		{
+			const Vector3 extent = Vector3(margin, margin, margin);
+			return BoundingBox(box.GetMin() - extent, box.GetMax() + extent);
+		}
+
+		bool Contains(const BoundingBox& outer, const BoundingBox& inner)
+		{
+			return
+				inner.GetMin().x >= outer.GetMin().x && inner.GetMin().y >= outer.GetMin().y && inner.GetMin().z >= outer.GetMin().z &&
+				inner.GetMax().x <= outer.GetMax().x && inner.GetMax().y <= outer.GetMax().y && inner.GetMax().z <= outer.GetMax().z;
+		}
+	}
+
+	SpatialTree::SpatialTree(const float margin)
+	{
+		m_margin = margin;
+	}
+
+	int SpatialTree::Insert(Entity* entity, const BoundingBox& box)
+	{
+		const int proxy = NodeAllocate();
+		Node& node		= m_nodes[proxy];
+		node.box		= Enlarged(box, m_margin);
+		node.entity		= entity;
+		node.height		= 0;
+
+		LeafInsert(proxy);
+		m_proxy_count++;
+
+		return proxy;
+	}
+
+	void SpatialTree::Remove(const int proxy)
+	{
+		LeafRemove(proxy);
+		NodeFree(proxy);
+		m_proxy_count--;
+	}
+
+	bool SpatialTree::Move(const int proxy, const BoundingBox& box)
+	{
+		// Still inside the enlarged box, nothing to do
+		if (Contains(m_nodes[proxy].box, box))
+			return false;
+
+		LeafRemove(proxy);
+		m_nodes[proxy].box = Enlarged(box, m_margin);
+		LeafInsert(proxy);
+
+		return true;
+	}
+
+	void SpatialTree::Clear()
+	{
+		m_nodes.clear();
+		m_root			= -1;
+		m_free			= -1;
+		m_node_count	= 0;
+		m_proxy_count	= 0;
+	}
+
+	unsigned int SpatialTree::GetMaxBalance() const
+	{
+		int balance_max = 0;
+		for (const auto& node : m_nodes)
+		{
+			if (node.height <= 1)
+				continue;
+
+			const int balance	= abs(m_nodes[node.child_right].height - m_nodes[node.child_left].height);
+			balance_max			= max(balance_max, balance);
+		}
+
+		return static_cast<unsigned int>(balance_max);
+	}
+
+	float SpatialTree::GetAreaRatio() const
+	{
+		if (m_root == -1)
+			return 0.0f;
+
+		const float area_root = SurfaceArea(m_nodes[m_root].box);
+		if (area_root == 0.0f)
+			return 0.0f;
+
+		float area_total = 0.0f;
+		for (const auto& node : m_nodes)
+		{
+			// Leaves and free nodes
+			if (node.height <= 0)
+				continue;
+
+			area_total += SurfaceArea(node.box);
+		}
+
+		return area_total / area_root;
+	}
+
+	int SpatialTree::NodeAllocate()
+	{
+		int index;
+		if (m_free == -1)
+		{
+			index = static_cast<int>(m_nodes.size());
+			m_nodes.emplace_back();
+		}
+		else
+		{
+			index			= m_free;
+			m_free			= m_nodes[index].parent;
+			m_nodes[index]	= Node();
+		}
+
+		m_node_count++;
+		return index;
+	}
+
+	void SpatialTree::NodeFree(const int node)
+	{
+		m_nodes[node]			= Node();
+		m_nodes[node].parent	= m_free;
+		m_free					= node;
+		m_node_count--;
+	}
+
+	void SpatialTree::LeafInsert(const int leaf)
+	{
+		if (m_root == -1)
+		{
+			m_root					= leaf;
+			m_nodes[leaf].parent	= -1;
+			return;
+		}
+
+		// Descend towards the sibling which increases the surface area of the tree the least
+		const BoundingBox box = m_nodes[leaf].box;
+		int index = m_root;
+		while (!m_nodes[index].IsLeaf())
+		{
+			const Node& node	= m_nodes[index];
+			const float area	= SurfaceArea(node.box);
+			const float area_combined = SurfaceArea(Merged(node.box, box));
+
+			// Cost of pairing the leaf with this node under a new parent
+			const float cost = 2.0f * area_combined;
+			// Minimum cost of pushing the leaf further down, all the ancestors grow by this much
+			const float cost_inheritance = 2.0f * (area_combined - area);
+
+			const auto cost_descend = [this, &box, cost_inheritance](const int child)
+			{
+				const Node& node_child	= m_nodes[child];
+				const float area_new	= SurfaceArea(Merged(node_child.box, box));
+				return (node_child.IsLeaf() ? area_new : area_new - SurfaceArea(node_child.box)) + cost_inheritance;
+			};
+			const float cost_left	= cost_descend(node.child_left);
+			const float cost_right	= cost_descend(node.child_right);
+
+			if (cost < cost_left && cost < cost_right)
+				break;
+
+			index = cost_left < cost_right ? node.child_left : node.child_right;
+		}
+		const int sibling = index;
+
+		// Create a new parent for the sibling and the leaf
+		const int parent_old	= m_nodes[sibling].parent;
+		const int parent_new	= NodeAllocate();
+		Node& parent			= m_nodes[parent_new];
+		parent.parent			= parent_old;
+		parent.box				= Merged(box, m_nodes[sibling].box);
+		parent.height			= m_nodes[sibling].height + 1;
+		parent.child_left		= sibling;
+		parent.child_right		= leaf;
+
+		if (parent_old != -1)
+		{
+			Node& node = m_nodes[parent_old];
+			(node.child_left == sibling ? node.child_left : node.child_right) = parent_new;
+		}
+		else
+		{
+			m_root = parent_new;
+		}
+		m_nodes[sibling].parent	= parent_new;
+		m_nodes[leaf].parent	= parent_new;
+
+		Refit(parent_new);
+	}
+
+	void SpatialTree::LeafRemove(const int leaf)
+	{
+		if (leaf == m_root)
+		{
+			m_root = -1;
+			return;
+		}
+
+		// The sibling takes the place of the parent
+		const int parent		= m_nodes[leaf].parent;
+		const int grandparent	= m_nodes[parent].parent;
+		const int sibling		= m_nodes[parent].child_left == leaf ? m_nodes[parent].child_right : m_nodes[parent].child_left;
+
+		m_nodes[sibling].parent = grandparent;
+		NodeFree(parent);
+
+		if (grandparent != -1)
+		{
+			Node& node = m_nodes[grandparent];
+			(node.child_left == parent ? node.child_left : node.child_right) = sibling;
+			Refit(grandparent);
+		}
+		else
+		{
+			m_root = sibling;
+		}
+	}
+
+	void SpatialTree::Refit(int node)
+	{
+		while (node != -1)
+		{
+			node = Balance(node);
+
+			Node& current		= m_nodes[node];
+			const Node& left	= m_nodes[current.child_left];
+			const Node& right	= m_nodes[current.child_right];
+			current.height		= 1 + max(left.height, right.height);
+			current.box			= Merged(left.box, right.box);
+
+			node = current.parent;
+		}
+	}
+
+	// Rotates the taller grandchild up if the children of a differ in height by more than one, returns the new root of the subtree
+	int SpatialTree::Balance(const int a)
+	{
+		Node& node_a = m_nodes[a];
+		if (node_a.IsLeaf() || node_a.height < 2)
+			return a;
+
+		const int b		= node_a.child_left;
+		const int c		= node_a.child_right;
+		Node& node_b	= m_nodes[b];
+		Node& node_c	= m_nodes[c];
+		const int balance = node_c.height - node_b.height;
+
+		// The child which moves up takes the place of a under a's parent
+		const auto replace_in_parent = [this, a](Node& node_up, const int up)
+		{
+			if (node_up.parent != -1)
+			{
+				Node& parent = m_nodes[node_up.parent];
+				(parent.child_left == a ? parent.child_left : parent.child_right) = up;
+			}
+			else
+			{
+				m_root = up;
+			}
+		};
+
+		// Rotate c up
+		if (balance > 1)
+		{
+			const int f		= node_c.child_left;
+			const int g		= node_c.child_right;
+			Node& node_f	= m_nodes[f];
+			Node& node_g	= m_nodes[g];
+
+			node_c.child_left	= a;
+			node_c.parent		= node_a.parent;
+			node_a.parent		= c;
+			replace_in_parent(node_c, c);
+
+			// The taller of c's children stays with c, the other one moves to a
+			const bool f_taller	= node_f.height > node_g.height;
+			const int stays		= f_taller ? f : g;
+			const int moves		= f_taller ? g : f;
+			node_c.child_right		= stays;
+			node_a.child_right		= moves;
+			m_nodes[moves].parent	= a;
+
+			node_a.box		= Merged(node_b.box, m_nodes[moves].box);
+			node_c.box		= Merged(node_a.box, m_nodes[stays].box);
+			node_a.height	= 1 + max(node_b.height, m_nodes[moves].height);
+			node_c.height	= 1 + max(node_a.height, m_nodes[stays].height);
+
+			return c;
+		}
+
+		// Rotate b up
+		if (balance < -1)
+		{
+			const int d		= node_b.child_left;
+			const int e		= node_b.child_right;
+			Node& node_d	= m_nodes[d];
+			Node& node_e	= m_nodes[e];
+
+			node_b.child_left	= a;
+			node_b.parent		= node_a.parent;
+			node_a.parent		= b;
+			replace_in_parent(node_b, b);
+
+			// The taller of b's children stays with b, the other one moves to a
+			const bool d_taller	= node_d.height > node_e.height;
+			const int stays		= d_taller ? d : e;
+			const int moves		= d_taller ? e : d;
+			node_b.child_right		= stays;
+			node_a.child_left		= moves;
+			m_nodes[moves].parent	= a;
+
+			node_a.box		= Merged(node_c.box, m_nodes[moves].box);
+			node_b.box		= Merged(node_a.box, m_nodes[stays].box);
+			node_a.height	= 1 + max(node_c.height, m_nodes[moves].height);
+			node_b.height	= 1 + max(node_a.height, m_nodes[stays].height);
+
+			return b;
+		}
+
+		return a;
+	}
+
+	bool SpatialTree::Overlaps(const BoundingBox& a, const BoundingBox& b)
+	{
+		return
+			a.GetMin().x <= b.GetMax().x && a.GetMax().x >= b.GetMin().x &&
+			a.GetMin().y <= b.GetMax().y && a.GetMax().y >= b.GetMin().y &&
+			a.GetMin().z <= b.GetMax().z && a.GetMax().z >= b.GetMin().z;
+	}
+
+	float SpatialTree::DistanceSquared(const BoundingBox& box, const Vector3& point)
+	{
+		const Vector3 closest = Vector3(
+			Helper::Clamp(point.x, box.GetMin().x, box.GetMax().x),
+			Helper::Clamp(point.y, box.GetMin().y, box.GetMax().y),
+			Helper::Clamp(point.z, box.GetMin().z, box.GetMax().z)
+		);
+		return (point - closest).LengthSquared();
+	}
+}
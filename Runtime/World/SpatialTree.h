@@ -0,0 +1,160 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES =====================
+#include <vector>
+#include <utility>
+#include "../Core/EngineDefs.h"
+#include "../Math/BoundingBox.h"
+#include "../Math/Frustum.h"
+#include "../Math/Ray.h"
+//================================
+
+namespace Spartan
+{
+	class Entity;
+
+	// A dynamic bounding volume hierarchy over the bounds of the entities of the world.
+	// Leaves store boxes enlarged by a margin, so entities which move a little don't touch the tree at all.
+	// Insertion picks the sibling with the least surface area cost and rotations keep the tree balanced.
+	class SPARTAN_CLASS SpatialTree
+	{
+	public:
+		SpatialTree(float margin = 0.1f);
+		~SpatialTree() = default;
+
+		// Returns a proxy which identifies the entity in the tree
+		int Insert(Entity* entity, const Math::BoundingBox& box);
+		void Remove(int proxy);
+		// Returns true if the box left the enlarged box of the proxy and it had to be reinserted
+		bool Move(int proxy, const Math::BoundingBox& box);
+		void Clear();
+
+		//= QUERIES ============================================================================================
+		// Invokes function(Entity*) for every entity whose enlarged box is not outside the frustum
+		template <typename Function>
+		void QueryFrustum(const Math::Frustum& frustum, Function&& function) const
+		{
+			Traverse(function, [&frustum](const Math::BoundingBox& box)
+			{
+				return frustum.CheckCube(box.GetCenter(), box.GetExtents());
+			});
+		}
+
+		// Invokes function(Entity*) for every entity whose enlarged box overlaps the box
+		template <typename Function>
+		void QueryBox(const Math::BoundingBox& box, Function&& function) const
+		{
+			Traverse(function, [&box](const Math::BoundingBox& node) { return Overlaps(node, box) ? Math::Helper::Intersects : Math::Helper::Outside; });
+		}
+
+		// Invokes function(Entity*) for every entity whose enlarged box overlaps the sphere
+		template <typename Function>
+		void QuerySphere(const Math::Vector3& center, const float radius, Function&& function) const
+		{
+			Traverse(function, [&center, radius](const Math::BoundingBox& node) { return DistanceSquared(node, center) <= radius * radius ? Math::Helper::Intersects : Math::Helper::Outside; });
+		}
+
+		// Invokes function(Entity*) for every entity whose enlarged box is hit by the ray
+		template <typename Function>
+		void QueryRay(const Math::Ray& ray, Function&& function) const
+		{
+			Traverse(function, [&ray](const Math::BoundingBox& node) { return ray.HitDistance(node) != INFINITY ? Math::Helper::Intersects : Math::Helper::Outside; });
+		}
+		//======================================================================================================
+
+		//= PROPERTIES ==============================================================================================
+		Entity* GetEntity(const int proxy) const						{ return m_nodes[proxy].entity; }
+		const Math::BoundingBox& GetBox(const int proxy) const			{ return m_nodes[proxy].box; }
+		unsigned int GetProxyCount() const								{ return m_proxy_count; }
+		unsigned int GetNodeCount() const								{ return m_node_count; }
+		unsigned int GetHeight() const									{ return m_root == -1 ? 0 : m_nodes[m_root].height; }
+		// Largest height difference between the two children of any node
+		unsigned int GetMaxBalance() const;
+		// Total surface area of the internal nodes over the surface area of the root, lower means a tighter tree
+		float GetAreaRatio() const;
+		//===========================================================================================================
+
+	private:
+		struct Node
+		{
+			bool IsLeaf() const { return child_left == -1; }
+
+			Math::BoundingBox box;
+			Entity* entity	= nullptr;
+			int parent		= -1; // next free node while the node is unused
+			int child_left	= -1;
+			int child_right	= -1;
+			int height		= -1; // 0 for leaves, -1 for free nodes
+		};
+
+		int NodeAllocate();
+		void NodeFree(int node);
+		void LeafInsert(int leaf);
+		void LeafRemove(int leaf);
+		// Walks from node to the root refitting the boxes and rotating unbalanced nodes
+		void Refit(int node);
+		int Balance(int node);
+
+		// Visits the nodes whose box test isn't Outside, subtrees which are completely Inside are reported without further tests
+		template <typename Function, typename Test>
+		void Traverse(Function& function, Test&& test) const
+		{
+			if (m_root == -1)
+				return;
+
+			// The tree is balanced, so its height (and the depth of the stack) stays far below this
+			std::pair<int, bool> stack[128];
+			unsigned int stack_size = 0;
+			stack[stack_size++] = { m_root, false };
+			while (stack_size != 0)
+			{
+				const auto [index, inside] = stack[--stack_size];
+
+				const Node& node = m_nodes[index];
+				const auto result = inside ? Math::Helper::Inside : test(node.box);
+				if (result == Math::Helper::Outside)
+					continue;
+
+				if (node.IsLeaf())
+				{
+					function(node.entity);
+					continue;
+				}
+
+				stack[stack_size++] = { node.child_left, result == Math::Helper::Inside };
+				stack[stack_size++] = { node.child_right, result == Math::Helper::Inside };
+			}
+		}
+
+		static bool Overlaps(const Math::BoundingBox& a, const Math::BoundingBox& b);
+		static float DistanceSquared(const Math::BoundingBox& box, const Math::Vector3& point);
+
+		std::vector<Node> m_nodes;
+		int m_root					= -1;
+		int m_free					= -1;
+		unsigned int m_node_count	= 0;
+		unsigned int m_proxy_count	= 0;
+		float m_margin;
+	};
+}
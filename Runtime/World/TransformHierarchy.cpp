@@ -0,0 +1,145 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES =====================
+#include "TransformHierarchy.h"
+#include "Entity.h"
+#include "Components/Transform.h"
+#include "../Threading/Threading.h"
+#include "../Math/SIMD.h"
+//================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+	void TransformHierarchy::Update(const vector<shared_ptr<Entity>>& entities, Threading* threading)
+	{
+		if (!m_is_valid)
+		{
+			Build(entities);
+		}
+
+		// Levels are resolved in order, so the parents of a level are always resolved when it starts
+		for (unsigned int level = 0; level + 1 < static_cast<unsigned int>(m_levels.size()); level++)
+		{
+			const unsigned int level_start	= m_levels[level];
+			const unsigned int level_count	= m_levels[level + 1] - level_start;
+
+			threading->ParallelFor(level_count, [this, level_start](const unsigned int start, const unsigned int end)
+			{
+				Resolve(level_start + start, level_start + end);
+			}, 0, Job_Critical);
+		}
+	}
+
+	void TransformHierarchy::Resolve(const unsigned int start, const unsigned int end)
+	{
+		for (unsigned int i = start; i < end; i++)
+		{
+			Transform* transform = m_transforms[i];
+			if (transform->m_is_dirty)
+			{
+				m_positions[i]	= transform->m_positionLocal;
+				m_rotations[i]	= transform->m_rotationLocal;
+				m_scales[i]		= transform->m_scaleLocal;
+				Math::Simd::MatrixCompose(m_positions[i].Data(), &m_rotations[i].x, m_scales[i].Data(), &m_matrices_local[i].m00);
+
+				// The parent is in an earlier level, so its slot holds its resolved world matrix
+				const int parent = m_parents[i];
+				if (parent == -1)
+				{
+					m_matrices[i] = m_matrices_local[i];
+				}
+				else
+				{
+					Math::Simd::MatrixMultiply(m_matrices_local[i].Data(), m_matrices[parent].Data(), &m_matrices[i].m00);
+				}
+
+				transform->m_matrixLocal	= m_matrices_local[i];
+				transform->m_matrix			= m_matrices[i];
+				transform->m_is_dirty		= false;
+				transform->m_is_decomposed	= false;
+				transform->m_has_moved		= true;
+			}
+			else if (transform->m_has_moved)
+			{
+				// Resolved on demand since the previous update, its children read the matrix from here
+				m_matrices[i] = transform->m_matrix;
+			}
+
+			m_moved[i]				= transform->m_has_moved;
+			transform->m_has_moved	= false;
+		}
+	}
+
+	void TransformHierarchy::Build(const vector<shared_ptr<Entity>>& entities)
+	{
+		m_transforms.clear();
+		m_parents.clear();
+		m_levels.clear();
+
+		// The roots are the first level
+		for (const auto& entity : entities)
+		{
+			Transform* transform = entity->GetTransform_PtrRaw();
+			if (transform->IsRoot())
+			{
+				m_transforms.emplace_back(transform);
+				m_parents.emplace_back(-1);
+			}
+		}
+		m_levels.emplace_back(0);
+
+		// Every other level consists of the children of the previous one
+		while (m_levels.back() < static_cast<unsigned int>(m_transforms.size()))
+		{
+			const unsigned int level_start	= m_levels.back();
+			const unsigned int level_end	= static_cast<unsigned int>(m_transforms.size());
+			m_levels.emplace_back(level_end);
+
+			for (unsigned int i = level_start; i < level_end; i++)
+			{
+				for (Transform* child : m_transforms[i]->GetChildren())
+				{
+					m_transforms.emplace_back(child);
+					m_parents.emplace_back(static_cast<int>(i));
+				}
+			}
+		}
+
+		// The slots of dirty transforms are filled in by the update, the rest start out with what the transforms hold
+		const auto count = m_transforms.size();
+		m_positions.resize(count);
+		m_rotations.resize(count);
+		m_scales.resize(count);
+		m_matrices_local.resize(count);
+		m_matrices.resize(count);
+		for (size_t i = 0; i < count; i++)
+		{
+			m_matrices[i] = m_transforms[i]->m_matrix;
+		}
+		m_moved.assign(count, 0);
+		m_is_valid = true;
+	}
+}
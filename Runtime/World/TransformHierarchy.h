@@ -0,0 +1,97 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES =====================
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include "../Core/EngineDefs.h"
+#include "../Math/Vector3.h"
+#include "../Math/Quaternion.h"
+#include "../Math/Matrix.h"
+//================================
+
+namespace Spartan
+{
+	class Entity;
+	class Transform;
+	class Threading;
+
+	// The transforms of the world flattened into depth ordered arrays, every parent comes before its children.
+	// This allows the world matrices to be resolved a depth level at a time, with each level in parallel.
+	// The local position, rotation and scale and the matrices live in arrays indexed by the same slot, the
+	// transforms are only read when dirty and written once their matrices are resolved.
+	class SPARTAN_CLASS TransformHierarchy
+	{
+	public:
+		TransformHierarchy() = default;
+		~TransformHierarchy() = default;
+
+		// Resolves the world matrices of all the dirty transforms, flattening the hierarchy again if it changed
+		void Update(const std::vector<std::shared_ptr<Entity>>& entities, Threading* threading);
+
+		// Has to be called when transforms are added, removed or change parent
+		void Invalidate() { m_is_valid = false; }
+
+		// Invokes function(Transform*) for every transform whose matrices were computed since the previous Update()
+		template <typename Function>
+		void ForEachMoved(Function&& function) const
+		{
+			for (unsigned int i = 0; i < static_cast<unsigned int>(m_moved.size()); i++)
+			{
+				if (m_moved[i])
+				{
+					function(m_transforms[i]);
+				}
+			}
+		}
+
+		unsigned int GetCount() const		{ return static_cast<unsigned int>(m_transforms.size()); }
+		// Depth of the deepest transform, roots are at depth 0
+		unsigned int GetDepth() const		{ return m_levels.size() < 3 ? 0 : static_cast<unsigned int>(m_levels.size() - 2); }
+
+	private:
+		void Build(const std::vector<std::shared_ptr<Entity>>& entities);
+
+		// Resolves the matrices of the dirty transforms in [start, end), their parents have to be resolved already
+		void Resolve(unsigned int start, unsigned int end);
+
+		// Depth ordered transforms
+		std::vector<Transform*> m_transforms;
+		// Index of the parent of each transform, -1 for roots
+		std::vector<int> m_parents;
+		// Index of the first transform of each depth level, followed by the transform count
+		std::vector<unsigned int> m_levels;
+
+		// Per slot, copied from the transforms which are dirty
+		std::vector<Math::Vector3> m_positions;
+		std::vector<Math::Quaternion> m_rotations;
+		std::vector<Math::Vector3> m_scales;
+		// Per slot, the world matrix of every transform is kept so children never have to reach into their parent
+		std::vector<Math::Matrix> m_matrices_local;
+		std::vector<Math::Matrix> m_matrices;
+		// Whether each transform moved during the last update, bytes so that jobs never share an element
+		std::vector<uint8_t> m_moved;
+		bool m_is_valid = false;
+	};
+}
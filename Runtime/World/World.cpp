@@ -27,6 +27,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "Components/Light.h"
 #include "Components/Script.h"
 #include "Components/Skybox.h"
+#include "Components/Renderable.h"
 #include "Components/AudioListener.h"
 #include "../Core/Engine.h"
 #include "../Core/Stopwatch.h"
@@ -36,6 +37,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../Profiling/Profiler.h"
 #include "../Rendering/Renderer.h"
 #include "../Input/Input.h"
+#include "../Threading/Threading.h"
 //=====================================
 
 //= NAMESPACES ================
@@ -52,8 +54,8 @@ namespace Spartan
 		
 		// Subscribe to events
 		SUBSCRIBE_TO_EVENT(Event_World_Resolve, [this](Variant) { m_isDirty = true; });
-		SUBSCRIBE_TO_EVENT(Event_World_Stop,	[this](Variant)	{ m_state = Idle; });
-		SUBSCRIBE_TO_EVENT(Event_World_Start,	[this](Variant)	{ m_state = Ticking; });
+		SUBSCRIBE_TO_EVENT(Event_World_Stop,	[this](Variant)	{ SetState(Idle); });
+		SUBSCRIBE_TO_EVENT(Event_World_Start,	[this](Variant)	{ SetState(Ticking); });
 	}
 
 	World::~World()
@@ -65,6 +67,7 @@ namespace Spartan
 	{
 		m_input		= m_context->GetSubsystem<Input>().get();
 		m_profiler	= m_context->GetSubsystem<Profiler>().get();
+		m_threading	= m_context->GetSubsystem<Threading>().get();
 
 		CreateCamera();
 		CreateSkybox();
@@ -77,7 +80,11 @@ namespace Spartan
 	{	
 		if (m_state == Request_Loading)
 		{
-			m_state = Loading;
+			{
+				lock_guard<mutex> lock(m_state_mutex);
+				m_state = Loading;
+			}
+			m_state_condition.notify_all();
 			return;
 		}
 
@@ -114,6 +121,15 @@ namespace Spartan
 			{
 				entity->Tick();
 			}
+
+			// Resolve the transforms of everything that moved, once and parents before children
+			m_transform_hierarchy.Update(m_entitiesPrimary, m_threading);
+
+			// Refit the bounds of everything that moved
+			m_transform_hierarchy.ForEachMoved([this](Transform* transform)
+			{
+				EntitySpatialUpdate(transform->GetEntity_PtrRaw());
+			});
 		}
 
 		TIME_BLOCK_END(m_profiler);
@@ -133,11 +149,25 @@ namespace Spartan
 
 		m_entitiesPrimary.clear();
 		m_entitiesPrimary.shrink_to_fit();
+		m_entity_lookup.clear();
+		m_transform_hierarchy.Invalidate();
+		m_archetypes.Clear();
+		m_spatial_tree.Clear();
+		m_spatial_proxies.clear();
 
 		m_isDirty = true;
 		
 		// Don't clear secondary m_entitiesSecondary as they might be used by the renderer
 	}
+
+	void World::SetState(const Scene_State state)
+	{
+		lock_guard<mutex> lock(m_state_mutex);
+		if (m_state != Request_Loading && m_state != Loading)
+		{
+			m_state = state;
+		}
+	}
 	//=========================================================================================================
 
 	//= I/O ===================================================================================================
@@ -206,8 +236,13 @@ namespace Spartan
 			return false;
 		}
 
-		// Thread safety: Wait for scene and the renderer to stop the entities (could do double buffering in the future)
-		while (m_state != Loading || Renderer::IsRendering()) { m_state = Request_Loading; this_thread::sleep_for(chrono::milliseconds(16)); }
+		// Thread safety: Ask the world to stop ticking the entities and block until it does (could do double buffering in the future).
+		// The renderer ticks before the world, so it's done with the entities by the time the world acknowledges.
+		{
+			unique_lock<mutex> lock(m_state_mutex);
+			m_state = Request_Loading;
+			m_state_condition.wait(lock, [this]() { return m_state == Loading; });
+		}
 
 		ProgressReport::Get().Reset(g_progress_Scene);
 		ProgressReport::Get().SetIsLoading(g_progress_Scene, true);
@@ -271,8 +306,11 @@ namespace Spartan
 		}
 		//==============================================
 
-		m_isDirty	= true;
-		m_state		= Ticking;
+		m_isDirty = true;
+		{
+			lock_guard<mutex> lock(m_state_mutex);
+			m_state = Ticking;
+		}
 		ProgressReport::Get().SetIsLoading(g_progress_Scene, false);	
 		LOG_INFO("Loading took " + to_string(static_cast<int>(timer.GetElapsedTimeMs())) + " ms");	
 
@@ -284,9 +322,16 @@ namespace Spartan
 	//= entity HELPER FUNCTIONS  ====================================================================
 	shared_ptr<Entity>& World::EntityCreate()
 	{
-		auto entity = make_shared<Entity>(m_context);
+		auto entity = allocate_shared<Entity>(PoolAllocator<Entity>(), m_context);
 		entity->Initialize(entity->AddComponent<Transform>().get());
-		return m_entitiesPrimary.emplace_back(entity);
+
+		// Ids are random 32-bit hashes, a world of 100k entities is likely to draw one twice
+		while (m_entity_lookup.find(entity->GetId()) != m_entity_lookup.end())
+		{
+			entity->SetId(GENERATE_GUID);
+		}
+
+		return EntityAdd(entity);
 	}
 
 	shared_ptr<Entity>& World::EntityAdd(const shared_ptr<Entity>& entity)
@@ -294,7 +339,16 @@ namespace Spartan
 		if (!entity)
 			return m_entity_empty;
 
-		return m_entitiesPrimary.emplace_back(entity);
+		// Already part of the world
+		const auto it = m_entity_lookup.find(entity->GetId());
+		if (it != m_entity_lookup.end())
+			return m_entitiesPrimary[it->second];
+
+		m_entity_lookup[entity->GetId()] = static_cast<unsigned int>(m_entitiesPrimary.size());
+		m_transform_hierarchy.Invalidate();
+		auto& entity_added = m_entitiesPrimary.emplace_back(entity);
+		EntitySpatialUpdate(entity_added.get());
+		return entity_added;
 	}
 
 	bool World::EntityExists(const shared_ptr<Entity>& entity)
@@ -306,11 +360,14 @@ namespace Spartan
 	}
 
 	// Removes an entity and all of it's children
-	void World::EntityRemove(const shared_ptr<Entity>& entity)
+	void World::EntityRemove(const shared_ptr<Entity>& entity_in)
 	{
-		if (!entity)
+		if (!entity_in)
 			return;
 
+		// Keep the entity alive, the reference could point into the entity list which is about to change
+		const auto entity = entity_in;
+
 		// remove any descendants
 		auto children = entity->GetTransform_PtrRaw()->GetChildren();
 		for (const auto& child : children)
@@ -318,25 +375,31 @@ namespace Spartan
 			EntityRemove(child->GetEntity_PtrShared());
 		}
 
-		// Keep a reference to it's parent (in case it has one)
-		auto parent = entity->GetTransform_PtrRaw()->GetParent();
+		// If there is a parent, make it forget about this entity
+		entity->GetTransform_PtrRaw()->BecomeOrphan();
 
-		// Remove this entity
-		for (auto it = m_entitiesPrimary.begin(); it < m_entitiesPrimary.end();)
+		// Remove this entity by moving the last entity into its place
+		const auto it = m_entity_lookup.find(entity->GetId());
+		if (it != m_entity_lookup.end())
 		{
-			const auto temp = *it;
-			if (temp->GetId() == entity->GetId())
+			const auto index = it->second;
+			m_entity_lookup.erase(it);
+			m_archetypes.Remove(entity.get());
+
+			const auto it_proxy = m_spatial_proxies.find(entity.get());
+			if (it_proxy != m_spatial_proxies.end())
 			{
-				it = m_entitiesPrimary.erase(it);
-				break;
+				m_spatial_tree.Remove(it_proxy->second);
+				m_spatial_proxies.erase(it_proxy);
 			}
-			++it;
-		}
 
-		// If there was a parent, update it
-		if (parent)
-		{
-			parent->AcquireChildren();
+			if (index != m_entitiesPrimary.size() - 1)
+			{
+				m_entitiesPrimary[index] = move(m_entitiesPrimary.back());
+				m_entity_lookup[m_entitiesPrimary[index]->GetId()] = index;
+			}
+			m_entitiesPrimary.pop_back();
+			m_transform_hierarchy.Invalidate();
 		}
 
 		m_isDirty = true;
@@ -369,13 +432,51 @@ namespace Spartan
 
 	const shared_ptr<Entity>& World::EntityGetById(const unsigned int id)
 	{
-		for (const auto& entity : m_entitiesPrimary)
+		const auto it = m_entity_lookup.find(id);
+		return it != m_entity_lookup.end() ? m_entitiesPrimary[it->second] : m_entity_empty;
+	}
+
+	void World::EntityIdUpdate(Entity* entity, const unsigned int id_previous)
+	{
+		const auto it = m_entity_lookup.find(id_previous);
+		if (it == m_entity_lookup.end() || m_entitiesPrimary[it->second].get() != entity)
+			return;
+
+		const auto index = it->second;
+		m_entity_lookup.erase(it);
+		m_entity_lookup[entity->GetId()] = index;
+	}
+
+	void World::EntitySpatialUpdate(Entity* entity)
+	{
+		// Only entities which are part of the world are tracked
+		const auto it_entity = m_entity_lookup.find(entity->GetId());
+		if (it_entity == m_entity_lookup.end() || m_entitiesPrimary[it_entity->second].get() != entity)
+			return;
+
+		// The tree is fitted to the bounds stored in the chunk
+		const auto& box	= m_archetypes.Update(entity);
+		const auto it	= m_spatial_proxies.find(entity);
+
+		// No bounds (yet), make sure the entity isn't in the tree
+		if (!box.Defined())
 		{
-			if (entity->GetId() == id)
-				return entity;
+			if (it != m_spatial_proxies.end())
+			{
+				m_spatial_tree.Remove(it->second);
+				m_spatial_proxies.erase(it);
+			}
+			return;
 		}
 
-		return m_entity_empty;
+		if (it != m_spatial_proxies.end())
+		{
+			m_spatial_tree.Move(it->second, box);
+		}
+		else
+		{
+			m_spatial_proxies[entity] = m_spatial_tree.Insert(entity, box);
+		}
 	}
 	//===================================================================================================
 
@@ -396,9 +497,11 @@ namespace Spartan
 		auto entity = EntityCreate();
 		entity->SetName("Camera");
 		entity->AddComponent<Camera>();
+#ifndef SPARTAN_HEADLESS // No audio or scripting in the headless build
 		entity->AddComponent<AudioListener>();
 		entity->AddComponent<Script>()->SetScript(dir_scripts + "MouseLook.as");
 		entity->AddComponent<Script>()->SetScript(dir_scripts + "FirstPersonController.as");
+#endif
 		entity->GetTransform_PtrRaw()->SetPositionLocal(Vector3(0.0f, 1.0f, -5.0f));
 
 		return entity;
@@ -24,8 +24,14 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES ==================
 #include <vector>
 #include <memory>
+#include <unordered_map>
+#include <mutex>
+#include <condition_variable>
 #include "../Core/EngineDefs.h"
 #include "../Core/ISubsystem.h"
+#include "TransformHierarchy.h"
+#include "SpatialTree.h"
+#include "ArchetypeStorage.h"
 //=============================
 
 namespace Spartan
@@ -34,6 +40,7 @@ namespace Spartan
 	class Light;
 	class Input;
 	class Profiler;
+	class Threading;
 
 	enum Scene_State
 	{
@@ -73,6 +80,28 @@ namespace Spartan
 		int Entity_GetCount() { return (int)m_entitiesPrimary.size(); }
 		//=========================================================================================
 
+		//= ENTITY NOTIFICATIONS ========================================================================
+		// Called by entities when their id changes
+		void EntityIdUpdate(Entity* entity, unsigned int id_previous);
+		// Called by transforms when their parent changes
+		void TransformHierarchyChanged() { m_transform_hierarchy.Invalidate(); }
+		//===============================================================================================
+
+		//= COMPONENT QUERIES =========================================================================================
+		// Invokes function(const ArchetypeChunk&) for every chunk of entities which have all of the components T and none of
+		// mask_exclude. The chunks hold the transforms and bounds by value, as they were at the end of the last tick.
+		template <typename... T, typename Function>
+		void Query(Function&& function, const ComponentMask mask_exclude = 0) const { m_archetypes.Query<T...>(std::forward<Function>(function), mask_exclude); }
+		const ArchetypeStorage& GetArchetypes() const { return m_archetypes; }
+		//===============================================================================================================
+
+		//= SPATIAL QUERIES =====================================================================================
+		// The bounds of every renderable entity, queries report entities whose (slightly enlarged) bounds match
+		const SpatialTree& GetSpatialTree() const { return m_spatial_tree; }
+		// Called when the components, the transform or the bounds of an entity may have changed, refreshes its chunk and the tree
+		void EntitySpatialUpdate(Entity* entity);
+		//=======================================================================================================
+
 	private:
 		//= COMMON ENTITY CREATION =======================
 		std::shared_ptr<Entity>& CreateSkybox();
@@ -80,15 +109,34 @@ namespace Spartan
 		std::shared_ptr<Entity>& CreateDirectionalLight();
 		//===============================================
 
+		// Leaves the state alone while a load is pending, the load sets it once it's done
+		void SetState(Scene_State state);
+
 		// Double-buffered entities
 		std::vector<std::shared_ptr<Entity>> m_entitiesPrimary;
 		std::vector<std::shared_ptr<Entity>> m_entitiesSecondary;
 
+		// Entity id to index into m_entitiesPrimary
+		std::unordered_map<unsigned int, unsigned int> m_entity_lookup;
+
+		// Transforms ordered by depth
+		TransformHierarchy m_transform_hierarchy;
+
+		// Entities grouped by their component types, with the data that is walked every frame
+		ArchetypeStorage m_archetypes;
+
+		// Bounds of the renderable entities and the proxy of each entity in the tree
+		SpatialTree m_spatial_tree;
+		std::unordered_map<Entity*, int> m_spatial_proxies;
+
 		std::shared_ptr<Entity> m_entity_empty;
 		Input* m_input;
 		Profiler* m_profiler;
+		Threading* m_threading;
 		bool m_wasInEditorMode;
 		bool m_isDirty;
 		Scene_State m_state;
+		std::mutex m_state_mutex;
+		std::condition_variable m_state_condition;
 	};
 }
\ No newline at end of file
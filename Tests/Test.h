@@ -0,0 +1,106 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES =================
+#include <cstdio>
+#include <memory>
+#include <atomic>
+#include "Logging/Log.h"
+#include "Logging/ILogger.h"
+#include "Core/Stopwatch.h"
+//============================
+
+// Minimal test harness, every test is an executable which returns the number of failed checks
+namespace Spartan::Test
+{
+	// Counts what the engine logs, so that tests can expect errors from invalid usage
+	class Logger : public ILogger
+	{
+	public:
+		void Log(const std::string& log, const unsigned int type) override
+		{
+			if (type == Log_Warning) m_warnings++;
+			if (type == Log_Error)
+			{
+				m_errors++;
+				if (m_print_errors) printf("  log: %s\n", log.c_str());
+			}
+		}
+
+		std::atomic<int> m_errors	= 0;
+		std::atomic<int> m_warnings	= 0;
+		bool m_print_errors			= false;
+	};
+
+	inline int& Failures() { static int failures = 0; return failures; }
+
+	// Routes the log to a counting logger instead of a file
+	inline Logger& Initialize()
+	{
+		static auto logger = std::make_shared<Logger>();
+		Log::SetLogger(logger);
+		LOG_TO_FILE(false);
+		return *logger;
+	}
+
+	inline int Finish(const char* name)
+	{
+		printf("%s: %s (%d failed checks)\n", name, Failures() == 0 ? "passed" : "FAILED", Failures());
+		return Failures();
+	}
+
+	// Runs function a few times and returns the fastest run in milliseconds
+	template <typename Function>
+	float Time(Function&& function, const unsigned int runs = 5)
+	{
+		float best = 0.0f;
+		for (unsigned int i = 0; i < runs; i++)
+		{
+			Stopwatch stopwatch;
+			function();
+			const float time = stopwatch.GetElapsedTimeMs();
+			best = i == 0 || time < best ? time : best;
+		}
+		return best;
+	}
+}
+
+#define TEST_CHECK(expression)																	\
+	if (!(expression))																			\
+	{																							\
+		printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #expression);					\
+		Spartan::Test::Failures()++;															\
+	}
+
+// Checks that a statement logs exactly the given number of errors
+#define TEST_CHECK_ERRORS(logger, count, statement)												\
+	{																							\
+		const int errors_before = (logger).m_errors;											\
+		statement;																				\
+		const int errors = (logger).m_errors - errors_before;									\
+		if (errors != (count))																	\
+		{																						\
+			printf("%s:%d: expected %d errors, got %d: %s\n", __FILE__, __LINE__, count, errors, #statement);	\
+			Spartan::Test::Failures()++;														\
+		}																						\
+	}
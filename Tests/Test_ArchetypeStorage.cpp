@@ -0,0 +1,180 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ===========================
+#include "Test.h"
+#include <vector>
+#include <set>
+#include "Core/Engine.h"
+#include "Core/Context.h"
+#include "Core/Settings.h"
+#include "FileSystem/FileSystem.h"
+#include "World/World.h"
+#include "World/Entity.h"
+#include "World/ArchetypeStorage.h"
+#include "World/Components/Transform.h"
+#include "World/Components/Renderable.h"
+//======================================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan;
+using namespace Spartan::Math;
+//============================
+
+namespace
+{
+	// The entities a query visits, every chunk it hands out has rows
+	template <typename... T>
+	vector<Entity*> Visit(World* world, const ComponentMask mask_exclude = 0)
+	{
+		vector<Entity*> visited;
+		world->Query<T...>([&visited](const ArchetypeChunk& chunk)
+		{
+			TEST_CHECK(chunk.count > 0 && chunk.count <= ArchetypeChunk::capacity);
+			visited.insert(visited.end(), chunk.entities, chunk.entities + chunk.count);
+		}, mask_exclude);
+		return visited;
+	}
+
+	bool Equal(const BoundingBox& a, const BoundingBox& b)
+	{
+		return a.GetMin() == b.GetMin() && a.GetMax() == b.GetMax();
+	}
+
+	// Rows whose values differ from the components of their entity
+	unsigned int Mismatches(World* world)
+	{
+		unsigned int mismatches = 0;
+		world->Query<>([&mismatches](const ArchetypeChunk& chunk)
+		{
+			for (unsigned int i = 0; i < chunk.count; i++)
+			{
+				Transform* transform	= chunk.entities[i]->GetTransform_PtrRaw();
+				Renderable* renderable	= chunk.entities[i]->GetRenderable_PtrRaw();
+				const bool match =
+					chunk.positions[i]	== transform->GetPositionLocal() &&
+					chunk.rotations[i]	== transform->GetRotationLocal() &&
+					chunk.scales[i]		== transform->GetScaleLocal() &&
+					chunk.matrices[i]	== transform->GetMatrix() &&
+					Equal(chunk.bounds[i], renderable ? renderable->GeometryAabb() : BoundingBox());
+				mismatches += !match;
+			}
+		});
+		return mismatches;
+	}
+}
+
+// The world keeps the transform and bounds of its entities in chunks grouped by component types, queries walk the
+// chunks and see what the components held at the end of the last tick. Runs from the build directory, next to a link to Data.
+int main()
+{
+	Test::Initialize();
+
+	FileSystem::DeleteFile_("Spartan.ini");
+	Settings::Get().SetMaxThreadCount(4);
+	auto context = make_shared<Context>();
+	Engine engine(context);
+	auto world = context->GetSubsystem<World>().get();
+	TEST_CHECK(world);
+	if (!world)
+		return Test::Finish("Archetype storage");
+
+	// Start from an empty world, the default one has a camera, a light and a skybox
+	world->Unload();
+	TEST_CHECK(world->GetArchetypes().GetCount() == 0);
+
+	// Empty entities and cubes, more than a chunk of each
+	const unsigned int empty_count	= 100;
+	const unsigned int cube_count	= 200;
+	vector<Entity*> cubes;
+	for (unsigned int i = 0; i < empty_count; i++)
+	{
+		world->EntityCreate()->GetTransform_PtrRaw()->SetPositionLocal(Vector3(static_cast<float>(i), 0.0f, 0.0f));
+	}
+	for (unsigned int i = 0; i < cube_count; i++)
+	{
+		auto& entity = world->EntityCreate();
+		entity->GetTransform_PtrRaw()->SetPositionLocal(Vector3(static_cast<float>(i), 2.0f, 0.0f));
+		entity->GetTransform_PtrRaw()->SetScaleLocal(Vector3(0.5f));
+		entity->AddComponent<Renderable>()->GeometrySet(Geometry_Default_Cube);
+		cubes.emplace_back(entity.get());
+	}
+	world->Tick();
+
+	const auto& archetypes = world->GetArchetypes();
+	TEST_CHECK(archetypes.GetCount() == empty_count + cube_count);
+	TEST_CHECK(archetypes.GetArchetypeCount() == 2);
+
+	// Queries visit the entities which match, each once
+	const auto all = Visit<>(world);
+	TEST_CHECK(all.size() == empty_count + cube_count);
+	TEST_CHECK(set<Entity*>(all.begin(), all.end()).size() == all.size());
+	const auto renderables = Visit<Renderable>(world);
+	TEST_CHECK(set<Entity*>(renderables.begin(), renderables.end()) == set<Entity*>(cubes.begin(), cubes.end()));
+	TEST_CHECK(Visit<>(world, GetComponentMask<Renderable>()).size() == empty_count);
+	TEST_CHECK(Mismatches(world) == 0);
+
+	// A moved cube reaches its chunk with the tick that resolves it
+	Entity* cube = cubes[10];
+	cube->GetTransform_PtrRaw()->SetPositionLocal(Vector3(0.0f, 50.0f, 0.0f));
+	TEST_CHECK(Mismatches(world) == 1);
+	world->Tick();
+	TEST_CHECK(Mismatches(world) == 0);
+	bool found = false;
+	world->Query<Renderable>([cube, &found](const ArchetypeChunk& chunk)
+	{
+		for (unsigned int i = 0; i < chunk.count; i++)
+		{
+			if (chunk.entities[i] == cube)
+			{
+				found = true;
+				TEST_CHECK(Vector3(chunk.matrices[i].m30, chunk.matrices[i].m31, chunk.matrices[i].m32) == Vector3(0.0f, 50.0f, 0.0f));
+				TEST_CHECK(chunk.bounds[i].GetCenter() == Vector3(0.0f, 50.0f, 0.0f));
+			}
+		}
+	});
+	TEST_CHECK(found);
+
+	// Removing a component moves the entity to the archetype of what it has left
+	cube->RemoveComponent<Renderable>();
+	TEST_CHECK(Visit<Renderable>(world).size() == cube_count - 1);
+	TEST_CHECK(Visit<>(world, GetComponentMask<Renderable>()).size() == empty_count + 1);
+	TEST_CHECK(Mismatches(world) == 0);
+
+	// Removed entities leave no gaps, the rest is still visited once each
+	for (unsigned int i = 0; i < cube_count; i += 4)
+	{
+		world->EntityRemove(cubes[i]->GetPtrShared());
+	}
+	const unsigned int count = empty_count + cube_count - cube_count / 4;
+	const auto remaining = Visit<>(world);
+	TEST_CHECK(archetypes.GetCount() == count);
+	TEST_CHECK(remaining.size() == count);
+	TEST_CHECK(set<Entity*>(remaining.begin(), remaining.end()).size() == count);
+	TEST_CHECK(Mismatches(world) == 0);
+
+	world->Unload();
+	TEST_CHECK(archetypes.GetCount() == 0);
+	TEST_CHECK(Visit<>(world).empty());
+
+	return Test::Finish("Archetype storage");
+}
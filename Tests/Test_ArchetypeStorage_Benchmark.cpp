@@ -0,0 +1,169 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ===========================
+#include "Test.h"
+#include <vector>
+#include "Core/Engine.h"
+#include "Core/Context.h"
+#include "Core/Settings.h"
+#include "FileSystem/FileSystem.h"
+#include "Rendering/Model.h"
+#include "World/World.h"
+#include "World/Entity.h"
+#include "World/ArchetypeStorage.h"
+#include "World/Components/Transform.h"
+#include "World/Components/Renderable.h"
+//======================================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan;
+using namespace Spartan::Math;
+//============================
+
+namespace
+{
+	bool Overlaps(const BoundingBox& a, const BoundingBox& b)
+	{
+		return a.GetMin().x <= b.GetMax().x && a.GetMax().x >= b.GetMin().x &&
+			a.GetMin().y <= b.GetMax().y && a.GetMax().y >= b.GetMin().y &&
+			a.GetMin().z <= b.GetMax().z && a.GetMax().z >= b.GetMin().z;
+	}
+
+	// Cubes on a square grid which share one model, every fourth entity has no geometry
+	void CreateScene(World* world, const unsigned int count)
+	{
+		const unsigned int side = static_cast<unsigned int>(sqrtf(static_cast<float>(count))) + 1;
+		shared_ptr<Model> model;
+		BoundingBox aabb;
+		unsigned int index_count	= 0;
+		unsigned int vertex_count	= 0;
+		for (unsigned int i = 0; i < count; i++)
+		{
+			auto& entity = world->EntityCreate();
+			Transform* transform = entity->GetTransform_PtrRaw();
+			transform->SetPositionLocal(Vector3(static_cast<float>(i % side) * 2.0f, 0.0f, static_cast<float>(i / side) * 2.0f));
+			transform->SetRotationLocal(Quaternion::FromEulerAngles(0.0f, static_cast<float>(i % 360), 0.0f));
+			if (i % 4 == 3)
+				continue;
+
+			auto renderable = entity->AddComponent<Renderable>();
+			if (!model)
+			{
+				renderable->GeometrySet(Geometry_Default_Cube);
+				model			= renderable->GeometryModel();
+				aabb			= model->GeometryAabb();
+				index_count		= renderable->GeometryIndexCount();
+				vertex_count	= renderable->GeometryVertexCount();
+			}
+			else
+			{
+				renderable->GeometrySet("Cube", 0, index_count, 0, vertex_count, aabb, model);
+			}
+		}
+	}
+}
+
+// Walks the bounds and the world matrices of 10k and 100k entities, through the components of every entity and
+// through the chunks of the world. Runs from the build directory, next to a link to Data.
+int main()
+{
+	Test::Initialize();
+
+	FileSystem::DeleteFile_("Spartan.ini");
+	Settings::Get().SetMaxThreadCount(4);
+	auto context = make_shared<Context>();
+	Engine engine(context);
+	auto world = context->GetSubsystem<World>().get();
+	TEST_CHECK(world);
+	if (!world)
+		return Test::Finish("Archetype storage benchmark");
+
+	printf("             bounds overlap            world positions   (ns per entity)\n");
+	printf("  entities   per entity    chunks      per entity    chunks\n");
+	for (const unsigned int count : { 10000u, 100000u })
+	{
+		world->Unload();
+		CreateScene(world, count);
+		world->Tick();
+
+		// A quarter of the scene
+		const float side = sqrtf(static_cast<float>(count)) * 2.0f;
+		const BoundingBox query(Vector3(0.0f, -1.0f, 0.0f), Vector3(side * 0.5f, 1.0f, side * 0.5f));
+
+		unsigned int overlaps_entities = 0;
+		const float time_bounds_entities = Test::Time([&]()
+		{
+			overlaps_entities = 0;
+			for (const auto& entity : world->Entities_GetAll())
+			{
+				if (Renderable* renderable = entity->GetRenderable_PtrRaw())
+				{
+					overlaps_entities += Overlaps(renderable->GeometryAabb(), query);
+				}
+			}
+		});
+		unsigned int overlaps_chunks = 0;
+		const float time_bounds_chunks = Test::Time([&]()
+		{
+			overlaps_chunks = 0;
+			world->Query<Renderable>([&](const ArchetypeChunk& chunk)
+			{
+				for (unsigned int i = 0; i < chunk.count; i++)
+				{
+					overlaps_chunks += Overlaps(chunk.bounds[i], query);
+				}
+			});
+		});
+		TEST_CHECK(overlaps_entities > 0 && overlaps_entities == overlaps_chunks);
+
+		Vector3 sum_entities = Vector3::Zero;
+		const float time_positions_entities = Test::Time([&]()
+		{
+			sum_entities = Vector3::Zero;
+			for (const auto& entity : world->Entities_GetAll())
+			{
+				const Matrix& matrix = entity->GetTransform_PtrRaw()->GetMatrix();
+				sum_entities += Vector3(matrix.m30, matrix.m31, matrix.m32);
+			}
+		});
+		Vector3 sum_chunks = Vector3::Zero;
+		const float time_positions_chunks = Test::Time([&]()
+		{
+			sum_chunks = Vector3::Zero;
+			world->Query<>([&](const ArchetypeChunk& chunk)
+			{
+				for (unsigned int i = 0; i < chunk.count; i++)
+				{
+					sum_chunks += Vector3(chunk.matrices[i].m30, chunk.matrices[i].m31, chunk.matrices[i].m32);
+				}
+			});
+		});
+		TEST_CHECK(sum_entities.x > 0.0f && (sum_entities - sum_chunks).Length() <= sum_entities.Length() * 1e-4f);
+
+		const float to_ns = 1e6f / count;
+		printf("%10u %12.1f %9.1f %15.1f %9.1f\n", count,
+			time_bounds_entities * to_ns, time_bounds_chunks * to_ns, time_positions_entities * to_ns, time_positions_chunks * to_ns);
+	}
+
+	return Test::Finish("Archetype storage benchmark");
+}
@@ -0,0 +1,127 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ================================
+#include "Test.h"
+#include <vector>
+#include "Rendering/Utilities/ConstantRing.h"
+#include "Math/Matrix.h"
+//===========================================
+
+//= NAMESPACES =====
+using namespace std;
+using namespace Spartan;
+//==================
+
+// Allocation and upload bookkeeping of the constant ring, with and without a page per allocation
+int main()
+{
+	Test::Initialize();
+
+	vector<ConstantRing::Range> ranges;
+
+	// Slices are aligned and packed, and never straddle a page
+	{
+		ConstantRing ring(1024, 256);
+		const auto a = ring.Allocate(64);
+		const auto b = ring.Allocate(300);
+		const auto c = ring.Allocate(256);
+		const auto d = ring.Allocate(1);
+		TEST_CHECK(a.page == 0 && a.offset == 0 && a.size == 256);
+		TEST_CHECK(b.page == 0 && b.offset == 256 && b.size == 512);
+		TEST_CHECK(c.page == 0 && c.offset == 768 && c.size == 256);
+		TEST_CHECK(d.page == 1 && d.offset == 0 && d.size == 256);
+		TEST_CHECK(ring.GetPageCount() == 2);
+		TEST_CHECK(ring.GetAllocationCount() == 4);
+		TEST_CHECK(ring.GetBytesAllocated() == 1280);
+
+		// Sizes which don't fit fail
+		TEST_CHECK(ring.Allocate(0).data == nullptr);
+		TEST_CHECK(ring.Allocate(1025).data == nullptr);
+		TEST_CHECK(ring.GetAllocationCount() == 4);
+
+		// Values land where the allocation says
+		const Math::Matrix value = Math::Matrix::CreateScale(2.0f);
+		const auto e = ring.AllocateValue(value);
+		TEST_CHECK(e.data == ring.GetPageData(e.page) + e.offset);
+		TEST_CHECK(memcmp(ring.GetPageData(e.page) + e.offset, &value, sizeof(value)) == 0);
+
+		// A range per page, then only what was allocated since
+		ring.Flush(ranges);
+		TEST_CHECK(ranges.size() == 2);
+		TEST_CHECK(ranges[0].page == 0 && ranges[0].offset == 0 && ranges[0].size == 1024);
+		TEST_CHECK(ranges[1].page == 1 && ranges[1].offset == 0 && ranges[1].size == 512);
+		ring.Flush(ranges);
+		TEST_CHECK(ranges.empty());
+		ring.Allocate(16);
+		ring.Flush(ranges);
+		TEST_CHECK(ranges.size() == 1 && ranges[0].page == 1 && ranges[0].offset == 512 && ranges[0].size == 256);
+
+		// A new frame starts over in the pages it already has
+		ring.Reset();
+		TEST_CHECK(ring.GetAllocationCount() == 0 && ring.GetBytesAllocated() == 0);
+		const auto f = ring.Allocate(16);
+		TEST_CHECK(f.page == 0 && f.offset == 0);
+		TEST_CHECK(ring.GetPageCount() == 2);
+		ring.Flush(ranges);
+		TEST_CHECK(ranges.size() == 1 && ranges[0].offset == 0 && ranges[0].size == 256);
+	}
+
+	// A page per allocation, for devices which can't bind a slice by offset
+	{
+		ConstantRing ring(1024, 256, true);
+		TEST_CHECK(ring.IsPagePerAllocation());
+		for (unsigned int i = 0; i < 3; i++)
+		{
+			const auto allocation = ring.Allocate(64);
+			TEST_CHECK(allocation.page == i && allocation.offset == 0);
+		}
+		ring.Flush(ranges);
+		TEST_CHECK(ranges.size() == 3);
+
+		ring.Reset();
+		TEST_CHECK(ring.Allocate(64).page == 0);
+		TEST_CHECK(ring.Allocate(64).page == 1);
+		TEST_CHECK(ring.GetPageCount() == 3);
+	}
+
+	// 10k objects a frame settle into the same pages and don't allocate any more
+	{
+		ConstantRing ring;
+		unsigned int page_count = 0;
+		for (unsigned int frame = 0; frame < 4; frame++)
+		{
+			ring.Reset();
+			for (unsigned int i = 0; i < 10000; i++)
+			{
+				TEST_CHECK(ring.AllocateValue(Math::Matrix::Identity).data != nullptr);
+			}
+			ring.Flush(ranges);
+
+			TEST_CHECK(frame == 0 || ring.GetPageCount() == page_count);
+			page_count = ring.GetPageCount();
+		}
+		TEST_CHECK(page_count == (10000 + 255) / 256);
+		TEST_CHECK(ranges.size() == page_count);
+	}
+
+	return Test::Finish("ConstantRing");
+}
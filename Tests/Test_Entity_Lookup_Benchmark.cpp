@@ -0,0 +1,161 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ===========================
+#include "Test.h"
+#include <vector>
+#include "Core/Context.h"
+#include "Core/PoolAllocator.h"
+#include "World/Entity.h"
+#include "World/Components/Transform.h"
+#include "World/Components/Renderable.h"
+#include "World/Components/Light.h"
+//======================================
+
+//= NAMESPACES =====
+using namespace std;
+using namespace Spartan;
+//==================
+
+namespace
+{
+	const unsigned int entity_count = 100000;
+
+	// How Entity looked components up before the slot table, a scan returning a shared_ptr copy
+	template <class T>
+	shared_ptr<T> GetComponentScan(const Entity* entity)
+	{
+		const ComponentType type = IComponent::TypeToEnum<T>();
+		for (const auto& component : entity->GetAllComponents())
+		{
+			if (component->GetType() == type)
+				return static_pointer_cast<T>(component);
+		}
+		return nullptr;
+	}
+
+	bool HasComponentScan(const Entity* entity, const ComponentType type)
+	{
+		for (const auto& component : entity->GetAllComponents())
+		{
+			if (component->GetType() == type)
+				return true;
+		}
+		return false;
+	}
+}
+
+// GetComponent and HasComponent over 100k entities, through the slot table and mask against the scan they replaced
+int main()
+{
+	Test::Initialize();
+	auto context = make_shared<Context>();
+
+	// Entities as World::EntityCreate makes them, every other one renderable, none of them a light
+	vector<shared_ptr<Entity>> entities(entity_count);
+	for (unsigned int i = 0; i < entity_count; i++)
+	{
+		auto& entity = entities[i];
+		entity = allocate_shared<Entity>(PoolAllocator<Entity>(), context.get());
+		entity->Initialize(entity->AddComponent<Transform>().get());
+		if (i % 2 == 0)
+		{
+			entity->AddComponent<Renderable>();
+		}
+	}
+
+	// Both ways find the same components
+	for (const auto& entity : entities)
+	{
+		TEST_CHECK(entity->GetComponent<Renderable>() == GetComponentScan<Renderable>(entity.get()));
+		TEST_CHECK(entity->GetComponent_PtrRaw<Transform>() == GetComponentScan<Transform>(entity.get()).get());
+		TEST_CHECK(entity->HasComponent<Renderable>() == HasComponentScan(entity.get(), ComponentType_Renderable));
+		TEST_CHECK(!entity->HasComponent<Light>() && !HasComponentScan(entity.get(), ComponentType_Light));
+	}
+
+	// What RenderablesAcquire and ShaderLight ask of every entity, a renderable, a light, and whether there is one
+	unsigned int found_scan = 0;
+	const float time_get_scan = Test::Time([&]()
+	{
+		found_scan = 0;
+		for (const auto& entity : entities)
+		{
+			found_scan += GetComponentScan<Renderable>(entity.get()) != nullptr;
+			found_scan += GetComponentScan<Light>(entity.get()) != nullptr;
+		}
+	});
+
+	unsigned int found_shared = 0;
+	const float time_get_shared = Test::Time([&]()
+	{
+		found_shared = 0;
+		for (const auto& entity : entities)
+		{
+			found_shared += entity->GetComponent<Renderable>() != nullptr;
+			found_shared += entity->GetComponent<Light>() != nullptr;
+		}
+	});
+
+	unsigned int found_raw = 0;
+	const float time_get_raw = Test::Time([&]()
+	{
+		found_raw = 0;
+		for (const auto& entity : entities)
+		{
+			found_raw += entity->GetComponent_PtrRaw<Renderable>() != nullptr;
+			found_raw += entity->GetComponent_PtrRaw<Light>() != nullptr;
+		}
+	});
+
+	unsigned int has_scan = 0;
+	const float time_has_scan = Test::Time([&]()
+	{
+		has_scan = 0;
+		for (const auto& entity : entities)
+		{
+			has_scan += HasComponentScan(entity.get(), ComponentType_Renderable);
+			has_scan += HasComponentScan(entity.get(), ComponentType_Light);
+		}
+	});
+
+	unsigned int has_mask = 0;
+	const float time_has_mask = Test::Time([&]()
+	{
+		has_mask = 0;
+		for (const auto& entity : entities)
+		{
+			has_mask += entity->HasComponent<Renderable>();
+			has_mask += entity->HasComponent<Light>();
+		}
+	});
+
+	TEST_CHECK(found_scan == entity_count / 2);
+	TEST_CHECK(found_shared == found_scan && found_raw == found_scan);
+	TEST_CHECK(has_scan == found_scan && has_mask == found_scan);
+
+	const float per_lookup = 1e6f / (entity_count * 2);
+	printf("GetComponent   scan %6.3f ms (%5.1f ns)   slot %6.3f ms (%5.1f ns)   slot raw %6.3f ms (%5.1f ns)\n",
+		time_get_scan, time_get_scan * per_lookup, time_get_shared, time_get_shared * per_lookup, time_get_raw, time_get_raw * per_lookup);
+	printf("HasComponent   scan %6.3f ms (%5.1f ns)   mask %6.3f ms (%5.1f ns)\n",
+		time_has_scan, time_has_scan * per_lookup, time_has_mask, time_has_mask * per_lookup);
+
+	return Test::Finish("Entity lookup benchmark");
+}
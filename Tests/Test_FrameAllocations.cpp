@@ -0,0 +1,282 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ===========================
+#include "Test.h"
+#include <new>
+#include <cstdlib>
+#include "Core/FrameAllocator.h"
+#include "Core/Settings.h"
+#include "Threading/Threading.h"
+#include "RHI/RHI_Implementation.h"
+#include "RHI/RHI_Device.h"
+#include "RHI/RHI_CommandList.h"
+#include "RHI/RHI_BlendState.h"
+#include "RHI/RHI_DepthStencilState.h"
+#include "RHI/RHI_RasterizerState.h"
+#include "RHI/RHI_Sampler.h"
+#include "RHI/RHI_Shader.h"
+#include "RHI/RHI_VertexBuffer.h"
+#include "RHI/RHI_IndexBuffer.h"
+#include "RHI/RHI_ConstantBuffer.h"
+#include "RHI/RHI_RenderTexture.h"
+#include "RHI/RHI_Vertex.h"
+#include "Core/Engine.h"
+#include "Core/Context.h"
+#include "Core/EventSystem.h"
+#include "FileSystem/FileSystem.h"
+#include "Rendering/Renderer.h"
+#include "Rendering/Material.h"
+#include "Rendering/Model.h"
+#include "World/World.h"
+#include "World/Entity.h"
+#include "World/Components/Transform.h"
+#include "World/Components/Renderable.h"
+//======================================
+
+//= NAMESPACES =====
+using namespace std;
+using namespace Spartan;
+//==================
+
+// Every general heap allocation of the process goes through here
+namespace
+{
+	atomic<unsigned int> g_allocations	= 0;
+	atomic<bool> g_counting				= false;
+}
+
+void* operator new(const size_t size)
+{
+	if (g_counting.load(memory_order_relaxed))
+	{
+		g_allocations++;
+	}
+
+	if (void* memory = malloc(size != 0 ? size : 1))
+		return memory;
+
+	throw bad_alloc();
+}
+
+void operator delete(void* memory) noexcept				{ free(memory); }
+void operator delete(void* memory, size_t) noexcept		{ free(memory); }
+
+namespace
+{
+	// Runs a few frames to warm up, then returns the heap allocations of the frames which follow
+	template <typename Function>
+	unsigned int CountAllocations(Function&& frame)
+	{
+		for (unsigned int i = 0; i < 4; i++)
+		{
+			FrameAllocator::OnFrameStart();
+			frame();
+		}
+
+		g_allocations = 0;
+		g_counting = true;
+		for (unsigned int i = 0; i < 16; i++)
+		{
+			FrameAllocator::OnFrameStart();
+			frame();
+		}
+		g_counting = false;
+
+		return g_allocations;
+	}
+
+	// Arenas are per thread and per frame buffer, and grow on first use. Has every worker and the calling thread
+	// allocate at the same time, in both buffers, so that a worker which happens to run its first job in a counted frame doesn't grow.
+	void WarmUpThreads(Threading& threading)
+	{
+		const unsigned int thread_count = threading.GetThreadCount() + 1;
+		for (unsigned int frame = 0; frame < 2; frame++)
+		{
+			FrameAllocator::OnFrameStart();
+
+			atomic<unsigned int> started = 0;
+			JobCounter counter;
+			for (unsigned int i = 0; i < thread_count; i++)
+			{
+				threading.AddTask([&started, thread_count]()
+				{
+					FrameVector<void*> textures(64, nullptr);
+					started++;
+					while (started.load() != thread_count)
+					{
+						this_thread::yield();
+					}
+				}, Job_Critical, &counter);
+			}
+			threading.Wait(&counter);
+		}
+	}
+}
+
+// Steady-state frames don't touch the general heap
+int main()
+{
+	Test::Initialize();
+
+	// Make sure the harness counts
+	g_counting = true;
+	::operator delete(::operator new(16));
+	g_counting = false;
+	TEST_CHECK(g_allocations == 1);
+
+	// Containers, strings and allocations from several threads
+	{
+		Settings::Get().SetMaxThreadCount(4);
+		Threading threading(nullptr);
+		WarmUpThreads(threading);
+
+		const unsigned int allocations = CountAllocations([&threading]()
+		{
+			FrameVector<unsigned int> values;
+			for (unsigned int i = 0; i < 10000; i++)
+			{
+				values.emplace_back(i);
+			}
+			TEST_CHECK(values.back() == 9999);
+
+			const char* name = FrameAllocator::AllocateString("Pass_GBuffer");
+			TEST_CHECK(name[0] == 'P');
+
+			threading.ParallelFor(64, [](const unsigned int start, const unsigned int end)
+			{
+				for (unsigned int i = start; i < end; i++)
+				{
+					FrameVector<void*> textures(8, nullptr);
+					textures.resize(64);
+				}
+			}, 1);
+		});
+		TEST_CHECK(allocations == 0);
+	}
+
+	// Recording and submitting a pass
+	{
+		auto device		= make_shared<RHI_Device>();
+		auto blend		= make_shared<RHI_BlendState>(device);
+		auto depth		= make_shared<RHI_DepthStencilState>(device, true, Comparison_Less);
+		auto rasterizer	= make_shared<RHI_RasterizerState>(device, Cull_Back, Fill_Solid, true, false, false, false);
+		auto sampler	= make_shared<RHI_Sampler>(device, Texture_Filter_Bilinear, Sampler_Address_Wrap, Comparison_Always);
+		auto shader		= make_shared<RHI_Shader>(device);
+		shader->Compile(Shader_VertexPixel, "float4 mainVS() {} float4 mainPS() {}", Vertex_Attributes_PositionTextureNormalTangent);
+		auto vertex_buffer = make_shared<RHI_VertexBuffer>(device);
+		vector<RHI_Vertex_PosUvNorTan> vertices(100);
+		vertex_buffer->Create(vertices);
+		auto index_buffer = make_shared<RHI_IndexBuffer>(device);
+		vector<uint32_t> indices(300);
+		index_buffer->Create(indices);
+		auto constant_buffer	= make_shared<RHI_ConstantBuffer>(device);
+		constant_buffer->Create(4096);
+		auto render_target		= make_shared<RHI_RenderTexture>(device, 640, 480, Format_R16G16B16A16_FLOAT, true);
+		auto texture			= make_shared<RHI_RenderTexture>(device, 640, 480, Format_R16G16B16A16_FLOAT);
+		RHI_CommandList cmd_list(device, nullptr);
+
+		const unsigned int allocations = CountAllocations([&]()
+		{
+			FrameVector<void*> textures(4, texture->GetBufferView());
+
+			cmd_list.Begin("Pass");
+			cmd_list.SetRenderTarget(render_target, render_target->GetDepthStencilView());
+			cmd_list.ClearRenderTarget(render_target->GetBufferRenderTargetView(), Math::Vector4(0.0f, 0.0f, 0.0f, 0.0f));
+			cmd_list.SetViewport(render_target->GetViewport());
+			cmd_list.SetBlendState(blend);
+			cmd_list.SetDepthStencilState(depth);
+			cmd_list.SetRasterizerState(rasterizer);
+			cmd_list.SetInputLayout(shader->GetInputLayout());
+			cmd_list.SetShaderVertex(shader);
+			cmd_list.SetShaderPixel(shader);
+			cmd_list.SetBufferVertex(vertex_buffer);
+			cmd_list.SetBufferIndex(index_buffer);
+			cmd_list.SetSampler(0, sampler);
+			cmd_list.SetTextures(0, textures);
+			cmd_list.SetConstantBuffer(0, Buffer_Global, constant_buffer);
+			for (unsigned int i = 0; i < 100; i++)
+			{
+				cmd_list.DrawIndexed(36, 0, 0);
+			}
+			cmd_list.End();
+			cmd_list.Submit();
+		});
+		TEST_CHECK(allocations == 0);
+	}
+
+	// The renderer acquiring and sorting what the world submits, debug lines and boxes, and a frame with the
+	// g-buffer pass, drawn instanced and not. Runs from the build directory, next to a link to Data.
+	{
+		FileSystem::DeleteFile_("Spartan.ini");
+		Settings::Get().SetMaxThreadCount(4);
+		auto context = make_shared<Context>();
+		Engine engine(context);
+		auto world		= context->GetSubsystem<World>().get();
+		auto renderer	= context->GetSubsystem<Renderer>().get();
+
+		// Cubes in front of the camera, sharing a model and spread over a few materials
+		vector<shared_ptr<Material>> materials;
+		for (unsigned int i = 0; i < 8; i++)
+		{
+			materials.emplace_back(make_shared<Material>(context.get()));
+			materials.back()->SetColorAlbedo(Math::Vector4(0.1f * i, 0.5f, 0.5f, 1.0f));
+		}
+		shared_ptr<Model> model;
+		for (unsigned int i = 0; i < 1024; i++)
+		{
+			auto& entity = world->EntityCreate();
+			entity->GetTransform_PtrRaw()->SetPositionLocal(Math::Vector3(static_cast<float>(i % 32) - 16.0f, static_cast<float>(i / 32) - 16.0f, 30.0f));
+			auto renderable = entity->AddComponent<Renderable>();
+			if (!model)
+			{
+				renderable->GeometrySet(Geometry_Default_Cube);
+				model = renderable->GeometryModel();
+			}
+			else
+			{
+				renderable->GeometrySet("Cube", 0, model->GetIndexBuffer()->GetIndexCount(), 0, model->GetVertexBuffer()->GetVertexCount(), model->GeometryAabb(), model);
+			}
+			renderable->MaterialSet(materials[i % materials.size()]);
+		}
+		FrameAllocator::OnFrameStart();
+		world->Tick();
+		WarmUpThreads(*context->GetSubsystem<Threading>());
+
+		const Variant entities = world->Entities_GetAll();
+		for (const bool instancing : { true, false })
+		{
+			instancing ? renderer->Flags_Enable(Render_Instancing) : renderer->Flags_Disable(Render_Instancing);
+
+			const unsigned int allocations = CountAllocations([&]()
+			{
+				FIRE_EVENT_DATA(Event_World_Submit, entities);
+				renderer->DrawLine(Math::Vector3::Zero, Math::Vector3::One);
+				renderer->DrawBox(Math::BoundingBox(Math::Vector3::Zero, Math::Vector3::One));
+				renderer->Tick();
+			});
+			TEST_CHECK(renderer->GetInstanceBatcherGBuffer().GetDrawCount() == 1024);
+			TEST_CHECK(allocations == 0);
+		}
+	}
+
+	return Test::Finish("Frame allocations");
+}
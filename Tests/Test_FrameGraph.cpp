@@ -0,0 +1,185 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ==================
+#include "Test.h"
+#include <vector>
+#include <string>
+#include "Rendering/Renderer.h"
+//=============================
+
+//= NAMESPACES =====
+using namespace std;
+using namespace Spartan;
+//==================
+
+namespace
+{
+	vector<string> PassOrder(const FrameGraph& graph)
+	{
+		vector<string> names;
+		for (const auto pass : graph.GetPassOrder())
+		{
+			names.emplace_back(graph.GetPassName(pass));
+		}
+		return names;
+	}
+
+	bool HasBarrier(const FrameGraph& graph, const char* pass_name, const char* texture_name, const uint32_t before, const uint32_t after)
+	{
+		for (const auto pass : graph.GetPassOrder())
+		{
+			if (graph.GetPassName(pass) != pass_name)
+				continue;
+
+			for (const auto& barrier : graph.GetBarriers(pass))
+			{
+				if (barrier.texture == graph.GetTexture(texture_name) && barrier.before == before && barrier.after == after)
+					return true;
+			}
+		}
+		return false;
+	}
+}
+
+// Compiles the graph of the renderer's pipeline with different settings, and small graphs for the corner cases
+int main()
+{
+	auto& logger = Test::Initialize();
+
+	const uint64_t pixels			= 1920 * 1080;
+	const uint64_t pixels_half		= 960 * 540;
+	const uint64_t pixels_quarter	= 480 * 270;
+	FrameGraph graph;
+
+	// The renderer's defaults
+	{
+		const unsigned long flags = Render_PostProcess_Bloom | Render_PostProcess_SSAO | Render_PostProcess_MotionBlur | Render_PostProcess_TAA | Render_PostProcess_Sharpening;
+		Renderer::FrameGraph_Declare(graph, 1920, 1080, flags, ToneMapping_ACES, RendererDebug_None);
+		TEST_CHECK_ERRORS(logger, 0, TEST_CHECK(graph.Compile()));
+
+		const vector<string> order =
+		{
+			"Pass_DepthDirectionalLight", "Pass_GBuffer", "Pass_ShadowMapping", "Pass_SSAO", "Pass_Light", "Pass_Transparent", "Pass_TAA", "Pass_Bloom",
+			"Pass_MotionBlur", "Pass_ToneMapping", "Pass_Sharpening", "Pass_GammaCorrection", "Pass_Lines", "Pass_Gizmos", "Pass_PerformanceMetrics"
+		};
+		TEST_CHECK(PassOrder(graph) == order);
+		TEST_CHECK(!graph.IsPassActive("Pass_Dithering") && !graph.IsPassActive("Pass_FXAA") && !graph.IsPassActive("Pass_ChromaticAberration") && !graph.IsPassActive("Pass_DebugBuffer"));
+
+		// G-buffer (32 bytes a pixel with the depth-stencil), three 8 bit half resolution textures, the bloom chain and the full resolution spare,
+		// which bloom only needs once the light pass is done with the normals, so they share memory
+		const uint64_t g_buffer	= pixels * (4 + 8 + 4 + 4 + 8 + 4);
+		const uint64_t bloom	= pixels_half * 8 + pixels_quarter * 8 * 2;
+		TEST_CHECK(graph.GetMemoryTransientUnaliased() == g_buffer + pixels_half * 3 + bloom + pixels * 8);
+		TEST_CHECK(graph.GetMemoryTransient() == g_buffer + pixels_half * 3 + bloom);
+		TEST_CHECK(graph.GetPhysical(graph.GetTexture("full_spare")) == graph.GetPhysical(graph.GetTexture("g_buffer_normal")));
+		TEST_CHECK(graph.GetPhysicalTextures().size() == 11);
+
+		// The light pass samples what the G-buffer pass rendered
+		TEST_CHECK(HasBarrier(graph, "Pass_GBuffer", "g_buffer_albedo", FrameGraph::State_Undefined, FrameGraph::State_RenderTarget));
+		TEST_CHECK(HasBarrier(graph, "Pass_Light", "g_buffer_albedo", FrameGraph::State_RenderTarget, FrameGraph::State_ShaderRead));
+		TEST_CHECK(HasBarrier(graph, "Pass_Transparent", "g_buffer_depth", FrameGraph::State_ShaderRead, FrameGraph::State_ShaderRead | FrameGraph::State_DepthStencil));
+	}
+
+	// Every optional pass off
+	{
+		Renderer::FrameGraph_Declare(graph, 1920, 1080, 0, ToneMapping_Off, RendererDebug_None);
+		TEST_CHECK(graph.Compile());
+
+		const vector<string> order =
+		{
+			"Pass_DepthDirectionalLight", "Pass_GBuffer", "Pass_ShadowMapping", "Pass_Light", "Pass_Transparent", "Pass_GammaCorrection", "Pass_Lines", "Pass_Gizmos", "Pass_PerformanceMetrics"
+		};
+		TEST_CHECK(PassOrder(graph) == order);
+		for (const char* name : { "half_ssao", "half_spare2", "quarter_blur1", "quarter_blur2", "full_spare", "full_taa_current", "full_taa_history" })
+		{
+			TEST_CHECK(!graph.IsTextureUsed(graph.GetTexture(name)));
+		}
+		TEST_CHECK(graph.GetMemoryTransient() == pixels * 32 + pixels_half * 2);
+	}
+
+	// A debug buffer replaces the frame, only what it shows is rendered
+	{
+		Renderer::FrameGraph_Declare(graph, 1920, 1080, Render_PostProcess_SSAO, ToneMapping_ACES, RendererDebug_Albedo);
+		TEST_CHECK(graph.Compile());
+		TEST_CHECK(PassOrder(graph) == vector<string>({ "Pass_GBuffer", "Pass_DebugBuffer", "Pass_PerformanceMetrics" }));
+
+		// Unless TAA is on, its history is needed by the next frame
+		Renderer::FrameGraph_Declare(graph, 1920, 1080, Render_PostProcess_SSAO | Render_PostProcess_TAA, ToneMapping_ACES, RendererDebug_Albedo);
+		TEST_CHECK(graph.Compile());
+		TEST_CHECK(graph.IsPassActive("Pass_TAA") && graph.IsPassActive("Pass_Light") && !graph.IsPassActive("Pass_ToneMapping"));
+
+		Renderer::FrameGraph_Declare(graph, 1920, 1080, Render_PostProcess_SSAO, ToneMapping_ACES, RendererDebug_SSAO);
+		TEST_CHECK(graph.Compile());
+		TEST_CHECK(graph.IsPassActive("Pass_SSAO") && !graph.IsPassActive("Pass_Light"));
+	}
+
+	// Textures which live at different times share memory if they are alike
+	{
+		graph.Clear();
+		const FrameGraph::Texture_Desc desc	= { 256, 256, Format_R8G8B8A8_UNORM, false };
+		const auto a		= graph.Create("a", desc);
+		const auto b		= graph.Create("b", desc);
+		const auto c		= graph.Create("c", desc);
+		const auto d		= graph.Create("d", { 256, 256, Format_R16G16B16A16_FLOAT, false });
+		const auto output	= graph.Import("output");
+
+		auto pass = graph.AddPass("write_a");
+		graph.Write(pass, a);
+		pass = graph.AddPass("a_to_b");
+		graph.Read(pass, a);
+		graph.Write(pass, b);
+		pass = graph.AddPass("b_to_c_and_d");
+		graph.Read(pass, b);
+		graph.Write(pass, c);
+		graph.Write(pass, d);
+		pass = graph.AddPass("c_and_d_to_output");
+		graph.Read(pass, c);
+		graph.Read(pass, d);
+		graph.Write(pass, output);
+		pass = graph.AddPass("unused");
+		graph.Write(pass, graph.Create("e", desc));
+		graph.SetOutput(output);
+
+		TEST_CHECK(graph.Compile());
+		TEST_CHECK(!graph.IsPassActive("unused"));
+		TEST_CHECK(graph.GetPhysical(a) == graph.GetPhysical(c));	// a is done before c starts
+		TEST_CHECK(graph.GetPhysical(a) != graph.GetPhysical(b));	// both live in a_to_b
+		TEST_CHECK(graph.GetPhysical(d) != graph.GetPhysical(a) && graph.GetPhysical(d) != graph.GetPhysical(b));
+		TEST_CHECK(graph.GetPhysical(output) == FrameGraph::invalid);
+		TEST_CHECK(graph.GetMemoryTransient() == 256 * 256 * (4 + 4 + 8));
+		TEST_CHECK(graph.GetMemoryTransientUnaliased() == 256 * 256 * (4 + 4 + 4 + 8));
+	}
+
+	// Reading a transient texture which nothing wrote is an error
+	{
+		graph.Clear();
+		const auto texture	= graph.Create("texture", { 64, 64, Format_R8_UNORM, false });
+		const auto output	= graph.Import("output");
+		const auto pass		= graph.AddPass("pass");
+		graph.Read(pass, texture);
+		graph.Write(pass, output);
+		graph.SetOutput(output);
+		TEST_CHECK_ERRORS(logger, 1, TEST_CHECK(!graph.Compile()));
+	}
+
+	return Test::Finish("FrameGraph");
+}
@@ -0,0 +1,121 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES =====================
+#include "Test.h"
+#include <vector>
+#include <random>
+#include "Math/Frustum.h"
+#include "Math/BoundingBox.h"
+#include "Threading/Threading.h"
+#include "Core/Settings.h"
+//================================
+
+//= NAMESPACES ===========
+using namespace std;
+using namespace Spartan;
+using namespace Spartan::Math;
+//========================
+
+// Culls 1M boxes box by box (CheckCube) and in batches (CheckCubes), serially and in parallel
+int main()
+{
+	Test::Initialize();
+
+	const unsigned int count		= 1000000;
+	const unsigned int word_count	= (count + 31) / 32;
+
+	// A camera at the origin, looking down +Z, and boxes scattered around it
+	Frustum frustum;
+	const Matrix view		= Matrix::CreateLookAtLH(Vector3::Zero, Vector3::Forward, Vector3::Up);
+	const Matrix projection	= Matrix::CreatePerspectiveFieldOfViewLH(1.0f, 16.0f / 9.0f, 0.3f, 1000.0f);
+	frustum.Construct(view, projection, 1000.0f);
+
+	mt19937 engine(1);
+	uniform_real_distribution<float> position(-1000.0f, 1000.0f);
+	uniform_real_distribution<float> size(0.5f, 10.0f);
+	vector<Vector3> centers(count);
+	vector<Vector3> extents(count);
+	BoundingBoxes boxes;
+	boxes.Resize(count);
+	for (unsigned int i = 0; i < count; i++)
+	{
+		centers[i] = Vector3(position(engine), position(engine), position(engine));
+		extents[i] = Vector3(size(engine), size(engine), size(engine));
+		boxes.Set(i, BoundingBox(centers[i] - extents[i], centers[i] + extents[i]));
+
+		// Test exactly what the batches test, the min/max round trip of the box can change the last bit
+		centers[i] = Vector3(boxes.center_x[i], boxes.center_y[i], boxes.center_z[i]);
+		extents[i] = Vector3(boxes.extent_x[i], boxes.extent_y[i], boxes.extent_z[i]);
+	}
+
+	// Box by box, the way the passes culled before
+	vector<uint32_t> visibility_single(word_count, 0);
+	const float time_single = Test::Time([&]()
+	{
+		for (unsigned int i = 0; i < count; i++)
+		{
+			if (frustum.CheckCube(centers[i], extents[i]) != Outside)
+			{
+				visibility_single[i / 32] |= 1u << (i % 32);
+			}
+		}
+	});
+
+	// Batches
+	vector<uint32_t> visibility_batch(word_count, 0);
+	const float time_batch = Test::Time([&]()
+	{
+		fill(visibility_batch.begin(), visibility_batch.end(), 0);
+		frustum.CheckCubes(boxes, 0, count, visibility_batch.data());
+	});
+
+	// Batches in parallel ranges of whole words, the way the renderer culls
+	Settings::Get().SetMaxThreadCount(thread::hardware_concurrency());
+	Threading threading(nullptr);
+	vector<uint32_t> visibility_parallel(word_count, 0);
+	const float time_parallel = Test::Time([&]()
+	{
+		fill(visibility_parallel.begin(), visibility_parallel.end(), 0);
+		threading.ParallelFor(word_count, [&](const unsigned int word_start, const unsigned int word_end)
+		{
+			frustum.CheckCubes(boxes, word_start * 32, min(word_end * 32, count), visibility_parallel.data());
+		}, 32, Job_Critical);
+	});
+
+	unsigned int visible = 0;
+	for (unsigned int i = 0; i < count; i++)
+	{
+		visible += (visibility_single[i / 32] >> (i % 32)) & 1;
+	}
+
+	printf("%u of %u boxes visible\n", visible, count);
+	printf("CheckCube                %6.2f ns/box\n", time_single * 1000000.0f / count);
+	printf("CheckCubes               %6.2f ns/box\n", time_batch * 1000000.0f / count);
+	printf("CheckCubes (%2u threads)  %6.2f ns/box\n", threading.GetThreadCount() + 1, time_parallel * 1000000.0f / count);
+
+	// Every path gives the same visibility
+	TEST_CHECK(visible != 0 && visible != count);
+	TEST_CHECK(visibility_batch == visibility_single);
+	TEST_CHECK(visibility_parallel == visibility_single);
+
+	return Test::Finish("Frustum culling");
+}
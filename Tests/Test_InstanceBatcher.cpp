@@ -0,0 +1,126 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ===================================
+#include "Test.h"
+#include <vector>
+#include <random>
+#include "Rendering/Utilities/InstanceBatcher.h"
+//==============================================
+
+//= NAMESPACES =====
+using namespace std;
+using namespace Spartan;
+//==================
+
+// 100k draws of 8 meshes with 8 materials, in random order, come out as 64 instanced batches
+int main()
+{
+	Test::Initialize();
+
+	const unsigned int draw_count = 100000;
+
+	// Only the addresses matter
+	const int geometries[8]	= {};
+	const int materials[8]	= {};
+	const int shader		= 0;
+
+	mt19937 engine(1);
+	vector<InstanceBatcher::Draw> draws(draw_count);
+	for (unsigned int i = 0; i < draw_count; i++)
+	{
+		const unsigned int mesh		= engine() % 8;
+		const unsigned int material	= engine() % 8;
+		draws[i] = { &geometries[mesh], &materials[material], &shader, 36 * (mesh + 1), 0, 0, i };
+	}
+
+	InstanceBatcher batcher;
+	const auto build = [&batcher, &draws]()
+	{
+		batcher.Clear();
+		for (const auto& draw : draws)
+		{
+			batcher.Add(draw);
+		}
+		batcher.Build();
+	};
+
+	const float time = Test::Time(build);
+	printf("%u draws, %u batches, %.3f ms\n", batcher.GetDrawCount(), batcher.GetBatchCount(), time);
+	TEST_CHECK(batcher.GetDrawCount() == draw_count);
+	TEST_CHECK(batcher.GetBatchCount() == 64);
+
+	// Every draw is an instance of exactly one batch, with the state of that batch, and in the order it was added in
+	const vector<InstanceBatcher::Batch>& batches	= batcher.GetBatches();
+	const vector<uint32_t>& instances				= batcher.GetInstances();
+	TEST_CHECK(instances.size() == draw_count);
+	vector<bool> seen(draw_count, false);
+	unsigned int offset			= 0;
+	unsigned int mismatches		= 0;
+	unsigned int first_previous	= 0;
+	for (unsigned int i = 0; i < static_cast<unsigned int>(batches.size()); i++)
+	{
+		const InstanceBatcher::Batch& batch = batches[i];
+		TEST_CHECK(batch.instance_offset == offset);
+		offset += batch.instance_count;
+
+		// Batches are ordered by their first draw
+		const uint32_t first = instances[batch.instance_offset];
+		TEST_CHECK(i == 0 || first > first_previous);
+		first_previous = first;
+
+		for (unsigned int j = batch.instance_offset; j < batch.instance_offset + batch.instance_count; j++)
+		{
+			const InstanceBatcher::Draw& draw = draws[instances[j]];
+			mismatches += (draw.geometry != batch.draw.geometry || draw.material != batch.draw.material || draw.index_count != batch.draw.index_count) ? 1 : 0;
+			mismatches += (j != batch.instance_offset && instances[j] <= instances[j - 1]) ? 1 : 0;
+			mismatches += seen[instances[j]] ? 1 : 0;
+			seen[instances[j]] = true;
+		}
+	}
+	TEST_CHECK(offset == draw_count);
+	TEST_CHECK(mismatches == 0);
+
+	// Building again gives the same result
+	const vector<uint32_t> instances_first = instances;
+	build();
+	TEST_CHECK(batcher.GetBatchCount() == 64);
+	TEST_CHECK(batcher.GetInstances() == instances_first);
+
+	// Any difference in state starts a new batch
+	batcher.Clear();
+	batcher.Add({ &geometries[0], &materials[0], &shader, 36, 0, 0, 0 });
+	batcher.Add({ &geometries[0], &materials[0], &shader, 36, 36, 0, 1 });	// index offset
+	batcher.Add({ &geometries[0], &materials[0], &shader, 36, 0, 24, 2 });	// vertex offset
+	batcher.Add({ &geometries[0], &materials[0], nullptr, 36, 0, 0, 3 });	// shader
+	batcher.Add({ &geometries[0], &materials[0], &shader, 36, 0, 0, 4 });	// same as the first
+	batcher.Build();
+	TEST_CHECK(batcher.GetBatchCount() == 4);
+	TEST_CHECK(batcher.GetBatches()[0].instance_count == 2);
+	TEST_CHECK(batcher.GetInstances()[1] == 4);
+
+	// Nothing added, nothing to draw
+	batcher.Clear();
+	batcher.Build();
+	TEST_CHECK(batcher.GetBatchCount() == 0);
+
+	return Test::Finish("InstanceBatcher");
+}
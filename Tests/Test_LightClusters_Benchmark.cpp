@@ -0,0 +1,142 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ================================
+#include "Test.h"
+#include <vector>
+#include <random>
+#include <algorithm>
+#include "Rendering/Deferred/LightClusters.h"
+#include "Threading/Threading.h"
+#include "Core/Settings.h"
+//===========================================
+
+//= NAMESPACES ===========
+using namespace std;
+using namespace Spartan;
+using namespace Spartan::Math;
+//========================
+
+namespace
+{
+	// Point and spot lights scattered in front of the camera and around it
+	vector<LightClusters::Light> CreateLights(const unsigned int count)
+	{
+		mt19937 engine(count);
+		uniform_real_distribution<float> side(-200.0f, 200.0f);
+		uniform_real_distribution<float> height(0.0f, 40.0f);
+		uniform_real_distribution<float> depth(-50.0f, 400.0f);
+		uniform_real_distribution<float> range(1.0f, 15.0f);
+		uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+		vector<LightClusters::Light> lights(count);
+		for (unsigned int i = 0; i < count; i++)
+		{
+			LightClusters::Light& light = lights[i];
+			light.position	= Vector3(side(engine), height(engine), depth(engine));
+			light.range		= range(engine);
+			light.color		= Vector3::One;
+			light.intensity	= 1.0f;
+			light.direction	= Vector3(unit(engine), -1.0f, unit(engine)).Normalized();
+			light.angle		= 0.5f;
+			light.type		= (i % 4 == 0) ? LightClusters::Light_Spot : LightClusters::Light_Point;
+		}
+
+		return lights;
+	}
+
+	bool SphereIntersectsBox(const Vector3& center, const float radius, const Vector3& box_min, const Vector3& box_max)
+	{
+		const Vector3 closest(Clamp(center.x, box_min.x, box_max.x), Clamp(center.y, box_min.y, box_max.y), Clamp(center.z, box_min.z, box_max.z));
+		return (center - closest).LengthSquared() <= radius * radius * 1.001f;
+	}
+}
+
+// Bins 1k, 10k and 50k lights into 16x8x24 clusters, serially and in jobs
+int main()
+{
+	Test::Initialize();
+
+	const float near_plane	= 0.3f;
+	const float far_plane	= 1000.0f;
+	const Matrix view		= Matrix::CreateLookAtLH(Vector3(0.0f, 10.0f, 0.0f), Vector3(0.0f, 10.0f, 1.0f), Vector3::Up);
+	const Matrix projection	= Matrix::CreatePerspectiveFieldOfViewLH(1.047f, 16.0f / 9.0f, near_plane, far_plane);
+
+	Settings::Get().SetMaxThreadCount(thread::hardware_concurrency());
+	Threading threading(nullptr);
+
+	LightClusters clusters_serial;
+	LightClusters clusters_parallel;
+	for (const unsigned int light_count : { 1000u, 10000u, 50000u })
+	{
+		const vector<LightClusters::Light> lights = CreateLights(light_count);
+
+		const float time_serial		= Test::Time([&]() { clusters_serial.Build(view, projection, near_plane, far_plane, lights); });
+		const float time_parallel	= Test::Time([&]() { clusters_parallel.Build(view, projection, near_plane, far_plane, lights, &threading); });
+
+		const vector<LightClusters::Cluster>& clusters	= clusters_serial.GetClusters();
+		const vector<uint32_t>& indices					= clusters_serial.GetLightIndices();
+		printf("%5u lights, %7u indices   serial %8.3f ms   %2u threads %8.3f ms\n", light_count, static_cast<unsigned int>(indices.size()), time_serial, threading.GetThreadCount() + 1, time_parallel);
+
+		// Jobs bin exactly what a single thread does
+		TEST_CHECK(clusters_parallel.GetLightIndices() == indices);
+		TEST_CHECK(equal(clusters.begin(), clusters.end(), clusters_parallel.GetClusters().begin(), [](const LightClusters::Cluster& a, const LightClusters::Cluster& b)
+		{
+			return a.offset == b.offset && a.count == b.count;
+		}));
+
+		// Lists are sorted, and every light in a cluster reaches it
+		unsigned int unsorted	= 0;
+		unsigned int unreached	= 0;
+		for (unsigned int cluster = 0; cluster < static_cast<unsigned int>(clusters.size()); cluster++)
+		{
+			const uint32_t* first	= indices.data() + clusters[cluster].offset;
+			const uint32_t* last	= first + clusters[cluster].count;
+			unsorted += is_sorted(first, last) ? 0 : 1;
+			for (const uint32_t* index = first; index != last; index++)
+			{
+				const LightClusters::Light& light = lights[*index];
+				if (light.type == LightClusters::Light_Point)
+				{
+					unreached += SphereIntersectsBox(view * light.position, light.range, clusters_serial.GetClusterMin()[cluster], clusters_serial.GetClusterMax()[cluster]) ? 0 : 1;
+				}
+			}
+		}
+		TEST_CHECK(unsorted == 0);
+		TEST_CHECK(unreached == 0);
+
+		// A point light which is on screen is in the cluster that contains it
+		unsigned int missing = 0;
+		for (unsigned int i = 0; i < light_count; i++)
+		{
+			const Vector3 position_view	= view * lights[i].position;
+			const Vector3 position_ndc	= projection * position_view;
+			if (lights[i].type != LightClusters::Light_Point || position_view.z < near_plane || Helper::Abs(position_ndc.x) > 0.99f || Helper::Abs(position_ndc.y) > 0.99f)
+				continue;
+
+			const LightClusters::Cluster& cluster = clusters[clusters_serial.GetClusterIndex(position_view)];
+			missing += binary_search(indices.begin() + cluster.offset, indices.begin() + cluster.offset + cluster.count, i) ? 0 : 1;
+		}
+		TEST_CHECK(missing == 0);
+	}
+
+	return Test::Finish("Light clusters");
+}
@@ -0,0 +1,130 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES =====
+#include "Test.h"
+#include "Test_Math.h"
+#include <algorithm>
+//================
+
+//= NAMESPACES ===========
+using namespace std;
+using namespace Spartan;
+using namespace Spartan::Math;
+//========================
+
+namespace
+{
+	const unsigned int sample_count = 100000;
+
+	float Magnitude(const Matrix& matrix)
+	{
+		float magnitude = 1.0f;
+		for (unsigned int i = 0; i < 16; i++)
+		{
+			magnitude = max(magnitude, fabsf(matrix.Data()[i]));
+		}
+		return magnitude;
+	}
+
+	// Largest difference, relative to the largest component of the expected value (when above one)
+	float Error(const Matrix& value, const Matrix& expected)
+	{
+		float error = 0.0f;
+		for (unsigned int i = 0; i < 16; i++)
+		{
+			error = max(error, fabsf(value.Data()[i] - expected.Data()[i]));
+		}
+		return error / Magnitude(expected);
+	}
+
+	float Error(const Vector3& value, const Vector3& expected)
+	{
+		const float error		= max(fabsf(value.x - expected.x), max(fabsf(value.y - expected.y), fabsf(value.z - expected.z)));
+		const float magnitude	= max(1.0f, max(fabsf(expected.x), max(fabsf(expected.y), fabsf(expected.z))));
+		return error / magnitude;
+	}
+
+	float Error(const Quaternion& value, const Quaternion& expected)
+	{
+		return max(max(fabsf(value.x - expected.x), fabsf(value.y - expected.y)), max(fabsf(value.z - expected.z), fabsf(value.w - expected.w)));
+	}
+
+	void Report(const char* operation, const float error, const float tolerance)
+	{
+		printf("%-20s max error %.2e (tolerance %.0e)\n", operation, error, tolerance);
+		TEST_CHECK(error <= tolerance);
+	}
+}
+
+// The SIMD paths of the math types give the results of the scalar formulas, within floating point tolerance
+int main()
+{
+	Test::Initialize();
+	Test::Reference::Random random;
+
+	float error_multiply	= 0.0f;
+	float error_transpose	= 0.0f;
+	float error_invert		= 0.0f;
+	float error_identity	= 0.0f;
+	float error_point		= 0.0f;
+	float error_compose		= 0.0f;
+	float error_quaternion	= 0.0f;
+	float error_decompose	= 0.0f;
+
+	for (unsigned int i = 0; i < sample_count; i++)
+	{
+		const Vector3 translation	= random.Position();
+		const Quaternion rotation	= random.Rotation();
+		const Vector3 scale			= random.Scale();
+		const Matrix a				= Test::Reference::Compose(translation, rotation, scale);
+		const Matrix b				= random.Transform();
+		const Vector3 point			= random.Position();
+
+		error_multiply	= max(error_multiply,	Error(a * b, Test::Reference::Multiply(a, b)));
+		error_transpose	= max(error_transpose,	Error(a.Transposed(), Test::Reference::Transpose(a)));
+		error_invert	= max(error_invert,		Error(a.Inverted(), Test::Reference::Invert(a)));
+		error_identity	= max(error_identity,	Error(a * a.Inverted(), Matrix::Identity) / (Magnitude(a) * Magnitude(a.Inverted())));
+		error_point		= max(error_point,		Error(point * a, Test::Reference::TransformPoint(a, point)) / Magnitude(a));
+		error_compose	= max(error_compose,	Error(Matrix(translation, rotation, scale), a));
+
+		const Quaternion rotation_other = random.Rotation();
+		error_quaternion = max(error_quaternion, Error(rotation * rotation_other, Test::Reference::Multiply(rotation, rotation_other)));
+
+		// Decomposition gives back what the matrix was composed from, the rotation up to its sign
+		Vector3 decomposed_scale, decomposed_translation;
+		Quaternion decomposed_rotation;
+		Matrix(a).Decompose(decomposed_scale, decomposed_rotation, decomposed_translation);
+		const float error_rotation = min(Error(decomposed_rotation, rotation), Error(decomposed_rotation, Quaternion(-rotation.x, -rotation.y, -rotation.z, -rotation.w)));
+		error_decompose = max(error_decompose, max(error_rotation, max(Error(decomposed_scale, scale), Error(decomposed_translation, translation))));
+	}
+
+	Report("Matrix * Matrix",		error_multiply,		1e-6f);
+	Report("Matrix::Transposed",	error_transpose,	0.0f);
+	Report("Matrix::Inverted",		error_invert,		1e-6f);
+	Report("Matrix * Inverse",		error_identity,		1e-6f);
+	Report("Vector3 * Matrix",		error_point,		1e-6f);
+	Report("Matrix(T, R, S)",		error_compose,		1e-6f);
+	Report("Quaternion products",	error_quaternion,	1e-6f);
+	Report("Matrix::Decompose",		error_decompose,	1e-5f);
+
+	return Test::Finish("Math");
+}
@@ -0,0 +1,176 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ==============
+#include <random>
+#include "Math/Matrix.h"
+#include "Math/Quaternion.h"
+#include "Math/Vector3.h"
+//=========================
+
+// The scalar formulas the math types used before their SIMD paths, the tests compare against them
+namespace Spartan::Test::Reference
+{
+	inline Math::Matrix Multiply(const Math::Matrix& lhs, const Math::Matrix& rhs)
+	{
+		return Math::Matrix(
+			lhs.m00 * rhs.m00 + lhs.m01 * rhs.m10 + lhs.m02 * rhs.m20 + lhs.m03 * rhs.m30,
+			lhs.m00 * rhs.m01 + lhs.m01 * rhs.m11 + lhs.m02 * rhs.m21 + lhs.m03 * rhs.m31,
+			lhs.m00 * rhs.m02 + lhs.m01 * rhs.m12 + lhs.m02 * rhs.m22 + lhs.m03 * rhs.m32,
+			lhs.m00 * rhs.m03 + lhs.m01 * rhs.m13 + lhs.m02 * rhs.m23 + lhs.m03 * rhs.m33,
+			lhs.m10 * rhs.m00 + lhs.m11 * rhs.m10 + lhs.m12 * rhs.m20 + lhs.m13 * rhs.m30,
+			lhs.m10 * rhs.m01 + lhs.m11 * rhs.m11 + lhs.m12 * rhs.m21 + lhs.m13 * rhs.m31,
+			lhs.m10 * rhs.m02 + lhs.m11 * rhs.m12 + lhs.m12 * rhs.m22 + lhs.m13 * rhs.m32,
+			lhs.m10 * rhs.m03 + lhs.m11 * rhs.m13 + lhs.m12 * rhs.m23 + lhs.m13 * rhs.m33,
+			lhs.m20 * rhs.m00 + lhs.m21 * rhs.m10 + lhs.m22 * rhs.m20 + lhs.m23 * rhs.m30,
+			lhs.m20 * rhs.m01 + lhs.m21 * rhs.m11 + lhs.m22 * rhs.m21 + lhs.m23 * rhs.m31,
+			lhs.m20 * rhs.m02 + lhs.m21 * rhs.m12 + lhs.m22 * rhs.m22 + lhs.m23 * rhs.m32,
+			lhs.m20 * rhs.m03 + lhs.m21 * rhs.m13 + lhs.m22 * rhs.m23 + lhs.m23 * rhs.m33,
+			lhs.m30 * rhs.m00 + lhs.m31 * rhs.m10 + lhs.m32 * rhs.m20 + lhs.m33 * rhs.m30,
+			lhs.m30 * rhs.m01 + lhs.m31 * rhs.m11 + lhs.m32 * rhs.m21 + lhs.m33 * rhs.m31,
+			lhs.m30 * rhs.m02 + lhs.m31 * rhs.m12 + lhs.m32 * rhs.m22 + lhs.m33 * rhs.m32,
+			lhs.m30 * rhs.m03 + lhs.m31 * rhs.m13 + lhs.m32 * rhs.m23 + lhs.m33 * rhs.m33
+		);
+	}
+
+	inline Math::Matrix Transpose(const Math::Matrix& matrix)
+	{
+		return Math::Matrix(
+			matrix.m00, matrix.m10, matrix.m20, matrix.m30,
+			matrix.m01, matrix.m11, matrix.m21, matrix.m31,
+			matrix.m02, matrix.m12, matrix.m22, matrix.m32,
+			matrix.m03, matrix.m13, matrix.m23, matrix.m33
+		);
+	}
+
+	inline Math::Matrix Invert(const Math::Matrix& matrix)
+	{
+		float v0 = matrix.m20 * matrix.m31 - matrix.m21 * matrix.m30;
+		float v1 = matrix.m20 * matrix.m32 - matrix.m22 * matrix.m30;
+		float v2 = matrix.m20 * matrix.m33 - matrix.m23 * matrix.m30;
+		float v3 = matrix.m21 * matrix.m32 - matrix.m22 * matrix.m31;
+		float v4 = matrix.m21 * matrix.m33 - matrix.m23 * matrix.m31;
+		float v5 = matrix.m22 * matrix.m33 - matrix.m23 * matrix.m32;
+
+		float i00 = (v5 * matrix.m11 - v4 * matrix.m12 + v3 * matrix.m13);
+		float i10 = -(v5 * matrix.m10 - v2 * matrix.m12 + v1 * matrix.m13);
+		float i20 = (v4 * matrix.m10 - v2 * matrix.m11 + v0 * matrix.m13);
+		float i30 = -(v3 * matrix.m10 - v1 * matrix.m11 + v0 * matrix.m12);
+
+		const float inv_det = 1.0f / (i00 * matrix.m00 + i10 * matrix.m01 + i20 * matrix.m02 + i30 * matrix.m03);
+
+		i00 *= inv_det;
+		i10 *= inv_det;
+		i20 *= inv_det;
+		i30 *= inv_det;
+
+		const float i01 = -(v5 * matrix.m01 - v4 * matrix.m02 + v3 * matrix.m03) * inv_det;
+		const float i11 = (v5 * matrix.m00 - v2 * matrix.m02 + v1 * matrix.m03) * inv_det;
+		const float i21 = -(v4 * matrix.m00 - v2 * matrix.m01 + v0 * matrix.m03) * inv_det;
+		const float i31 = (v3 * matrix.m00 - v1 * matrix.m01 + v0 * matrix.m02) * inv_det;
+
+		v0 = matrix.m10 * matrix.m31 - matrix.m11 * matrix.m30;
+		v1 = matrix.m10 * matrix.m32 - matrix.m12 * matrix.m30;
+		v2 = matrix.m10 * matrix.m33 - matrix.m13 * matrix.m30;
+		v3 = matrix.m11 * matrix.m32 - matrix.m12 * matrix.m31;
+		v4 = matrix.m11 * matrix.m33 - matrix.m13 * matrix.m31;
+		v5 = matrix.m12 * matrix.m33 - matrix.m13 * matrix.m32;
+
+		const float i02 = (v5 * matrix.m01 - v4 * matrix.m02 + v3 * matrix.m03) * inv_det;
+		const float i12 = -(v5 * matrix.m00 - v2 * matrix.m02 + v1 * matrix.m03) * inv_det;
+		const float i22 = (v4 * matrix.m00 - v2 * matrix.m01 + v0 * matrix.m03) * inv_det;
+		const float i32 = -(v3 * matrix.m00 - v1 * matrix.m01 + v0 * matrix.m02) * inv_det;
+
+		v0 = matrix.m21 * matrix.m10 - matrix.m20 * matrix.m11;
+		v1 = matrix.m22 * matrix.m10 - matrix.m20 * matrix.m12;
+		v2 = matrix.m23 * matrix.m10 - matrix.m20 * matrix.m13;
+		v3 = matrix.m22 * matrix.m11 - matrix.m21 * matrix.m12;
+		v4 = matrix.m23 * matrix.m11 - matrix.m21 * matrix.m13;
+		v5 = matrix.m23 * matrix.m12 - matrix.m22 * matrix.m13;
+
+		const float i03 = -(v5 * matrix.m01 - v4 * matrix.m02 + v3 * matrix.m03) * inv_det;
+		const float i13 = (v5 * matrix.m00 - v2 * matrix.m02 + v1 * matrix.m03) * inv_det;
+		const float i23 = -(v4 * matrix.m00 - v2 * matrix.m01 + v0 * matrix.m03) * inv_det;
+		const float i33 = (v3 * matrix.m00 - v1 * matrix.m01 + v0 * matrix.m02) * inv_det;
+
+		return Math::Matrix(
+			i00, i01, i02, i03,
+			i10, i11, i12, i13,
+			i20, i21, i22, i23,
+			i30, i31, i32, i33);
+	}
+
+	inline Math::Vector3 TransformPoint(const Math::Matrix& matrix, const Math::Vector3& point)
+	{
+		const float x = (point.x * matrix.m00) + (point.y * matrix.m10) + (point.z * matrix.m20) + matrix.m30;
+		const float y = (point.x * matrix.m01) + (point.y * matrix.m11) + (point.z * matrix.m21) + matrix.m31;
+		const float z = (point.x * matrix.m02) + (point.y * matrix.m12) + (point.z * matrix.m22) + matrix.m32;
+		const float w = 1 / ((point.x * matrix.m03) + (point.y * matrix.m13) + (point.z * matrix.m23) + matrix.m33);
+
+		return Math::Vector3(x * w, y * w, z * w);
+	}
+
+	inline Math::Matrix Compose(const Math::Vector3& translation, const Math::Quaternion& rotation, const Math::Vector3& scale)
+	{
+		const Math::Matrix r = Math::Matrix::CreateRotation(rotation);
+
+		return Math::Matrix(
+			scale.x * r.m00,	scale.x * r.m01,	scale.x * r.m02,	0.0f,
+			scale.y * r.m10,	scale.y * r.m11,	scale.y * r.m12,	0.0f,
+			scale.z * r.m20,	scale.z * r.m21,	scale.z * r.m22,	0.0f,
+			translation.x,		translation.y,		translation.z,		1.0f
+		);
+	}
+
+	inline Math::Quaternion Multiply(const Math::Quaternion& lhs, const Math::Quaternion& rhs)
+	{
+		const float num12	= (lhs.y * rhs.z) - (lhs.z * rhs.y);
+		const float num11	= (lhs.z * rhs.x) - (lhs.x * rhs.z);
+		const float num10	= (lhs.x * rhs.y) - (lhs.y * rhs.x);
+		const float num9	= ((lhs.x * rhs.x) + (lhs.y * rhs.y)) + (lhs.z * rhs.z);
+
+		return Math::Quaternion(
+			((lhs.x * rhs.w) + (rhs.x * lhs.w)) + num12,
+			((lhs.y * rhs.w) + (rhs.y * lhs.w)) + num11,
+			((lhs.z * rhs.w) + (rhs.z * lhs.w)) + num10,
+			(lhs.w * rhs.w) - num9
+		);
+	}
+
+	// Random transforms, the way scenes produce them
+	class Random
+	{
+	public:
+		Random(const unsigned int seed = 1) : m_engine(seed) {}
+
+		float Range(const float min, const float max) { return std::uniform_real_distribution<float>(min, max)(m_engine); }
+
+		Math::Vector3 Position()	{ return Math::Vector3(Range(-100.0f, 100.0f), Range(-100.0f, 100.0f), Range(-100.0f, 100.0f)); }
+		Math::Vector3 Scale()		{ return Math::Vector3(Range(0.5f, 2.0f), Range(0.5f, 2.0f), Range(0.5f, 2.0f)); }
+		Math::Quaternion Rotation()	{ return Math::Quaternion::FromAngleAxis(Range(-3.14f, 3.14f), Math::Vector3(Range(-1.0f, 1.0f), Range(-1.0f, 1.0f), Range(0.1f, 1.0f)).Normalized()); }
+		Math::Matrix Transform()	{ return Compose(Position(), Rotation(), Scale()); }
+
+	private:
+		std::mt19937 m_engine;
+	};
+}
@@ -0,0 +1,122 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES =====
+#include "Test.h"
+#include "Test_Math.h"
+#include <vector>
+//================
+
+//= NAMESPACES ===========
+using namespace std;
+using namespace Spartan;
+using namespace Spartan::Math;
+//========================
+
+namespace
+{
+	const unsigned int sample_count	= 4096;
+	const unsigned int repeat_count	= 64;
+
+	vector<Matrix> g_matrices;
+	vector<Quaternion> g_rotations;
+	vector<Vector3> g_points;
+
+	// Times an operation over every sample, returns nanoseconds per operation.
+	// The results are stored, so that the compiler has to compute all of their components.
+	template <typename Function>
+	float Measure(Function&& operation)
+	{
+		using result_type = decltype(operation(0u, 0u));
+		vector<result_type> results(sample_count);
+
+		const float ms = Test::Time([&operation, &results]()
+		{
+			for (unsigned int repeat = 0; repeat < repeat_count; repeat++)
+			{
+				for (unsigned int i = 0; i < sample_count; i++)
+				{
+					results[i] = operation(i, (i + repeat + 1) % sample_count);
+				}
+			}
+		});
+
+		return ms * 1000000.0f / (sample_count * repeat_count);
+	}
+
+	template <typename Engine, typename Scalar>
+	void Benchmark(const char* operation, Engine&& engine, Scalar&& scalar)
+	{
+		const float ns_engine	= Measure(engine);
+		const float ns_scalar	= Measure(scalar);
+		printf("%-20s engine %6.2f ns, scalar %6.2f ns (%.2fx)\n", operation, ns_engine, ns_scalar, ns_scalar / ns_engine);
+	}
+}
+
+// Every hot operation of the math types, against the scalar formulas they replaced
+int main()
+{
+	Test::Initialize();
+	Test::Reference::Random random;
+
+	for (unsigned int i = 0; i < sample_count; i++)
+	{
+		g_matrices.emplace_back(random.Transform());
+		g_rotations.emplace_back(random.Rotation());
+		g_points.emplace_back(random.Position());
+	}
+
+	Benchmark("Matrix * Matrix",
+		[](unsigned int a, unsigned int b) { return g_matrices[a] * g_matrices[b]; },
+		[](unsigned int a, unsigned int b) { return Test::Reference::Multiply(g_matrices[a], g_matrices[b]); });
+
+	Benchmark("Matrix::Inverted",
+		[](unsigned int a, unsigned int) { return g_matrices[a].Inverted(); },
+		[](unsigned int a, unsigned int) { return Test::Reference::Invert(g_matrices[a]); });
+
+	Benchmark("Matrix::Transposed",
+		[](unsigned int a, unsigned int) { return g_matrices[a].Transposed(); },
+		[](unsigned int a, unsigned int) { return Test::Reference::Transpose(g_matrices[a]); });
+
+	Benchmark("Vector3 * Matrix",
+		[](unsigned int a, unsigned int b) { return g_points[b] * g_matrices[a]; },
+		[](unsigned int a, unsigned int b) { return Test::Reference::TransformPoint(g_matrices[a], g_points[b]); });
+
+	Benchmark("Matrix(T, R, S)",
+		[](unsigned int a, unsigned int b) { return Matrix(g_points[a], g_rotations[b], g_points[b]); },
+		[](unsigned int a, unsigned int b) { return Test::Reference::Compose(g_points[a], g_rotations[b], g_points[b]); });
+
+	Benchmark("Quaternion products",
+		[](unsigned int a, unsigned int b) { return g_rotations[a] * g_rotations[b]; },
+		[](unsigned int a, unsigned int b) { return Test::Reference::Multiply(g_rotations[a], g_rotations[b]); });
+
+	// Decompose has no scalar counterpart left, it only saves extracting the scale twice
+	struct Decomposition { Vector3 scale; Quaternion rotation; Vector3 translation; };
+	const float ns_decompose = Measure([](unsigned int a, unsigned int)
+	{
+		Decomposition decomposition;
+		g_matrices[a].Decompose(decomposition.scale, decomposition.rotation, decomposition.translation);
+		return decomposition;
+	});
+	printf("%-20s engine %6.2f ns\n", "Matrix::Decompose", ns_decompose);
+
+	return Test::Finish("Math benchmark");
+}
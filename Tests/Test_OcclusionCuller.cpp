@@ -0,0 +1,87 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ===================================
+#include "Test.h"
+#include "Test_OcclusionCuller.h"
+#include "Rendering/Utilities/OcclusionCuller.h"
+#include "Threading/Threading.h"
+#include "Core/Settings.h"
+//==============================================
+
+//= NAMESPACES ===========
+using namespace std;
+using namespace Spartan;
+using namespace Spartan::Math;
+//========================
+
+// A camera at the origin looking down +Z at a 10x10 wall which is 10 units away
+int main()
+{
+	Test::Initialize();
+
+	const Test::Cube cube;
+	const Matrix view_projection	= Test::CameraViewProjection(Vector3::Zero, Vector3::Forward);
+	const Matrix wall				= Test::CubeWorld(Vector3(0.0f, 0.0f, 10.0f), Vector3(5.0f, 5.0f, 0.5f));
+
+	OcclusionCuller culler;
+
+	// Nothing is occluded without occluders
+	culler.Begin(view_projection);
+	culler.Rasterize();
+	TEST_CHECK(culler.GetOccluderCount() == 0);
+	TEST_CHECK(!culler.IsOccluded(Test::Box(Vector3(0.0f, 0.0f, 50.0f), Vector3(1.0f))));
+
+	culler.Begin(view_projection);
+	culler.AddOccluder(cube.vertices.data(), cube.indices.data(), cube.GetIndexCount(), wall);
+	culler.Rasterize();
+	TEST_CHECK(culler.GetOccluderCount() == 1);
+	TEST_CHECK(culler.GetTriangleCount() != 0);
+
+	// The front face of the wall is 9.5 units away, depth is 1 / w
+	const vector<float>& depth	= culler.GetDepth();
+	const float center			= depth[(culler.GetHeight() / 2) * culler.GetWidth() + culler.GetWidth() / 2];
+	TEST_CHECK(Helper::Abs(center - 1.0f / 9.5f) < 0.001f);
+
+	// Behind the wall
+	TEST_CHECK(culler.IsOccluded(Test::Box(Vector3(0.0f, 0.0f, 50.0f), Vector3(1.0f))));
+	TEST_CHECK(culler.IsOccluded(Test::Box(Vector3(5.0f, -3.0f, 20.0f), Vector3(2.0f))));
+	// In front of the wall, or intersecting it
+	TEST_CHECK(!culler.IsOccluded(Test::Box(Vector3(0.0f, 0.0f, 5.0f), Vector3(1.0f))));
+	TEST_CHECK(!culler.IsOccluded(Test::Box(Vector3(0.0f, 0.0f, 10.0f), Vector3(1.0f))));
+	// Behind the wall but sticking out beside it, or completely beside it
+	TEST_CHECK(!culler.IsOccluded(Test::Box(Vector3(15.0f, 0.0f, 30.0f), Vector3(2.0f))));
+	TEST_CHECK(!culler.IsOccluded(Test::Box(Vector3(40.0f, 0.0f, 60.0f), Vector3(2.0f))));
+	// Crossing the near plane, or behind the camera
+	TEST_CHECK(!culler.IsOccluded(Test::Box(Vector3(0.0f, 0.0f, 0.0f), Vector3(1.0f))));
+	TEST_CHECK(!culler.IsOccluded(Test::Box(Vector3(0.0f, 0.0f, -50.0f), Vector3(1.0f))));
+
+	// Rasterizing in jobs gives the same depth
+	const vector<float> depth_serial = depth;
+	Settings::Get().SetMaxThreadCount(4);
+	Threading threading(nullptr);
+	culler.Begin(view_projection);
+	culler.AddOccluder(cube.vertices.data(), cube.indices.data(), cube.GetIndexCount(), wall);
+	culler.Rasterize(&threading);
+	TEST_CHECK(culler.GetDepth() == depth_serial);
+
+	return Test::Finish("OcclusionCuller");
+}
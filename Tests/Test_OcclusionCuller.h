@@ -0,0 +1,93 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ================
+#include <vector>
+#include "Math/Matrix.h"
+#include "Math/Quaternion.h"
+#include "Math/BoundingBox.h"
+#include "RHI/RHI_Vertex.h"
+//===========================
+
+// Occluder meshes and a camera for the occlusion culling tests
+namespace Spartan::Test
+{
+	// A unit cube (from -1 to 1), each side split into subdivisions x subdivisions quads
+	class Cube
+	{
+	public:
+		Cube(const unsigned int subdivisions = 1)
+		{
+			const Math::Vector3 axes[3] = { Math::Vector3::Right, Math::Vector3::Up, Math::Vector3::Forward };
+			for (unsigned int axis = 0; axis < 3; axis++)
+			{
+				for (const float side : { -1.0f, 1.0f })
+				{
+					const Math::Vector3 normal	= axes[axis] * side;
+					const Math::Vector3 u		= axes[(axis + 1) % 3];
+					const Math::Vector3 v		= axes[(axis + 2) % 3] * side;
+					const auto first			= static_cast<unsigned int>(vertices.size());
+					for (unsigned int j = 0; j <= subdivisions; j++)
+					{
+						for (unsigned int i = 0; i <= subdivisions; i++)
+						{
+							const float s = 2.0f * i / subdivisions - 1.0f;
+							const float t = 2.0f * j / subdivisions - 1.0f;
+							vertices.emplace_back(normal + u * s + v * t, Math::Vector2::Zero, normal, u);
+						}
+					}
+					for (unsigned int j = 0; j < subdivisions; j++)
+					{
+						for (unsigned int i = 0; i < subdivisions; i++)
+						{
+							const unsigned int k = first + j * (subdivisions + 1) + i;
+							indices.insert(indices.end(), { k, k + subdivisions + 1, k + 1, k + 1, k + subdivisions + 1, k + subdivisions + 2 });
+						}
+					}
+				}
+			}
+		}
+
+		unsigned int GetIndexCount() const { return static_cast<unsigned int>(indices.size()); }
+
+		std::vector<RHI_Vertex_PosUvNorTan> vertices;
+		std::vector<unsigned int> indices;
+	};
+
+	// World matrix which turns the unit cube into the given box
+	inline Math::Matrix CubeWorld(const Math::Vector3& center, const Math::Vector3& extent)
+	{
+		return Math::Matrix(center, Math::Quaternion::Identity, extent);
+	}
+
+	// A camera at position looking at target, 16:9 with a 60 degree vertical field of view
+	inline Math::Matrix CameraViewProjection(const Math::Vector3& position, const Math::Vector3& target)
+	{
+		return Math::Matrix::CreateLookAtLH(position, target, Math::Vector3::Up) * Math::Matrix::CreatePerspectiveFieldOfViewLH(1.047f, 16.0f / 9.0f, 0.3f, 1000.0f);
+	}
+
+	inline Math::BoundingBox Box(const Math::Vector3& center, const Math::Vector3& extent)
+	{
+		return Math::BoundingBox(center - extent, center + extent);
+	}
+}
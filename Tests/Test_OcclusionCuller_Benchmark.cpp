@@ -0,0 +1,110 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ===================================
+#include "Test.h"
+#include "Test_OcclusionCuller.h"
+#include <random>
+#include "Rendering/Utilities/OcclusionCuller.h"
+#include "Threading/Threading.h"
+#include "Core/Settings.h"
+//==============================================
+
+//= NAMESPACES ===========
+using namespace std;
+using namespace Spartan;
+using namespace Spartan::Math;
+//========================
+
+// A street of 64 buildings (768 triangles each) in front of the camera, with 100k boxes scattered behind and between them
+int main()
+{
+	Test::Initialize();
+
+	const unsigned int building_count	= 64;
+	const unsigned int box_count		= 100000;
+
+	const Test::Cube cube(8);
+	const Matrix view_projection = Test::CameraViewProjection(Vector3(0.0f, 2.0f, 0.0f), Vector3(0.0f, 2.0f, 1.0f));
+
+	mt19937 engine(1);
+	uniform_real_distribution<float> side(-80.0f, 80.0f);
+	uniform_real_distribution<float> depth(10.0f, 300.0f);
+	uniform_real_distribution<float> size(2.0f, 12.0f);
+	vector<Matrix> buildings(building_count);
+	for (Matrix& building : buildings)
+	{
+		const Vector3 extent(size(engine), size(engine) * 2.0f, size(engine));
+		building = Test::CubeWorld(Vector3(side(engine), extent.y, depth(engine)), extent);
+	}
+	vector<BoundingBox> boxes(box_count);
+	for (BoundingBox& box : boxes)
+	{
+		box = Test::Box(Vector3(side(engine), size(engine), depth(engine) * 2.0f), Vector3(size(engine) * 0.1f));
+	}
+
+	OcclusionCuller culler;
+	const auto add_occluders = [&]()
+	{
+		culler.Begin(view_projection);
+		for (const Matrix& building : buildings)
+		{
+			culler.AddOccluder(cube.vertices.data(), cube.indices.data(), cube.GetIndexCount(), building);
+		}
+	};
+
+	const float time_serial = Test::Time([&]()
+	{
+		add_occluders();
+		culler.Rasterize();
+	});
+	const vector<float> depth_serial = culler.GetDepth();
+
+	Settings::Get().SetMaxThreadCount(thread::hardware_concurrency());
+	Threading threading(nullptr);
+	const float time_parallel = Test::Time([&]()
+	{
+		add_occluders();
+		culler.Rasterize(&threading);
+	});
+
+	unsigned int occluded = 0;
+	const float time_query = Test::Time([&]()
+	{
+		occluded = 0;
+		for (const BoundingBox& box : boxes)
+		{
+			occluded += culler.IsOccluded(box) ? 1 : 0;
+		}
+	});
+
+	printf("%u occluders, %u triangles after setup\n", culler.GetOccluderCount(), culler.GetTriangleCount());
+	printf("%u of %u boxes occluded\n", occluded, box_count);
+	printf("Rasterize                %8.3f ms\n", time_serial);
+	printf("Rasterize (%2u threads)   %8.3f ms\n", threading.GetThreadCount() + 1, time_parallel);
+	printf("IsOccluded               %8.2f ns/box\n", time_query * 1000000.0f / box_count);
+
+	// The buildings hide some of the boxes but not all of them, and the jobs rasterize the same depth
+	TEST_CHECK(occluded != 0 && occluded != box_count);
+	TEST_CHECK(culler.GetDepth() == depth_serial);
+
+	return Test::Finish("Occlusion culling");
+}
@@ -0,0 +1,170 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ===========================
+#include "Test.h"
+#include <vector>
+#include <random>
+#include <algorithm>
+#include "Core/Context.h"
+#include "Core/PoolAllocator.h"
+#include "World/Entity.h"
+#include "World/Components/Transform.h"
+#include "World/Components/Renderable.h"
+//======================================
+
+//= NAMESPACES =====
+using namespace std;
+using namespace Spartan;
+//==================
+
+namespace
+{
+	const unsigned int entity_count = 100000;
+
+	// An entity and the components the renderer reads every frame
+	struct Object
+	{
+		shared_ptr<Entity> entity;
+		shared_ptr<Transform> transform;
+		shared_ptr<Renderable> renderable;
+	};
+
+	// How World::EntityCreate and Entity::AddComponent allocate, from the pools
+	struct Pooled
+	{
+		template <typename T, typename... Args>
+		static shared_ptr<T> Create(Args&&... args) { return allocate_shared<T>(PoolAllocator<T>(), forward<Args>(args)...); }
+	};
+
+	// How they allocated before, every object on its own from the heap
+	struct Heap
+	{
+		template <typename T, typename... Args>
+		static shared_ptr<T> Create(Args&&... args) { return make_shared<T>(forward<Args>(args)...); }
+	};
+
+	template <typename Allocation>
+	Object CreateObject(Context* context, const unsigned int index)
+	{
+		Object object;
+		object.entity		= Allocation::template Create<Entity>(context);
+		object.transform	= Allocation::template Create<Transform>(context, object.entity.get(), nullptr);
+		object.renderable	= Allocation::template Create<Renderable>(context, object.entity.get(), object.transform.get());
+		object.transform->SetPositionLocal(Math::Vector3(static_cast<float>(index % 100), static_cast<float>(index / 100), 0.0f));
+		return object;
+	}
+
+	// What the renderer does per entity, reads the world matrix and the draw parameters
+	float Iterate(const vector<Object>& objects)
+	{
+		float sum = 0.0f;
+		for (const auto& object : objects)
+		{
+			sum += object.transform->GetMatrix().m30 + static_cast<float>(object.renderable->GetCastShadows());
+		}
+		return sum;
+	}
+
+	template <typename Allocation>
+	void Run(const char* name, Context* context, float& iteration_sum)
+	{
+		vector<Object> objects;
+		objects.reserve(entity_count);
+
+		// Create and destroy every entity, the pools keep their slabs so only the first run touches the heap for them
+		const float time_churn = Test::Time([&]()
+		{
+			for (unsigned int i = 0; i < entity_count; i++)
+			{
+				objects.emplace_back(CreateObject<Allocation>(context, i));
+			}
+			objects.clear();
+		});
+
+		// A world which has been played for a while, a random half of it got destroyed and created again
+		for (unsigned int i = 0; i < entity_count; i++)
+		{
+			objects.emplace_back(CreateObject<Allocation>(context, i));
+		}
+		vector<unsigned int> order(entity_count);
+		for (unsigned int i = 0; i < entity_count; i++)
+		{
+			order[i] = i;
+		}
+		shuffle(order.begin(), order.end(), mt19937(7));
+		for (unsigned int i = 0; i < entity_count / 2; i++)
+		{
+			objects[order[i]] = Object();
+		}
+		for (unsigned int i = 0; i < entity_count / 2; i++)
+		{
+			objects[order[i]] = CreateObject<Allocation>(context, order[i]);
+		}
+
+		float sum = 0.0f;
+		const float time_iterate = Test::Time([&]() { sum = Iterate(objects); }, 20);
+		iteration_sum = sum;
+
+		printf("%-6s create/destroy %7.2f ms (%6.1f ns per entity)   iterate %6.3f ms per frame\n",
+			name, time_churn, time_churn * 1e6f / entity_count, time_iterate);
+	}
+}
+
+// Create/destroy throughput and per-frame iteration of 100k entities, pooled against heap allocated
+int main()
+{
+	Test::Initialize();
+	auto context = make_shared<Context>();
+
+	// A destroyed object's slot is the next one handed out
+	{
+		auto first			= Pooled::Create<Transform>(context.get(), nullptr, nullptr);
+		const auto* address	= first.get();
+		first.reset();
+		auto second			= Pooled::Create<Transform>(context.get(), nullptr, nullptr);
+		TEST_CHECK(second.get() == address);
+	}
+
+	// The allocation alone, without constructing anything, a slot per entity-sized object
+	{
+		vector<void*> slots(entity_count);
+		const float time_pool = Test::Time([&]()
+		{
+			for (auto& slot : slots) slot = Pool<Transform>::Get().Allocate();
+			for (auto& slot : slots) Pool<Transform>::Get().Free(static_cast<Transform*>(slot));
+		});
+		const float time_heap = Test::Time([&]()
+		{
+			for (auto& slot : slots) slot = ::operator new(sizeof(Transform));
+			for (auto& slot : slots) ::operator delete(slot);
+		});
+		printf("allocate/free of %u objects   heap %6.3f ms   pooled %6.3f ms\n", entity_count, time_heap, time_pool);
+	}
+
+	float sum_heap		= 0.0f;
+	float sum_pooled	= 0.0f;
+	Run<Heap>("heap", context.get(), sum_heap);
+	Run<Pooled>("pooled", context.get(), sum_pooled);
+	TEST_CHECK(sum_heap == sum_pooled);
+
+	return Test::Finish("Pool benchmark");
+}
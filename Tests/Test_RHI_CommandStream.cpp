@@ -0,0 +1,185 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ======================
+#include "Test.h"
+#include "Test_RHI_CommandStream.h"
+//=================================
+
+//= NAMESPACES =====
+using namespace std;
+using namespace Spartan;
+//==================
+
+namespace
+{
+	vector<vector<uint64_t>> ReplayLog(const RHI_CommandStream& stream)
+	{
+		Test::LoggingSink sink;
+		stream.Replay(sink);
+		return sink.commands;
+	}
+
+	uint8_t objects[16];
+	void* Object(const unsigned int index) { return &objects[index]; }
+}
+
+// Commands replay as recorded, and binds which wouldn't change the state are dropped
+int main()
+{
+	Test::Initialize();
+
+	RHI_CommandStream stream;
+
+	// Every kind of command replays with its payload
+	{
+		void* targets[2]				= { Object(0), Object(1) };
+		const float color[4]			= { 0.0f, 0.5f, 1.0f, 1.0f };
+		const RHI_Cmd::Viewport viewport	= { 0.0f, 0.0f, 640.0f, 480.0f, 0.0f, 1.0f };
+		stream.Begin("Pass");
+		stream.SetRenderTargets(targets, 2, Object(2));
+		stream.ClearRenderTarget(Object(0), color);
+		stream.ClearDepthStencil(Object(2), 1, 1.0f, 0);
+		stream.SetViewport(viewport);
+		stream.SetScissorRectangle({ 0.0f, 0.0f, 64.0f, 64.0f });
+		stream.SetPrimitiveTopology(PrimitiveTopology_TriangleList);
+		stream.SetState(RHI_Cmd_SetVertexShader, Object(3), Object(4));
+		stream.Draw(3);
+		stream.DrawIndexed(36, 6, 2);
+		stream.DrawIndexedInstanced(36, 10, 6, 2, 1);
+		stream.End();
+
+		const auto log = ReplayLog(stream);
+		TEST_CHECK(stream.GetCommandCount() == 12);
+		TEST_CHECK(log.size() == 12);
+		TEST_CHECK(log[1] == vector<uint64_t>({ RHI_Cmd_SetRenderTargets, reinterpret_cast<uintptr_t>(Object(2)), reinterpret_cast<uintptr_t>(Object(0)), reinterpret_cast<uintptr_t>(Object(1)) }));
+		TEST_CHECK(log[7] == vector<uint64_t>({ RHI_Cmd_SetVertexShader, reinterpret_cast<uintptr_t>(Object(3)), reinterpret_cast<uintptr_t>(Object(4)) }));
+		TEST_CHECK(log[9] == vector<uint64_t>({ RHI_Cmd_DrawIndexed, 36, 6, 2 }));
+		TEST_CHECK(log[10] == vector<uint64_t>({ RHI_Cmd_DrawIndexedInstanced, 36, 10, 6, 2, 1 }));
+		TEST_CHECK(stream.GetSize() % 8 == 0);
+	}
+
+	// Redundant state
+	{
+		stream.Clear();
+		TEST_CHECK(stream.GetCommandCount() == 0 && stream.GetBindsEliminated() == 0);
+
+		const RHI_Cmd::Viewport viewport = { 0.0f, 0.0f, 640.0f, 480.0f, 0.0f, 1.0f };
+		stream.SetViewport(viewport);
+		stream.SetViewport(viewport);														// dropped
+		stream.SetPrimitiveTopology(PrimitiveTopology_TriangleList);
+		stream.SetPrimitiveTopology(PrimitiveTopology_TriangleList);						// dropped
+		stream.SetState(RHI_Cmd_SetBlendState, Object(0), Object(0));
+		stream.SetState(RHI_Cmd_SetBlendState, Object(0), Object(0));						// dropped
+		stream.SetState(RHI_Cmd_SetBlendState, Object(0), Object(1));						// same wrapper, new API object
+		stream.SetState(RHI_Cmd_SetRasterizerState, Object(0), Object(1));					// same object, other state
+		TEST_CHECK(stream.GetCommandCount() == 5);
+		TEST_CHECK(stream.GetBindsEliminated() == 3);
+	}
+
+	// Constant buffers compare the range, global binds cover both stages
+	{
+		stream.Clear();
+		void* buffer = Object(0);
+		stream.SetConstantBuffers(0, Buffer_Global, &buffer, 1, 256, 256);
+		stream.SetConstantBuffers(0, Buffer_PixelShader, &buffer, 1, 256, 256);			// dropped
+		stream.SetConstantBuffers(0, Buffer_VertexShader, &buffer, 1, 256, 256);			// dropped
+		stream.SetConstantBuffers(0, Buffer_Global, &buffer, 1, 512, 256);					// other range
+		stream.SetConstantBuffers(1, Buffer_PixelShader, &buffer, 1, 512, 256);			// other slot
+		stream.SetConstantBuffers(1, Buffer_Global, &buffer, 1, 512, 256);					// the vertex stage doesn't have it
+		TEST_CHECK(stream.GetCommandCount() == 4);
+		TEST_CHECK(stream.GetBindsEliminated() == 2);
+	}
+
+	// Samplers and textures only bind the slots which change
+	{
+		stream.Clear();
+		void* samplers[3]	= { Object(0), Object(1), Object(2) };
+		void* changed[3]	= { Object(0), Object(3), Object(2) };
+		stream.SetSamplers(0, samplers, 3);
+		stream.SetSamplers(0, changed, 3);
+		stream.SetSamplers(0, changed, 3);													// dropped
+
+		void* textures[4]	= { Object(4), Object(5), nullptr, nullptr };
+		void* cleared[4]	= { nullptr, nullptr, nullptr, nullptr };
+		stream.SetTextures(0, Buffer_PixelShader, textures, 4);
+		stream.SetTextures(0, Buffer_PixelShader, cleared, 4);								// only the first two slots
+		stream.SetTextures(0, Buffer_PixelShader, cleared, 4);								// dropped
+
+		const auto log = ReplayLog(stream);
+		TEST_CHECK(log.size() == 4);
+		TEST_CHECK(log[1] == vector<uint64_t>({ RHI_Cmd_SetSamplers, 1, reinterpret_cast<uintptr_t>(Object(3)) }));
+		TEST_CHECK(log[3] == vector<uint64_t>({ RHI_Cmd_SetTextures, 0, Buffer_PixelShader, 0, 0 }));
+		TEST_CHECK(stream.GetBindsEliminated() == 2);
+
+		// Binding render targets unbinds the textures which are now outputs, so textures are bound again
+		void* target = Object(4);
+		stream.SetRenderTargets(&target, 1, nullptr);
+		stream.SetRenderTargets(&target, 1, nullptr);										// dropped
+		stream.SetTextures(0, Buffer_PixelShader, cleared, 4);
+		TEST_CHECK(stream.GetCommandCount() == 6);
+		TEST_CHECK(stream.GetBindsEliminated() == 3);
+	}
+
+	// Clearing forgets the state, other code may have touched the device in between
+	{
+		stream.Clear();
+		stream.SetState(RHI_Cmd_SetBlendState, Object(0), Object(0));
+		stream.Clear();
+		stream.SetState(RHI_Cmd_SetBlendState, Object(0), Object(0));
+		TEST_CHECK(stream.GetCommandCount() == 1);
+		TEST_CHECK(stream.GetBindsEliminated() == 0);
+	}
+
+	// Appending drops what the other stream couldn't know was redundant
+	{
+		stream.Clear();
+		RHI_CommandStream other;
+		stream.SetState(RHI_Cmd_SetBlendState, Object(0), Object(0));
+		other.SetState(RHI_Cmd_SetBlendState, Object(0), Object(0));
+		other.SetState(RHI_Cmd_SetBlendState, Object(0), Object(0));
+		other.Draw(3);
+		TEST_CHECK(other.GetCommandCount() == 2 && other.GetBindsEliminated() == 1);
+		stream.Append(other);
+		TEST_CHECK(stream.GetCommandCount() == 2);
+		TEST_CHECK(stream.GetBindsEliminated() == 2);
+	}
+
+	// A G-buffer pass, every bind is either recorded or counted as dropped
+	{
+		stream.Clear();
+		Test::Pass pass;
+		pass.Record(stream, 0, 1000);
+
+		Test::CountingSink sink;
+		stream.Replay(sink);
+		unsigned int binds = 0;
+		for (unsigned int type = RHI_Cmd_SetViewport; type < RHI_Cmd_ClearRenderTarget; type++)
+		{
+			binds += sink.counts[type];
+		}
+		TEST_CHECK(sink.counts[RHI_Cmd_DrawIndexed] == 1000);
+		TEST_CHECK(binds + stream.GetBindsEliminated() == pass.binds_requested);
+		TEST_CHECK(stream.GetBindsEliminated() > pass.binds_requested / 2);
+	}
+
+	return Test::Finish("RHI_CommandStream");
+}
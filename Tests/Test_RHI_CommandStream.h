@@ -0,0 +1,166 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES =====================
+#include <vector>
+#include <atomic>
+#include <cstring>
+#include <initializer_list>
+#include "RHI/RHI_CommandStream.h"
+//================================
+
+// Sinks to replay command streams into, and a synthetic pass to record
+namespace Spartan::Test
+{
+	// Counts the commands a stream replays, and folds their payloads into a checksum so that replaying can't be optimized away
+	struct CountingSink
+	{
+		void Begin(const RHI_Cmd::Begin& cmd)								{ Count(RHI_Cmd_Begin, reinterpret_cast<uintptr_t>(cmd.name)); }
+		void End()															{ Count(RHI_Cmd_End, 0); }
+		void Draw(const RHI_Cmd::Draw& cmd)									{ Count(RHI_Cmd_Draw, cmd.vertex_count); }
+		void DrawIndexed(const RHI_Cmd::DrawIndexed& cmd)					{ Count(RHI_Cmd_DrawIndexed, cmd.index_count + cmd.index_offset + cmd.vertex_offset); }
+		void DrawIndexedInstanced(const RHI_Cmd::DrawIndexedInstanced& cmd)	{ Count(RHI_Cmd_DrawIndexedInstanced, cmd.index_count + cmd.instance_count); }
+		void SetViewport(const RHI_Cmd::Viewport& cmd)						{ Count(RHI_Cmd_SetViewport, static_cast<uint64_t>(cmd.width)); }
+		void SetScissorRectangle(const RHI_Cmd::ScissorRectangle& cmd)		{ Count(RHI_Cmd_SetScissorRectangle, static_cast<uint64_t>(cmd.width)); }
+		void SetPrimitiveTopology(const RHI_Cmd::PrimitiveTopology& cmd)	{ Count(RHI_Cmd_SetPrimitiveTopology, cmd.mode); }
+		void SetState(const RHI_Cmd_Type type, const RHI_Cmd::State& cmd)	{ Count(type, reinterpret_cast<uintptr_t>(cmd.object)); }
+		void SetConstantBuffers(const RHI_Cmd::Bindings& cmd)				{ Count(RHI_Cmd_SetConstantBuffers, reinterpret_cast<uintptr_t>(cmd.Objects()[0]) + cmd.offset); }
+		void SetSamplers(const RHI_Cmd::Bindings& cmd)						{ Count(RHI_Cmd_SetSamplers, reinterpret_cast<uintptr_t>(cmd.Objects()[0])); }
+		void SetTextures(const RHI_Cmd::Bindings& cmd)						{ Count(RHI_Cmd_SetTextures, reinterpret_cast<uintptr_t>(cmd.Objects()[0])); }
+		void SetRenderTargets(const RHI_Cmd::RenderTargets& cmd)			{ Count(RHI_Cmd_SetRenderTargets, reinterpret_cast<uintptr_t>(cmd.depth_stencil)); }
+		void ClearRenderTarget(const RHI_Cmd::ClearRenderTarget& cmd)		{ Count(RHI_Cmd_ClearRenderTarget, reinterpret_cast<uintptr_t>(cmd.render_target)); }
+		void ClearDepthStencil(const RHI_Cmd::ClearDepthStencil& cmd)		{ Count(RHI_Cmd_ClearDepthStencil, reinterpret_cast<uintptr_t>(cmd.depth_stencil)); }
+
+		void Count(const RHI_Cmd_Type type, const uint64_t value)
+		{
+			counts[type]++;
+			checksum = checksum * 31 + value;
+		}
+
+		unsigned int counts[RHI_Cmd_Count] = {};
+		uint64_t checksum = 0;
+	};
+
+	// Writes down every command a stream replays along with its payload, streams which log the same did the same
+	struct LoggingSink
+	{
+		void Begin(const RHI_Cmd::Begin& cmd)								{ Log({ RHI_Cmd_Begin, reinterpret_cast<uintptr_t>(cmd.name) }); }
+		void End()															{ Log({ RHI_Cmd_End }); }
+		void Draw(const RHI_Cmd::Draw& cmd)									{ Log({ RHI_Cmd_Draw, cmd.vertex_count }); }
+		void DrawIndexed(const RHI_Cmd::DrawIndexed& cmd)					{ Log({ RHI_Cmd_DrawIndexed, cmd.index_count, cmd.index_offset, cmd.vertex_offset }); }
+		void DrawIndexedInstanced(const RHI_Cmd::DrawIndexedInstanced& cmd)	{ Log({ RHI_Cmd_DrawIndexedInstanced, cmd.index_count, cmd.instance_count, cmd.index_offset, cmd.vertex_offset, cmd.instance_offset }); }
+		void SetViewport(const RHI_Cmd::Viewport& cmd)						{ Log({ RHI_Cmd_SetViewport, Bits(cmd.x), Bits(cmd.y), Bits(cmd.width), Bits(cmd.height), Bits(cmd.depth_min), Bits(cmd.depth_max) }); }
+		void SetScissorRectangle(const RHI_Cmd::ScissorRectangle& cmd)		{ Log({ RHI_Cmd_SetScissorRectangle, Bits(cmd.x), Bits(cmd.y), Bits(cmd.width), Bits(cmd.height) }); }
+		void SetPrimitiveTopology(const RHI_Cmd::PrimitiveTopology& cmd)	{ Log({ RHI_Cmd_SetPrimitiveTopology, static_cast<uint64_t>(cmd.mode) }); }
+		void SetState(const RHI_Cmd_Type type, const RHI_Cmd::State& cmd)	{ Log({ type, reinterpret_cast<uintptr_t>(cmd.object), reinterpret_cast<uintptr_t>(cmd.identity) }); }
+		void SetConstantBuffers(const RHI_Cmd::Bindings& cmd)				{ Log({ RHI_Cmd_SetConstantBuffers, cmd.start_slot, static_cast<uint64_t>(cmd.scope), cmd.offset, cmd.size }, cmd); }
+		void SetSamplers(const RHI_Cmd::Bindings& cmd)						{ Log({ RHI_Cmd_SetSamplers, cmd.start_slot }, cmd); }
+		void SetTextures(const RHI_Cmd::Bindings& cmd)						{ Log({ RHI_Cmd_SetTextures, cmd.start_slot, static_cast<uint64_t>(cmd.scope) }, cmd); }
+		void SetRenderTargets(const RHI_Cmd::RenderTargets& cmd)
+		{
+			Log({ RHI_Cmd_SetRenderTargets, reinterpret_cast<uintptr_t>(cmd.depth_stencil) });
+			Objects(cmd.Objects(), cmd.count);
+		}
+		void ClearRenderTarget(const RHI_Cmd::ClearRenderTarget& cmd)		{ Log({ RHI_Cmd_ClearRenderTarget, reinterpret_cast<uintptr_t>(cmd.render_target), Bits(cmd.color[0]), Bits(cmd.color[1]), Bits(cmd.color[2]), Bits(cmd.color[3]) }); }
+		void ClearDepthStencil(const RHI_Cmd::ClearDepthStencil& cmd)		{ Log({ RHI_Cmd_ClearDepthStencil, reinterpret_cast<uintptr_t>(cmd.depth_stencil), cmd.flags, Bits(cmd.depth), cmd.stencil }); }
+
+		void Log(const std::initializer_list<uint64_t> values)
+		{
+			commands.emplace_back(values);
+		}
+
+		void Log(const std::initializer_list<uint64_t> values, const RHI_Cmd::Bindings& cmd)
+		{
+			Log(values);
+			Objects(cmd.Objects(), cmd.count);
+		}
+
+		void Objects(void* const* objects, const uint32_t count)
+		{
+			for (uint32_t i = 0; i < count; i++)
+			{
+				commands.back().emplace_back(reinterpret_cast<uintptr_t>(objects[i]));
+			}
+		}
+
+		static uint64_t Bits(const float value)
+		{
+			uint32_t bits;
+			memcpy(&bits, &value, sizeof(bits));
+			return bits;
+		}
+
+		std::vector<std::vector<uint64_t>> commands;
+	};
+
+	// What a G-buffer pass records, draws sorted by material with a few meshes each. The API objects are
+	// stand-ins, only their addresses are recorded.
+	class Pass
+	{
+	public:
+		// Binds the state of the pass and records draws start to end, like a range of the pass recorded on its own would
+		void Record(RHI_CommandStream& stream, const unsigned int start, const unsigned int end)
+		{
+			void* render_targets[3]			= { Object(0), Object(1), Object(2) };
+			void* samplers[2]				= { Object(3), Object(4) };
+			void* global_buffer				= Object(5);
+			void* object_buffer				= Object(6);
+			const RHI_Cmd::Viewport viewport = { 0.0f, 0.0f, 1920.0f, 1080.0f, 0.0f, 1.0f };
+
+			stream.SetRenderTargets(render_targets, 3, Object(7));
+			stream.SetViewport(viewport);
+			stream.SetPrimitiveTopology(PrimitiveTopology_TriangleList);
+			stream.SetState(RHI_Cmd_SetDepthStencilState, Object(8), Object(8));
+			stream.SetState(RHI_Cmd_SetRasterizerState, Object(9), Object(9));
+			stream.SetState(RHI_Cmd_SetBlendState, Object(10), Object(10));
+			stream.SetState(RHI_Cmd_SetInputLayout, Object(11), Object(11));
+			stream.SetState(RHI_Cmd_SetVertexShader, Object(12), Object(12));
+			stream.SetSamplers(0, samplers, 2);
+			stream.SetConstantBuffers(0, Buffer_Global, &global_buffer, 1);
+			binds_requested += 10;
+
+			for (unsigned int i = start; i < end; i++)
+			{
+				const unsigned int material	= (i / 40) % 64;
+				const unsigned int mesh		= (i / 4) % 100;
+				void* textures[4]			= { Object(16 + material * 4), Object(17 + material * 4), Object(18 + material * 4), Object(19 + material * 4) };
+
+				stream.SetState(RHI_Cmd_SetPixelShader, Object(13 + material % 3), Object(13 + material % 3));
+				stream.SetTextures(0, Buffer_PixelShader, textures, 4);
+				stream.SetState(RHI_Cmd_SetVertexBuffer, Object(272 + mesh), Object(272 + mesh));
+				stream.SetState(RHI_Cmd_SetIndexBuffer, Object(372 + mesh), Object(372 + mesh));
+				stream.SetConstantBuffers(1, Buffer_Global, &object_buffer, 1, i * 256, 256);
+				stream.DrawIndexed(36 * (mesh + 1), 0, 0);
+				binds_requested += 5;
+			}
+		}
+
+		// Set*() calls made so far, whether they were dropped or not, ranges may be recorded concurrently
+		std::atomic<unsigned int> binds_requested = 0;
+
+	private:
+		void* Object(const unsigned int index) { return &m_objects[index]; }
+
+		uint8_t m_objects[512] = {};
+	};
+}
@@ -0,0 +1,68 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ======================
+#include "Test.h"
+#include "Test_RHI_CommandStream.h"
+//=================================
+
+//= NAMESPACES =====
+using namespace std;
+using namespace Spartan;
+//==================
+
+// Records G-buffer passes of 1k to 100k draws and replays them into a sink which only counts
+int main()
+{
+	Test::Initialize();
+
+	RHI_CommandStream stream;
+	for (const unsigned int draw_count : { 1000u, 10000u, 100000u })
+	{
+		Test::Pass pass;
+		const float time_record = Test::Time([&]()
+		{
+			pass.binds_requested = 0;
+			stream.Clear();
+			stream.Begin("Pass_GBuffer");
+			pass.Record(stream, 0, draw_count);
+			stream.End();
+		});
+
+		Test::CountingSink sink;
+		const float time_replay = Test::Time([&]()
+		{
+			sink = Test::CountingSink();
+			stream.Replay(sink);
+		});
+
+		const unsigned int binds_requested	= pass.binds_requested;
+		const unsigned int commands			= stream.GetCommandCount();
+		printf("%6u draws: %7u commands, %8u bytes (%4.1f per command), %7u of %7u binds dropped\n", draw_count, commands, stream.GetSize(), static_cast<float>(stream.GetSize()) / commands, stream.GetBindsEliminated(), binds_requested);
+		printf("              record %6.2f ns/draw, replay %6.2f ns/draw\n", time_record * 1000000.0f / draw_count, time_replay * 1000000.0f / draw_count);
+
+		TEST_CHECK(sink.counts[RHI_Cmd_DrawIndexed] == draw_count);
+		TEST_CHECK(sink.checksum != 0);
+		TEST_CHECK(commands + stream.GetBindsEliminated() == binds_requested + draw_count + 2);
+	}
+
+	return Test::Finish("RHI_CommandStream");
+}
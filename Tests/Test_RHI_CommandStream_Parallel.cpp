@@ -0,0 +1,96 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ======================
+#include "Test.h"
+#include "Test_RHI_CommandStream.h"
+#include "Threading/Threading.h"
+#include "Core/Settings.h"
+//=================================
+
+//= NAMESPACES =====
+using namespace std;
+using namespace Spartan;
+//==================
+
+namespace
+{
+	vector<vector<uint64_t>> ReplayLog(const RHI_CommandStream& stream)
+	{
+		Test::LoggingSink sink;
+		stream.Replay(sink);
+		return sink.commands;
+	}
+}
+
+// A pass recorded in ranges on worker threads, each into its own stream, and appended in order,
+// replays exactly the commands the same pass recorded serially does
+int main()
+{
+	Test::Initialize();
+
+	Settings::Get().SetMaxThreadCount(8);
+	Threading threading(nullptr);
+
+	// Odd, so the ranges split the draws of a material
+	const unsigned int draw_count = 10007;
+
+	Test::Pass pass;
+	RHI_CommandStream serial;
+	serial.Begin("Pass_GBuffer");
+	pass.Record(serial, 0, draw_count);
+	serial.End();
+	const auto log_serial = ReplayLog(serial);
+
+	RHI_CommandStream merged;
+	vector<RHI_CommandStream> ranges(8);
+	for (const unsigned int range_count : { 2u, 3u, 5u, 8u })
+	{
+		// Twice, the streams are reused from frame to frame
+		for (unsigned int frame = 0; frame < 2; frame++)
+		{
+			threading.ParallelFor(range_count, [&pass, &ranges, draw_count, range_count](const unsigned int range_start, const unsigned int range_end)
+			{
+				for (unsigned int i = range_start; i < range_end; i++)
+				{
+					const auto start	= static_cast<unsigned int>((static_cast<uint64_t>(draw_count) * i) / range_count);
+					const auto end		= static_cast<unsigned int>((static_cast<uint64_t>(draw_count) * (i + 1)) / range_count);
+					ranges[i].Clear();
+					pass.Record(ranges[i], start, end);
+				}
+			}, 1, Job_Critical);
+
+			merged.Clear();
+			merged.Begin("Pass_GBuffer");
+			for (unsigned int i = 0; i < range_count; i++)
+			{
+				merged.Append(ranges[i]);
+			}
+			merged.End();
+
+			TEST_CHECK(merged.GetCommandCount() == serial.GetCommandCount());
+			TEST_CHECK(merged.GetSize() == serial.GetSize());
+			TEST_CHECK(ReplayLog(merged) == log_serial);
+		}
+	}
+
+	return Test::Finish("RHI_CommandStream (parallel recording)");
+}
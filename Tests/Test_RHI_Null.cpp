@@ -0,0 +1,172 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES =========================
+#include "Test.h"
+#include "RHI/RHI_Implementation.h"
+#include "RHI/RHI_Device.h"
+#include "RHI/RHI_CommandList.h"
+#include "RHI/RHI_BlendState.h"
+#include "RHI/RHI_DepthStencilState.h"
+#include "RHI/RHI_RasterizerState.h"
+#include "RHI/RHI_Sampler.h"
+#include "RHI/RHI_Shader.h"
+#include "RHI/RHI_InputLayout.h"
+#include "RHI/RHI_VertexBuffer.h"
+#include "RHI/RHI_IndexBuffer.h"
+#include "RHI/RHI_ConstantBuffer.h"
+#include "RHI/RHI_RenderTexture.h"
+#include "RHI/RHI_SwapChain.h"
+#include "RHI/RHI_Vertex.h"
+#include "Profiling/Profiler.h"
+//====================================
+
+//= NAMESPACES =====
+using namespace std;
+using namespace Spartan;
+//==================
+
+// The null device validates what D3D11 would reject, invalid usage has to show up as errors
+int main()
+{
+	auto& logger = Test::Initialize();
+
+	auto device = make_shared<RHI_Device>();
+	TEST_CHECK(device->IsInitialized());
+	RHI_Context* context = device->GetContext();
+
+	{
+		auto blend		= make_shared<RHI_BlendState>(device);
+		auto depth		= make_shared<RHI_DepthStencilState>(device, true, Comparison_Less);
+		auto rasterizer	= make_shared<RHI_RasterizerState>(device, Cull_Back, Fill_Solid, true, false, false, false);
+		auto sampler	= make_shared<RHI_Sampler>(device, Texture_Filter_Bilinear, Sampler_Address_Wrap, Comparison_Always);
+
+		// Shaders compile from source, files which don't exist fail
+		auto shader = make_shared<RHI_Shader>(device);
+		shader->Compile(Shader_VertexPixel, "float4 mainVS() {} float4 mainPS() {}", Vertex_Attributes_PositionTextureNormalTangent);
+		TEST_CHECK(shader->GetCompilationState() == Shader_Compiled);
+		auto shader_missing = make_shared<RHI_Shader>(device);
+		TEST_CHECK_ERRORS(logger, 2, shader_missing->Compile(Shader_Vertex, "missing.hlsl"));
+
+		// Resources and the memory they would occupy
+		auto vertex_buffer = make_shared<RHI_VertexBuffer>(device);
+		vector<RHI_Vertex_PosUvNorTan> vertices(100);
+		TEST_CHECK(vertex_buffer->Create(vertices));
+		auto index_buffer = make_shared<RHI_IndexBuffer>(device);
+		vector<uint32_t> indices(300);
+		TEST_CHECK(index_buffer->Create(indices));
+		auto constant_buffer = make_shared<RHI_ConstantBuffer>(device);
+		TEST_CHECK(constant_buffer->Create(4096));
+		auto render_target	= make_shared<RHI_RenderTexture>(device, 1920, 1080, Format_R16G16B16A16_FLOAT, true);
+		auto swap_chain		= make_shared<RHI_SwapChain>(nullptr, device, 1920, 1080);
+		TEST_CHECK(swap_chain->IsInitialized());
+		TEST_CHECK(context->resource_count != 0);
+		TEST_CHECK(context->upload_memory >= vertices.size() * sizeof(RHI_Vertex_PosUvNorTan) + indices.size() * sizeof(uint32_t));
+
+		// Maps
+		void* mapped = nullptr;
+		TEST_CHECK_ERRORS(logger, 0, mapped = constant_buffer->Map());
+		TEST_CHECK(mapped != nullptr);
+		TEST_CHECK_ERRORS(logger, 1, constant_buffer->Map());		// already mapped
+		TEST_CHECK_ERRORS(logger, 0, constant_buffer->Unmap());
+		TEST_CHECK_ERRORS(logger, 1, constant_buffer->Unmap());		// not mapped
+		TEST_CHECK_ERRORS(logger, 1, vertex_buffer->Map());			// immutable
+
+		// A complete pass
+		RHI_CommandList cmd_list(device, nullptr);
+		cmd_list.Begin("Pass");
+		cmd_list.SetRenderTarget(render_target, render_target->GetDepthStencilView());
+		cmd_list.ClearRenderTarget(render_target->GetBufferRenderTargetView(), Math::Vector4(0.0f, 0.0f, 0.0f, 0.0f));
+		cmd_list.SetViewport(render_target->GetViewport());
+		cmd_list.SetBlendState(blend);
+		cmd_list.SetDepthStencilState(depth);
+		cmd_list.SetRasterizerState(rasterizer);
+		cmd_list.SetInputLayout(shader->GetInputLayout());
+		cmd_list.SetShaderVertex(shader);
+		cmd_list.SetShaderPixel(shader);
+		cmd_list.SetBufferVertex(vertex_buffer);
+		cmd_list.SetBufferIndex(index_buffer);
+		cmd_list.SetSampler(0, sampler);
+		cmd_list.SetConstantBuffer(0, Buffer_Global, constant_buffer, 256, 256);
+		cmd_list.DrawIndexed(300, 0, 0);
+		cmd_list.DrawIndexedInstanced(36, 10, 264, 0, 0);
+		cmd_list.End();
+		TEST_CHECK_ERRORS(logger, 0, cmd_list.Submit());
+
+		// Invalid usage
+		TEST_CHECK_ERRORS(logger, 1, (cmd_list.Begin("Pass"), cmd_list.DrawIndexed(36, 280, 0), cmd_list.End(), cmd_list.Submit()));	// indices out of range
+		TEST_CHECK_ERRORS(logger, 1, (cmd_list.SetConstantBuffer(0, Buffer_Global, constant_buffer, 128, 256), cmd_list.Submit()));	// misaligned slice
+		TEST_CHECK_ERRORS(logger, 1, (cmd_list.SetConstantBuffer(0, Buffer_Global, constant_buffer, 4096, 256), cmd_list.Submit()));	// slice out of range
+		TEST_CHECK_ERRORS(logger, 1, (cmd_list.End(), cmd_list.Submit()));																// End() without Begin()
+
+		// State persists across submissions, like it does on an immediate context
+		TEST_CHECK_ERRORS(logger, 0, (cmd_list.DrawIndexed(36, 0, 0), cmd_list.Submit()));
+		TEST_CHECK_ERRORS(logger, 1, (cmd_list.SetRenderTarget(nullptr, nullptr), cmd_list.Draw(3), cmd_list.Submit()));				// no render target
+		TEST_CHECK_ERRORS(logger, 1, (cmd_list.SetShaderVertex(shader_missing), cmd_list.Submit()));									// shader which didn't compile
+
+		// Lists recorded on other threads are merged into the main one, a backend which reports that it
+		// can merge them has to replay their draws, the renderer records on one list when it can't.
+		TEST_CHECK(device->IsCommandListMergingSupported());
+		{
+			Profiler profiler(nullptr);
+			RHI_CommandList cmd_list_main(device, &profiler);
+			vector<unique_ptr<RHI_CommandList>> cmd_lists_worker;
+			cmd_list_main.Begin("Parallel");
+			for (unsigned int i = 0; i < 4; i++)
+			{
+				auto& worker = cmd_lists_worker.emplace_back(make_unique<RHI_CommandList>(device, &profiler));
+				worker->SetRenderTarget(render_target, render_target->GetDepthStencilView());
+				worker->SetViewport(render_target->GetViewport());
+				worker->SetInputLayout(shader->GetInputLayout());
+				worker->SetShaderVertex(shader);
+				worker->SetShaderPixel(shader);
+				worker->SetBufferVertex(vertex_buffer);
+				worker->SetBufferIndex(index_buffer);
+				for (unsigned int j = 0; j <= i; j++)
+				{
+					worker->DrawIndexed(36, 0, 0);
+				}
+				cmd_list_main.ExecuteCommandList(worker.get());
+			}
+			cmd_list_main.End();
+			TEST_CHECK_ERRORS(logger, 0, cmd_list_main.Submit());
+			TEST_CHECK(profiler.m_rhi_draw_calls == 1 + 2 + 3 + 4);
+
+			// The merged lists are left empty
+			for (auto& worker : cmd_lists_worker)
+			{
+				TEST_CHECK_ERRORS(logger, 0, worker->Submit());
+			}
+			TEST_CHECK(profiler.m_rhi_draw_calls == 1 + 2 + 3 + 4);
+		}
+
+		// Resizing the swap chain replaces its buffers
+		const uint64_t memory = context->resource_memory;
+		TEST_CHECK(swap_chain->Resize(1280, 720));
+		TEST_CHECK(context->resource_memory < memory);
+	}
+
+	// Everything was released
+	TEST_CHECK(context->resource_count == 0);
+	TEST_CHECK(context->resource_memory == 0);
+
+	return Test::Finish("RHI_Null");
+}
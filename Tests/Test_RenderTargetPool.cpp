@@ -0,0 +1,149 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ==========================
+#include "Test.h"
+#include "Rendering/Renderer.h"
+#include "Rendering/RenderTargetPool.h"
+#include "RHI/RHI_Implementation.h"
+#include "RHI/RHI_Device.h"
+#include "RHI/RHI_RenderTexture.h"
+//=====================================
+
+//= NAMESPACES =====
+using namespace std;
+using namespace Spartan;
+//==================
+
+// Recycling, eviction and statistics of the render target pool, on the null device
+int main()
+{
+	Test::Initialize();
+
+	auto device					= make_shared<RHI_Device>();
+	const RHI_Context* context	= device->GetContext();
+	const FrameGraph::Texture_Desc hdr		= { 1920, 1080, Format_R16G16B16A16_FLOAT, false };
+	const FrameGraph::Texture_Desc depth	= { 1920, 1080, Format_R32G32_FLOAT, true };
+	const FrameGraph::Texture_Desc half		= { 960, 540, Format_R8_UNORM, false };
+
+	// Textures are recycled once released, and only by the same description
+	{
+		RenderTargetPool pool(device);
+		auto a = pool.Acquire(hdr);
+		TEST_CHECK(a->GetWidth() == 1920 && a->GetHeight() == 1080 && a->GetFormat() == Format_R16G16B16A16_FLOAT);
+		auto b = pool.Acquire(hdr);
+		TEST_CHECK(a != b);
+		auto c = pool.Acquire(depth);
+		TEST_CHECK(c->GetDepthEnabled());
+		TEST_CHECK(pool.GetCount() == 3 && pool.GetCountFree() == 0 && pool.GetCountCreated() == 3);
+		TEST_CHECK(pool.GetMemory() == FrameGraph::GetMemory(hdr) * 2 + FrameGraph::GetMemory(depth));
+
+		RHI_RenderTexture* released = a.get();
+		a = nullptr;
+		TEST_CHECK(pool.GetCountFree() == 1 && pool.GetMemoryFree() == FrameGraph::GetMemory(hdr));
+		TEST_CHECK(pool.Acquire(half).get() != released);
+		TEST_CHECK(pool.Acquire(hdr).get() == released);
+		TEST_CHECK(pool.GetCountCreated() == 4);
+
+		// Trimming only destroys what's free, and the peak remains
+		const uint64_t peak = pool.GetMemoryPeak();
+		TEST_CHECK(peak == pool.GetMemory());
+		b = nullptr;
+		pool.Trim();
+		TEST_CHECK(pool.GetCount() == 1 && pool.GetMemory() == FrameGraph::GetMemory(depth));
+		TEST_CHECK(pool.GetMemoryPeak() == peak);
+	}
+	TEST_CHECK(context->resource_count == 0);
+
+	// Free textures are destroyed after some frames, textures in use never are
+	{
+		RenderTargetPool pool(device, 3);
+		auto used	= pool.Acquire(hdr);
+		pool.Acquire(half);
+		const uint64_t resources = context->resource_count;
+		for (unsigned int frame = 0; frame < 3; frame++)
+		{
+			pool.Tick();
+		}
+		TEST_CHECK(pool.GetCount() == 2);
+		pool.Tick();
+		TEST_CHECK(pool.GetCount() == 1 && pool.GetCountFree() == 0);
+		TEST_CHECK(context->resource_count < resources);
+
+		for (unsigned int frame = 0; frame < 10; frame++)
+		{
+			pool.Tick();
+		}
+		TEST_CHECK(pool.GetCount() == 1);
+	}
+
+	// Over the memory budget, the least recently used free textures go first
+	{
+		RenderTargetPool pool(device, 30, FrameGraph::GetMemory(half) * 2);
+		shared_ptr<RHI_RenderTexture> textures[3] = { pool.Acquire(half), pool.Acquire(half), pool.Acquire(half) };
+		RHI_RenderTexture* second	= textures[1].get();
+		RHI_RenderTexture* third	= textures[2].get();
+		for (auto& texture : textures)
+		{
+			texture = nullptr;
+			pool.Tick();
+		}
+		TEST_CHECK(pool.GetCount() == 2);
+		TEST_CHECK(pool.GetMemoryFree() == FrameGraph::GetMemory(half) * 2);
+
+		// The most recently used of what's left is handed out first
+		auto first_out	= pool.Acquire(half);
+		auto second_out	= pool.Acquire(half);
+		TEST_CHECK(first_out.get() == third && second_out.get() == second);
+		TEST_CHECK(pool.GetCountCreated() == 3);
+	}
+
+	// The pipeline switching between two resolutions every few frames settles, and stops creating textures
+	{
+		RenderTargetPool pool(device);
+		FrameGraph graph;
+		uint64_t created = 0;
+		for (unsigned int frame = 0; frame < 40; frame++)
+		{
+			const bool high = (frame / 5) % 2 == 0;
+			Renderer::FrameGraph_Declare(graph, high ? 1920 : 1280, high ? 1080 : 720, Render_PostProcess_Bloom | Render_PostProcess_SSAO | Render_PostProcess_TAA, ToneMapping_ACES, RendererDebug_None);
+			TEST_CHECK(graph.Compile());
+
+			vector<shared_ptr<RHI_RenderTexture>> textures;
+			for (const auto& desc : graph.GetPhysicalTextures())
+			{
+				textures.emplace_back(pool.Acquire(desc));
+			}
+			textures.clear();
+			pool.Tick();
+
+			if (frame == 9)
+			{
+				created = pool.GetCountCreated();
+			}
+		}
+		TEST_CHECK(created == pool.GetCountCreated());
+		TEST_CHECK(pool.GetMemoryPeak() == pool.GetMemory());
+	}
+	TEST_CHECK(context->resource_count == 0);
+
+	return Test::Finish("RenderTargetPool");
+}
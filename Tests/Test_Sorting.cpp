@@ -0,0 +1,108 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ===========================
+#include "Test.h"
+#include <vector>
+#include <random>
+#include <algorithm>
+#include "Rendering/Utilities/Sorting.h"
+#include "Threading/Threading.h"
+#include "Core/Settings.h"
+//======================================
+
+//= NAMESPACES ============================
+using namespace std;
+using namespace Spartan;
+using namespace Spartan::Utility::Sorting;
+//=========================================
+
+namespace
+{
+	// Keys where only the bits in mask vary, the index is the original position
+	vector<KeyIndex> CreateItems(const unsigned int count, const uint64_t mask, const unsigned int seed)
+	{
+		mt19937_64 engine(seed);
+		vector<KeyIndex> items(count);
+		for (unsigned int i = 0; i < count; i++)
+		{
+			items[i] = { (engine() & mask) | 0x0100000000000000ull, i };
+		}
+
+		return items;
+	}
+
+	// The order a stable comparison sort gives
+	vector<KeyIndex> Reference(vector<KeyIndex> items)
+	{
+		stable_sort(items.begin(), items.end(), [](const KeyIndex& a, const KeyIndex& b) { return a.key < b.key; });
+		return items;
+	}
+
+	bool Equal(const vector<KeyIndex>& a, const vector<KeyIndex>& b)
+	{
+		return equal(a.begin(), a.end(), b.begin(), b.end(), [](const KeyIndex& x, const KeyIndex& y) { return x.key == y.key && x.index == y.index; });
+	}
+}
+
+// Radix sort gives the order of a stable sort, for every kind of key and with or without jobs
+int main()
+{
+	Test::Initialize();
+
+	Settings::Get().SetMaxThreadCount(4);
+	Threading threading(nullptr);
+
+	const uint64_t masks[] =
+	{
+		~0ull,					// every digit varies
+		0,						// every key is the same, all digits are skipped
+		0x7,					// a few distinct keys, lots of ties which have to keep their order
+		0xFF00000000000000ull,	// only the top digit varies
+		0x00FF0000FF0000FFull	// an odd number of digits vary, the result ends up in the scratch buffer
+	};
+
+	vector<KeyIndex> scratch;
+	for (const unsigned int count : { 0u, 1u, 2u, 1000u, 100000u })
+	{
+		for (const uint64_t mask : masks)
+		{
+			const vector<KeyIndex> items		= CreateItems(count, mask, count);
+			const vector<KeyIndex> expected		= Reference(items);
+
+			vector<KeyIndex> sorted = items;
+			RadixSort(sorted, scratch);
+			TEST_CHECK(Equal(sorted, expected));
+
+			sorted = items;
+			RadixSort(sorted, scratch, &threading);
+			TEST_CHECK(Equal(sorted, expected));
+		}
+	}
+
+	// Sorting what is already sorted changes nothing
+	vector<KeyIndex> items = Reference(CreateItems(50000, ~0ull, 7));
+	const vector<KeyIndex> expected = items;
+	RadixSort(items, scratch, &threading);
+	TEST_CHECK(Equal(items, expected));
+
+	return Test::Finish("Sorting");
+}
@@ -0,0 +1,93 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ===========================
+#include "Test.h"
+#include <vector>
+#include <random>
+#include <algorithm>
+#include "Rendering/Utilities/Sorting.h"
+#include "Threading/Threading.h"
+#include "Core/Settings.h"
+//======================================
+
+//= NAMESPACES ============================
+using namespace std;
+using namespace Spartan;
+using namespace Spartan::Utility::Sorting;
+//=========================================
+
+// Sorts 10k to 1M draw keys with std::sort and with the radix sort, serially and in jobs
+int main()
+{
+	Test::Initialize();
+
+	Settings::Get().SetMaxThreadCount(thread::hardware_concurrency());
+	Threading threading(nullptr);
+
+	vector<KeyIndex> scratch;
+	for (const unsigned int count : { 10000u, 100000u, 1000000u })
+	{
+		// Keys laid out like the renderer's, a few passes and materials, a few hundred meshes and 24 bits of depth
+		mt19937 engine(count);
+		vector<KeyIndex> items(count);
+		for (unsigned int i = 0; i < count; i++)
+		{
+			const uint64_t pass		= engine() % 3;
+			const uint64_t material	= engine() % 64;
+			const uint64_t mesh		= engine() % 500;
+			const uint64_t depth	= engine() & 0xFFFFFF;
+			items[i] = { (pass << 62) | (material << 40) | (mesh << 24) | depth, i };
+		}
+
+		vector<KeyIndex> sorted_std;
+		const float time_std = Test::Time([&]()
+		{
+			sorted_std = items;
+			sort(sorted_std.begin(), sorted_std.end(), [](const KeyIndex& a, const KeyIndex& b) { return a.key < b.key; });
+		});
+
+		vector<KeyIndex> sorted_radix;
+		const float time_radix = Test::Time([&]()
+		{
+			sorted_radix = items;
+			RadixSort(sorted_radix, scratch);
+		});
+
+		vector<KeyIndex> sorted_parallel;
+		const float time_parallel = Test::Time([&]()
+		{
+			sorted_parallel = items;
+			RadixSort(sorted_parallel, scratch, &threading);
+		});
+
+		printf("%7u keys   std::sort %8.3f ms   radix %8.3f ms   radix (%2u threads) %8.3f ms\n", count, time_std, time_radix, threading.GetThreadCount() + 1, time_parallel);
+
+		const auto by_key = [](const KeyIndex& a, const KeyIndex& b) { return a.key < b.key; };
+		TEST_CHECK(is_sorted(sorted_radix.begin(), sorted_radix.end(), by_key));
+		TEST_CHECK(equal(sorted_radix.begin(), sorted_radix.end(), sorted_parallel.begin(), [](const KeyIndex& a, const KeyIndex& b)
+		{
+			return a.key == b.key && a.index == b.index;
+		}));
+	}
+
+	return Test::Finish("Sorting");
+}
@@ -0,0 +1,225 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES =====================
+#include "Test.h"
+#include <vector>
+#include <random>
+#include <algorithm>
+#include "World/SpatialTree.h"
+//================================
+
+//= NAMESPACES ===========
+using namespace std;
+using namespace Spartan;
+using namespace Spartan::Math;
+//========================
+
+namespace
+{
+	const unsigned int entity_count	= 100000;
+	const unsigned int query_count	= 1000;
+	const unsigned int height_max	= 2 * 17; // twice the height of a perfectly balanced tree
+
+	// The tree only stores the pointers, so the entities are stand-in indices
+	Entity* ToEntity(const unsigned int index)	{ return reinterpret_cast<Entity*>(static_cast<uintptr_t>(index) + 1); }
+	unsigned int ToIndex(Entity* entity)		{ return static_cast<unsigned int>(reinterpret_cast<uintptr_t>(entity) - 1); }
+
+	bool Overlaps(const BoundingBox& a, const BoundingBox& b)
+	{
+		return a.GetMin().x <= b.GetMax().x && a.GetMax().x >= b.GetMin().x &&
+			a.GetMin().y <= b.GetMax().y && a.GetMax().y >= b.GetMin().y &&
+			a.GetMin().z <= b.GetMax().z && a.GetMax().z >= b.GetMin().z;
+	}
+
+	// A city sized scene, mostly small objects and a few large ones
+	class Scene
+	{
+	public:
+		BoundingBox Box()
+		{
+			const Vector3 center(Range(-2000.0f, 2000.0f), Range(0.0f, 100.0f), Range(-2000.0f, 2000.0f));
+			const float size = Range(0.0f, 1.0f) < 0.95f ? Range(0.5f, 4.0f) : Range(10.0f, 50.0f);
+			return BoundingBox(center - Vector3(size), center + Vector3(size));
+		}
+
+		BoundingBox Moved(const BoundingBox& box, const float distance)
+		{
+			const Vector3 offset(Range(-distance, distance), Range(-distance, distance), Range(-distance, distance));
+			return BoundingBox(box.GetMin() + offset, box.GetMax() + offset);
+		}
+
+		float Range(const float min, const float max) { return uniform_real_distribution<float>(min, max)(m_engine); }
+
+	private:
+		mt19937 m_engine = mt19937(1);
+	};
+
+	void PrintQuality(const char* label, const SpatialTree& tree)
+	{
+		printf("%-24s height %2u, max balance %u, area ratio %.1f\n", label, tree.GetHeight(), tree.GetMaxBalance(), tree.GetAreaRatio());
+	}
+
+	float DistanceSquared(const BoundingBox& box, const Vector3& point)
+	{
+		const Vector3 closest(Helper::Clamp(point.x, box.GetMin().x, box.GetMax().x), Helper::Clamp(point.y, box.GetMin().y, box.GetMax().y), Helper::Clamp(point.z, box.GetMin().z, box.GetMax().z));
+		return (closest - point).LengthSquared();
+	}
+
+	// Times the queries against the tree and against every box, and checks that the tree reports every box that
+	// brute force finds (it may report a few more, it tests the enlarged boxes)
+	template <typename Exact, typename Query>
+	void Benchmark(const char* label, const vector<BoundingBox>& boxes, const unsigned int count, Exact&& exact_test, Query&& query)
+	{
+		unsigned int hits_tree = 0;
+		const float time_tree = Test::Time([&]()
+		{
+			hits_tree = 0;
+			for (unsigned int q = 0; q < count; q++)
+			{
+				query(q, [&hits_tree](Entity*) { hits_tree++; });
+			}
+		}, 1);
+
+		unsigned int hits_exact	= 0;
+		unsigned int missed		= 0;
+		vector<vector<unsigned int>> exact(count);
+		const float time_brute = Test::Time([&]()
+		{
+			hits_exact = 0;
+			for (unsigned int q = 0; q < count; q++)
+			{
+				exact[q].clear();
+				for (unsigned int i = 0; i < static_cast<unsigned int>(boxes.size()); i++)
+				{
+					if (exact_test(q, boxes[i]))
+					{
+						exact[q].emplace_back(i);
+						hits_exact++;
+					}
+				}
+			}
+		}, 1);
+
+		vector<unsigned int> stamps(boxes.size(), 0);
+		for (unsigned int q = 0; q < count; q++)
+		{
+			fill(stamps.begin(), stamps.end(), 0);
+			query(q, [&stamps](Entity* entity) { stamps[ToIndex(entity)] = 1; });
+			for (const unsigned int i : exact[q])
+			{
+				missed += stamps[i] == 0 ? 1 : 0;
+			}
+		}
+
+		printf("%-24s %8.2f us/query (brute force %8.2f us), %u hits (%u exact)\n", label, time_tree * 1000.0f / count, time_brute * 1000.0f / count, hits_tree, hits_exact);
+		TEST_CHECK(missed == 0);
+		TEST_CHECK(hits_tree >= hits_exact);
+	}
+}
+
+// Insert, update and query throughput and the quality of the tree, on a randomly generated scene
+int main()
+{
+	Test::Initialize();
+
+	Scene scene;
+	vector<BoundingBox> boxes(entity_count);
+	for (auto& box : boxes)
+	{
+		box = scene.Box();
+	}
+
+	// Insertion
+	SpatialTree tree;
+	vector<int> proxies(entity_count);
+	const float time_insert = Test::Time([&tree, &boxes, &proxies]()
+	{
+		tree.Clear();
+		for (unsigned int i = 0; i < entity_count; i++)
+		{
+			proxies[i] = tree.Insert(ToEntity(i), boxes[i]);
+		}
+	});
+	printf("Insert                   %6.0f ns/entity\n", time_insert * 1000000.0f / entity_count);
+	PrintQuality("After insertion", tree);
+	TEST_CHECK(tree.GetProxyCount() == entity_count);
+	TEST_CHECK(tree.GetNodeCount() == entity_count * 2 - 1);
+	TEST_CHECK(tree.GetHeight() <= height_max);
+
+	// Updates, a frame where 10% of the entities move a little (mostly within the margin) and 1% teleport
+	unsigned int moved		= 0;
+	unsigned int reinserted	= 0;
+	const float time_move = Test::Time([&]()
+	{
+		for (unsigned int i = 0; i < entity_count; i += 10)
+		{
+			boxes[i] = scene.Moved(boxes[i], i % 100 == 0 ? 1000.0f : 0.05f);
+			reinserted += tree.Move(proxies[i], boxes[i]) ? 1 : 0;
+			moved++;
+		}
+	});
+	printf("Move                     %6.0f ns/entity (%u of %u reinserted)\n", time_move * 1000000.0f / (entity_count / 10), reinserted, moved);
+	PrintQuality("After updates", tree);
+	TEST_CHECK(tree.GetHeight() <= height_max);
+	TEST_CHECK(reinserted < moved / 2);
+
+	// Removal and re-insertion of half of the entities
+	for (unsigned int i = 0; i < entity_count; i += 2)
+	{
+		tree.Remove(proxies[i]);
+	}
+	TEST_CHECK(tree.GetProxyCount() == entity_count / 2);
+	for (unsigned int i = 0; i < entity_count; i += 2)
+	{
+		proxies[i] = tree.Insert(ToEntity(i), boxes[i]);
+	}
+	PrintQuality("After re-insertion", tree);
+	TEST_CHECK(tree.GetProxyCount() == entity_count);
+	TEST_CHECK(tree.GetHeight() <= height_max);
+
+	// Queries, a mix of what the renderer and gameplay ask for
+	vector<BoundingBox> query_boxes(query_count);
+	vector<pair<Vector3, float>> query_spheres(query_count);
+	vector<Frustum> query_frustums(query_count / 10);
+	for (unsigned int q = 0; q < query_count; q++)
+	{
+		const Vector3 center(scene.Range(-2000.0f, 2000.0f), 50.0f, scene.Range(-2000.0f, 2000.0f));
+		query_boxes[q]		= BoundingBox(center - Vector3(25.0f), center + Vector3(25.0f));
+		query_spheres[q]	= { center, 50.0f };
+	}
+	for (auto& frustum : query_frustums)
+	{
+		const Vector3 position(scene.Range(-2000.0f, 2000.0f), 50.0f, scene.Range(-2000.0f, 2000.0f));
+		const Vector3 target = position + Vector3(scene.Range(-1.0f, 1.0f), scene.Range(-0.2f, 0.2f), scene.Range(-1.0f, 1.0f));
+		frustum.Construct(Matrix::CreateLookAtLH(position, target, Vector3::Up), Matrix::CreatePerspectiveFieldOfViewLH(1.0f, 16.0f / 9.0f, 0.3f, 500.0f), 500.0f);
+	}
+
+	const auto test_box		= [&query_boxes](const unsigned int q, const BoundingBox& box)		{ return Overlaps(box, query_boxes[q]); };
+	const auto test_sphere	= [&query_spheres](const unsigned int q, const BoundingBox& box)	{ return DistanceSquared(box, query_spheres[q].first) <= query_spheres[q].second * query_spheres[q].second; };
+	const auto test_frustum	= [&query_frustums](const unsigned int q, const BoundingBox& box)	{ return query_frustums[q].CheckCube(box.GetCenter(), box.GetExtents()) != Outside; };
+
+	Benchmark("Box query", boxes, query_count, test_box, [&tree, &query_boxes](const unsigned int q, auto&& report) { tree.QueryBox(query_boxes[q], report); });
+	Benchmark("Sphere query", boxes, query_count, test_sphere, [&tree, &query_spheres](const unsigned int q, auto&& report) { tree.QuerySphere(query_spheres[q].first, query_spheres[q].second, report); });
+	Benchmark("Frustum query", boxes, query_count / 10, test_frustum, [&tree, &query_frustums](const unsigned int q, auto&& report) { tree.QueryFrustum(query_frustums[q], report); });
+
+	return Test::Finish("Spatial tree");
+}
@@ -0,0 +1,291 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES =====================
+#include "Test.h"
+#include <vector>
+#include "Threading/Threading.h"
+#include "Core/Settings.h"
+//================================
+
+//= NAMESPACES =====
+using namespace std;
+using namespace Spartan;
+//==================
+
+namespace
+{
+	void Test_Counter(Threading& threading)
+	{
+		const unsigned int count = 1000;
+		atomic<unsigned int> executed = 0;
+
+		JobCounter counter;
+		for (unsigned int i = 0; i < count; i++)
+		{
+			threading.AddTask([&executed]() { executed++; }, Job_Normal, &counter);
+		}
+		threading.Wait(&counter);
+
+		TEST_CHECK(counter.IsDone());
+		TEST_CHECK(executed == count);
+	}
+
+	// Jobs which depend on a counter only run once every job of that counter is done
+	void Test_Dependency(Threading& threading)
+	{
+		const unsigned int count = 256;
+		vector<unsigned int> values(count, 0);
+		atomic<unsigned int> stage_a = 0;
+		atomic<unsigned int> violations = 0;
+
+		JobCounter counter_a;
+		JobCounter counter_b;
+		for (unsigned int i = 0; i < count; i++)
+		{
+			threading.AddTask([&values, &stage_a, i]() { values[i] = i; stage_a++; }, Job_Normal, &counter_a);
+		}
+		for (unsigned int i = 0; i < count; i++)
+		{
+			threading.AddTask([&values, &stage_a, &violations, i]()
+			{
+				if (stage_a != count || values[count - 1 - i] != count - 1 - i)
+				{
+					violations++;
+				}
+			}, Job_Normal, &counter_b, &counter_a);
+		}
+		threading.Wait(&counter_b);
+
+		TEST_CHECK(counter_a.IsDone());
+		TEST_CHECK(violations == 0);
+	}
+
+	// A chain of dependencies executes in order
+	void Test_Chain(Threading& threading)
+	{
+		const unsigned int length = 16;
+		vector<JobCounter> counters(length);
+		vector<unsigned int> order;
+		mutex order_mutex;
+
+		for (unsigned int i = 0; i < length; i++)
+		{
+			threading.AddTask([&order, &order_mutex, i]()
+			{
+				lock_guard<mutex> lock(order_mutex);
+				order.emplace_back(i);
+			}, Job_Normal, &counters[i], i != 0 ? &counters[i - 1] : nullptr);
+		}
+		threading.Wait(&counters[length - 1]);
+
+		TEST_CHECK(order.size() == length);
+		for (unsigned int i = 0; i < order.size(); i++)
+		{
+			TEST_CHECK(order[i] == i);
+		}
+	}
+
+	// Jobs can fork more jobs and wait on them, the waiting job executes pending jobs in the meantime
+	void Test_ForkJoin(Threading& threading)
+	{
+		const unsigned int parents	= 8;
+		const unsigned int children	= 64;
+		atomic<unsigned int> executed = 0;
+		atomic<unsigned int> joined = 0;
+
+		JobCounter counter;
+		for (unsigned int i = 0; i < parents; i++)
+		{
+			threading.AddTask([&threading, &executed, &joined]()
+			{
+				JobCounter counter_children;
+				atomic<unsigned int> executed_children = 0;
+				for (unsigned int j = 0; j < children; j++)
+				{
+					threading.AddTask([&executed, &executed_children]() { executed++; executed_children++; }, Job_Normal, &counter_children);
+				}
+				threading.Wait(&counter_children);
+
+				if (executed_children == children)
+				{
+					joined++;
+				}
+			}, Job_Normal, &counter);
+		}
+		threading.Wait(&counter);
+
+		TEST_CHECK(executed == parents * children);
+		TEST_CHECK(joined == parents);
+	}
+
+	// Waiting on a predicate executes pending jobs, so it finishes even when every worker is busy
+	void Test_WaitUntil(Threading& threading)
+	{
+		// Keep every worker busy until the waiting thread is done
+		atomic<unsigned int> busy = 0;
+		atomic<bool> release = false;
+		JobCounter counter_busy;
+		for (unsigned int i = 0; i < threading.GetThreadCount(); i++)
+		{
+			threading.AddTask([&busy, &release]()
+			{
+				busy++;
+				while (!release)
+				{
+					this_thread::yield();
+				}
+			}, Job_Normal, &counter_busy);
+		}
+		while (busy != threading.GetThreadCount())
+		{
+			this_thread::yield();
+		}
+
+		// Nobody but the waiting thread can run these
+		const unsigned int count = 64;
+		atomic<unsigned int> executed = 0;
+		for (unsigned int i = 0; i < count; i++)
+		{
+			threading.AddTask([&executed]() { executed++; });
+		}
+		threading.WaitUntil([&executed]() { return executed == count; });
+		TEST_CHECK(executed == count);
+
+		release = true;
+		threading.Wait(&counter_busy);
+	}
+
+	void Test_ParallelFor(Threading& threading)
+	{
+		const unsigned int count = 100000;
+		vector<unsigned int> visits(count, 0);
+
+		threading.ParallelFor(count, [&visits](const unsigned int start, const unsigned int end)
+		{
+			for (unsigned int i = start; i < end; i++)
+			{
+				visits[i]++;
+			}
+		});
+
+		unsigned int visited_once = 0;
+		for (const unsigned int visit : visits)
+		{
+			visited_once += visit == 1 ? 1 : 0;
+		}
+		TEST_CHECK(visited_once == count);
+
+		// Empty and tiny loops
+		unsigned int calls = 0;
+		threading.ParallelFor(0, [&calls](unsigned int, unsigned int) { calls++; });
+		threading.ParallelFor(3, [&calls](const unsigned int start, const unsigned int end) { calls += end - start; });
+		TEST_CHECK(calls == 4);
+	}
+
+	// The reduction combines the ranges in order, so even a non-commutative combine gives the serial result
+	void Test_ParallelReduce(Threading& threading)
+	{
+		const unsigned int count = 50000;
+
+		const uint64_t sum = threading.ParallelReduce<uint64_t>(count, 0, [](const unsigned int start, const unsigned int end, uint64_t& partial)
+		{
+			for (unsigned int i = start; i < end; i++)
+			{
+				partial += i;
+			}
+		},
+		[](uint64_t& result, const uint64_t& partial) { result += partial; });
+		TEST_CHECK(sum == static_cast<uint64_t>(count) * (count - 1) / 2);
+
+		const vector<unsigned int> sequence = threading.ParallelReduce<vector<unsigned int>>(count, {}, [](const unsigned int start, const unsigned int end, vector<unsigned int>& partial)
+		{
+			for (unsigned int i = start; i < end; i++)
+			{
+				partial.emplace_back(i);
+			}
+		},
+		[](vector<unsigned int>& result, const vector<unsigned int>& partial) { result.insert(result.end(), partial.begin(), partial.end()); });
+
+		bool in_order = sequence.size() == count;
+		for (unsigned int i = 0; i < sequence.size() && in_order; i++)
+		{
+			in_order = sequence[i] == i;
+		}
+		TEST_CHECK(in_order);
+	}
+
+	void Test_WaitIdle(Threading& threading)
+	{
+		atomic<unsigned int> executed = 0;
+		for (unsigned int i = 0; i < 400; i++)
+		{
+			threading.AddTask([&executed]() { executed++; }, static_cast<Job_Priority>(i % job_priority_count));
+		}
+		threading.WaitIdle();
+
+		TEST_CHECK(executed == 400);
+	}
+
+	void Test_All(const unsigned int worker_count)
+	{
+		Settings::Get().SetMaxThreadCount(worker_count + 1);
+		Threading threading(nullptr);
+		TEST_CHECK(threading.GetThreadCount() == worker_count);
+
+		Test_Counter(threading);
+		Test_Dependency(threading);
+		Test_Chain(threading);
+		Test_ForkJoin(threading);
+		Test_WaitUntil(threading);
+		Test_ParallelFor(threading);
+		Test_ParallelReduce(threading);
+		Test_WaitIdle(threading);
+	}
+}
+
+int main()
+{
+	auto& logger = Test::Initialize();
+
+	// Without workers, tasks execute in the calling thread (with a warning)
+	{
+		Settings::Get().SetMaxThreadCount(1);
+		Threading threading(nullptr);
+
+		bool executed = false;
+		threading.AddTask([&executed]() { executed = true; });
+		TEST_CHECK(executed);
+		TEST_CHECK(logger.m_warnings != 0);
+
+		// A dependency which is already done doesn't hold anything back
+		JobCounter counter;
+		threading.AddTask([]() {}, Job_Normal, &counter);
+		threading.AddTask([&executed]() { executed = false; }, Job_Normal, nullptr, &counter);
+		TEST_CHECK(!executed);
+	}
+
+	Test_All(1);
+	Test_All(3);
+	Test_All(8);
+
+	return Test::Finish("Threading");
+}
@@ -0,0 +1,98 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES =====================
+#include "Test.h"
+#include <vector>
+#include <algorithm>
+#include "Threading/Threading.h"
+#include "Core/Settings.h"
+//================================
+
+//= NAMESPACES =====
+using namespace std;
+using namespace Spartan;
+//==================
+
+namespace
+{
+	float ElapsedMs(const chrono::steady_clock::time_point& start)
+	{
+		return chrono::duration<float, milli>(chrono::steady_clock::now() - start).count();
+	}
+}
+
+// Frame critical jobs keep a bounded latency while the background and I/O lanes are saturated
+int main()
+{
+	Test::Initialize();
+
+	Settings::Get().SetMaxThreadCount(4);
+	Threading threading(nullptr);
+	TEST_CHECK(threading.GetThreadCount() == 3);
+
+	// Saturate the background lane and the I/O lane with long running (blocking) jobs
+	const unsigned int background_count = 100;
+	const unsigned int io_count			= 20;
+	JobCounter counter_background;
+	for (unsigned int i = 0; i < background_count; i++)
+	{
+		threading.AddTask([]() { this_thread::sleep_for(chrono::milliseconds(2)); }, Job_Background, &counter_background);
+	}
+	for (unsigned int i = 0; i < io_count; i++)
+	{
+		threading.AddTask([]() { this_thread::sleep_for(chrono::milliseconds(5)); }, Job_Io, &counter_background);
+	}
+	TEST_CHECK(threading.GetStats(Job_Background).queued != 0);
+	TEST_CHECK(threading.GetStats(Job_Io).queued != 0);
+
+	// Submit frame work at a steady rate, the way the renderer would, and measure how long it waits for a worker
+	const unsigned int critical_count = 50;
+	vector<float> latencies(critical_count, 0.0f);
+	JobCounter counter_critical;
+	for (unsigned int i = 0; i < critical_count; i++)
+	{
+		const auto time_submitted = chrono::steady_clock::now();
+		threading.AddTask([&latencies, time_submitted, i]() { latencies[i] = ElapsedMs(time_submitted); }, Job_Critical, &counter_critical);
+		this_thread::sleep_for(chrono::milliseconds(1));
+	}
+	threading.Wait(&counter_critical);
+	const JobStats stats_critical = threading.GetStats(Job_Critical);
+
+	threading.Wait(&counter_background);
+	const JobStats stats_background = threading.GetStats(Job_Background);
+
+	sort(latencies.begin(), latencies.end());
+	const float latency_median	= latencies[critical_count / 2];
+	const float latency_max		= latencies.back();
+	printf("critical latency: median %.3f ms, max %.3f ms (stats average %.3f ms), background average wait %.3f ms\n", latency_median, latency_max, stats_critical.time_wait_ms, stats_background.time_wait_ms);
+
+	TEST_CHECK(stats_critical.executed == critical_count);
+	TEST_CHECK(stats_background.executed == background_count);
+	TEST_CHECK(threading.GetStats(Job_Io).executed == io_count);
+
+	// The bound is loose so that a busy machine doesn't fail the test, a critical job which queued
+	// behind the background work would wait for tens of milliseconds.
+	TEST_CHECK(latency_median < 5.0f);
+	TEST_CHECK(latency_max < stats_background.time_wait_ms);
+
+	return Test::Finish("Threading latency");
+}
@@ -0,0 +1,106 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ===================
+#include "Test.h"
+#include <vector>
+#include <cmath>
+#include "Threading/Threading.h"
+#include "Core/Settings.h"
+//==============================
+
+//= NAMESPACES =====
+using namespace std;
+using namespace Spartan;
+//==================
+
+// ParallelFor and ParallelReduce over 4M elements with 1 thread up to every hardware thread
+int main()
+{
+	Test::Initialize();
+
+	const unsigned int count = 4 * 1024 * 1024;
+	vector<float> input(count);
+	for (unsigned int i = 0; i < count; i++)
+	{
+		input[i] = static_cast<float>(i % 1000) * 0.001f;
+	}
+
+	// Serial results to compare against
+	vector<float> expected(count);
+	for (unsigned int i = 0; i < count; i++)
+	{
+		expected[i] = sqrtf(input[i]) * 2.0f + 1.0f;
+	}
+	double expected_sum = 0.0;
+	for (unsigned int i = 0; i < count; i++)
+	{
+		expected_sum += input[i];
+	}
+
+	vector<unsigned int> thread_counts = { 1, 2, 4 };
+	if (thread::hardware_concurrency() > 4)
+	{
+		thread_counts.emplace_back(thread::hardware_concurrency());
+	}
+
+	vector<float> output(count);
+	float time_for_single		= 0.0f;
+	float time_reduce_single	= 0.0f;
+	for (const unsigned int thread_count : thread_counts)
+	{
+		Settings::Get().SetMaxThreadCount(thread_count);
+		Threading threading(nullptr);
+
+		const float time_for = Test::Time([&]()
+		{
+			threading.ParallelFor(count, [&input, &output](const unsigned int start, const unsigned int end)
+			{
+				for (unsigned int i = start; i < end; i++)
+				{
+					output[i] = sqrtf(input[i]) * 2.0f + 1.0f;
+				}
+			});
+		});
+
+		double sum = 0.0;
+		const float time_reduce = Test::Time([&]()
+		{
+			sum = threading.ParallelReduce(count, 0.0, [&input](const unsigned int start, const unsigned int end, double& partial)
+			{
+				for (unsigned int i = start; i < end; i++)
+				{
+					partial += input[i];
+				}
+			}, [](double& result, const double& partial) { result += partial; });
+		});
+
+		time_for_single		= thread_count == 1 ? time_for : time_for_single;
+		time_reduce_single	= thread_count == 1 ? time_reduce : time_reduce_single;
+		printf("%2u threads   ParallelFor %7.3f ms (%4.2fx)   ParallelReduce %7.3f ms (%4.2fx)\n",
+			thread_count, time_for, time_for_single / time_for, time_reduce, time_reduce_single / time_reduce);
+
+		TEST_CHECK(output == expected);
+		TEST_CHECK(fabs(sum - expected_sum) < expected_sum * 1e-9);
+	}
+
+	return Test::Finish("Threading scaling");
+}
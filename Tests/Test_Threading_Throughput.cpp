@@ -0,0 +1,185 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ====================
+#include "Test.h"
+#include <queue>
+#include <functional>
+#include <algorithm>
+#include "Threading/Threading.h"
+#include "Core/Settings.h"
+//===============================
+
+//= NAMESPACES =====
+using namespace std;
+using namespace Spartan;
+//==================
+
+namespace
+{
+	const unsigned int job_count	= 100000;
+	const unsigned int batch_size	= 2048; // below the job pool capacity, like a frame worth of jobs
+
+	// The thread pool as it was before the job system, one queue behind one mutex, a heap allocated task per job
+	class Threading_Queue
+	{
+	public:
+		Threading_Queue(const unsigned int thread_count)
+		{
+			for (unsigned int i = 0; i < thread_count; i++)
+			{
+				m_threads.emplace_back(&Threading_Queue::Invoke, this);
+			}
+		}
+
+		~Threading_Queue()
+		{
+			{
+				lock_guard<mutex> lock(m_mutex);
+				m_stopping = true;
+			}
+			m_condition_var.notify_all();
+
+			for (auto& thread : m_threads)
+			{
+				thread.join();
+			}
+		}
+
+		template <typename Function>
+		void AddTask(Function&& task)
+		{
+			unique_lock<mutex> lock(m_mutex);
+			m_tasks.push(make_shared<function<void()>>(forward<Function>(task)));
+			lock.unlock();
+			m_condition_var.notify_one();
+		}
+
+	private:
+		void Invoke()
+		{
+			while (true)
+			{
+				unique_lock<mutex> lock(m_mutex);
+				m_condition_var.wait(lock, [this] { return !m_tasks.empty() || m_stopping; });
+				if (m_stopping && m_tasks.empty())
+					return;
+
+				auto task = m_tasks.front();
+				m_tasks.pop();
+				lock.unlock();
+
+				(*task)();
+			}
+		}
+
+		vector<thread> m_threads;
+		queue<shared_ptr<function<void()>>> m_tasks;
+		mutex m_mutex;
+		condition_variable m_condition_var;
+		bool m_stopping = false;
+	};
+
+	// A small amount of work, so that the benchmark measures the scheduling overhead
+	void Work(atomic<uint64_t>& sum, const unsigned int index)
+	{
+		uint64_t value = index;
+		for (unsigned int i = 0; i < 16; i++)
+		{
+			value = value * 6364136223846793005ull + 1442695040888963407ull;
+		}
+		sum.fetch_add(value & 1, memory_order_relaxed);
+	}
+
+	uint64_t Expected()
+	{
+		atomic<uint64_t> sum = 0;
+		for (unsigned int i = 0; i < job_count; i++)
+		{
+			Work(sum, i);
+		}
+		return sum;
+	}
+}
+
+// Job throughput of the job system against the single queue, for 1 to N workers
+int main()
+{
+	Test::Initialize();
+
+	const uint64_t expected				= Expected();
+	const unsigned int worker_count_max	= max(thread::hardware_concurrency(), 2u);
+
+	for (unsigned int worker_count = 1; worker_count <= worker_count_max; worker_count *= 2)
+	{
+		// Single queue, the submitting thread waits for each batch
+		float time_queue = 0.0f;
+		{
+			Threading_Queue threading(worker_count);
+			time_queue = Test::Time([&threading, expected]()
+			{
+				atomic<uint64_t> sum = 0;
+				for (unsigned int start = 0; start < job_count; start += batch_size)
+				{
+					const unsigned int end = min(start + batch_size, job_count);
+					atomic<unsigned int> remaining = end - start;
+					for (unsigned int i = start; i < end; i++)
+					{
+						threading.AddTask([&sum, &remaining, i]() { Work(sum, i); remaining--; });
+					}
+
+					while (remaining.load() != 0)
+					{
+						this_thread::yield();
+					}
+				}
+				TEST_CHECK(sum == expected);
+			}, 3);
+		}
+
+		// Job system, the submitting thread helps out while it waits for each batch
+		float time_jobs = 0.0f;
+		{
+			Settings::Get().SetMaxThreadCount(worker_count + 1);
+			Threading threading(nullptr);
+			TEST_CHECK(threading.GetThreadCount() == worker_count);
+			time_jobs = Test::Time([&threading, expected]()
+			{
+				atomic<uint64_t> sum = 0;
+				for (unsigned int start = 0; start < job_count; start += batch_size)
+				{
+					const unsigned int end = min(start + batch_size, job_count);
+					JobCounter counter;
+					for (unsigned int i = start; i < end; i++)
+					{
+						threading.AddTask([&sum, i]() { Work(sum, i); }, Job_Normal, &counter);
+					}
+					threading.Wait(&counter);
+				}
+				TEST_CHECK(sum == expected);
+			}, 3);
+		}
+
+		printf("%2u workers: queue %8.0f jobs/ms, job system %8.0f jobs/ms\n", worker_count, job_count / time_queue, job_count / time_jobs);
+	}
+
+	return Test::Finish("Threading throughput");
+}
@@ -0,0 +1,182 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ==========================
+#include "Test.h"
+#include <vector>
+#include <set>
+#include "Core/Context.h"
+#include "Core/Settings.h"
+#include "Threading/Threading.h"
+#include "World/Entity.h"
+#include "World/TransformHierarchy.h"
+#include "World/Components/Transform.h"
+//=====================================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan;
+using namespace Spartan::Math;
+//============================
+
+namespace
+{
+	// A full binary tree below root, depth levels deep
+	void CreateTree(Context* context, vector<shared_ptr<Entity>>& entities, Transform* root, const unsigned int depth)
+	{
+		if (depth == 0)
+			return;
+
+		for (unsigned int i = 0; i < 2; i++)
+		{
+			auto entity = make_shared<Entity>(context);
+			entity->Initialize(entity->AddComponent<Transform>().get());
+			entity->GetTransform_PtrRaw()->SetPositionLocal(Vector3(i == 0 ? -1.0f : 1.0f, 1.0f, 0.5f));
+			entity->GetTransform_PtrRaw()->SetRotationLocal(Quaternion::FromEulerAngles(0.0f, 30.0f, 0.0f));
+			entity->GetTransform_PtrRaw()->SetScaleLocal(Vector3(0.5f));
+			entity->GetTransform_PtrRaw()->SetParent(root);
+			entities.emplace_back(entity);
+			CreateTree(context, entities, entity->GetTransform_PtrRaw(), depth - 1);
+		}
+	}
+
+	set<Transform*> Moved(const TransformHierarchy& hierarchy)
+	{
+		set<Transform*> moved;
+		hierarchy.ForEachMoved([&moved](Transform* transform) { moved.insert(transform); });
+		return moved;
+	}
+
+	set<Transform*> Subtree(Transform* root)
+	{
+		vector<Transform*> descendants;
+		root->GetDescendants(&descendants);
+		set<Transform*> subtree(descendants.begin(), descendants.end());
+		subtree.insert(root);
+		return subtree;
+	}
+
+	// The world matrix composed the slow way, up the parent chain
+	Matrix Reference(Transform* transform)
+	{
+		const Matrix local = Matrix(transform->GetPositionLocal(), transform->GetRotationLocal(), transform->GetScaleLocal());
+		return transform->HasParent() ? local * Reference(transform->GetParent()) : local;
+	}
+}
+
+// Setters only mark transforms dirty, the hierarchy resolves each dirty transform once per update and leaves the rest alone
+int main()
+{
+	Test::Initialize();
+	Settings::Get().SetMaxThreadCount(4);
+	Threading threading(nullptr);
+	auto context = make_shared<Context>();
+
+	// Two roots with a tree of depth 4 each
+	vector<shared_ptr<Entity>> entities;
+	Transform* roots[2];
+	for (auto& root : roots)
+	{
+		auto entity = make_shared<Entity>(context.get());
+		entity->Initialize(entity->AddComponent<Transform>().get());
+		entities.emplace_back(entity);
+		root = entity->GetTransform_PtrRaw();
+		CreateTree(context.get(), entities, root, 4);
+	}
+	const auto subtree_a = Subtree(roots[0]);
+	const auto subtree_b = Subtree(roots[1]);
+	TEST_CHECK(subtree_a.size() == 31 && subtree_b.size() == 31);
+
+	// The first update resolves everything
+	TransformHierarchy hierarchy;
+	hierarchy.Update(entities, &threading);
+	TEST_CHECK(hierarchy.GetCount() == 62);
+	TEST_CHECK(hierarchy.GetDepth() == 4);
+	TEST_CHECK(Moved(hierarchy).size() == 62);
+	for (const auto& entity : entities)
+	{
+		TEST_CHECK(!entity->GetTransform_PtrRaw()->IsDirty());
+	}
+
+	// Nothing changed, nothing is resolved
+	hierarchy.Update(entities, &threading);
+	TEST_CHECK(Moved(hierarchy).empty());
+
+	// Moving a root a few times only marks its subtree, which resolves once and leaves the other tree alone
+	for (unsigned int i = 0; i < 3; i++)
+	{
+		roots[0]->SetPositionLocal(Vector3(static_cast<float>(i), 2.0f, 3.0f));
+		roots[0]->SetRotationLocal(Quaternion::FromEulerAngles(10.0f * i, 0.0f, 0.0f));
+	}
+	for (Transform* transform : subtree_a)
+	{
+		TEST_CHECK(transform->IsDirty());
+	}
+	for (Transform* transform : subtree_b)
+	{
+		TEST_CHECK(!transform->IsDirty());
+	}
+	hierarchy.Update(entities, &threading);
+	TEST_CHECK(Moved(hierarchy) == subtree_a);
+
+	// Moving a leaf touches only the leaf
+	Transform* leaf = roots[1];
+	while (leaf->HasChildren())
+	{
+		leaf = leaf->GetChildren().back();
+	}
+	leaf->SetScaleLocal(Vector3(2.0f));
+	hierarchy.Update(entities, &threading);
+	TEST_CHECK(Moved(hierarchy) == set<Transform*>({ leaf }));
+
+	// Reading a matrix resolves it on demand, the next update still reports it as moved but computes nothing else
+	Transform* middle = roots[1]->GetChildren()[0];
+	middle->SetPositionLocal(Vector3(5.0f, 0.0f, 0.0f));
+	const Matrix middle_matrix = middle->GetMatrix();
+	TEST_CHECK(!middle->IsDirty());
+	for (Transform* child : middle->GetChildren())
+	{
+		TEST_CHECK(child->IsDirty());
+	}
+	hierarchy.Update(entities, &threading);
+	TEST_CHECK(Moved(hierarchy) == Subtree(middle));
+	TEST_CHECK(middle->GetMatrix() == middle_matrix);
+
+	// Every world matrix and its decomposition matches the slow composition
+	for (const auto& entity : entities)
+	{
+		Transform* transform	= entity->GetTransform_PtrRaw();
+		Matrix reference		= Reference(transform);
+		TEST_CHECK(transform->GetMatrix() == reference);
+		TEST_CHECK(transform->GetPosition() == reference.GetTranslation());
+		TEST_CHECK(transform->GetScale() == reference.GetScale());
+	}
+
+	// Re-parenting a subtree moves it and everything below it
+	Transform* moved_subtree = roots[0]->GetChildren()[1];
+	moved_subtree->SetParent(roots[1]);
+	hierarchy.Invalidate();
+	hierarchy.Update(entities, &threading);
+	TEST_CHECK(Moved(hierarchy) == Subtree(moved_subtree));
+	TEST_CHECK(moved_subtree->GetMatrix() == Reference(moved_subtree));
+
+	return Test::Finish("Transform hierarchy");
+}
@@ -0,0 +1,148 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ==========================
+#include "Test.h"
+#include <vector>
+#include "Core/Context.h"
+#include "Core/Settings.h"
+#include "Threading/Threading.h"
+#include "World/Entity.h"
+#include "World/TransformHierarchy.h"
+#include "World/Components/Transform.h"
+//=====================================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan;
+using namespace Spartan::Math;
+//============================
+
+namespace
+{
+	// Every root has this many children, which have as many children of their own
+	const unsigned int children_per_node	= 9;
+	const unsigned int nodes_per_root		= 1 + children_per_node + children_per_node * children_per_node;
+
+	Transform* CreateNode(Context* context, vector<shared_ptr<Entity>>& entities, Transform* parent, const float offset)
+	{
+		auto entity = make_shared<Entity>(context);
+		entity->Initialize(entity->AddComponent<Transform>().get());
+		Transform* transform = entity->GetTransform_PtrRaw();
+		transform->SetPositionLocal(Vector3(offset, 1.0f, 0.0f));
+		transform->SetRotationLocal(Quaternion::FromEulerAngles(0.0f, offset * 10.0f, 0.0f));
+		transform->SetScaleLocal(Vector3(0.9f));
+		transform->SetParent(parent);
+		entities.emplace_back(entity);
+		return transform;
+	}
+
+	// Parents come before their children, which is the order the per transform path resolves them in
+	vector<Transform*> CreateHierarchy(Context* context, vector<shared_ptr<Entity>>& entities, const unsigned int count)
+	{
+		vector<Transform*> roots;
+		for (unsigned int i = 0; i < count / nodes_per_root; i++)
+		{
+			Transform* root = CreateNode(context, entities, nullptr, static_cast<float>(i % 100));
+			for (unsigned int j = 0; j < children_per_node; j++)
+			{
+				Transform* child = CreateNode(context, entities, root, static_cast<float>(j));
+				for (unsigned int k = 0; k < children_per_node; k++)
+				{
+					CreateNode(context, entities, child, static_cast<float>(k));
+				}
+			}
+			roots.emplace_back(root);
+		}
+		return roots;
+	}
+
+	// Every root turns each frame, so every transform has to be resolved
+	void Animate(const vector<Transform*>& roots, const float angle)
+	{
+		for (Transform* root : roots)
+		{
+			root->SetRotationLocal(Quaternion::FromEulerAngles(0.0f, angle, 0.0f));
+		}
+	}
+}
+
+// Animated hierarchies of 10k, 100k and 1M transforms, resolved one transform at a time through GetMatrix()
+// and by the flattened hierarchy a level at a time. Both paths have to give the same matrices.
+int main()
+{
+	Test::Initialize();
+	Settings::Get().SetMaxThreadCount(4);
+	Threading threading(nullptr);
+	auto context = make_shared<Context>();
+
+	printf("%u threads\n", threading.GetThreadCount());
+	printf("     nodes   per transform   hierarchy   (ns per node)\n");
+	for (const unsigned int count : { 10000u, 100000u, 1000000u })
+	{
+		vector<shared_ptr<Entity>> entities;
+		entities.reserve(count);
+		const auto roots = CreateHierarchy(context.get(), entities, count);
+
+		TransformHierarchy hierarchy;
+		hierarchy.Update(entities, &threading);
+		TEST_CHECK(hierarchy.GetCount() == static_cast<unsigned int>(entities.size()));
+		TEST_CHECK(hierarchy.GetDepth() == 2);
+
+		float angle = 0.0f;
+		const float time_per_transform = Test::Time([&]()
+		{
+			Animate(roots, angle += 1.0f);
+			for (const auto& entity : entities)
+			{
+				entity->GetTransform_PtrRaw()->GetMatrix();
+			}
+		});
+		const float time_hierarchy = Test::Time([&]()
+		{
+			Animate(roots, angle += 1.0f);
+			hierarchy.Update(entities, &threading);
+		});
+
+		// The hierarchy resolves to the matrices the per transform path computes
+		Animate(roots, 45.0f);
+		hierarchy.Update(entities, &threading);
+		vector<Matrix> resolved;
+		for (const auto& entity : entities)
+		{
+			resolved.emplace_back(entity->GetTransform_PtrRaw()->GetMatrix());
+		}
+		Animate(roots, 0.0f);
+		hierarchy.Update(entities, &threading);
+		Animate(roots, 45.0f);
+		unsigned int mismatches = 0;
+		for (unsigned int i = 0; i < static_cast<unsigned int>(entities.size()); i++)
+		{
+			mismatches += entities[i]->GetTransform_PtrRaw()->GetMatrix() != resolved[i];
+		}
+		TEST_CHECK(mismatches == 0);
+
+		const float to_ns = 1e6f / entities.size();
+		printf("%10u %15.1f %11.1f\n", static_cast<unsigned int>(entities.size()), time_per_transform * to_ns, time_hierarchy * to_ns);
+	}
+
+	return Test::Finish("Transform hierarchy benchmark");
+}
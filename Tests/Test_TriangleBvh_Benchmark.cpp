@@ -0,0 +1,158 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES =====================
+#include "Test.h"
+#include <vector>
+#include <random>
+#include "Math/TriangleBvh.h"
+#include "Math/MathHelper.h"
+#include "RHI/RHI_Vertex.h"
+//================================
+
+//= NAMESPACES ===========
+using namespace std;
+using namespace Spartan;
+using namespace Spartan::Math;
+//========================
+
+namespace
+{
+	const unsigned int grid_size	= 708; // quads per side, 1M triangles
+	const unsigned int ray_count	= 10000;
+	const unsigned int ray_count_brute_force = 100;
+
+	// Brute force Moller-Trumbore over every triangle, with the same operations as the hierarchy
+	TriangleHit IntersectAll(const vector<RHI_Vertex_PosUvNorTan>& vertices, const vector<unsigned int>& indices, const Vector3& origin, const Vector3& direction)
+	{
+		TriangleHit hit;
+		for (unsigned int i = 0; i < static_cast<unsigned int>(indices.size()); i += 3)
+		{
+			const Vector3 vertex(vertices[indices[i]].pos[0], vertices[indices[i]].pos[1], vertices[indices[i]].pos[2]);
+			const Vector3 edge_1 = Vector3(vertices[indices[i + 1]].pos[0], vertices[indices[i + 1]].pos[1], vertices[indices[i + 1]].pos[2]) - vertex;
+			const Vector3 edge_2 = Vector3(vertices[indices[i + 2]].pos[0], vertices[indices[i + 2]].pos[1], vertices[indices[i + 2]].pos[2]) - vertex;
+
+			const Vector3 p				= Vector3::Cross(direction, edge_2);
+			const float determinant		= Vector3::Dot(edge_1, p);
+			if (Helper::Abs(determinant) < Helper::M_EPSILON)
+				continue;
+
+			const float determinant_inv = 1.0f / determinant;
+			const Vector3 s	= origin - vertex;
+			const float u	= Vector3::Dot(s, p) * determinant_inv;
+			if (u < 0.0f || u > 1.0f)
+				continue;
+
+			const Vector3 q	= Vector3::Cross(s, edge_1);
+			const float v	= Vector3::Dot(direction, q) * determinant_inv;
+			if (v < 0.0f || u + v > 1.0f)
+				continue;
+
+			const float t = Vector3::Dot(edge_2, q) * determinant_inv;
+			if (t <= 0.0f || t >= hit.distance)
+				continue;
+
+			hit.triangle		= i / 3;
+			hit.distance		= t;
+			hit.barycentrics	= Vector2(u, v);
+		}
+
+		return hit;
+	}
+}
+
+// Picking against a 1M triangle terrain, the hierarchy has to find what testing every triangle finds
+int main()
+{
+	Test::Initialize();
+
+	// A rolling terrain
+	vector<RHI_Vertex_PosUvNorTan> vertices;
+	vector<unsigned int> indices;
+	vertices.reserve((grid_size + 1) * (grid_size + 1));
+	indices.reserve(grid_size * grid_size * 6);
+	for (unsigned int z = 0; z <= grid_size; z++)
+	{
+		for (unsigned int x = 0; x <= grid_size; x++)
+		{
+			const float height = 4.0f * sinf(x * 0.05f) * cosf(z * 0.07f) + 0.5f * sinf(x * 0.9f + z * 1.3f);
+			vertices.emplace_back(Vector3(static_cast<float>(x), height, static_cast<float>(z)), Vector2::Zero, Vector3::Up, Vector3::Right);
+		}
+	}
+	for (unsigned int z = 0; z < grid_size; z++)
+	{
+		for (unsigned int x = 0; x < grid_size; x++)
+		{
+			const unsigned int i = z * (grid_size + 1) + x;
+			indices.insert(indices.end(), { i, i + grid_size + 1, i + 1, i + 1, i + grid_size + 1, i + grid_size + 2 });
+		}
+	}
+
+	Stopwatch stopwatch;
+	const TriangleBvh bvh(vertices.data(), indices.data(), static_cast<unsigned int>(indices.size()));
+	const float time_build = stopwatch.GetElapsedTimeMs();
+	TEST_CHECK(bvh.GetTriangleCount() == indices.size() / 3);
+
+	// Rays from a camera above the terrain, some of them miss it
+	mt19937 engine(1);
+	uniform_real_distribution<float> range(0.0f, 1.0f);
+	vector<pair<Vector3, Vector3>> rays(ray_count);
+	for (auto& ray : rays)
+	{
+		const Vector3 origin(range(engine) * grid_size, 50.0f, range(engine) * grid_size);
+		const Vector3 target(range(engine) * grid_size * 1.2f - grid_size * 0.1f, 0.0f, range(engine) * grid_size * 1.2f - grid_size * 0.1f);
+		ray = { origin, (target - origin).Normalized() };
+	}
+
+	vector<TriangleHit> hits(ray_count);
+	const float time_bvh = Test::Time([&bvh, &rays, &hits]()
+	{
+		for (unsigned int i = 0; i < ray_count; i++)
+		{
+			hits[i] = TriangleHit();
+			bvh.Intersect(rays[i].first, rays[i].second, &hits[i]);
+		}
+	});
+
+	unsigned int mismatches = 0;
+	unsigned int misses		= 0;
+	stopwatch.Start();
+	for (unsigned int i = 0; i < ray_count_brute_force; i++)
+	{
+		const TriangleHit expected = IntersectAll(vertices, indices, rays[i].first, rays[i].second);
+		misses += expected.distance == INFINITY ? 1 : 0;
+
+		// A ray through a shared edge can report either triangle, at the same distance
+		const bool same_distance	= hits[i].distance == expected.distance;
+		const bool same_triangle	= hits[i].triangle == expected.triangle && hits[i].barycentrics == expected.barycentrics;
+		mismatches += same_distance && (same_triangle || expected.distance != INFINITY) ? 0 : 1;
+	}
+	const float time_brute_force = stopwatch.GetElapsedTimeMs();
+
+	printf("%u triangles, %u nodes, built in %.0f ms\n", bvh.GetTriangleCount(), bvh.GetNodeCount(), time_build);
+	printf("Hierarchy   %8.3f us/ray\n", time_bvh * 1000.0f / ray_count);
+	printf("Brute force %8.3f us/ray\n", time_brute_force * 1000.0f / ray_count_brute_force);
+
+	TEST_CHECK(mismatches == 0);
+	TEST_CHECK(misses != 0 && misses != ray_count_brute_force);
+
+	return Test::Finish("Triangle BVH");
+}
@@ -0,0 +1,185 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ==========================
+#include "Test.h"
+#include <vector>
+#include <future>
+#include "Core/Engine.h"
+#include "Core/Context.h"
+#include "Core/Settings.h"
+#include "FileSystem/FileSystem.h"
+#include "World/World.h"
+#include "World/Entity.h"
+#include "World/Components/Transform.h"
+//=====================================
+
+//= NAMESPACES =====
+using namespace std;
+using namespace Spartan;
+//==================
+
+namespace
+{
+	const unsigned int children_per_root = 3;
+
+	// Loading waits for the world to stop ticking entities, so it runs on another thread while this one ticks
+	bool Load(World* world, const string& file_path)
+	{
+		auto loading = async(launch::async, [world, &file_path]() { return world->LoadFromFile(file_path); });
+		while (loading.wait_for(chrono::milliseconds(1)) != future_status::ready)
+		{
+			world->Tick();
+		}
+		return loading.get();
+	}
+
+	// Roots with a few children each, returns the roots
+	vector<Entity*> CreateHierarchy(World* world, const unsigned int count)
+	{
+		vector<Entity*> roots;
+		Transform* root = nullptr;
+		for (unsigned int i = 0; i < count; i++)
+		{
+			auto entity = world->EntityCreate().get();
+			if (i % (children_per_root + 1) == 0)
+			{
+				root = entity->GetTransform_PtrRaw();
+				roots.emplace_back(entity);
+				continue;
+			}
+			entity->GetTransform_PtrRaw()->SetParent(root);
+		}
+		return roots;
+	}
+}
+
+// Id lookups, re-parenting, saving, loading and removal of worlds of 25k, 50k and 100k entities, the time per
+// entity should stay about the same as the world grows. Runs from the build directory, next to a link to Data.
+int main()
+{
+	Test::Initialize();
+
+	FileSystem::DeleteFile_("Spartan.ini");
+	Settings::Get().SetMaxThreadCount(4);
+	auto context = make_shared<Context>();
+	Engine engine(context);
+	auto world = context->GetSubsystem<World>().get();
+	TEST_CHECK(world);
+	if (!world)
+		return Test::Finish("World entities benchmark");
+
+	const string file_path = "Test_World_Entities" + string(EXTENSION_WORLD);
+	printf("  entities   get by id   re-parent        save        load      remove   (ns per entity)\n");
+	for (const unsigned int count : { 25000u, 50000u, 100000u })
+	{
+		// Only the hierarchy, the camera, light and skybox of the default world go with the unload
+		world->Unload();
+		const auto roots = CreateHierarchy(world, count);
+		world->Tick();
+
+		vector<unsigned int> ids;
+		for (const auto& entity : world->Entities_GetAll())
+		{
+			ids.emplace_back(entity->GetId());
+		}
+
+		unsigned int found = 0;
+		const float time_get = Test::Time([&]()
+		{
+			found = 0;
+			for (const unsigned int id : ids)
+			{
+				const auto& entity = world->EntityGetById(id);
+				found += entity && entity->GetId() == id;
+			}
+		});
+		TEST_CHECK(found == static_cast<unsigned int>(ids.size()));
+
+		// Hand the children of every root to the next root, and back
+		struct Move { Transform* child; Transform* from; Transform* to; };
+		vector<Move> moves;
+		for (unsigned int i = 0; i < static_cast<unsigned int>(roots.size()); i++)
+		{
+			for (auto child : roots[i]->GetTransform_PtrRaw()->GetChildren())
+			{
+				moves.push_back({ child, roots[i]->GetTransform_PtrRaw(), roots[(i + 1) % roots.size()]->GetTransform_PtrRaw() });
+			}
+		}
+		const float time_reparent = Test::Time([&moves]()
+		{
+			for (const auto& move : moves) move.child->SetParent(move.to);
+			for (const auto& move : moves) move.child->SetParent(move.from);
+		}, 1);
+		unsigned int children = 0;
+		for (const auto& root : roots)
+		{
+			children += root->GetTransform_PtrRaw()->GetChildrenCount();
+		}
+		TEST_CHECK(children == count - static_cast<unsigned int>(roots.size()));
+
+		const unsigned int world_count = world->Entity_GetCount();
+		bool saved = false;
+		const float time_save = Test::Time([&]() { saved = world->SaveToFile(file_path); }, 1);
+		bool loaded = false;
+		const float time_load = Test::Time([&]() { loaded = Load(world, file_path); }, 1);
+		TEST_CHECK(saved && loaded);
+		TEST_CHECK(world->Entity_GetCount() == static_cast<int>(world_count));
+
+		// Ids and parents come back as they were saved
+		found = 0;
+		for (const unsigned int id : ids)
+		{
+			const auto& entity = world->EntityGetById(id);
+			found += entity && entity->GetId() == id;
+		}
+		TEST_CHECK(found == static_cast<unsigned int>(ids.size()));
+		unsigned int loaded_roots		= 0;
+		unsigned int loaded_children	= 0;
+		for (const auto& entity : world->Entities_GetAll())
+		{
+			const auto transform	= entity->GetTransform_PtrRaw();
+			loaded_roots			+= transform->GetChildrenCount() == children_per_root;
+			loaded_children			+= transform->HasParent();
+		}
+		TEST_CHECK(loaded_roots == static_cast<unsigned int>(roots.size()));
+		TEST_CHECK(loaded_children == children);
+
+		// Removing a root removes its children as well
+		const auto roots_loaded = world->EntitiesGetRoots();
+		const float time_remove = Test::Time([&]()
+		{
+			for (const auto& root : roots_loaded)
+			{
+				world->EntityRemove(root);
+			}
+		}, 1);
+		TEST_CHECK(world->Entity_GetCount() == 0);
+		TEST_CHECK(!world->EntityGetById(ids[0]));
+
+		const float to_ns = 1e6f / count;
+		printf("%10u %11.1f %11.1f %11.1f %11.1f %11.1f\n", count,
+			time_get * 1e6f / ids.size(), time_reparent * to_ns, time_save * to_ns, time_load * to_ns, time_remove * to_ns);
+	}
+
+	FileSystem::DeleteFile_(file_path);
+	return Test::Finish("World entities benchmark");
+}
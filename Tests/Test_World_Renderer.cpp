@@ -0,0 +1,176 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ===========================
+#include "Test.h"
+#include <vector>
+#include "Core/Engine.h"
+#include "Core/Context.h"
+#include "Core/FrameAllocator.h"
+#include "Core/Settings.h"
+#include "FileSystem/FileSystem.h"
+#include "Profiling/Profiler.h"
+#include "Rendering/Renderer.h"
+#include "Rendering/Material.h"
+#include "Rendering/Model.h"
+#include "World/World.h"
+#include "World/Entity.h"
+#include "World/Components/Transform.h"
+#include "World/Components/Renderable.h"
+//======================================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan;
+using namespace Spartan::Math;
+//============================
+
+// Ticks the world and the renderer on the null graphics backend with synthetic entities, the default
+// world puts the camera at (0, 1, -5) looking down +z. Runs from the build directory, next to a link to Data.
+namespace
+{
+	struct Scene
+	{
+		shared_ptr<Material> material;
+		shared_ptr<Model> model;
+		BoundingBox aabb; // model space
+		unsigned int index_count	= 0;
+		unsigned int vertex_count	= 0;
+	};
+
+	// All cubes share a model and a material, so the g-buffer pass can draw them as one batch
+	Entity* CreateCube(World* world, Scene& scene, const Vector3& position, const Vector3& scale = Vector3::One)
+	{
+		auto& entity = world->EntityCreate();
+		entity->GetTransform_PtrRaw()->SetPositionLocal(position);
+		entity->GetTransform_PtrRaw()->SetScaleLocal(scale);
+
+		auto renderable = entity->AddComponent<Renderable>();
+		if (!scene.model)
+		{
+			renderable->GeometrySet(Geometry_Default_Cube);
+			scene.model			= renderable->GeometryModel();
+			scene.aabb			= scene.model->GeometryAabb();
+			scene.index_count	= renderable->GeometryIndexCount();
+			scene.vertex_count	= renderable->GeometryVertexCount();
+		}
+		else
+		{
+			renderable->GeometrySet("Cube", 0, scene.index_count, 0, scene.vertex_count, scene.aabb, scene.model);
+		}
+		renderable->MaterialSet(scene.material);
+
+		return entity.get();
+	}
+
+	void TickFrame(Test::Logger& logger, World* world, Renderer* renderer)
+	{
+		TEST_CHECK_ERRORS(logger, 0,
+			FrameAllocator::OnFrameStart();
+			world->Tick();
+			renderer->Tick();
+		);
+	}
+}
+
+int main()
+{
+	auto& logger = Test::Initialize();
+
+	// Registers and initializes every subsystem the headless build has, nothing can be imported so
+	// the fonts and textures the renderer loads fail, the checks start counting errors after that.
+	// Record on a few threads whatever the machine has, the settings file would override the count
+	FileSystem::DeleteFile_("Spartan.ini");
+	Settings::Get().SetMaxThreadCount(4);
+	auto context = make_shared<Context>();
+	Engine engine(context);
+	auto world		= context->GetSubsystem<World>().get();
+	auto renderer	= context->GetSubsystem<Renderer>().get();
+	auto profiler	= context->GetSubsystem<Profiler>().get();
+	TEST_CHECK(world && renderer && profiler);
+	if (!world || !renderer || !profiler)
+		return Test::Finish("World and renderer");
+
+	Scene scene;
+	scene.material = make_shared<Material>(context.get());
+	scene.material->SetColorAlbedo(Vector4(0.5f, 0.5f, 0.5f, 1.0f));
+
+	// 32x32 cubes in front of the camera and as many behind it
+	const unsigned int grid_count = 32 * 32;
+	vector<Entity*> grid;
+	for (unsigned int i = 0; i < grid_count; i++)
+	{
+		const float x = static_cast<float>(i % 32) - 16.0f;
+		const float y = static_cast<float>(i / 32) - 16.0f;
+		grid.emplace_back(CreateCube(world, scene, Vector3(x, y, 30.0f)));
+		CreateCube(world, scene, Vector3(x, y, -40.0f));
+	}
+
+	const auto& batcher = renderer->GetInstanceBatcherGBuffer();
+
+	// Frustum culling drops everything behind the camera, what's left is drawn as one instanced batch
+	renderer->Flags_Disable(Render_OcclusionCulling);
+	TickFrame(logger, world, renderer);
+	TEST_CHECK(renderer->GetCamera() != nullptr);
+	TEST_CHECK(renderer->GetFrameNum() == 1);
+	TEST_CHECK(batcher.GetDrawCount() == grid_count);
+	TEST_CHECK(batcher.GetBatchCount() == 1);
+	TEST_CHECK(profiler->m_renderer_meshes_rendered == grid_count);
+	TEST_CHECK(profiler->m_renderer_batches_instanced == 1);
+	TEST_CHECK(profiler->m_rhi_draw_calls > 0);
+
+	// A wall between the camera and the grid
+	auto wall = CreateCube(world, scene, Vector3(0.0f, 0.0f, 20.0f), Vector3(80.0f, 80.0f, 1.0f));
+	TickFrame(logger, world, renderer);
+	TEST_CHECK(batcher.GetDrawCount() == grid_count + 1);
+
+	// With occlusion culling only the wall is left
+	renderer->Flags_Enable(Render_OcclusionCulling);
+	TickFrame(logger, world, renderer);
+	TEST_CHECK(batcher.GetDrawCount() == 1);
+	TEST_CHECK(profiler->m_renderer_meshes_rendered == 1);
+
+	// Moving the wall behind the camera brings the grid back, the moved transform reaches the renderer through the world
+	wall->GetTransform_PtrRaw()->SetPositionLocal(Vector3(0.0f, 0.0f, -20.0f));
+	TickFrame(logger, world, renderer);
+	TEST_CHECK(batcher.GetDrawCount() == grid_count);
+
+	TEST_CHECK(renderer->GetFrameNum() == 4);
+
+	// With a material each every cube is a batch of its own, enough to record them on all threads. The lists recorded
+	// in parallel are merged into the main one, so the backend draws as much as when everything is recorded on it.
+	for (auto entity : grid)
+	{
+		auto material = make_shared<Material>(context.get());
+		material->SetColorAlbedo(Vector4(0.5f, 0.5f, 0.5f, 1.0f));
+		entity->GetRenderable_PtrRaw()->MaterialSet(material);
+	}
+	renderer->Flags_Disable(Render_ParallelRecording);
+	TickFrame(logger, world, renderer);
+	const unsigned int draw_calls_serial = profiler->m_rhi_draw_calls;
+	renderer->Flags_Enable(Render_ParallelRecording);
+	TickFrame(logger, world, renderer);
+	TEST_CHECK(batcher.GetBatchCount() == grid_count);
+	TEST_CHECK(profiler->m_rhi_draw_calls == draw_calls_serial);
+	TEST_CHECK(draw_calls_serial > grid_count);
+
+	return Test::Finish("World and renderer");
+}